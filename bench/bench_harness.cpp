@@ -0,0 +1,207 @@
+// bench/bench_harness.cpp
+#include "bench_harness.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <iomanip>
+
+namespace YoloApp {
+namespace Bench {
+
+namespace {
+
+int64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+std::string jsonString(const std::string& value) {
+    std::string out = "\"";
+    for (char c : value) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+            out += escaped;
+        } else {
+            out += c;
+        }
+    }
+    return out + "\"";
+}
+
+} // namespace
+
+State::State(uint64_t iterations)
+    : iterations_(iterations)
+    , itemsPerIteration_(0)
+    , startNs_(0)
+    , elapsedNs_(0)
+    , running_(false) {
+}
+
+void State::start() {
+    elapsedNs_ = 0;
+    running_ = true;
+    startNs_ = nowNs();
+}
+
+void State::stop() {
+    if (running_) {
+        elapsedNs_ += nowNs() - startNs_;
+        running_ = false;
+    }
+}
+
+void State::pauseTiming() {
+    stop();
+}
+
+void State::resumeTiming() {
+    if (!running_) {
+        running_ = true;
+        startNs_ = nowNs();
+    }
+}
+
+double State::elapsedSeconds() const {
+    return elapsedNs_ / 1e9;
+}
+
+void Runner::add(const std::string& name, BenchmarkFunction function) {
+    entries_.push_back({name, std::move(function)});
+}
+
+double Runner::timeOnce(const BenchmarkFunction& function, uint64_t iterations, uint64_t& items) {
+    State state(iterations);
+    state.start();
+    function(state);
+    state.stop();
+    items = state.itemsPerIteration();
+    return state.elapsedSeconds();
+}
+
+std::vector<Result> Runner::run(const RunOptions& options, std::ostream& log) {
+    std::vector<Result> results;
+
+    if (options.list) {
+        for (const auto& entry : entries_) {
+            log << entry.name << '\n';
+        }
+        return results;
+    }
+
+    log << std::left << std::setw(44) << "Benchmark"
+        << std::right << std::setw(14) << "median"
+        << std::setw(14) << "min"
+        << std::setw(10) << "stddev"
+        << std::setw(12) << "iterations"
+        << std::setw(16) << "items/s" << '\n'
+        << std::string(110, '-') << '\n';
+
+    for (const auto& entry : entries_) {
+        if (!options.filter.empty() && entry.name.find(options.filter) == std::string::npos) {
+            continue;
+        }
+
+        // Calibrate: grow the iteration count until one repetition is long enough
+        uint64_t items = 0;
+        uint64_t iterations = 1;
+        double seconds = timeOnce(entry.function, iterations, items);
+        while (seconds < options.minSecondsPerRepetition && iterations < (1ull << 40)) {
+            double scale = seconds > 0.0 ? options.minSecondsPerRepetition / seconds * 1.4 : 10.0;
+            iterations = std::max(iterations + 1, static_cast<uint64_t>(iterations * std::min(scale, 10.0)));
+            seconds = timeOnce(entry.function, iterations, items);
+        }
+
+        std::vector<double> perIterationNs;
+        for (int rep = 0; rep < std::max(1, options.repetitions); ++rep) {
+            seconds = timeOnce(entry.function, iterations, items);
+            perIterationNs.push_back(seconds * 1e9 / iterations);
+        }
+
+        Result result;
+        result.name = entry.name;
+        result.iterations = iterations;
+        result.repetitions = static_cast<int>(perIterationNs.size());
+
+        std::vector<double> sorted = perIterationNs;
+        std::sort(sorted.begin(), sorted.end());
+        size_t n = sorted.size();
+        result.minNs = sorted.front();
+        result.maxNs = sorted.back();
+        result.medianNs = n % 2 ? sorted[n / 2] : (sorted[n / 2 - 1] + sorted[n / 2]) / 2.0;
+
+        double sum = 0.0;
+        for (double ns : sorted) {
+            sum += ns;
+        }
+        result.meanNs = sum / n;
+        double variance = 0.0;
+        for (double ns : sorted) {
+            variance += (ns - result.meanNs) * (ns - result.meanNs);
+        }
+        result.stddevNs = n > 1 ? std::sqrt(variance / (n - 1)) : 0.0;
+        result.itemsPerSecond = items > 0 && result.medianNs > 0.0 ? items * 1e9 / result.medianNs : 0.0;
+
+        auto formatNs = [](double ns) {
+            char text[32];
+            if (ns >= 1e6) {
+                std::snprintf(text, sizeof(text), "%.3f ms", ns / 1e6);
+            } else if (ns >= 1e3) {
+                std::snprintf(text, sizeof(text), "%.3f us", ns / 1e3);
+            } else {
+                std::snprintf(text, sizeof(text), "%.1f ns", ns);
+            }
+            return std::string(text);
+        };
+        char spread[16];
+        std::snprintf(spread, sizeof(spread), "%.1f%%", result.meanNs > 0.0 ? 100.0 * result.stddevNs / result.meanNs : 0.0);
+
+        log << std::left << std::setw(44) << result.name
+            << std::right << std::setw(14) << formatNs(result.medianNs)
+            << std::setw(14) << formatNs(result.minNs)
+            << std::setw(10) << spread
+            << std::setw(12) << result.iterations
+            << std::setw(16) << std::fixed << std::setprecision(0) << result.itemsPerSecond
+            << std::defaultfloat << '\n';
+        log.flush();
+
+        results.push_back(result);
+    }
+
+    return results;
+}
+
+void Runner::writeJson(std::ostream& out,
+                       const std::vector<std::pair<std::string, std::string>>& context,
+                       const std::vector<Result>& results) {
+    out << "{\n  \"context\": {";
+    for (size_t i = 0; i < context.size(); ++i) {
+        out << (i ? ",\n    " : "\n    ") << jsonString(context[i].first) << ": " << jsonString(context[i].second);
+    }
+    out << "\n  },\n  \"benchmarks\": [";
+
+    out << std::fixed << std::setprecision(1);
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        out << (i ? ",\n    {" : "\n    {")
+            << "\"name\": " << jsonString(r.name)
+            << ", \"iterations\": " << r.iterations
+            << ", \"repetitions\": " << r.repetitions
+            << ", \"median_ns\": " << r.medianNs
+            << ", \"mean_ns\": " << r.meanNs
+            << ", \"min_ns\": " << r.minNs
+            << ", \"max_ns\": " << r.maxNs
+            << ", \"stddev_ns\": " << r.stddevNs
+            << ", \"items_per_second\": " << r.itemsPerSecond
+            << "}";
+    }
+    out << "\n  ]\n}\n";
+}
+
+} // namespace Bench
+} // namespace YoloApp
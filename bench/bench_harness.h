@@ -0,0 +1,125 @@
+// bench/bench_harness.h
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace YoloApp {
+namespace Bench {
+
+/**
+ * @brief Per-benchmark state handed to the body
+ *
+ * The body runs `iterations()` repetitions of the measured operation.
+ * Setup that must not be timed goes before the loop; per-iteration work
+ * that must not be timed can be bracketed with pauseTiming/resumeTiming.
+ */
+class State {
+public:
+    explicit State(uint64_t iterations);
+
+    uint64_t iterations() const { return iterations_; }
+
+    void pauseTiming();
+    void resumeTiming();
+
+    /**
+     * @brief Items processed per iteration (e.g. boxes), reported as items/s
+     */
+    void setItemsPerIteration(uint64_t items) { itemsPerIteration_ = items; }
+    uint64_t itemsPerIteration() const { return itemsPerIteration_; }
+
+    double elapsedSeconds() const;
+
+private:
+    friend class Runner;
+    void start();
+    void stop();
+
+    uint64_t iterations_;
+    uint64_t itemsPerIteration_;
+    int64_t startNs_;
+    int64_t elapsedNs_;
+    bool running_;
+};
+
+using BenchmarkFunction = std::function<void(State&)>;
+
+/**
+ * @brief Result of one benchmark: per-iteration time statistics over the repetitions
+ */
+struct Result {
+    std::string name;
+    uint64_t iterations = 0;
+    int repetitions = 0;
+    double meanNs = 0.0;
+    double medianNs = 0.0;
+    double minNs = 0.0;
+    double maxNs = 0.0;
+    double stddevNs = 0.0;
+    double itemsPerSecond = 0.0;
+};
+
+struct RunOptions {
+    std::string filter;             ///< Substring of the names to run; empty runs all
+    int repetitions = 5;
+    double minSecondsPerRepetition = 0.2;
+    bool list = false;
+};
+
+/**
+ * @brief Self-contained benchmark runner
+ *
+ * Each benchmark is calibrated until one repetition takes at least
+ * minSecondsPerRepetition, then repeated to get a spread. Results go to a
+ * human-readable table and optionally to a JSON document for tracking.
+ */
+class Runner {
+public:
+    void add(const std::string& name, BenchmarkFunction function);
+
+    std::vector<Result> run(const RunOptions& options, std::ostream& log);
+
+    /**
+     * @brief Write {"context": {...}, "benchmarks": [...]} for per-commit tracking
+     */
+    static void writeJson(std::ostream& out,
+                          const std::vector<std::pair<std::string, std::string>>& context,
+                          const std::vector<Result>& results);
+
+private:
+    struct Entry {
+        std::string name;
+        BenchmarkFunction function;
+    };
+
+    static double timeOnce(const BenchmarkFunction& function, uint64_t iterations, uint64_t& items);
+
+    std::vector<Entry> entries_;
+};
+
+/**
+ * @brief Keep the optimizer from discarding a computed value
+ */
+template <typename T>
+inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "g"(&value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+// Registration functions of the benchmark groups
+void registerCoreBenchmarks(Runner& runner);
+#ifdef YOLO_BENCH_DISPLAY
+void registerDisplayBenchmarks(Runner& runner);
+#endif
+
+} // namespace Bench
+} // namespace YoloApp
@@ -0,0 +1,124 @@
+// bench/bench_main.cpp
+#include "bench_harness.h"
+#include <opencv2/core.hpp>
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#ifdef YOLO_BENCH_DISPLAY
+#include <QGuiApplication>
+#endif
+
+#ifndef YOLO_GIT_COMMIT
+#define YOLO_GIT_COMMIT "unknown"
+#endif
+#ifndef YOLO_BUILD_TYPE
+#define YOLO_BUILD_TYPE "unknown"
+#endif
+
+namespace {
+
+void printUsage() {
+    std::cout << "Usage: yolo_bench [options]\n"
+              << "\n"
+              << "  --filter TEXT       Run only benchmarks whose name contains TEXT\n"
+              << "  --repetitions N     Timed repetitions per benchmark (default 5)\n"
+              << "  --min-time SECONDS  Minimum duration of one repetition (default 0.2)\n"
+              << "  --json FILE         Write machine-readable results to FILE\n"
+              << "  --list              List benchmark names and exit\n";
+}
+
+std::string currentTimeUtc() {
+    std::time_t now = std::time(nullptr);
+    char text[32];
+    std::strftime(text, sizeof(text), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+    return text;
+}
+
+std::string compilerName() {
+#if defined(__clang__)
+    return "clang " __clang_version__;
+#elif defined(__GNUC__)
+    return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+    return "msvc " + std::to_string(_MSC_VER);
+#else
+    return "unknown";
+#endif
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+#ifdef YOLO_BENCH_DISPLAY
+    // Pixmaps need a GUI application, but not a display
+    if (!std::getenv("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QGuiApplication app(argc, argv);
+#endif
+
+    YoloApp::Bench::RunOptions options;
+    std::string jsonPath;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--filter" && hasValue) {
+            options.filter = argv[++i];
+        } else if (arg == "--repetitions" && hasValue) {
+            options.repetitions = std::atoi(argv[++i]);
+        } else if (arg == "--min-time" && hasValue) {
+            options.minSecondsPerRepetition = std::atof(argv[++i]);
+        } else if (arg == "--json" && hasValue) {
+            jsonPath = argv[++i];
+        } else if (arg == "--list") {
+            options.list = true;
+        } else if (arg == "-h" || arg == "--help") {
+            printUsage();
+            return 0;
+        } else {
+            std::cerr << "Unknown argument: " << arg << "\n\n";
+            printUsage();
+            return 2;
+        }
+    }
+
+    // One thread keeps OpenCV timings comparable between machines and runs
+    cv::setNumThreads(1);
+
+    YoloApp::Bench::Runner runner;
+    YoloApp::Bench::registerCoreBenchmarks(runner);
+#ifdef YOLO_BENCH_DISPLAY
+    YoloApp::Bench::registerDisplayBenchmarks(runner);
+#endif
+
+    std::vector<YoloApp::Bench::Result> results = runner.run(options, std::cout);
+    if (options.list) {
+        return 0;
+    }
+
+    if (!jsonPath.empty()) {
+        std::vector<std::pair<std::string, std::string>> context = {
+            {"git_commit", YOLO_GIT_COMMIT},
+            {"build_type", YOLO_BUILD_TYPE},
+            {"compiler", compilerName()},
+            {"opencv_version", CV_VERSION},
+            {"hardware_threads", std::to_string(std::thread::hardware_concurrency())},
+            {"date", currentTimeUtc()}
+        };
+
+        std::ofstream out(jsonPath, std::ios::trunc);
+        YoloApp::Bench::Runner::writeJson(out, context, results);
+        if (!out) {
+            std::cerr << "Cannot write " << jsonPath << std::endl;
+            return 1;
+        }
+        std::cout << "\nResults written to " << jsonPath << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,239 @@
+// bench/core_benchmarks.cpp
+#include "bench_harness.h"
+#include "core/config.h"
+#include "core/detector.h"
+#include "core/trace.h"
+#include "processing/folder_scanner.h"
+#include "processing/image_processor.h"
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <random>
+
+namespace fs = std::filesystem;
+
+namespace YoloApp {
+namespace Bench {
+
+namespace {
+
+constexpr int NETWORK_SIZE = 640;
+constexpr int YOLOV5_ROWS = 25200;      // 3 heads x anchors at 640x640
+constexpr int YOLOV5_COLS = 85;         // 4 box + objectness + 80 COCO classes
+
+/**
+ * @brief A deterministic stand-in for a recorded YOLOv5 output tensor
+ *
+ * candidateFraction of the rows clear the default 0.5 threshold; the rest
+ * carry low objectness like the background rows of a real output.
+ */
+cv::Mat makeOutputTensor(double candidateFraction, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+    cv::Mat output(YOLOV5_ROWS, YOLOV5_COLS, CV_32F);
+    for (int r = 0; r < YOLOV5_ROWS; ++r) {
+        float* row = output.ptr<float>(r);
+        bool candidate = unit(rng) < candidateFraction;
+
+        row[0] = unit(rng) * NETWORK_SIZE;
+        row[1] = unit(rng) * NETWORK_SIZE;
+        row[2] = 8.0f + unit(rng) * 200.0f;
+        row[3] = 8.0f + unit(rng) * 200.0f;
+        row[4] = candidate ? 0.6f + 0.4f * unit(rng) : 0.3f * unit(rng);
+        for (int c = 5; c < YOLOV5_COLS; ++c) {
+            row[c] = 0.05f * unit(rng);
+        }
+        row[5 + static_cast<int>(unit(rng) * 79.99f)] = candidate ? 0.85f + 0.15f * unit(rng) : 0.2f;
+    }
+    return output;
+}
+
+/**
+ * @brief Clustered boxes, several overlapping boxes per object like raw detector output
+ */
+void makeNmsInput(int boxCount, unsigned seed, std::vector<cv::Rect>& boxes, std::vector<float>& scores) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::normal_distribution<float> jitter(0.0f, 4.0f);
+
+    boxes.clear();
+    scores.clear();
+    const int perObject = 8;
+    while (static_cast<int>(boxes.size()) < boxCount) {
+        float x = unit(rng) * 1800.0f;
+        float y = unit(rng) * 1000.0f;
+        float w = 20.0f + unit(rng) * 150.0f;
+        float h = 20.0f + unit(rng) * 150.0f;
+        for (int i = 0; i < perObject && static_cast<int>(boxes.size()) < boxCount; ++i) {
+            boxes.emplace_back(static_cast<int>(x + jitter(rng)), static_cast<int>(y + jitter(rng)),
+                               static_cast<int>(w + jitter(rng)), static_cast<int>(h + jitter(rng)));
+            scores.push_back(0.5f + 0.5f * unit(rng));
+        }
+    }
+}
+
+std::vector<Core::Detection> makeDetections(int count, const cv::Size& imageSize, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+    std::vector<Core::Detection> detections;
+    detections.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        int w = 20 + static_cast<int>(unit(rng) * 200);
+        int h = 20 + static_cast<int>(unit(rng) * 200);
+        int x = static_cast<int>(unit(rng) * (imageSize.width - w));
+        int y = static_cast<int>(unit(rng) * (imageSize.height - h));
+        int classId = static_cast<int>(unit(rng) * 79.99f);
+        detections.emplace_back(cv::Rect(x, y, w, h), 0.5f + 0.5f * unit(rng), classId, Config::COCO_CLASSES[classId]);
+    }
+    return detections;
+}
+
+cv::Mat makeImage(const cv::Size& size) {
+    cv::Mat image(size, CV_8UC3);
+    cv::randu(image, 0, 255);
+    return image;
+}
+
+/**
+ * @brief Folder tree of empty image files, created on first use and removed at exit
+ */
+class SyntheticTree {
+public:
+    SyntheticTree(int folders, int imagesPerFolder)
+        : folders_(folders), imagesPerFolder_(imagesPerFolder) {
+    }
+
+    ~SyntheticTree() {
+        if (!root_.empty()) {
+            std::error_code ignored;
+            fs::remove_all(root_, ignored);
+        }
+    }
+
+    const std::string& root() {
+        if (root_.empty()) {
+            create();
+        }
+        return root_;
+    }
+
+private:
+    void create() {
+        fs::path root = fs::temp_directory_path() /
+            ("yolo_bench_tree_" + std::to_string(folders_) + "x" + std::to_string(imagesPerFolder_));
+        fs::remove_all(root);
+
+        for (int f = 0; f < folders_; ++f) {
+            // Two levels deep, with a few non-image files mixed in
+            fs::path folder = root / ("group_" + std::to_string(f / 10)) / ("folder_" + std::to_string(f));
+            fs::create_directories(folder);
+            for (int i = 0; i < imagesPerFolder_; ++i) {
+                std::ofstream(folder / ("frame_" + std::to_string(i) + (i % 3 ? ".jpg" : ".png")));
+            }
+            std::ofstream(folder / "notes.txt");
+            std::ofstream(folder / "labels.json");
+        }
+        root_ = root.string();
+    }
+
+    int folders_;
+    int imagesPerFolder_;
+    std::string root_;
+};
+
+} // namespace
+
+void registerCoreBenchmarks(Runner& runner) {
+    // Preprocessing: resize, swap channels and normalize into the input blob
+    for (const cv::Size& size : {cv::Size(1280, 720), cv::Size(1920, 1080), cv::Size(4000, 3000)}) {
+        auto image = std::make_shared<cv::Mat>(makeImage(size));
+        std::string name = "preprocess/blob_" + std::to_string(size.width) + "x" + std::to_string(size.height);
+        runner.add(name, [image](State& state) {
+            Core::YoloDetector detector;
+            for (uint64_t i = 0; i < state.iterations(); ++i) {
+                cv::Mat blob = detector.createInputBlob(*image);
+                doNotOptimize(blob);
+            }
+        });
+    }
+
+    // Post-processing of a full YOLOv5 output at several candidate densities
+    for (double fraction : {0.001, 0.01, 0.05}) {
+        auto outputs = std::make_shared<std::vector<cv::Mat>>(1, makeOutputTensor(fraction, 42));
+        std::string name = "postprocess/yolov5_640_candidates_" + std::to_string(static_cast<int>(fraction * YOLOV5_ROWS));
+        runner.add(name, [outputs](State& state) {
+            Core::YoloDetector detector;
+            for (uint64_t i = 0; i < state.iterations(); ++i) {
+                std::vector<Core::Detection> detections = detector.postProcessDetections(*outputs, cv::Size(1920, 1080));
+                doNotOptimize(detections);
+            }
+            state.setItemsPerIteration(YOLOV5_ROWS);
+        });
+    }
+
+    // NMS on clustered boxes
+    for (int boxCount : {100, 1000, 10000}) {
+        auto boxes = std::make_shared<std::vector<cv::Rect>>();
+        auto scores = std::make_shared<std::vector<float>>();
+        makeNmsInput(boxCount, 7, *boxes, *scores);
+        runner.add("nms/boxes_" + std::to_string(boxCount), [boxes, scores](State& state) {
+            std::vector<int> keep;
+            for (uint64_t i = 0; i < state.iterations(); ++i) {
+                cv::dnn::NMSBoxes(*boxes, *scores, 0.5f, 0.4f, keep);
+                doNotOptimize(keep);
+            }
+            state.setItemsPerIteration(boxes->size());
+        });
+    }
+
+    // Drawing boxes and labels on a copy of the frame
+    for (int count : {10, 100, 1000}) {
+        cv::Size size(1920, 1080);
+        auto image = std::make_shared<cv::Mat>(makeImage(size));
+        auto detections = std::make_shared<std::vector<Core::Detection>>(makeDetections(count, size, 3));
+        runner.add("annotate/1920x1080_boxes_" + std::to_string(count), [image, detections](State& state) {
+            for (uint64_t i = 0; i < state.iterations(); ++i) {
+                cv::Mat annotated = Processing::ImageProcessor::createAnnotatedImage(*image, *detections);
+                doNotOptimize(annotated);
+            }
+            state.setItemsPerIteration(detections->size());
+        });
+    }
+
+    // Directory scanning of synthetic trees (file system cache warm after calibration)
+    for (const auto& shape : {std::make_pair(20, 100), std::make_pair(200, 250)}) {
+        auto tree = std::make_shared<SyntheticTree>(shape.first, shape.second);
+        std::string name = "scan/folders_" + std::to_string(shape.first) + "_images_" +
+                           std::to_string(shape.first * shape.second);
+        int images = shape.first * shape.second;
+        runner.add(name, [tree, images](State& state) {
+            state.pauseTiming();
+            const std::string& root = tree->root();
+            state.resumeTiming();
+
+            Processing::FolderScanner scanner;
+            for (uint64_t i = 0; i < state.iterations(); ++i) {
+                std::vector<Core::FolderResult> folders = scanner.scanForImages(root, true);
+                doNotOptimize(folders);
+            }
+            state.setItemsPerIteration(images);
+        });
+    }
+
+    // Cost of one trace span, recording off and on
+    for (bool enabled : {false, true}) {
+        runner.add(std::string("trace/span_") + (enabled ? "enabled" : "disabled"), [enabled](State& state) {
+            Core::Trace::setEnabled(enabled);
+            for (uint64_t i = 0; i < state.iterations(); ++i) {
+                Core::TraceSpan span("bench");
+            }
+            Core::Trace::setEnabled(false);
+            Core::Trace::clear();
+        });
+    }
+}
+
+} // namespace Bench
+} // namespace YoloApp
@@ -0,0 +1,45 @@
+// bench/display_benchmarks.cpp
+#include "bench_harness.h"
+#include "ui/display_image.h"
+#include <QImage>
+#include <QPixmap>
+#include <memory>
+
+namespace YoloApp {
+namespace Bench {
+
+void registerDisplayBenchmarks(Runner& runner) {
+    for (const cv::Size& size : {cv::Size(1920, 1080), cv::Size(4000, 3000)}) {
+        auto image = std::make_shared<cv::Mat>(size, CV_8UC3);
+        cv::randu(*image, 0, 255);
+        std::string suffix = std::to_string(size.width) + "x" + std::to_string(size.height);
+
+        // Zero-copy wrap, as done for every displayed frame
+        runner.add("display/wrap_mat_" + suffix, [image](State& state) {
+            for (uint64_t i = 0; i < state.iterations(); ++i) {
+                QImage wrapped = UI::DisplayImage::wrapMat(*image);
+                doNotOptimize(wrapped);
+            }
+        });
+
+        // Conversion done off the GUI thread by the prefetcher
+        runner.add("display/convert_rgb32_" + suffix, [image](State& state) {
+            for (uint64_t i = 0; i < state.iterations(); ++i) {
+                QImage converted = UI::DisplayImage::wrapMat(*image).convertToFormat(QImage::Format_RGB32);
+                doNotOptimize(converted);
+            }
+        });
+
+        // Full Mat to QPixmap path of a prefetch miss
+        runner.add("display/mat_to_pixmap_" + suffix, [image](State& state) {
+            for (uint64_t i = 0; i < state.iterations(); ++i) {
+                QPixmap pixmap = QPixmap::fromImage(
+                    UI::DisplayImage::wrapMat(*image).convertToFormat(QImage::Format_RGB32));
+                doNotOptimize(pixmap);
+            }
+        });
+    }
+}
+
+} // namespace Bench
+} // namespace YoloApp
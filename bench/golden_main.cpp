@@ -0,0 +1,482 @@
+// bench/golden_main.cpp
+#include "synthetic_dataset.h"
+#include "core/cascade_detector.h"
+#include "core/detection_metrics.h"
+#include "core/detector.h"
+#include "core/results_store.h"
+#include "processing/detection_pipeline.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifndef YOLO_GIT_COMMIT
+#define YOLO_GIT_COMMIT "unknown"
+#endif
+
+namespace fs = std::filesystem;
+using namespace YoloApp;
+
+namespace {
+
+constexpr const char* SETTINGS_FILE = "golden.cfg";
+
+enum ExitCode {
+    EXIT_PASS = 0,
+    EXIT_REGRESSION = 1,
+    EXIT_ERROR = 2
+};
+
+struct Options {
+    std::string command;
+    std::string imagesRoot;
+    std::string goldenDir;
+    std::string modelPath;
+    std::string configPath;
+    std::string classesPath;
+    std::string screenModelPath;
+    std::string screenConfigPath;
+    int screenInputSize = Config::CASCADE_SCREEN_INPUT_SIZE;
+    float screenThreshold = Config::CASCADE_SCREEN_THRESHOLD;
+    Core::DetectionConfig detection;
+    bool sizeOverridden = false;
+    bool thresholdsOverridden = false;
+    float matchIou = 0.5f;
+    float boxIouTolerance = 0.95f;
+    float scoreTolerance = 0.02f;
+    double maxMapDrift = 0.005;
+    double minRecall = 0.0;
+    int maxFailedImages = 0;
+    int worstImages = 10;
+    std::string jsonPath;
+};
+
+struct ImageReport {
+    std::string path;
+    size_t reference = 0;
+    size_t candidate = 0;
+    size_t missing = 0;
+    size_t extra = 0;
+    float minIou = 1.0f;
+    float maxScoreDelta = 0.0f;
+    bool failed = false;
+};
+
+void printUsage() {
+    std::cout << "Usage: yolo_golden record|compare [options]\n"
+              << "\n"
+              << "record  runs the detector over an image tree and stores its detections\n"
+              << "        as the golden reference (a session directory plus golden.cfg).\n"
+              << "compare runs the detector again and checks every image against the\n"
+              << "        reference; exits 0 when within tolerance, 1 on a regression.\n"
+              << "\n"
+              << "Data:\n"
+              << "  --golden DIR          Golden reference directory (required)\n"
+              << "  --images DIR          Image tree (default: a generated synthetic dataset)\n"
+              << "\n"
+              << "Model (default: the generated tiny Darknet model):\n"
+              << "  --model FILE          Model file\n"
+              << "  --config FILE         Darknet .cfg for .weights models\n"
+              << "  --classes FILE        Class names\n"
+              << "  --width N, --height N Network input size (compare: default as recorded)\n"
+              << "  --confidence X        Confidence threshold (compare: default as recorded)\n"
+              << "  --nms X               NMS threshold (compare: default as recorded)\n"
+              << "  --rect                Keep each image's aspect ratio in the input (not recorded)\n"
+              << "  --tiles               Detect in overlapping input-sized tiles (not recorded)\n"
+              << "  --tile-overlap X      Overlap between neighboring tiles (default 0.2)\n"
+              << "  --screen-model FILE   Run --model only where this small model finds something (cascade)\n"
+              << "  --screen-config FILE  Darknet .cfg for a .weights screening model\n"
+              << "  --screen-size N       Screening model input edge (default 416)\n"
+              << "  --screen-threshold X  Screening score that escalates an image (default 0.1)\n"
+              << "\n"
+              << "Tolerances (compare):\n"
+              << "  --iou X               IoU for a box to count as the same detection (default 0.5)\n"
+              << "  --box-iou-tol X       Minimum IoU of every matched box (default 0.95)\n"
+              << "  --score-tol X         Maximum score difference of a matched box (default 0.02)\n"
+              << "  --max-map-drift X     Maximum drop of mAP@0.5:0.95 against the golden set (default 0.005)\n"
+              << "  --min-recall X        Minimum share of golden boxes found at IoU 0.5 (default 0, not checked)\n"
+              << "  --max-failed-images N Images allowed outside the box/score tolerances (default 0)\n"
+              << "  --worst N             Worst images to list (default 10)\n"
+              << "  --json FILE           Write the report as JSON\n";
+}
+
+bool parseArguments(int argc, char* argv[], Options& options) {
+    if (argc < 2) {
+        printUsage();
+        return false;
+    }
+    options.command = argv[1];
+    if (options.command == "-h" || options.command == "--help") {
+        printUsage();
+        std::exit(EXIT_PASS);
+    }
+    if (options.command != "record" && options.command != "compare") {
+        std::cerr << "Unknown command: " << options.command << "\n\n";
+        printUsage();
+        return false;
+    }
+
+    options.imagesRoot = (fs::temp_directory_path() / "yolo_golden_dataset").string();
+    options.detection.inputWidth = 320;
+    options.detection.inputHeight = 320;
+
+    for (int i = 2; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "-h" || arg == "--help") {
+            printUsage();
+            std::exit(EXIT_PASS);
+        } else if (arg == "--golden" && hasValue) {
+            options.goldenDir = argv[++i];
+        } else if (arg == "--images" && hasValue) {
+            options.imagesRoot = argv[++i];
+        } else if (arg == "--model" && hasValue) {
+            options.modelPath = argv[++i];
+        } else if (arg == "--config" && hasValue) {
+            options.configPath = argv[++i];
+        } else if (arg == "--classes" && hasValue) {
+            options.classesPath = argv[++i];
+        } else if (arg == "--width" && hasValue) {
+            options.detection.inputWidth = std::atoi(argv[++i]);
+            options.sizeOverridden = true;
+        } else if (arg == "--height" && hasValue) {
+            options.detection.inputHeight = std::atoi(argv[++i]);
+            options.sizeOverridden = true;
+        } else if (arg == "--confidence" && hasValue) {
+            options.detection.confidenceThreshold = static_cast<float>(std::atof(argv[++i]));
+            options.thresholdsOverridden = true;
+        } else if (arg == "--nms" && hasValue) {
+            options.detection.nmsThreshold = static_cast<float>(std::atof(argv[++i]));
+            options.thresholdsOverridden = true;
+        } else if (arg == "--rect") {
+            options.detection.rectInference = true;
+        } else if (arg == "--tiles") {
+            options.detection.tiledInference = true;
+        } else if (arg == "--tile-overlap" && hasValue) {
+            options.detection.tileOverlap = static_cast<float>(std::atof(argv[++i]));
+        } else if (arg == "--screen-model" && hasValue) {
+            options.screenModelPath = argv[++i];
+        } else if (arg == "--screen-config" && hasValue) {
+            options.screenConfigPath = argv[++i];
+        } else if (arg == "--screen-size" && hasValue) {
+            options.screenInputSize = std::atoi(argv[++i]);
+        } else if (arg == "--screen-threshold" && hasValue) {
+            options.screenThreshold = static_cast<float>(std::atof(argv[++i]));
+        } else if (arg == "--min-recall" && hasValue) {
+            options.minRecall = std::atof(argv[++i]);
+        } else if (arg == "--iou" && hasValue) {
+            options.matchIou = static_cast<float>(std::atof(argv[++i]));
+        } else if (arg == "--box-iou-tol" && hasValue) {
+            options.boxIouTolerance = static_cast<float>(std::atof(argv[++i]));
+        } else if (arg == "--score-tol" && hasValue) {
+            options.scoreTolerance = static_cast<float>(std::atof(argv[++i]));
+        } else if (arg == "--max-map-drift" && hasValue) {
+            options.maxMapDrift = std::atof(argv[++i]);
+        } else if (arg == "--max-failed-images" && hasValue) {
+            options.maxFailedImages = std::atoi(argv[++i]);
+        } else if (arg == "--worst" && hasValue) {
+            options.worstImages = std::atoi(argv[++i]);
+        } else if (arg == "--json" && hasValue) {
+            options.jsonPath = argv[++i];
+        } else {
+            std::cerr << "Unknown argument: " << arg << "\n\n";
+            printUsage();
+            return false;
+        }
+    }
+
+    if (options.goldenDir.empty()) {
+        std::cerr << "--golden is required\n";
+        return false;
+    }
+    return true;
+}
+
+std::string relativePath(const std::string& path, const std::string& root) {
+    fs::path base = fs::path(root).lexically_normal();
+    if (!base.has_filename()) {
+        base = base.parent_path();  // Trailing separator
+    }
+    return fs::path(path).lexically_normal().lexically_relative(base).generic_string();
+}
+
+/**
+ * @brief Detection settings the reference was recorded with
+ */
+void writeSettings(const std::string& path, const Core::DetectionConfig& config) {
+    std::ofstream out(path, std::ios::trunc);
+    out << "input_width=" << config.inputWidth << "\n"
+        << "input_height=" << config.inputHeight << "\n"
+        << "confidence=" << config.confidenceThreshold << "\n"
+        << "nms=" << config.nmsThreshold << "\n"
+        << "git_commit=" << YOLO_GIT_COMMIT << "\n";
+    if (!out) {
+        throw std::runtime_error("Cannot write " + path);
+    }
+}
+
+void readSettings(const std::string& path, const Options& options, Core::DetectionConfig& config) {
+    std::ifstream in(path);
+    if (!in) {
+        throw std::runtime_error("Missing " + path + "; record a golden reference first");
+    }
+    std::string line;
+    while (std::getline(in, line)) {
+        size_t separator = line.find('=');
+        if (separator == std::string::npos) {
+            continue;
+        }
+        std::string key = line.substr(0, separator);
+        std::string value = line.substr(separator + 1);
+        if (!options.sizeOverridden && key == "input_width") {
+            config.inputWidth = std::atoi(value.c_str());
+        } else if (!options.sizeOverridden && key == "input_height") {
+            config.inputHeight = std::atoi(value.c_str());
+        } else if (!options.thresholdsOverridden && key == "confidence") {
+            config.confidenceThreshold = static_cast<float>(std::atof(value.c_str()));
+        } else if (!options.thresholdsOverridden && key == "nms") {
+            config.nmsThreshold = static_cast<float>(std::atof(value.c_str()));
+        } else if (key == "git_commit") {
+            std::cout << "Golden reference recorded at commit " << value << "\n";
+        }
+    }
+}
+
+/**
+ * @brief Run detection over the image tree, boxes only
+ */
+std::vector<Core::FolderResult> detectAll(const Options& options, const Core::DetectionConfig& config) {
+    auto detector = std::make_shared<Core::YoloDetector>();
+    detector->setConfig(config);
+    if (!detector->loadModel(options.modelPath, options.configPath, options.classesPath)) {
+        throw std::runtime_error("Failed to load model: " + options.modelPath);
+    }
+
+    std::shared_ptr<Core::IDetector> engine = detector;
+    std::shared_ptr<Core::CascadeDetector> cascade;
+    if (!options.screenModelPath.empty()) {
+        auto screen = std::make_shared<Core::YoloDetector>();
+        Core::DetectionConfig screenConfig = config;
+        screenConfig.inputWidth = options.screenInputSize;
+        screenConfig.inputHeight = options.screenInputSize;
+        screen->setConfig(screenConfig);
+        if (!screen->loadModel(options.screenModelPath, options.screenConfigPath, options.classesPath)) {
+            throw std::runtime_error("Failed to load screening model: " + options.screenModelPath);
+        }
+        Core::CascadeDetector::Options cascadeOptions;
+        cascadeOptions.screenThreshold = options.screenThreshold;
+        cascade = std::make_shared<Core::CascadeDetector>(screen, detector, cascadeOptions);
+        engine = cascade;
+    }
+
+    Processing::DetectionPipeline::Options pipelineOptions;
+    pipelineOptions.retainImages = false;
+    Processing::DetectionPipeline pipeline(engine, pipelineOptions);
+
+    Processing::DetectionPipeline::Callbacks callbacks;
+    callbacks.imageFailed = [](const std::string& path, const std::string& error) {
+        std::cerr << "Failed: " << path << ": " << error << "\n";
+    };
+    pipeline.setCallbacks(callbacks);
+    std::vector<Core::FolderResult> folders = pipeline.run(options.imagesRoot);
+    if (cascade) {
+        Core::CascadeDetector::Stats stats = cascade->stats();
+        std::printf("Cascade escalated %llu of %llu images (%.1f%%)\n",
+                    static_cast<unsigned long long>(stats.escalated), static_cast<unsigned long long>(stats.images),
+                    stats.escalationRate() * 100.0);
+    }
+    return folders;
+}
+
+int record(const Options& options) {
+    std::vector<Core::FolderResult> folders = detectAll(options, options.detection);
+
+    fs::remove_all(options.goldenDir);
+    size_t images = 0;
+    size_t detections = 0;
+    {
+        // Paths relative to the image root, so the reference survives moving the tree
+        Core::ResultsStoreWriter writer(options.goldenDir);
+        for (Core::FolderResult& folder : folders) {
+            folder.folderPath = relativePath(folder.folderPath, options.imagesRoot);
+            for (auto& image : folder.images) {
+                image->imagePath = relativePath(image->imagePath, options.imagesRoot);
+                detections += image->detections.size();
+            }
+            images += folder.images.size();
+            writer.appendFolder(folder);
+        }
+    }
+    writeSettings((fs::path(options.goldenDir) / SETTINGS_FILE).string(), options.detection);
+
+    std::cout << "Recorded " << detections << " detections over " << images << " images into "
+              << options.goldenDir << "\n";
+    return EXIT_PASS;
+}
+
+int compare(const Options& options) {
+    Core::DetectionConfig config = options.detection;
+    readSettings((fs::path(options.goldenDir) / SETTINGS_FILE).string(), options, config);
+
+    Core::ResultsStore golden;
+    golden.open(options.goldenDir);
+    std::map<std::string, std::vector<Core::Detection>> reference;
+    for (size_t f = 0; f < golden.folderCount(); ++f) {
+        Core::FolderResult folder = golden.loadFolder(f);
+        for (const auto& image : folder.images) {
+            reference[image->imagePath] = image->detections;
+        }
+    }
+
+    std::vector<Core::FolderResult> folders = detectAll(options, config);
+
+    Core::DetectionMetrics metrics;
+    std::vector<ImageReport> reports;
+    size_t unmatchedImages = 0;
+    for (const Core::FolderResult& folder : folders) {
+        for (const auto& image : folder.images) {
+            ImageReport report;
+            report.path = relativePath(image->imagePath, options.imagesRoot);
+            auto it = reference.find(report.path);
+            if (it == reference.end()) {
+                ++unmatchedImages;
+                continue;
+            }
+
+            Core::ImageComparison comparison =
+                Core::DetectionMetrics::compare(it->second, image->detections, options.matchIou);
+            metrics.addImage(it->second, image->detections);
+            reference.erase(it);
+
+            report.reference = comparison.matches.size() + comparison.missing.size();
+            report.candidate = image->detections.size();
+            report.missing = comparison.missing.size();
+            report.extra = comparison.extra.size();
+            report.minIou = comparison.minIou;
+            report.maxScoreDelta = comparison.maxAbsScoreDelta;
+            report.failed = report.missing > 0 || report.extra > 0 ||
+                            report.minIou < options.boxIouTolerance ||
+                            report.maxScoreDelta > options.scoreTolerance;
+            reports.push_back(report);
+        }
+    }
+    // Golden images that were not produced this time (deleted or failed to decode)
+    size_t missingImages = reference.size();
+
+    size_t failedImages = 0;
+    for (const ImageReport& report : reports) {
+        failedImages += report.failed;
+    }
+    double map50 = metrics.meanAveragePrecision(0.5f);
+    double mapCoco = metrics.meanAveragePrecisionCoco();
+    double drift = 1.0 - mapCoco;
+    double recall = metrics.recall(0.5f);
+    bool pass = missingImages == 0 && unmatchedImages == 0 &&
+                failedImages <= static_cast<size_t>(std::max(0, options.maxFailedImages)) &&
+                drift <= options.maxMapDrift && recall >= options.minRecall;
+
+    // Worst first: structural differences, then box drift, then score drift
+    std::vector<ImageReport> worst = reports;
+    std::sort(worst.begin(), worst.end(), [](const ImageReport& a, const ImageReport& b) {
+        size_t aCount = a.missing + a.extra;
+        size_t bCount = b.missing + b.extra;
+        if (aCount != bCount) {
+            return aCount > bCount;
+        }
+        if (a.minIou != b.minIou) {
+            return a.minIou < b.minIou;
+        }
+        return a.maxScoreDelta > b.maxScoreDelta;
+    });
+    worst.resize(std::min(worst.size(), static_cast<size_t>(std::max(0, options.worstImages))));
+
+    std::printf("Images compared: %zu, outside tolerance: %zu, missing from run: %zu, not in golden set: %zu\n",
+                reports.size(), failedImages, missingImages, unmatchedImages);
+    std::printf("mAP@0.5: %.4f, mAP@0.5:0.95: %.4f (drift %.4f, limit %.4f)\n",
+                map50, mapCoco, drift, options.maxMapDrift);
+    std::printf("Recall@0.5: %.4f (minimum %.4f)\n", recall, options.minRecall);
+    if (!worst.empty() && worst.front().failed) {
+        std::printf("\n%-48s %6s %6s %7s %5s %7s %9s\n", "worst images", "golden", "now", "missing", "extra",
+                    "min IoU", "max dScore");
+        for (const ImageReport& report : worst) {
+            if (!report.failed) {
+                break;
+            }
+            std::printf("%-48s %6zu %6zu %7zu %5zu %7.3f %9.4f\n", report.path.c_str(), report.reference,
+                        report.candidate, report.missing, report.extra, report.minIou, report.maxScoreDelta);
+        }
+    }
+    std::printf("\n%s\n", pass ? "PASS" : "REGRESSION");
+
+    if (!options.jsonPath.empty()) {
+        std::ofstream out(options.jsonPath, std::ios::trunc);
+        out.setf(std::ios::fixed);
+        out.precision(5);
+        out << "{\n"
+            << "  \"git_commit\": \"" << YOLO_GIT_COMMIT << "\",\n"
+            << "  \"pass\": " << (pass ? "true" : "false") << ",\n"
+            << "  \"images\": " << reports.size() << ",\n"
+            << "  \"failed_images\": " << failedImages << ",\n"
+            << "  \"missing_images\": " << missingImages << ",\n"
+            << "  \"unmatched_images\": " << unmatchedImages << ",\n"
+            << "  \"map50\": " << map50 << ",\n"
+            << "  \"map50_95\": " << mapCoco << ",\n"
+            << "  \"map_drift\": " << drift << ",\n"
+            << "  \"recall\": " << recall << ",\n"
+            << "  \"tolerances\": {\"iou\": " << options.matchIou << ", \"box_iou\": " << options.boxIouTolerance
+            << ", \"score\": " << options.scoreTolerance << ", \"map_drift\": " << options.maxMapDrift
+            << ", \"min_recall\": " << options.minRecall << "},\n"
+            << "  \"worst_images\": [";
+        for (size_t i = 0; i < worst.size(); ++i) {
+            const ImageReport& report = worst[i];
+            out << (i ? ",\n    " : "\n    ")
+                << "{\"path\": \"" << report.path << "\", \"golden\": " << report.reference
+                << ", \"now\": " << report.candidate << ", \"missing\": " << report.missing
+                << ", \"extra\": " << report.extra << ", \"min_iou\": " << report.minIou
+                << ", \"max_score_delta\": " << report.maxScoreDelta << "}";
+        }
+        out << (worst.empty() ? "]\n" : "\n  ]\n") << "}\n";
+        if (!out) {
+            std::cerr << "Cannot write " << options.jsonPath << std::endl;
+            return EXIT_ERROR;
+        }
+    }
+    return pass ? EXIT_PASS : EXIT_REGRESSION;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseArguments(argc, argv, options)) {
+        return EXIT_ERROR;
+    }
+
+    try {
+        // Default data: a small fixed-seed synthetic tree and the tiny model beside it
+        if (!fs::exists(options.imagesRoot) || fs::is_empty(options.imagesRoot)) {
+            Bench::DatasetSpec spec;
+            spec.folders = 2;
+            spec.imagesPerFolder = 20;
+            spec.seed = 7;
+            size_t written = Bench::SyntheticDataset::generate(options.imagesRoot, spec);
+            std::cout << "Generated " << written << " images in " << options.imagesRoot << "\n";
+        }
+        if (options.modelPath.empty()) {
+            Bench::SyntheticDataset::writeTinyModel(options.imagesRoot + "_model", options.configPath,
+                                                    options.modelPath);
+        }
+
+        return options.command == "record" ? record(options) : compare(options);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return EXIT_ERROR;
+    }
+}
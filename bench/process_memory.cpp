@@ -0,0 +1,58 @@
+// bench/process_memory.cpp
+#include "process_memory.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#include <unistd.h>
+#include <fstream>
+#endif
+
+namespace YoloApp {
+namespace Bench {
+
+uint64_t peakResidentBytes() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return counters.PeakWorkingSetSize;
+    }
+    return 0;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+#ifdef __APPLE__
+    return static_cast<uint64_t>(usage.ru_maxrss);          // Bytes on macOS
+#else
+    return static_cast<uint64_t>(usage.ru_maxrss) * 1024;   // Kilobytes on Linux
+#endif
+#endif
+}
+
+uint64_t currentResidentBytes() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return counters.WorkingSetSize;
+    }
+    return 0;
+#elif defined(__linux__)
+    // Second field of statm is the resident page count
+    std::ifstream statm("/proc/self/statm");
+    uint64_t totalPages = 0;
+    uint64_t residentPages = 0;
+    if (statm >> totalPages >> residentPages) {
+        return residentPages * static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+    }
+    return 0;
+#else
+    return 0;
+#endif
+}
+
+} // namespace Bench
+} // namespace YoloApp
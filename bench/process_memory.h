@@ -0,0 +1,20 @@
+// bench/process_memory.h
+#pragma once
+
+#include <cstdint>
+
+namespace YoloApp {
+namespace Bench {
+
+/**
+ * @brief Peak resident set size of this process in bytes (0 if unknown)
+ */
+uint64_t peakResidentBytes();
+
+/**
+ * @brief Current resident set size of this process in bytes (0 if unknown)
+ */
+uint64_t currentResidentBytes();
+
+} // namespace Bench
+} // namespace YoloApp
@@ -0,0 +1,171 @@
+// bench/synthetic_dataset.cpp
+#include "synthetic_dataset.h"
+#include <opencv2/imgcodecs.hpp>
+#include <opencv2/imgproc.hpp>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+
+namespace fs = std::filesystem;
+
+namespace YoloApp {
+namespace Bench {
+
+namespace {
+
+struct ConvLayer {
+    int filters;
+    int size;
+    int stride;
+    const char* activation;
+};
+
+// Five stride-2 stages down to stride 32, then the 1x1 detection convolution
+const ConvLayer TINY_LAYERS[] = {
+    {16, 3, 2, "leaky"},
+    {32, 3, 2, "leaky"},
+    {64, 3, 2, "leaky"},
+    {64, 3, 2, "leaky"},
+    {64, 3, 2, "leaky"},
+    {3 * (5 + 80), 1, 1, "linear"},
+};
+
+} // namespace
+
+size_t SyntheticDataset::generate(const std::string& root, const DatasetSpec& spec) {
+    if (spec.sizes.empty()) {
+        throw std::runtime_error("Dataset spec has no image sizes");
+    }
+
+    std::mt19937 rng(spec.seed);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+
+    // Marked before any image, so an interrupted run can still be regenerated
+    fs::create_directories(root);
+    {
+        std::ofstream marker(fs::path(root) / MARKER_FILE);
+        marker << "seed " << spec.seed << "\n";
+        if (!marker) {
+            throw std::runtime_error("Cannot write " + (fs::path(root) / MARKER_FILE).string());
+        }
+    }
+
+    const std::vector<int> jpegParams = {cv::IMWRITE_JPEG_QUALITY, spec.jpegQuality};
+    size_t written = 0;
+
+    for (int f = 0; f < spec.folders; ++f) {
+        // Nest every other folder one level deeper to exercise recursive scanning
+        fs::path folder = fs::path(root) / (f % 2 ? "nested" : "") / ("folder_" + std::to_string(f));
+        fs::create_directories(folder);
+
+        for (int i = 0; i < spec.imagesPerFolder; ++i) {
+            const cv::Size& size = spec.sizes[written % spec.sizes.size()];
+            bool png = unit(rng) < spec.pngFraction;
+            uint32_t imageSeed = static_cast<uint32_t>(rng());
+
+            char name[32];
+            std::snprintf(name, sizeof(name), "image_%05d.%s", i, png ? "png" : "jpg");
+            std::string path = (folder / name).string();
+
+            cv::Mat image = renderImage(size, imageSeed);
+            bool ok = png ? cv::imwrite(path, image) : cv::imwrite(path, image, jpegParams);
+            if (!ok) {
+                throw std::runtime_error("Cannot write " + path);
+            }
+            ++written;
+        }
+    }
+    return written;
+}
+
+bool SyntheticDataset::isGenerated(const std::string& root) {
+    std::error_code error;
+    return fs::is_regular_file(fs::path(root) / MARKER_FILE, error);
+}
+
+cv::Mat SyntheticDataset::renderImage(const cv::Size& size, uint32_t seed) {
+    cv::RNG rng(seed);
+
+    // Smooth low-frequency texture, upscaled from a coarse noise field
+    cv::Mat coarse(std::max(2, size.height / 32), std::max(2, size.width / 32), CV_8UC3);
+    rng.fill(coarse, cv::RNG::UNIFORM, 40, 215);
+    cv::Mat image;
+    cv::resize(coarse, image, size, 0, 0, cv::INTER_LINEAR);
+
+    // Scattered objects of varied size
+    int shapes = rng.uniform(0, 40);
+    for (int s = 0; s < shapes; ++s) {
+        cv::Scalar color(rng.uniform(0, 256), rng.uniform(0, 256), rng.uniform(0, 256));
+        int w = rng.uniform(8, std::max(9, size.width / 6));
+        int h = rng.uniform(8, std::max(9, size.height / 6));
+        cv::Point origin(rng.uniform(0, std::max(1, size.width - w)), rng.uniform(0, std::max(1, size.height - h)));
+        if (s % 3 == 0) {
+            cv::circle(image, cv::Point(origin.x + w / 2, origin.y + h / 2), std::min(w, h) / 2, color, cv::FILLED);
+        } else {
+            cv::rectangle(image, cv::Rect(origin.x, origin.y, w, h), color, cv::FILLED);
+        }
+    }
+
+    // Fine grain so the encoders have real detail to compress
+    cv::Mat grain(size, CV_8UC3);
+    rng.fill(grain, cv::RNG::UNIFORM, 0, 24);
+    image += grain;
+    return image;
+}
+
+void SyntheticDataset::writeTinyModel(const std::string& directory, std::string& cfgPath, std::string& weightsPath) {
+    fs::create_directories(directory);
+    cfgPath = (fs::path(directory) / "tiny.cfg").string();
+    weightsPath = (fs::path(directory) / "tiny.weights").string();
+
+    std::ostringstream cfg;
+    cfg << "[net]\nbatch=1\nsubdivisions=1\nwidth=320\nheight=320\nchannels=3\n";
+    for (const ConvLayer& layer : TINY_LAYERS) {
+        cfg << "\n[convolutional]\n"
+            << "filters=" << layer.filters << "\n"
+            << "size=" << layer.size << "\n"
+            << "stride=" << layer.stride << "\n"
+            << "pad=1\n"
+            << "activation=" << layer.activation << "\n";
+    }
+    cfg << "\n[yolo]\n"
+        << "mask=0,1,2\n"
+        << "anchors=10,14, 23,27, 37,58, 81,82, 135,169, 344,319\n"
+        << "classes=80\nnum=6\njitter=.3\nignore_thresh=.7\ntruth_thresh=1\nrandom=0\n";
+
+    std::ofstream cfgFile(cfgPath, std::ios::trunc);
+    cfgFile << cfg.str();
+    if (!cfgFile) {
+        throw std::runtime_error("Cannot write " + cfgPath);
+    }
+
+    // Darknet weights: version header, images seen, then per layer biases and kernels
+    std::ofstream weights(weightsPath, std::ios::binary | std::ios::trunc);
+    const int32_t version[3] = {0, 2, 0};
+    const uint64_t seen = 0;
+    weights.write(reinterpret_cast<const char*>(version), sizeof(version));
+    weights.write(reinterpret_cast<const char*>(&seen), sizeof(seen));
+
+    std::mt19937 rng(12345);
+    std::normal_distribution<float> kernel(0.0f, 0.08f);
+    int channels = 3;
+    for (const ConvLayer& layer : TINY_LAYERS) {
+        std::vector<float> biases(layer.filters, 0.0f);
+        std::vector<float> kernels(static_cast<size_t>(layer.filters) * channels * layer.size * layer.size);
+        for (float& w : kernels) {
+            w = kernel(rng);
+        }
+        weights.write(reinterpret_cast<const char*>(biases.data()), biases.size() * sizeof(float));
+        weights.write(reinterpret_cast<const char*>(kernels.data()), kernels.size() * sizeof(float));
+        channels = layer.filters;
+    }
+    if (!weights) {
+        throw std::runtime_error("Cannot write " + weightsPath);
+    }
+}
+
+} // namespace Bench
+} // namespace YoloApp
@@ -0,0 +1,70 @@
+// bench/synthetic_dataset.h
+#pragma once
+
+#include <opencv2/core.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace YoloApp {
+namespace Bench {
+
+/**
+ * @brief Shape of a generated image tree
+ */
+struct DatasetSpec {
+    int folders = 4;
+    int imagesPerFolder = 50;
+    std::vector<cv::Size> sizes = {cv::Size(1280, 720), cv::Size(1920, 1080)};  ///< Cycled per image
+    double pngFraction = 0.25;      ///< Share of images written as PNG, the rest JPEG
+    int jpegQuality = 90;
+    uint32_t seed = 1;
+};
+
+/**
+ * @brief Reproducible folder tree of synthetic images
+ *
+ * Images are textured backgrounds with a random number of filled shapes,
+ * so the encoded sizes and decode costs resemble photos more than flat
+ * frames do. With the same spec, seed, platform and OpenCV version the
+ * files are byte-identical.
+ */
+class SyntheticDataset {
+public:
+    /**
+     * @brief File written into the root first, marking the tree as generated
+     */
+    static constexpr const char* MARKER_FILE = ".yolo_synthetic_dataset";
+
+    /**
+     * @brief Write the tree under root (created if needed)
+     * @return Number of images written
+     * @throws std::runtime_error if the marker or an image cannot be written
+     */
+    static size_t generate(const std::string& root, const DatasetSpec& spec);
+
+    /**
+     * @brief Whether root holds a tree written by generate(), even a partial one
+     */
+    static bool isGenerated(const std::string& root);
+
+    /**
+     * @brief Render one image of the dataset
+     */
+    static cv::Mat renderImage(const cv::Size& size, uint32_t seed);
+
+    /**
+     * @brief Write a tiny Darknet YOLO model with deterministic weights
+     *
+     * Five convolutions and one YOLO head (80 classes, stride 32). It
+     * detects nothing meaningful, but the forward pass, output shape and
+     * post-processing load have the same structure as a real model.
+     * Writes tiny.cfg and tiny.weights into the directory.
+     *
+     * @throws std::runtime_error if the files cannot be written
+     */
+    static void writeTinyModel(const std::string& directory, std::string& cfgPath, std::string& weightsPath);
+};
+
+} // namespace Bench
+} // namespace YoloApp
@@ -0,0 +1,419 @@
+// bench/throughput_main.cpp
+#include "process_memory.h"
+#include "synthetic_dataset.h"
+#include "core/detector.h"
+#include "core/trace.h"
+#include "processing/detection_pipeline.h"
+#include "processing/image_processor.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifndef YOLO_GIT_COMMIT
+#define YOLO_GIT_COMMIT "unknown"
+#endif
+#ifndef YOLO_BUILD_TYPE
+#define YOLO_BUILD_TYPE "unknown"
+#endif
+
+namespace fs = std::filesystem;
+using namespace YoloApp;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double msSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+/**
+ * @brief Pass-through detector that times every detectObjects call
+ *
+ * Splits the per-image time into detection (preprocess, forward, decode,
+ * NMS) and everything around it (decode from disk, annotation, metadata)
+ * without touching the pipeline itself.
+ */
+class TimedDetector : public Core::IDetector {
+public:
+    explicit TimedDetector(std::shared_ptr<Core::IDetector> inner) : inner_(std::move(inner)) {}
+
+    bool loadModel(const std::string& modelPath, const std::string& configPath,
+                   const std::string& classesPath) override {
+        return inner_->loadModel(modelPath, configPath, classesPath);
+    }
+
+    std::vector<Core::Detection> detectObjects(const cv::Mat& image) override {
+        auto start = Clock::now();
+        std::vector<Core::Detection> detections = inner_->detectObjects(image);
+        lastMs_ = msSince(start);
+        return detections;
+    }
+
+    std::string lastDetectionError() const override { return inner_->lastDetectionError(); }
+
+    void setConfig(const Core::DetectionConfig& config) override { inner_->setConfig(config); }
+    Core::DetectionConfig getConfig() const override { return inner_->getConfig(); }
+    bool isLoaded() const override { return inner_->isLoaded(); }
+    std::string getModelInfo() const override { return inner_->getModelInfo(); }
+
+    // The harness runs one engine; a copy times its own calls
+    std::shared_ptr<Core::IDetector> clone() const override {
+        auto inner = inner_->clone();
+        return inner ? std::make_shared<TimedDetector>(inner) : nullptr;
+    }
+
+    /**
+     * @brief Time of the last call, reset to zero when read
+     */
+    double takeLastMs() {
+        double ms = lastMs_;
+        lastMs_ = 0.0;
+        return ms;
+    }
+
+private:
+    std::shared_ptr<Core::IDetector> inner_;
+    double lastMs_ = 0.0;
+};
+
+struct Options {
+    std::string datasetRoot;
+    bool regenerate = false;
+    Bench::DatasetSpec spec;
+    std::string modelPath;
+    std::string configPath;
+    std::string classesPath;
+    Core::DetectionConfig detection;
+    bool boxesOnly = false;
+    int warmup = 3;
+    int threads = -1;
+    std::string jsonPath;
+    std::string tracePath;
+};
+
+struct Percentiles {
+    double p50 = 0.0;
+    double p95 = 0.0;
+    double p99 = 0.0;
+    double max = 0.0;
+    double mean = 0.0;
+};
+
+Percentiles percentiles(std::vector<double> samples) {
+    Percentiles result;
+    if (samples.empty()) {
+        return result;
+    }
+    std::sort(samples.begin(), samples.end());
+
+    // Nearest-rank percentiles
+    auto rank = [&samples](double p) {
+        size_t index = static_cast<size_t>(std::ceil(p / 100.0 * samples.size()));
+        return samples[std::min(samples.size() - 1, index > 0 ? index - 1 : 0)];
+    };
+    result.p50 = rank(50);
+    result.p95 = rank(95);
+    result.p99 = rank(99);
+    result.max = samples.back();
+
+    double sum = 0.0;
+    for (double sample : samples) {
+        sum += sample;
+    }
+    result.mean = sum / samples.size();
+    return result;
+}
+
+bool parseSizes(const std::string& text, std::vector<cv::Size>& sizes) {
+    sizes.clear();
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        int width = 0;
+        int height = 0;
+        if (std::sscanf(item.c_str(), "%dx%d", &width, &height) != 2 || width <= 0 || height <= 0) {
+            return false;
+        }
+        sizes.emplace_back(width, height);
+    }
+    return !sizes.empty();
+}
+
+void printUsage() {
+    std::cout << "Usage: yolo_throughput [options]\n"
+              << "\n"
+              << "Runs scan -> detect -> annotate over a synthetic image tree and reports\n"
+              << "throughput, per-image latency percentiles, stage times and peak memory.\n"
+              << "\n"
+              << "Dataset:\n"
+              << "  --dataset DIR         Dataset root (default: <temp>/yolo_throughput_dataset)\n"
+              << "  --regenerate          Rewrite the dataset even if it exists (only one\n"
+              << "                        this tool generated; other directories are refused)\n"
+              << "  --folders N           Folders to generate (default 4)\n"
+              << "  --images N            Images per folder (default 50)\n"
+              << "  --sizes WxH[,WxH]     Image sizes, cycled (default 1280x720,1920x1080)\n"
+              << "  --png-fraction X      Share of PNG images (default 0.25)\n"
+              << "  --seed N              Generator seed (default 1)\n"
+              << "\n"
+              << "Model (default: a generated tiny Darknet model at 320x320):\n"
+              << "  --model FILE          Model file\n"
+              << "  --config FILE         Darknet .cfg for .weights models\n"
+              << "  --classes FILE        Class names\n"
+              << "  --width N, --height N Network input size\n"
+              << "  --rect                Keep each image's aspect ratio in the input\n"
+              << "  --tiles               Detect in overlapping input-sized tiles\n"
+              << "  --tile-overlap X      Overlap between neighboring tiles (default 0.2)\n"
+              << "\n"
+              << "Run:\n"
+              << "  --boxes-only          Keep boxes only, like the headless CLI (no annotation)\n"
+              << "  --warmup N            Untimed warm-up inferences (default 3)\n"
+              << "  --threads N           OpenCV threads (default: OpenCV's choice)\n"
+              << "  --json FILE           Write the report as JSON\n"
+              << "  --trace FILE          Write a Chrome trace of the timed run\n";
+}
+
+bool parseArguments(int argc, char* argv[], Options& options) {
+    options.datasetRoot = (fs::temp_directory_path() / "yolo_throughput_dataset").string();
+    options.detection.inputWidth = 320;
+    options.detection.inputHeight = 320;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "-h" || arg == "--help") {
+            printUsage();
+            std::exit(0);
+        } else if (arg == "--dataset" && hasValue) {
+            options.datasetRoot = argv[++i];
+        } else if (arg == "--regenerate") {
+            options.regenerate = true;
+        } else if (arg == "--folders" && hasValue) {
+            options.spec.folders = std::atoi(argv[++i]);
+        } else if (arg == "--images" && hasValue) {
+            options.spec.imagesPerFolder = std::atoi(argv[++i]);
+        } else if (arg == "--sizes" && hasValue) {
+            if (!parseSizes(argv[++i], options.spec.sizes)) {
+                std::cerr << "Invalid --sizes, expected e.g. 1920x1080,640x480\n";
+                return false;
+            }
+        } else if (arg == "--png-fraction" && hasValue) {
+            options.spec.pngFraction = std::atof(argv[++i]);
+        } else if (arg == "--seed" && hasValue) {
+            options.spec.seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--model" && hasValue) {
+            options.modelPath = argv[++i];
+        } else if (arg == "--config" && hasValue) {
+            options.configPath = argv[++i];
+        } else if (arg == "--classes" && hasValue) {
+            options.classesPath = argv[++i];
+        } else if (arg == "--width" && hasValue) {
+            options.detection.inputWidth = std::atoi(argv[++i]);
+        } else if (arg == "--height" && hasValue) {
+            options.detection.inputHeight = std::atoi(argv[++i]);
+        } else if (arg == "--rect") {
+            options.detection.rectInference = true;
+        } else if (arg == "--tiles") {
+            options.detection.tiledInference = true;
+        } else if (arg == "--tile-overlap" && hasValue) {
+            options.detection.tileOverlap = static_cast<float>(std::atof(argv[++i]));
+        } else if (arg == "--boxes-only") {
+            options.boxesOnly = true;
+        } else if (arg == "--warmup" && hasValue) {
+            options.warmup = std::atoi(argv[++i]);
+        } else if (arg == "--threads" && hasValue) {
+            options.threads = std::atoi(argv[++i]);
+        } else if (arg == "--json" && hasValue) {
+            options.jsonPath = argv[++i];
+        } else if (arg == "--trace" && hasValue) {
+            options.tracePath = argv[++i];
+        } else {
+            std::cerr << "Unknown argument: " << arg << "\n\n";
+            printUsage();
+            return false;
+        }
+    }
+    return true;
+}
+
+void writePercentiles(std::ostream& out, const char* name, const Percentiles& p) {
+    out << "\"" << name << "\": {\"p50\": " << p.p50 << ", \"p95\": " << p.p95
+        << ", \"p99\": " << p.p99 << ", \"max\": " << p.max << ", \"mean\": " << p.mean << "}";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseArguments(argc, argv, options)) {
+        return 2;
+    }
+    if (options.threads >= 0) {
+        cv::setNumThreads(options.threads);
+    }
+
+    try {
+        // Dataset (untimed); reused between runs unless asked to regenerate
+        bool generated = false;
+        bool hasData = fs::exists(options.datasetRoot) && !fs::is_empty(options.datasetRoot);
+        if (options.regenerate || !hasData) {
+            // --dataset may name any directory; only a tree this tool wrote is ever wiped
+            if (hasData && !Bench::SyntheticDataset::isGenerated(options.datasetRoot)) {
+                std::cerr << "Refusing to regenerate " << options.datasetRoot
+                          << ": it is not empty and was not created by yolo_throughput (no "
+                          << Bench::SyntheticDataset::MARKER_FILE << " file)" << std::endl;
+                return 2;
+            }
+            fs::remove_all(options.datasetRoot);
+            auto start = Clock::now();
+            size_t written = Bench::SyntheticDataset::generate(options.datasetRoot, options.spec);
+            std::cout << "Generated " << written << " images in " << options.datasetRoot
+                      << " (" << msSince(start) / 1000.0 << " s)\n";
+            generated = true;
+        }
+
+        if (options.modelPath.empty()) {
+            // Kept outside the dataset root so it is not scanned
+            std::string modelDir = options.datasetRoot + "_model";
+            Bench::SyntheticDataset::writeTinyModel(modelDir, options.configPath, options.modelPath);
+        }
+
+        uint64_t rssBefore = Bench::currentResidentBytes();
+
+        auto loadStart = Clock::now();
+        auto yolo = std::make_shared<Core::YoloDetector>();
+        yolo->setConfig(options.detection);
+        if (!yolo->loadModel(options.modelPath, options.configPath, options.classesPath)) {
+            std::cerr << "Failed to load model: " << options.modelPath << std::endl;
+            return 2;
+        }
+        double modelLoadMs = msSince(loadStart);
+        auto detector = std::make_shared<TimedDetector>(yolo);
+
+        Processing::DetectionPipeline::Options pipelineOptions;
+        pipelineOptions.retainImages = !options.boxesOnly;
+        Processing::DetectionPipeline pipeline(detector, pipelineOptions);
+
+        auto scanStart = Clock::now();
+        std::vector<Core::FolderResult> folders = pipeline.scan(options.datasetRoot);
+        double scanMs = msSince(scanStart);
+
+        // Warm-up on the first image so one-time initialization stays out of the percentiles
+        double warmupMs = 0.0;
+        if (!folders.empty() && !folders.front().images.empty() && options.warmup > 0) {
+            cv::Mat first = Processing::ImageProcessor::loadImage(folders.front().images.front()->imagePath);
+            auto start = Clock::now();
+            for (int i = 0; i < options.warmup; ++i) {
+                detector->detectObjects(first);
+            }
+            warmupMs = msSince(start);
+            detector->takeLastMs();
+        }
+
+        std::vector<double> latencyMs;
+        std::vector<double> detectMs;
+        size_t failed = 0;
+        size_t detections = 0;
+        Clock::time_point imageStart;
+
+        Processing::DetectionPipeline::Callbacks callbacks;
+        callbacks.imageFailed = [&failed](const std::string&, const std::string&) {
+            ++failed;
+        };
+        callbacks.imageProcessed = [&](size_t, size_t, const Core::ImageResult& image) {
+            latencyMs.push_back(msSince(imageStart));
+            detectMs.push_back(detector->takeLastMs());
+            detections += image.detections.size();
+            imageStart = Clock::now();
+        };
+        pipeline.setCallbacks(callbacks);
+
+        // Only the timed run is traced, not generation, scan or warm-up
+        if (!options.tracePath.empty()) {
+            Core::Trace::setThreadName("pipeline");
+            Core::Trace::setEnabled(true);
+        }
+
+        auto processStart = Clock::now();
+        for (size_t folderIndex = 0; folderIndex < folders.size(); ++folderIndex) {
+            imageStart = Clock::now();
+            pipeline.processFolder(folderIndex, folders[folderIndex]);
+        }
+        double processMs = msSince(processStart);
+
+        if (!options.tracePath.empty()) {
+            Core::Trace::setEnabled(false);
+            Core::Trace::writeChromeJson(options.tracePath);
+            std::cout << "Trace written to " << options.tracePath << "\n";
+        }
+
+        size_t images = latencyMs.size();
+        std::vector<double> otherMs(images);
+        for (size_t i = 0; i < images; ++i) {
+            otherMs[i] = std::max(0.0, latencyMs[i] - detectMs[i]);
+        }
+        Percentiles latency = percentiles(latencyMs);
+        Percentiles detect = percentiles(detectMs);
+        Percentiles other = percentiles(otherMs);
+        double imagesPerSecond = processMs > 0.0 ? images * 1000.0 / processMs : 0.0;
+        uint64_t peakRss = Bench::peakResidentBytes();
+
+        std::printf("\nImages: %zu (%zu failed), detections: %zu, folders: %zu\n",
+                    images, failed, detections, folders.size());
+        std::printf("Model load: %.1f ms, warm-up: %.1f ms, scan: %.1f ms\n", modelLoadMs, warmupMs, scanMs);
+        std::printf("Throughput: %.2f images/s over %.2f s\n", imagesPerSecond, processMs / 1000.0);
+        std::printf("%-28s %10s %10s %10s %10s %10s\n", "per image (ms)", "p50", "p95", "p99", "max", "mean");
+        for (const auto& row : {std::make_pair("total", latency), std::make_pair("detect", detect),
+                                std::make_pair("decode+annotate+metadata", other)}) {
+            std::printf("%-28s %10.2f %10.2f %10.2f %10.2f %10.2f\n", row.first,
+                        row.second.p50, row.second.p95, row.second.p99, row.second.max, row.second.mean);
+        }
+        std::printf("Peak RSS: %.1f MB (%.1f MB before model load)\n",
+                    peakRss / (1024.0 * 1024.0), rssBefore / (1024.0 * 1024.0));
+
+        if (!options.jsonPath.empty()) {
+            std::ofstream out(options.jsonPath, std::ios::trunc);
+            out.setf(std::ios::fixed);
+            out.precision(3);
+            out << "{\n"
+                << "  \"context\": {\"git_commit\": \"" << YOLO_GIT_COMMIT << "\", \"build_type\": \"" << YOLO_BUILD_TYPE
+                << "\", \"opencv_threads\": " << cv::getNumThreads() << "},\n"
+                << "  \"dataset\": {\"folders\": " << folders.size() << ", \"images\": " << images
+                << ", \"seed\": " << options.spec.seed << ", \"generated\": " << (generated ? "true" : "false") << "},\n"
+                << "  \"mode\": \"" << (options.boxesOnly ? "boxes_only" : "full") << "\",\n"
+                << "  \"input_size\": [" << options.detection.inputWidth << ", " << options.detection.inputHeight << "],\n"
+                << "  \"images\": " << images << ",\n"
+                << "  \"failed_images\": " << failed << ",\n"
+                << "  \"detections\": " << detections << ",\n"
+                << "  \"images_per_second\": " << imagesPerSecond << ",\n"
+                << "  \"stage_ms\": {\"model_load\": " << modelLoadMs << ", \"warmup\": " << warmupMs
+                << ", \"scan\": " << scanMs << ", \"process\": " << processMs << "},\n  ";
+            writePercentiles(out, "latency_ms", latency);
+            out << ",\n  ";
+            writePercentiles(out, "detect_ms", detect);
+            out << ",\n  ";
+            writePercentiles(out, "decode_annotate_metadata_ms", other);
+            out << ",\n"
+                << "  \"rss_before_bytes\": " << rssBefore << ",\n"
+                << "  \"peak_rss_bytes\": " << peakRss << "\n"
+                << "}\n";
+            if (!out) {
+                std::cerr << "Cannot write " << options.jsonPath << std::endl;
+                return 1;
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 2;
+    }
+    return 0;
+}
@@ -0,0 +1,7 @@
+// src/cli/batch_main.cpp
+#include "batch_runner.h"
+
+// Standalone headless entry point; links yolo_core only, no Qt
+int main(int argc, char* argv[]) {
+    return YoloApp::Cli::BatchRunner::main(argc, argv);
+}
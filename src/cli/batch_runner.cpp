@@ -0,0 +1,767 @@
+// src/cli/batch_runner.cpp
+#include "batch_runner.h"
+#include "../core/results_store.h"
+#include "../core/trace.h"
+#include "../processing/folder_scanner.h"
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+namespace YoloApp {
+namespace Cli {
+
+namespace {
+
+std::atomic<bool> g_interrupted(false);
+
+void onSignal(int) {
+    g_interrupted = true;
+}
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+bool parseFormat(const std::string& name, Processing::ResultExporter::Format& format) {
+    using Format = Processing::ResultExporter::Format;
+    if (name == "csv") {
+        format = Format::Csv;
+    } else if (name == "jsonl") {
+        format = Format::JsonLines;
+    } else if (name == "coco") {
+        format = Format::Coco;
+    } else if (name == "yolo") {
+        format = Format::YoloTxt;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+const char* formatKey(Processing::ResultExporter::Format format) {
+    using Format = Processing::ResultExporter::Format;
+    switch (format) {
+        case Format::Csv:       return "csv";
+        case Format::JsonLines: return "jsonl";
+        case Format::Coco:      return "coco";
+        case Format::YoloTxt:   return "yolo";
+    }
+    return "";
+}
+
+std::string jsonString(const std::string& value) {
+    std::string out = "\"";
+    for (char c : value) {
+        switch (c) {
+            case '"':  out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char escaped[8];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                    out += escaped;
+                } else {
+                    out += c;
+                }
+        }
+    }
+    return out + "\"";
+}
+
+bool parseNumber(const std::string& text, double& value) {
+    char* end = nullptr;
+    value = std::strtod(text.c_str(), &end);
+    return !text.empty() && end && *end == '\0';
+}
+
+} // namespace
+
+int BatchRunner::main(int argc, char* argv[]) {
+    Options options;
+    std::string error;
+    if (!parseArguments(argc, argv, options, error)) {
+        if (error == "help") {
+            printUsage(std::cout);
+            return EXIT_OK;
+        }
+        std::cerr << "Error: " << error << "\n\n";
+        printUsage(std::cerr);
+        return EXIT_FATAL;
+    }
+
+    std::signal(SIGINT, onSignal);
+    std::signal(SIGTERM, onSignal);
+
+    if (!options.tracePath.empty()) {
+        Core::Trace::setThreadName("main");
+        Core::Trace::setEnabled(true);
+    }
+
+    Summary summary;
+    int code = EXIT_FATAL;
+    try {
+        BatchRunner runner(options);
+        runner.setCancellationFlag(&g_interrupted);
+        summary = runner.run();
+        code = exitCode(summary);
+        error.clear();
+    } catch (const std::exception& e) {
+        error = e.what();
+        std::cerr << "Error: " << error << std::endl;
+    }
+
+    if (!options.quiet && !summary.slowestImages.empty()) {
+        printSlowestImages(std::cerr, summary);
+    }
+
+    std::string json = summaryJson(options, summary, error);
+    std::cout << json << std::endl;
+    if (!options.summaryPath.empty()) {
+        std::ofstream file(options.summaryPath, std::ios::trunc);
+        file << json << '\n';
+        if (!file) {
+            std::cerr << "Error: cannot write summary to " << options.summaryPath << std::endl;
+            code = EXIT_FATAL;
+        }
+    }
+    if (!options.tracePath.empty()) {
+        try {
+            Core::Trace::writeChromeJson(options.tracePath);
+        } catch (const std::exception& e) {
+            std::cerr << "Error: " << e.what() << std::endl;
+            code = EXIT_FATAL;
+        }
+    }
+    return code;
+}
+
+bool BatchRunner::parseArguments(int argc, char* argv[], Options& options, std::string& error) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+
+        // Options taking a value accept both "--name value" and "--name=value"
+        std::string value;
+        bool hasInlineValue = false;
+        size_t equals = arg.find('=');
+        if (arg.rfind("--", 0) == 0 && equals != std::string::npos) {
+            value = arg.substr(equals + 1);
+            arg = arg.substr(0, equals);
+            hasInlineValue = true;
+        }
+        auto takeValue = [&](std::string& target) {
+            if (hasInlineValue) {
+                target = value;
+                return true;
+            }
+            if (i + 1 >= argc) {
+                error = "missing value for " + arg;
+                return false;
+            }
+            target = argv[++i];
+            return true;
+        };
+        auto takeNumber = [&](double& target) {
+            std::string text;
+            if (!takeValue(text)) {
+                return false;
+            }
+            if (!parseNumber(text, target)) {
+                error = "invalid number for " + arg + ": " + text;
+                return false;
+            }
+            return true;
+        };
+
+        double number = 0.0;
+        if (arg == "--headless") {
+            continue;
+        } else if (arg == "-h" || arg == "--help") {
+            error = "help";
+            return false;
+        } else if (arg == "-m" || arg == "--model") {
+            if (!takeValue(options.modelPath)) return false;
+        } else if (arg == "--config") {
+            if (!takeValue(options.configPath)) return false;
+        } else if (arg == "--classes") {
+            if (!takeValue(options.classesPath)) return false;
+        } else if (arg == "--screen-model") {
+            if (!takeValue(options.screenModelPath)) return false;
+        } else if (arg == "--screen-config") {
+            if (!takeValue(options.screenConfigPath)) return false;
+        } else if (arg == "--screen-size") {
+            if (!takeNumber(number)) return false;
+            if (number < 32) {
+                error = "--screen-size must be at least 32";
+                return false;
+            }
+            options.screenInputSize = static_cast<int>(number);
+        } else if (arg == "--screen-threshold") {
+            if (!takeNumber(number)) return false;
+            if (number < Config::CASCADE_MIN_SCREEN_THRESHOLD || number > 1.0) {
+                std::ostringstream message;
+                message << "--screen-threshold must be between " << Config::CASCADE_MIN_SCREEN_THRESHOLD << " and 1";
+                error = message.str();
+                return false;
+            }
+            options.screenThreshold = static_cast<float>(number);
+        } else if (arg == "--recall-tolerance") {
+            if (!takeNumber(number)) return false;
+            if (number < 0.0 || number >= 1.0) {
+                error = "--recall-tolerance must be at least 0 and below 1";
+                return false;
+            }
+            options.recallTolerance = number;
+        } else if (arg == "--validation") {
+            if (!takeValue(options.validationFolder)) return false;
+        } else if (arg == "-f" || arg == "--folder") {
+            if (!takeValue(options.inputFolder)) return false;
+        } else if (arg == "-o" || arg == "--output") {
+            if (!takeValue(options.outputPath)) return false;
+        } else if (arg == "--session") {
+            if (!takeValue(options.sessionDirectory)) return false;
+        } else if (arg == "--summary") {
+            if (!takeValue(options.summaryPath)) return false;
+        } else if (arg == "--trace") {
+            if (!takeValue(options.tracePath)) return false;
+        } else if (arg == "--metrics") {
+            if (!takeValue(options.metricsPath)) return false;
+        } else if (arg == "--slowest") {
+            if (!takeNumber(number)) return false;
+            if (number < 0) {
+                error = "--slowest must not be negative";
+                return false;
+            }
+            options.slowestImages = static_cast<size_t>(number);
+        } else if (arg == "--metrics-interval") {
+            if (!takeNumber(number)) return false;
+            if (number < 1) {
+                error = "--metrics-interval must be at least 1 second";
+                return false;
+            }
+            options.metricsIntervalSeconds = static_cast<int>(number);
+        } else if (arg == "--cores") {
+            if (!takeNumber(number)) return false;
+            if (number < 1) {
+                error = "--cores must be at least 1";
+                return false;
+            }
+            options.cores = static_cast<int>(number);
+        } else if (arg == "--engines") {
+            std::string text;
+            if (!takeValue(text)) return false;
+            if (text == "auto") {
+                options.engines = 0;
+            } else if (!parseNumber(text, number) || number < 1) {
+                error = "--engines must be auto or at least 1";
+                return false;
+            } else {
+                options.engines = static_cast<int>(number);
+            }
+        } else if (arg == "--threads") {
+            if (!takeNumber(number)) return false;
+            if (number < 1) {
+                error = "--threads must be at least 1";
+                return false;
+            }
+            options.threadsPerEngine = static_cast<int>(number);
+        } else if (arg == "--pin") {
+            std::string name;
+            if (!takeValue(name)) return false;
+            if (!Core::ThreadScheduler::parsePinning(name, options.pinning)) {
+                error = "unknown pinning: " + name;
+                return false;
+            }
+        } else if (arg == "--format") {
+            std::string name;
+            if (!takeValue(name)) return false;
+            if (!parseFormat(name, options.format)) {
+                error = "unknown format: " + name;
+                return false;
+            }
+        } else if (arg == "--confidence") {
+            if (!takeNumber(number)) return false;
+            options.detection.confidenceThreshold = static_cast<float>(number);
+        } else if (arg == "--nms") {
+            if (!takeNumber(number)) return false;
+            options.detection.nmsThreshold = static_cast<float>(number);
+        } else if (arg == "--width") {
+            if (!takeNumber(number)) return false;
+            options.detection.inputWidth = static_cast<int>(number);
+        } else if (arg == "--height") {
+            if (!takeNumber(number)) return false;
+            options.detection.inputHeight = static_cast<int>(number);
+        } else if (arg == "--rect") {
+            options.detection.rectInference = true;
+        } else if (arg == "--tiles") {
+            options.detection.tiledInference = true;
+        } else if (arg == "--tile-overlap") {
+            if (!takeNumber(number)) return false;
+            options.detection.tileOverlap = static_cast<float>(number);
+        } else if (arg == "--no-full-frame") {
+            options.detection.tileFullFrame = false;
+        } else if (arg == "--tile-merge") {
+            std::string name;
+            if (!takeValue(name)) return false;
+            if (name != "nms" && name != "wbf") {
+                error = "unknown tile merge: " + name;
+                return false;
+            }
+            options.detection.tileWeightedFusion = name == "wbf";
+        } else if (arg == "--auto-tune") {
+            options.autoTune = true;
+        } else if (arg == "--no-recursive") {
+            options.recursive = false;
+        } else if (arg == "-q" || arg == "--quiet") {
+            options.quiet = true;
+        } else {
+            error = "unknown argument: " + arg;
+            return false;
+        }
+    }
+
+    if (options.modelPath.empty()) {
+        error = "--model is required";
+        return false;
+    }
+    if (options.inputFolder.empty()) {
+        error = "--folder is required";
+        return false;
+    }
+    if (options.outputPath.empty()) {
+        error = "--output is required";
+        return false;
+    }
+    if (!options.detection.isValid()) {
+        error = "invalid detection settings";
+        return false;
+    }
+    return true;
+}
+
+void BatchRunner::printUsage(std::ostream& out) {
+    out << "Usage: yolo_batch --model FILE --folder DIR --output PATH [options]\n"
+        << "       YOLODetectionApp --headless --model FILE --folder DIR --output PATH [options]\n"
+        << "\n"
+        << "Runs detection over a folder tree without a GUI and prints a JSON summary.\n"
+        << "\n"
+        << "Options:\n"
+        << "  -m, --model FILE       Model file (.onnx, .weights, .pb)\n"
+        << "      --config FILE      Darknet .cfg for .weights models\n"
+        << "      --classes FILE     Class names, one per line\n"
+        << "      --screen-model FILE  Screen every image with this small model first; only images\n"
+        << "                         where it finds something go to --model (cascade)\n"
+        << "      --screen-config FILE Darknet .cfg for a .weights screening model\n"
+        << "      --screen-size N    Screening model input edge (default 416)\n"
+        << "      --screen-threshold X  Fixed escalation score (0.01-1); without it the score is calibrated\n"
+        << "      --recall-tolerance X  Recall the cascade may lose against --model alone (default 0.02)\n"
+        << "      --validation DIR   Calibration images (default: a sample of the input)\n"
+        << "  -f, --folder DIR       Input folder\n"
+        << "  -o, --output PATH      Output file (a directory for --format yolo)\n"
+        << "      --format NAME      csv, jsonl (default), coco or yolo\n"
+        << "      --session DIR      Also save a session that the GUI can open\n"
+        << "      --summary FILE     Also write the JSON summary to a file\n"
+        << "      --trace FILE       Write a Chrome trace of the run (builds with YOLO_TRACING)\n"
+        << "      --metrics FILE     Write Prometheus metrics during the run (textfile collector)\n"
+        << "      --metrics-interval S  Seconds between metrics writes (default 15)\n"
+        << "      --slowest N        Report the N slowest images at the end (default 10, 0 for none)\n"
+        << "      --cores N          Threads the run may use in total (default all)\n"
+        << "      --engines N|auto   Images detected in parallel (default 1); auto measures and picks\n"
+        << "      --threads N        OpenCV threads per engine (default: cores / engines)\n"
+        << "      --pin MODE         Pin engine threads: none (default), cores or numa\n"
+        << "      --auto-tune        Sweep input size and engines on sample images, then use the best\n"
+        << "      --confidence X     Confidence threshold (default 0.5)\n"
+        << "      --nms X            NMS threshold (default 0.4)\n"
+        << "      --width N          Network input width (default 640)\n"
+        << "      --height N         Network input height (default 640)\n"
+        << "      --rect             Keep each image's aspect ratio in the input (stride-32 shapes)\n"
+        << "      --tiles            Detect large frames in overlapping input-sized tiles\n"
+        << "      --tile-overlap X   Share of a tile overlapping its neighbor (default 0.2)\n"
+        << "      --no-full-frame    With --tiles, skip the extra pass over the whole frame\n"
+        << "      --tile-merge NAME  Merge tile boxes with nms (default) or wbf (weighted box fusion)\n"
+        << "      --no-recursive     Only scan the top-level folder\n"
+        << "  -q, --quiet            Do not report per-image errors\n"
+        << "\n"
+        << "Exit codes: 0 success, 1 some images failed or interrupted, 2 fatal error\n";
+}
+
+BatchRunner::BatchRunner(Options options)
+    : options_(std::move(options))
+    , cancelled_(nullptr) {
+}
+
+void BatchRunner::setCancellationFlag(const std::atomic<bool>* cancelled) {
+    cancelled_ = cancelled;
+}
+
+BatchRunner::Summary BatchRunner::run() {
+    auto runStart = std::chrono::steady_clock::now();
+    summary_ = Summary();
+
+    auto detector = std::make_shared<Core::YoloDetector>();
+    detector->setConfig(options_.detection);
+    if (!detector->loadModel(options_.modelPath, options_.configPath, options_.classesPath)) {
+        throw std::runtime_error("Failed to load model: " + options_.modelPath +
+                                 (detector->getLastError().empty() ? "" : " (" + detector->getLastError() + ")"));
+    }
+    detector->warmUp();     // Keeps first-forward initialization out of the first image
+    detector_ = detector;
+    
+    if (!options_.screenModelPath.empty()) {
+        auto screen = std::make_shared<Core::YoloDetector>();
+        Core::DetectionConfig screenConfig = options_.detection;
+        screenConfig.inputWidth = options_.screenInputSize;
+        screenConfig.inputHeight = options_.screenInputSize;
+        screen->setConfig(screenConfig);
+        if (!screen->loadModel(options_.screenModelPath, options_.screenConfigPath, options_.classesPath)) {
+            throw std::runtime_error("Failed to load screening model: " + options_.screenModelPath +
+                                     (screen->getLastError().empty() ? "" : " (" + screen->getLastError() + ")"));
+        }
+        screen->warmUp();
+        Core::CascadeDetector::Options cascadeOptions;
+        if (options_.screenThreshold >= 0.0f) {
+            cascadeOptions.screenThreshold = options_.screenThreshold;
+        }
+        cascade_ = std::make_shared<Core::CascadeDetector>(screen, detector, cascadeOptions);
+        detector_ = cascade_;
+        summary_.cascade = true;
+        summary_.cascadeCalibration.screenThreshold = cascadeOptions.screenThreshold;
+    }
+    summary_.modelLoadSeconds = secondsSince(runStart);
+
+    Processing::DetectionPipeline::Options pipelineOptions;
+    pipelineOptions.recursive = options_.recursive;
+    pipelineOptions.retainImages = false;
+    pipeline_ = std::make_unique<Processing::DetectionPipeline>(detector_, pipelineOptions);
+    pipeline_->setCancellationFlag(cancelled_);
+
+    // Always collected: the slowest images are reported even without --metrics
+    metrics_ = std::make_shared<Core::PipelineMetrics>();
+    metrics_->setSlowestImagesKept(options_.slowestImages);
+    pipeline_->setMetrics(metrics_);
+    lastMetricsWrite_ = std::chrono::steady_clock::now();
+
+    auto scheduler = std::make_shared<Core::ThreadScheduler>(options_.cores);
+    scheduler->setPinning(options_.pinning);
+    if (options_.engines > 0) {
+        scheduler->setLayout({options_.engines, options_.threadsPerEngine});
+    }
+    pipeline_->setScheduler(scheduler);
+
+    Processing::DetectionPipeline::Callbacks callbacks;
+    callbacks.imageProcessed = [this](size_t, size_t, const Core::ImageResult& image) {
+        if (image.processed) {
+            ++summary_.processedImages;
+            summary_.detections += image.detections.size();
+        }
+        writeMetrics(false);
+    };
+    callbacks.imageFailed = [this](const std::string& imagePath, const std::string& error) {
+        ++summary_.failedImages;
+        if (!options_.quiet) {
+            std::cerr << "Error processing " << imagePath << ": " << error << std::endl;
+        }
+    };
+    pipeline_->setCallbacks(std::move(callbacks));
+
+    auto scanStart = std::chrono::steady_clock::now();
+    folders_ = pipeline_->scan(options_.inputFolder);
+    detected_.assign(folders_.size(), false);
+    summary_.scanSeconds = secondsSince(scanStart);
+
+    if (options_.autoTune && !isCancelled()) {
+        autoTune(*scheduler);
+    }
+
+    if (cascade_ && options_.screenThreshold < 0.0f && !isCancelled()) {
+        calibrateCascade();
+    }
+
+    auto calibrationStart = std::chrono::steady_clock::now();
+    pipeline_->calibrate(folders_);
+    summary_.calibrationSeconds = secondsSince(calibrationStart);
+    summary_.engines = scheduler->layout().engines;
+    summary_.threadsPerEngine = scheduler->layout().threadsPerEngine;
+    if (!options_.quiet && !scheduler->measurements().empty()) {
+        for (const auto& measurement : scheduler->measurements()) {
+            std::cerr << "Layout " << measurement.layout.engines << " x " << measurement.layout.threadsPerEngine
+                      << " threads: " << measurement.imagesPerSecond << " images/s" << std::endl;
+        }
+        std::cerr << "Using " << summary_.engines << " engine(s) x " << summary_.threadsPerEngine
+                  << " thread(s)" << std::endl;
+    }
+
+    summary_.folders = folders_.size();
+    for (const auto& folder : folders_) {
+        summary_.images += folder.images.size();
+    }
+
+    std::unique_ptr<Core::ResultsStoreWriter> storeWriter;
+    if (!options_.sessionDirectory.empty()) {
+        storeWriter = std::make_unique<Core::ResultsStoreWriter>(options_.sessionDirectory);
+    }
+
+    // Detection runs inside the exporter's folder loader, so each folder is
+    // written as soon as it is done and only one folder's pixels exist at a time
+    Processing::ResultExporter exporter(options_.format);
+    exporter.setCancellationFlag(cancelled_);
+    Processing::ResultExporter::Summary exported = exporter.exportResults(
+        folders_.size(), summary_.images,
+        [this, &storeWriter](size_t folderIndex) {
+            bool firstVisit = !detected_[folderIndex];
+            Core::FolderResult folder = detectFolder(folderIndex);
+            if (firstVisit && storeWriter && !isCancelled()) {
+                storeWriter->appendFolder(folder);
+            }
+            return folder;
+        },
+        options_.outputPath);
+
+    summary_.bytesWritten = exported.bytesWritten;
+    summary_.cancelled = exported.cancelled || isCancelled();
+    summary_.totalSeconds = secondsSince(runStart);
+    summary_.slowestImages = metrics_->slowestImages();
+    if (cascade_) {
+        summary_.cascadeStats = cascade_->stats();
+        if (!options_.quiet) {
+            std::cerr << "Cascade: " << summary_.cascadeStats.escalated << " of " << summary_.cascadeStats.images
+                      << " images escalated (" << summary_.cascadeStats.escalationRate() * 100.0 << "%)" << std::endl;
+        }
+    }
+    writeMetrics(true);
+    return summary_;
+}
+
+Core::FolderResult BatchRunner::detectFolder(size_t folderIndex) {
+    Core::FolderResult& folder = folders_[folderIndex];
+    if (detected_[folderIndex]) {
+        return folder;  // Second COCO pass
+    }
+    detected_[folderIndex] = true;
+
+    auto start = std::chrono::steady_clock::now();
+    pipeline_->processFolder(folderIndex, folder);
+    summary_.detectSeconds += secondsSince(start);
+
+    if (options_.format == Processing::ResultExporter::Format::Coco) {
+        return folder;
+    }
+
+    // Single-pass formats never come back for this folder
+    Core::FolderResult result = std::move(folder);
+    folders_[folderIndex] = Core::FolderResult();
+    return result;
+}
+
+void BatchRunner::autoTune(Core::ThreadScheduler& scheduler) {
+    auto start = std::chrono::steady_clock::now();
+    Processing::AutoTuner::Options tunerOptions;
+    tunerOptions.coreBudget = options_.cores;
+    Processing::AutoTuner tuner(detector_, tunerOptions);
+    tuner.setCancellationFlag(cancelled_);
+    Processing::AutoTuner::Result result = tuner.run(Processing::AutoTuner::sampleImages(folders_));
+    summary_.autoTuneSeconds = secondsSince(start);
+    if (result.recommended < 0 || result.cancelled) {
+        return;
+    }
+
+    const Processing::AutoTuner::Trial& best = result.trials[result.recommended];
+    if (!options_.quiet) {
+        char line[128];
+        std::cerr << "Auto-tune on " << result.sampleImages << " images against "
+                  << result.referenceSize << " px:\n";
+        std::snprintf(line, sizeof(line), "%7s %8s %8s %9s %8s %7s\n",
+                      "input", "engines", "threads", "images/s", "mAP@0.5", "recall");
+        std::cerr << line;
+        for (size_t i = 0; i < result.trials.size(); ++i) {
+            const auto& trial = result.trials[i];
+            std::snprintf(line, sizeof(line), "%7d %8d %8d %9.1f %8.3f %7.3f %s\n",
+                          trial.inputSize, trial.layout.engines, trial.layout.threadsPerEngine,
+                          trial.imagesPerSecond, trial.meanAveragePrecision, trial.recall,
+                          static_cast<int>(i) == result.recommended ? "<- used"
+                          : trial.paretoOptimal ? "pareto" : "");
+            std::cerr << line;
+        }
+        for (const auto& failure : result.failedSizes) {
+            std::cerr << "Dropped " << failure << "\n";
+        }
+    }
+
+    Core::DetectionConfig config = detector_->getConfig();
+    config.inputWidth = best.inputSize;
+    config.inputHeight = best.inputSize;
+    detector_->setConfig(config);
+    scheduler.setLayout(best.layout);
+    scheduler.applyIntraOpThreads();
+    summary_.tuned = best;
+}
+
+void BatchRunner::calibrateCascade() {
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::string> samples;
+    if (options_.validationFolder.empty()) {
+        samples = Processing::AutoTuner::sampleImages(folders_, Config::CASCADE_VALIDATION_IMAGES);
+    } else {
+        Processing::FolderScanner scanner;
+        samples = Processing::AutoTuner::sampleImages(scanner.scanForImages(options_.validationFolder, true),
+                                                      Config::CASCADE_VALIDATION_IMAGES);
+    }
+
+    Core::CascadeDetector::Calibration calibration =
+        cascade_->calibrate(samples, options_.recallTolerance, cancelled_);
+    summary_.cascadeCalibrationSeconds = secondsSince(start);
+    summary_.cascadeCalibration = calibration;
+    if (calibration.images == 0) {
+        if (!isCancelled()) {
+            throw std::runtime_error("None of the cascade validation images could be read");
+        }
+        return;
+    }
+
+    if (!options_.quiet) {
+        std::cerr << "Cascade calibrated on " << calibration.images << " images: escalating at "
+                  << calibration.screenThreshold << " keeps recall " << calibration.recall << " with "
+                  << calibration.escalationRate * 100.0 << "% escalated" << std::endl;
+        if (!calibration.withinTolerance) {
+            std::cerr << "Warning: the screening model misses more than the recall tolerance even at its lowest threshold"
+                      << std::endl;
+        }
+    }
+}
+
+void BatchRunner::writeMetrics(bool force) {
+    if (!metrics_ || options_.metricsPath.empty()) {
+        return;
+    }
+    auto now = std::chrono::steady_clock::now();
+    if (!force && now - lastMetricsWrite_ < std::chrono::seconds(options_.metricsIntervalSeconds)) {
+        return;
+    }
+    lastMetricsWrite_ = now;
+
+    // A scrape file that cannot be written never fails the run
+    try {
+        metrics_->writePrometheusFile(options_.metricsPath);
+    } catch (const std::exception& e) {
+        if (!options_.quiet) {
+            std::cerr << "Warning: " << e.what() << std::endl;
+        }
+    }
+}
+
+bool BatchRunner::isCancelled() const {
+    return cancelled_ && cancelled_->load();
+}
+
+void BatchRunner::printSlowestImages(std::ostream& out, const Summary& summary) {
+    char line[160];
+    out << "Slowest images (ms):\n";
+    std::snprintf(line, sizeof(line), "%9s %8s %8s %9s %8s %10s %11s %8s  %s\n",
+                  "total", "decode", "preproc", "inference", "nms", "candidates", "size", "MB", "image");
+    out << line;
+    for (const auto& image : summary.slowestImages) {
+        const Core::ImageTiming& timing = image.timing;
+        std::string size = std::to_string(image.imageSize.width) + "x" + std::to_string(image.imageSize.height);
+        std::snprintf(line, sizeof(line), "%9.1f %8.1f %8.1f %9.1f %8.1f %10u %11s %8.1f  ",
+                      timing.totalMicros / 1000.0, timing.decodeMicros / 1000.0,
+                      timing.preprocessMicros / 1000.0, timing.inferenceMicros / 1000.0,
+                      timing.postprocessMicros / 1000.0, timing.candidates, size.c_str(),
+                      timing.fileBytes / (1024.0 * 1024.0));
+        out << line << image.imagePath << "\n";
+    }
+}
+
+int BatchRunner::exitCode(const Summary& summary) {
+    if (summary.cancelled || summary.failedImages > 0) {
+        return EXIT_PARTIAL;
+    }
+    return EXIT_OK;
+}
+
+std::string BatchRunner::summaryJson(const Options& options, const Summary& summary, const std::string& error) {
+    const char* status = !error.empty() ? "error"
+                       : summary.cancelled ? "interrupted"
+                       : summary.failedImages > 0 ? "partial"
+                       : "ok";
+    double imagesPerSecond = summary.detectSeconds > 0.0 ? summary.processedImages / summary.detectSeconds : 0.0;
+
+    std::ostringstream out;
+    out.precision(3);
+    out << std::fixed
+        << "{\"status\":\"" << status << "\""
+        << ",\"model\":" << jsonString(options.modelPath)
+        << ",\"input\":" << jsonString(options.inputFolder)
+        << ",\"output\":" << jsonString(options.outputPath)
+        << ",\"format\":\"" << formatKey(options.format) << "\""
+        << ",\"folders\":" << summary.folders
+        << ",\"images\":" << summary.images
+        << ",\"processed_images\":" << summary.processedImages
+        << ",\"failed_images\":" << summary.failedImages
+        << ",\"detections\":" << summary.detections
+        << ",\"bytes_written\":" << summary.bytesWritten
+        << ",\"model_load_seconds\":" << summary.modelLoadSeconds
+        << ",\"scan_seconds\":" << summary.scanSeconds
+        << ",\"calibration_seconds\":" << summary.calibrationSeconds
+        << ",\"auto_tune_seconds\":" << summary.autoTuneSeconds
+        << ",\"engines\":" << summary.engines
+        << ",\"threads_per_engine\":" << summary.threadsPerEngine
+        << ",\"detect_seconds\":" << summary.detectSeconds
+        << ",\"total_seconds\":" << summary.totalSeconds
+        << ",\"images_per_second\":" << imagesPerSecond;
+    if (summary.tuned.inputSize > 0) {
+        out << ",\"auto_tune\":{\"input_size\":" << summary.tuned.inputSize
+            << ",\"engines\":" << summary.tuned.layout.engines
+            << ",\"images_per_second\":" << summary.tuned.imagesPerSecond
+            << ",\"map50\":" << summary.tuned.meanAveragePrecision
+            << ",\"recall\":" << summary.tuned.recall << "}";
+    }
+    if (summary.cascade) {
+        const Core::CascadeDetector::Calibration& calibration = summary.cascadeCalibration;
+        out << ",\"cascade\":{\"screen_model\":" << jsonString(options.screenModelPath)
+            << ",\"images\":" << summary.cascadeStats.images
+            << ",\"escalated\":" << summary.cascadeStats.escalated
+            << ",\"escalation_rate\":" << summary.cascadeStats.escalationRate()
+            << ",\"screen_threshold\":" << calibration.screenThreshold;
+        if (calibration.images > 0) {
+            out << ",\"calibration_seconds\":" << summary.cascadeCalibrationSeconds
+                << ",\"validation_images\":" << calibration.images
+                << ",\"validation_recall\":" << calibration.recall
+                << ",\"within_tolerance\":" << (calibration.withinTolerance ? "true" : "false");
+        }
+        out << "}";
+    }
+    if (!summary.slowestImages.empty()) {
+        out << ",\"slowest_images\":[";
+        for (size_t i = 0; i < summary.slowestImages.size(); ++i) {
+            const auto& image = summary.slowestImages[i];
+            const Core::ImageTiming& timing = image.timing;
+            out << (i == 0 ? "" : ",")
+                << "{\"image\":" << jsonString(image.imagePath)
+                << ",\"width\":" << image.imageSize.width
+                << ",\"height\":" << image.imageSize.height
+                << ",\"file_bytes\":" << timing.fileBytes
+                << ",\"total_ms\":" << timing.totalMicros / 1000.0
+                << ",\"decode_ms\":" << timing.decodeMicros / 1000.0
+                << ",\"preprocess_ms\":" << timing.preprocessMicros / 1000.0
+                << ",\"inference_ms\":" << timing.inferenceMicros / 1000.0
+                << ",\"postprocess_ms\":" << timing.postprocessMicros / 1000.0
+                << ",\"candidates\":" << timing.candidates << "}";
+        }
+        out << "]";
+    }
+    if (!error.empty()) {
+        out << ",\"error\":" << jsonString(error);
+    }
+    out << "}";
+    return out.str();
+}
+
+} // namespace Cli
+} // namespace YoloApp
@@ -0,0 +1,150 @@
+// src/cli/batch_runner.h
+#pragma once
+
+#include "../core/types.h"
+#include "../core/config.h"
+#include "../core/detector.h"
+#include "../core/cascade_detector.h"
+#include "../core/pipeline_metrics.h"
+#include "../core/thread_scheduler.h"
+#include "../processing/detection_pipeline.h"
+#include "../processing/auto_tuner.h"
+#include "../processing/result_exporter.h"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace YoloApp {
+namespace Cli {
+
+/**
+ * @brief Headless batch detection for servers and render-farm nodes
+ *
+ * Loads a model, scans a folder tree and runs detection folder by folder
+ * while the results stream straight into a ResultExporter (and optionally
+ * a session store). No QApplication or widget is created, so no display
+ * is needed. When done, a one-line JSON summary with counts and throughput
+ * is written to stdout (and to --summary if given).
+ *
+ * Exit codes: 0 all images processed, 1 finished but some images failed
+ * or the run was interrupted, 2 usage error or fatal failure.
+ */
+class BatchRunner {
+public:
+    enum ExitCode {
+        EXIT_OK = 0,
+        EXIT_PARTIAL = 1,
+        EXIT_FATAL = 2
+    };
+
+    struct Options {
+        std::string modelPath;
+        std::string configPath;
+        std::string classesPath;
+        std::string inputFolder;
+        std::string outputPath;
+        std::string sessionDirectory;   ///< Also save a session when not empty
+        std::string summaryPath;        ///< Also write the JSON summary here when not empty
+        std::string tracePath;          ///< Record spans and write a Chrome trace here when not empty
+        std::string metricsPath;        ///< Write Prometheus metrics here during the run when not empty
+        int metricsIntervalSeconds = Config::METRICS_EXPORT_INTERVAL_SECONDS;
+        size_t slowestImages = Core::PipelineMetrics::DEFAULT_SLOWEST_IMAGES;  ///< Reported at the end, 0 for none
+        int cores = 0;                  ///< Thread budget, 0 for all hardware threads
+        int engines = 1;                ///< Images detected in parallel, 0 to measure and pick
+        int threadsPerEngine = 0;       ///< OpenCV threads per engine, 0 for an even share of the budget
+        Core::ThreadScheduler::Pinning pinning = Core::ThreadScheduler::Pinning::None;
+        bool autoTune = false;          ///< Sweep input size and engines on a sample first and use the recommendation
+        std::string screenModelPath;    ///< Screen images with this model first when not empty (cascade)
+        std::string screenConfigPath;
+        int screenInputSize = Config::CASCADE_SCREEN_INPUT_SIZE;
+        float screenThreshold = -1.0f;  ///< Fixed escalation threshold, negative to calibrate against recall
+        double recallTolerance = Config::CASCADE_RECALL_TOLERANCE;
+        std::string validationFolder;   ///< Calibration images, a sample of the input when empty
+        Processing::ResultExporter::Format format = Processing::ResultExporter::Format::JsonLines;
+        Core::DetectionConfig detection;
+        bool recursive = true;
+        bool quiet = false;             ///< No per-image errors on stderr
+    };
+
+    struct Summary {
+        size_t folders = 0;
+        size_t images = 0;
+        size_t processedImages = 0;
+        size_t failedImages = 0;
+        size_t detections = 0;
+        uint64_t bytesWritten = 0;
+        double modelLoadSeconds = 0.0;
+        double scanSeconds = 0.0;
+        double calibrationSeconds = 0.0;
+        double autoTuneSeconds = 0.0;
+        Processing::AutoTuner::Trial tuned;     ///< inputSize 0 unless --auto-tune ran
+        bool cascade = false;
+        double cascadeCalibrationSeconds = 0.0;
+        Core::CascadeDetector::Calibration cascadeCalibration;  ///< images 0 unless calibrated
+        Core::CascadeDetector::Stats cascadeStats;
+        int engines = 1;
+        int threadsPerEngine = 1;
+        double detectSeconds = 0.0;
+        double totalSeconds = 0.0;
+        bool cancelled = false;
+        std::vector<Core::PipelineMetrics::SlowImage> slowestImages;
+    };
+
+    /**
+     * @brief Entry point for `--headless`; parses argv, runs and reports
+     */
+    static int main(int argc, char* argv[]);
+
+    /**
+     * @brief Parse command line arguments
+     * @return false with a message in error on invalid input
+     */
+    static bool parseArguments(int argc, char* argv[], Options& options, std::string& error);
+
+    static void printUsage(std::ostream& out);
+
+    /**
+     * @brief Human-readable table of the slowest images and where their time went
+     */
+    static void printSlowestImages(std::ostream& out, const Summary& summary);
+
+    explicit BatchRunner(Options options);
+
+    /**
+     * @brief Flag polled between images to stop early (e.g. set from SIGTERM)
+     */
+    void setCancellationFlag(const std::atomic<bool>* cancelled);
+
+    /**
+     * @brief Run the batch
+     * @throws std::runtime_error on fatal errors (model, input or output)
+     */
+    Summary run();
+
+    static int exitCode(const Summary& summary);
+    static std::string summaryJson(const Options& options, const Summary& summary, const std::string& error = "");
+
+private:
+    Core::FolderResult detectFolder(size_t folderIndex);
+    bool isCancelled() const;
+    void writeMetrics(bool force);
+    void autoTune(Core::ThreadScheduler& scheduler);
+    void calibrateCascade();
+
+    Options options_;
+    std::shared_ptr<Core::IDetector> detector_;
+    std::shared_ptr<Core::CascadeDetector> cascade_;
+    std::unique_ptr<Processing::DetectionPipeline> pipeline_;
+    std::vector<Core::FolderResult> folders_;
+    std::vector<bool> detected_;
+    const std::atomic<bool>* cancelled_;
+    Summary summary_;
+    std::shared_ptr<Core::PipelineMetrics> metrics_;
+    std::chrono::steady_clock::time_point lastMetricsWrite_;
+};
+
+} // namespace Cli
+} // namespace YoloApp
@@ -0,0 +1,252 @@
+// src/core/cascade_detector.cpp
+#include "cascade_detector.h"
+#include "detection_metrics.h"
+#include "trace.h"
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+
+namespace YoloApp {
+namespace Core {
+
+namespace {
+
+// What the cascade returns for one image, given its screening boxes at the
+// lowest threshold and the confirming model's boxes
+const std::vector<Detection>* cascadeOutput(const std::vector<Detection>& screened,
+                                            const std::vector<Detection>& confirmed,
+                                            float screenThreshold, float acceptThreshold,
+                                            float confidenceThreshold, std::vector<Detection>& accepted,
+                                            bool& escalated) {
+    static const std::vector<Detection> nothing;
+    escalated = false;
+    accepted.clear();
+    bool confident = true;
+    for (const auto& detection : screened) {
+        if (detection.confidence >= screenThreshold) {
+            accepted.push_back(detection);
+            confident = confident && detection.confidence >= std::max(acceptThreshold, confidenceThreshold);
+        }
+    }
+    if (accepted.empty()) {
+        return &nothing;
+    }
+    if (acceptThreshold < 1.0f && confident) {
+        return &accepted;
+    }
+    escalated = true;
+    return &confirmed;
+}
+
+} // namespace
+
+CascadeDetector::CascadeDetector(std::shared_ptr<IDetector> screen, std::shared_ptr<IDetector> confirm,
+                                 Options options)
+    : CascadeDetector(std::move(screen), std::move(confirm), options, std::make_shared<Counters>()) {
+}
+
+CascadeDetector::CascadeDetector(std::shared_ptr<IDetector> screen, std::shared_ptr<IDetector> confirm,
+                                 Options options, std::shared_ptr<Counters> counters)
+    : screen_(std::move(screen))
+    , confirm_(std::move(confirm))
+    , counters_(std::move(counters))
+    , options_(options) {
+    if (!screen_ || !confirm_) {
+        throw std::invalid_argument("A cascade needs a screening and a confirming detector");
+    }
+    validateOptions(options_);
+    applyScreenConfig(options_.screenThreshold);
+}
+
+bool CascadeDetector::loadModel(const std::string& modelPath,
+                                const std::string& configPath,
+                                const std::string& classesPath) {
+    return confirm_->loadModel(modelPath, configPath, classesPath);
+}
+
+std::vector<Detection> CascadeDetector::detectObjects(const cv::Mat& image) {
+    Options options = this->options();
+    ++counters_->images;
+
+    std::vector<Detection> screened;
+    {
+        YOLO_TRACE_SPAN("screen");
+        screened = screen_->detectObjects(image);
+    }
+    detectionError_ = screen_->lastDetectionError();
+    if (screened.empty()) {
+        return {};
+    }
+
+    float confidenceThreshold = confirm_->getConfig().confidenceThreshold;
+    if (options.acceptThreshold < 1.0f &&
+        std::all_of(screened.begin(), screened.end(), [&](const Detection& detection) {
+            return detection.confidence >= std::max(options.acceptThreshold, confidenceThreshold);
+        })) {
+        ++counters_->acceptedByScreen;
+        return screened;
+    }
+
+    ++counters_->escalated;
+    YOLO_TRACE_SPAN("confirm");
+    std::vector<Detection> confirmed = confirm_->detectObjects(image);
+    detectionError_ = confirm_->lastDetectionError();
+    return confirmed;
+}
+
+void CascadeDetector::setConfig(const DetectionConfig& config) {
+    confirm_->setConfig(config);
+    applyScreenConfig(options().screenThreshold);
+}
+
+DetectionConfig CascadeDetector::getConfig() const {
+    return confirm_->getConfig();
+}
+
+bool CascadeDetector::isLoaded() const {
+    return screen_->isLoaded() && confirm_->isLoaded();
+}
+
+std::string CascadeDetector::getModelInfo() const {
+    Options options = this->options();
+    return confirm_->getModelInfo() +
+           "\n\nScreened by:\n" + screen_->getModelInfo() +
+           "\nEscalation threshold: " + std::to_string(options.screenThreshold);
+}
+
+std::shared_ptr<IDetector> CascadeDetector::clone() const {
+    std::shared_ptr<IDetector> screen = screen_->clone();
+    std::shared_ptr<IDetector> confirm = screen ? confirm_->clone() : nullptr;
+    if (!screen || !confirm) {
+        return nullptr;
+    }
+    return std::shared_ptr<CascadeDetector>(
+        new CascadeDetector(std::move(screen), std::move(confirm), options(), counters_));
+}
+
+void CascadeDetector::setOptions(const Options& options) {
+    validateOptions(options);
+    {
+        std::lock_guard<std::mutex> lock(optionsMutex_);
+        options_ = options;
+    }
+    applyScreenConfig(options.screenThreshold);
+}
+
+CascadeDetector::Options CascadeDetector::options() const {
+    std::lock_guard<std::mutex> lock(optionsMutex_);
+    return options_;
+}
+
+CascadeDetector::Stats CascadeDetector::stats() const {
+    Stats stats;
+    stats.images = counters_->images.load();
+    stats.escalated = counters_->escalated.load();
+    stats.acceptedByScreen = counters_->acceptedByScreen.load();
+    return stats;
+}
+
+void CascadeDetector::resetStats() {
+    counters_->images = 0;
+    counters_->escalated = 0;
+    counters_->acceptedByScreen = 0;
+}
+
+CascadeDetector::Calibration CascadeDetector::calibrate(const std::vector<std::string>& imagePaths,
+                                                        double recallTolerance,
+                                                        const std::atomic<bool>* cancelled) {
+    if (!isLoaded()) {
+        throw std::runtime_error("Detector not loaded");
+    }
+
+    YOLO_TRACE_SPAN("cascade calibrate");
+    Options options = this->options();
+    auto isCancelled = [cancelled]() { return cancelled && cancelled->load(); };
+
+    // One pass of each model; only the boxes are kept
+    std::vector<std::vector<Detection>> screened;
+    std::vector<std::vector<Detection>> confirmed;
+    applyScreenConfig(Config::CASCADE_MIN_SCREEN_THRESHOLD);
+    for (const auto& path : imagePaths) {
+        if (isCancelled()) {
+            break;
+        }
+        cv::Mat image = cv::imread(path, cv::IMREAD_COLOR);
+        if (image.empty()) {
+            continue;   // Unreadable images are reported by the real run
+        }
+        screened.push_back(screen_->detectObjects(image));
+        confirmed.push_back(confirm_->detectObjects(image));
+    }
+    applyScreenConfig(options.screenThreshold);
+
+    Calibration calibration;
+    calibration.images = screened.size();
+    calibration.screenThreshold = options.screenThreshold;
+    if (screened.empty() || isCancelled()) {
+        return calibration;
+    }
+
+    // From the most selective threshold down; the first within tolerance wins
+    float confidenceThreshold = confirm_->getConfig().confidenceThreshold;
+    int steps = static_cast<int>(std::lround((Config::CASCADE_MAX_SCREEN_THRESHOLD - Config::CASCADE_MIN_SCREEN_THRESHOLD) /
+                                             Config::CASCADE_THRESHOLD_STEP));
+    std::vector<Detection> accepted;
+    for (int step = 0; step <= steps; ++step) {
+        float threshold = std::max(Config::CASCADE_MIN_SCREEN_THRESHOLD,
+                                   Config::CASCADE_MAX_SCREEN_THRESHOLD - step * Config::CASCADE_THRESHOLD_STEP);
+        DetectionMetrics metrics;
+        size_t escalated = 0;
+        for (size_t i = 0; i < screened.size(); ++i) {
+            bool wasEscalated = false;
+            const std::vector<Detection>* output = cascadeOutput(screened[i], confirmed[i], threshold,
+                                                                 options.acceptThreshold, confidenceThreshold,
+                                                                 accepted, wasEscalated);
+            metrics.addImage(confirmed[i], *output);
+            escalated += wasEscalated ? 1 : 0;
+        }
+
+        calibration.screenThreshold = threshold;
+        calibration.recall = metrics.recall(0.5f);
+        calibration.escalationRate = static_cast<double>(escalated) / screened.size();
+        calibration.withinTolerance = calibration.recall >= 1.0 - recallTolerance;
+        if (calibration.withinTolerance) {
+            break;
+        }
+    }
+
+    options.screenThreshold = calibration.screenThreshold;
+    setOptions(options);
+    return calibration;
+}
+
+void CascadeDetector::validateOptions(const Options& options) {
+    if (!(options.screenThreshold >= Config::CASCADE_MIN_SCREEN_THRESHOLD && options.screenThreshold <= 1.0f)) {
+        std::ostringstream message;
+        message << "Screening threshold must be between " << Config::CASCADE_MIN_SCREEN_THRESHOLD << " and 1";
+        throw std::invalid_argument(message.str());
+    }
+    if (!(options.acceptThreshold > 0.0f && options.acceptThreshold <= 1.0f)) {
+        throw std::invalid_argument("Accept threshold must be above 0 and at most 1");
+    }
+}
+
+void CascadeDetector::applyScreenConfig(float screenThreshold) {
+    // Same classes and thresholds as the cascade, at the screening model's own input size
+    DetectionConfig config = confirm_->getConfig();
+    DetectionConfig screenConfig = screen_->getConfig();
+    config.inputWidth = screenConfig.inputWidth;
+    config.inputHeight = screenConfig.inputHeight;
+    config.confidenceThreshold = screenThreshold;
+    if (!config.isValid()) {
+        // setConfig would keep the previous threshold and screen at the wrong gate
+        std::ostringstream message;
+        message << "Invalid screening config (threshold " << screenThreshold << ")";
+        throw std::invalid_argument(message.str());
+    }
+    screen_->setConfig(config);
+}
+
+} // namespace Core
+} // namespace YoloApp
@@ -0,0 +1,125 @@
+// src/core/cascade_detector.h
+#pragma once
+
+#include "types.h"
+#include "config.h"
+#include "detector.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace YoloApp {
+namespace Core {
+
+/**
+ * @brief Two-stage detector: a small screening model decides which images the large one sees
+ *
+ * Every image first goes through the screening model at a low confidence
+ * threshold. Images where it finds nothing are returned empty; the others
+ * are escalated to the confirming model, whose detections are the result.
+ * Optionally, images where every screening box is already confident are
+ * kept with the screening boxes instead.
+ *
+ * The cascade's config is the confirming model's; the screening model
+ * shares it except for its own input size and the screening threshold.
+ * Clones share the statistics, so the escalation rate covers all engines.
+ */
+class CascadeDetector : public IDetector {
+public:
+    struct Options {
+        float screenThreshold = Config::CASCADE_SCREEN_THRESHOLD;  ///< A screening box at or above this escalates
+        float acceptThreshold = 1.0f;   ///< Keep the screening boxes when all score at least this; 1 always confirms
+    };
+
+    struct Stats {
+        uint64_t images = 0;
+        uint64_t escalated = 0;         ///< Sent to the confirming model
+        uint64_t acceptedByScreen = 0;  ///< Kept with the screening boxes
+
+        double escalationRate() const { return images > 0 ? static_cast<double>(escalated) / images : 0.0; }
+    };
+
+    struct Calibration {
+        size_t images = 0;              ///< Validation images that could be read
+        float screenThreshold = 0.0f;   ///< Chosen, and now in use
+        double recall = 0.0;            ///< Of the confirming model's boxes at IoU 0.5, at that threshold
+        double escalationRate = 0.0;    ///< On the validation images, at that threshold
+        bool withinTolerance = false;   ///< false if even the lowest threshold misses the tolerance
+    };
+
+    /**
+     * @param screen Loaded screening model (e.g. YOLOv4-tiny)
+     * @param confirm Confirming model; loadModel loads into this one
+     * @throws std::invalid_argument if a model is missing or the options are out of range
+     */
+    CascadeDetector(std::shared_ptr<IDetector> screen, std::shared_ptr<IDetector> confirm, Options options);
+
+    CascadeDetector(const CascadeDetector&) = delete;
+    CascadeDetector& operator=(const CascadeDetector&) = delete;
+
+    bool loadModel(const std::string& modelPath,
+                   const std::string& configPath = "",
+                   const std::string& classesPath = "") override;
+
+    std::vector<Detection> detectObjects(const cv::Mat& image) override;
+    std::string lastDetectionError() const override { return detectionError_; }
+
+    void setConfig(const DetectionConfig& config) override;
+    DetectionConfig getConfig() const override;
+
+    bool isLoaded() const override;
+    std::string getModelInfo() const override;
+
+    // Clones both models; the copy counts into the same statistics
+    std::shared_ptr<IDetector> clone() const override;
+
+    /**
+     * @brief Safe while detecting on another thread, like setConfig
+     * @throws std::invalid_argument if screenThreshold is below
+     *         Config::CASCADE_MIN_SCREEN_THRESHOLD or a threshold is above 1
+     */
+    void setOptions(const Options& options);
+    Options options() const;
+
+    Stats stats() const;
+    void resetStats();
+
+    /**
+     * @brief Pick the highest screening threshold that keeps recall within tolerance
+     *
+     * Both models run once over the images: the confirming model alone gives
+     * the reference, the screening model runs at the lowest threshold. The
+     * cascade's output at every candidate threshold is then derived from
+     * those without running again, and the highest threshold whose recall
+     * against the reference is at least 1 - recallTolerance is applied.
+     * Must not run while the cascade detects on another thread.
+     * @param cancelled Polled between images; a cancelled calibration changes nothing
+     */
+    Calibration calibrate(const std::vector<std::string>& imagePaths, double recallTolerance,
+                          const std::atomic<bool>* cancelled = nullptr);
+
+private:
+    struct Counters {
+        std::atomic<uint64_t> images{0};
+        std::atomic<uint64_t> escalated{0};
+        std::atomic<uint64_t> acceptedByScreen{0};
+    };
+
+    CascadeDetector(std::shared_ptr<IDetector> screen, std::shared_ptr<IDetector> confirm,
+                    Options options, std::shared_ptr<Counters> counters);
+
+    static void validateOptions(const Options& options);
+    void applyScreenConfig(float screenThreshold);
+
+    std::shared_ptr<IDetector> screen_;
+    std::shared_ptr<IDetector> confirm_;
+    std::shared_ptr<Counters> counters_;
+    mutable std::mutex optionsMutex_;
+    Options options_;
+    std::string detectionError_;    // Of whichever model failed in the last detectObjects call
+};
+
+} // namespace Core
+} // namespace YoloApp
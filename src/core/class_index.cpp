@@ -0,0 +1,256 @@
+// src/core/class_index.cpp
+#include "class_index.h"
+#include <algorithm>
+#include <cctype>
+#include <mutex>
+
+namespace YoloApp {
+namespace Core {
+
+namespace {
+
+std::string trim(const std::string& text) {
+    size_t begin = text.find_first_not_of(" \t");
+    if (begin == std::string::npos) {
+        return std::string();
+    }
+    size_t end = text.find_last_not_of(" \t");
+    return text.substr(begin, end - begin + 1);
+}
+
+std::string toLower(std::string text) {
+    std::transform(text.begin(), text.end(), text.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return text;
+}
+
+bool parseNumber(const std::string& text, double& value) {
+    try {
+        size_t used = 0;
+        value = std::stod(text, &used);
+        return used == text.size();
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+bool satisfies(const ClassIndex::Posting& posting, const ClassQuery::Term& term) {
+    return posting.count >= term.minCount && posting.maxConfidence >= term.minConfidence;
+}
+
+} // namespace
+
+uint32_t ClassIndex::addImage(uint32_t folderIndex, uint32_t imageIndex,
+                              const std::vector<Detection>& detections) {
+    std::unique_lock lock(mutex_);
+    uint32_t imageId = static_cast<uint32_t>(locations_.size());
+    locations_.push_back({folderIndex, imageIndex});
+
+    for (const auto& detection : detections) {
+        if (!classNames_.count(detection.classId)) {
+            classNames_[detection.classId] = detection.className;
+        }
+        addPosting(detection.classId, imageId, detection.confidence);
+    }
+    return imageId;
+}
+
+uint32_t ClassIndex::addImage(uint32_t folderIndex, uint32_t imageIndex,
+                              const int32_t* classIds, const float* scores, size_t count) {
+    std::unique_lock lock(mutex_);
+    uint32_t imageId = static_cast<uint32_t>(locations_.size());
+    locations_.push_back({folderIndex, imageIndex});
+
+    for (size_t i = 0; i < count; ++i) {
+        addPosting(classIds[i], imageId, scores[i]);
+    }
+    return imageId;
+}
+
+void ClassIndex::setClassName(int classId, const std::string& name) {
+    std::unique_lock lock(mutex_);
+    classNames_[classId] = name;
+}
+
+void ClassIndex::clear() {
+    std::unique_lock lock(mutex_);
+    postings_.clear();
+    classNames_.clear();
+    locations_.clear();
+}
+
+size_t ClassIndex::imageCount() const {
+    std::shared_lock lock(mutex_);
+    return locations_.size();
+}
+
+ClassIndex::ImageLocation ClassIndex::location(uint32_t imageId) const {
+    std::shared_lock lock(mutex_);
+    return imageId < locations_.size() ? locations_[imageId] : ImageLocation{UINT32_MAX, UINT32_MAX};
+}
+
+bool ClassIndex::parseQuery(const std::string& text, ClassQuery& query, std::string& error) const {
+    std::shared_lock lock(mutex_);
+    query.terms.clear();
+
+    size_t start = 0;
+    while (start <= text.size()) {
+        size_t end = text.find(',', start);
+        if (end == std::string::npos) {
+            end = text.size();
+        }
+        std::string termText = trim(text.substr(start, end - start));
+        start = end + 1;
+        if (termText.empty()) {
+            continue;
+        }
+
+        ClassQuery::Term term;
+        if (termText[0] == '!') {
+            term.negated = true;
+            termText = trim(termText.substr(1));
+        }
+
+        size_t at = termText.find('@');
+        if (at != std::string::npos) {
+            double confidence = 0.0;
+            if (!parseNumber(trim(termText.substr(at + 1)), confidence) || confidence < 0.0 || confidence > 1.0) {
+                error = "Invalid confidence in \"" + termText + "\" (expected 0..1)";
+                return false;
+            }
+            term.minConfidence = static_cast<float>(confidence);
+            termText = trim(termText.substr(0, at));
+        }
+
+        size_t op = termText.find('>');
+        if (op != std::string::npos) {
+            bool inclusive = op + 1 < termText.size() && termText[op + 1] == '=';
+            double count = 0.0;
+            if (!parseNumber(trim(termText.substr(op + (inclusive ? 2 : 1))), count) || count < 0.0) {
+                error = "Invalid count in \"" + termText + "\"";
+                return false;
+            }
+            term.minCount = static_cast<uint32_t>(count) + (inclusive ? 0u : 1u);
+            termText = trim(termText.substr(0, op));
+        }
+
+        term.classId = findClass(termText);
+        if (term.classId < 0) {
+            error = "Unknown class \"" + termText + "\"";
+            return false;
+        }
+        query.terms.push_back(term);
+    }
+
+    if (query.terms.empty()) {
+        error = "Empty query";
+        return false;
+    }
+    return true;
+}
+
+std::vector<uint32_t> ClassIndex::execute(const ClassQuery& query, size_t limit) const {
+    std::shared_lock lock(mutex_);
+    std::vector<uint32_t> matches;
+
+    struct Constraint {
+        const ClassQuery::Term* term;
+        const std::vector<Posting>* postings;
+        size_t cursor;
+    };
+    std::vector<Constraint> required;
+    std::vector<Constraint> excluded;
+
+    static const std::vector<Posting> noPostings;
+    for (const auto& term : query.terms) {
+        auto it = postings_.find(term.classId);
+        const std::vector<Posting>* list = (it != postings_.end()) ? &it->second : &noPostings;
+        if (!term.negated && list->empty()) {
+            return matches;  // A required class that never occurs
+        }
+        (term.negated ? excluded : required).push_back({&term, list, 0});
+    }
+
+    // Probe the other lists from the rarest class; candidates come in id order,
+    // so each list is searched forward from where the previous probe stopped
+    std::sort(required.begin(), required.end(), [](const Constraint& a, const Constraint& b) {
+        return a.postings->size() < b.postings->size();
+    });
+
+    auto findPosting = [](Constraint& constraint, uint32_t imageId) -> const Posting* {
+        const auto& list = *constraint.postings;
+        auto it = std::lower_bound(list.begin() + constraint.cursor, list.end(), imageId,
+                                   [](const Posting& posting, uint32_t id) { return posting.imageId < id; });
+        constraint.cursor = static_cast<size_t>(it - list.begin());
+        return (it != list.end() && it->imageId == imageId) ? &*it : nullptr;
+    };
+
+    auto accept = [&](uint32_t imageId) {
+        for (size_t i = 1; i < required.size(); ++i) {
+            const Posting* posting = findPosting(required[i], imageId);
+            if (!posting || !satisfies(*posting, *required[i].term)) {
+                return false;
+            }
+        }
+        for (auto& constraint : excluded) {
+            const Posting* posting = findPosting(constraint, imageId);
+            if (posting && satisfies(*posting, *constraint.term)) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    if (!required.empty()) {
+        for (const Posting& posting : *required.front().postings) {
+            if (satisfies(posting, *required.front().term) && accept(posting.imageId)) {
+                matches.push_back(posting.imageId);
+                if (limit > 0 && matches.size() >= limit) {
+                    break;
+                }
+            }
+        }
+    } else {
+        // Only exclusions: every image is a candidate
+        for (uint32_t imageId = 0; imageId < locations_.size(); ++imageId) {
+            if (accept(imageId)) {
+                matches.push_back(imageId);
+                if (limit > 0 && matches.size() >= limit) {
+                    break;
+                }
+            }
+        }
+    }
+    return matches;
+}
+
+void ClassIndex::addPosting(int classId, uint32_t imageId, float confidence) {
+    std::vector<Posting>& list = postings_[classId];
+    if (list.empty() || list.back().imageId != imageId) {
+        list.push_back({imageId, 1, confidence});
+        return;
+    }
+    Posting& posting = list.back();
+    ++posting.count;
+    posting.maxConfidence = std::max(posting.maxConfidence, confidence);
+}
+
+int ClassIndex::findClass(const std::string& name) const {
+    std::string wanted = toLower(name);
+    for (const auto& [classId, className] : classNames_) {
+        if (toLower(className) == wanted) {
+            return classId;
+        }
+    }
+
+    // Fall back to a numeric class id
+    double value = 0.0;
+    if (!wanted.empty() && parseNumber(wanted, value) && value >= 0.0 &&
+        value == static_cast<int>(value)) {
+        return static_cast<int>(value);
+    }
+    return -1;
+}
+
+} // namespace Core
+} // namespace YoloApp
@@ -0,0 +1,105 @@
+// src/core/class_index.h
+#pragma once
+
+#include "types.h"
+#include <cstdint>
+#include <map>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+namespace YoloApp {
+namespace Core {
+
+/**
+ * @brief A parsed class query: all terms must hold for an image to match
+ *
+ * Text form is a comma-separated list of terms, each
+ *   [!]class[>=count][@confidence]
+ * where class is a class name or id. "person>=3, truck@0.7" matches images
+ * with at least 3 person boxes and a truck box scoring at least 0.7;
+ * "!dog" matches images without any dog.
+ */
+struct ClassQuery {
+    struct Term {
+        int classId = -1;
+        uint32_t minCount = 1;
+        float minConfidence = 0.0f;
+        bool negated = false;
+    };
+    std::vector<Term> terms;
+};
+
+/**
+ * @brief Inverted index from class id to the images containing that class
+ *
+ * Each posting records the image, the number of boxes of the class and
+ * their highest confidence. Images are added incrementally (ids increase,
+ * so posting lists stay sorted) and queries intersect posting lists
+ * starting from the rarest class. Safe to query while images are added.
+ */
+class ClassIndex {
+public:
+    struct Posting {
+        uint32_t imageId;
+        uint32_t count;
+        float maxConfidence;
+    };
+
+    /**
+     * @brief Where an indexed image lives in the results
+     */
+    struct ImageLocation {
+        uint32_t folderIndex;
+        uint32_t imageIndex;
+    };
+
+    ClassIndex() = default;
+
+    /**
+     * @brief Index the detections of one image
+     * @return The id assigned to the image
+     */
+    uint32_t addImage(uint32_t folderIndex, uint32_t imageIndex,
+                      const std::vector<Detection>& detections);
+
+    /**
+     * @brief Index one image from raw detection columns (used for saved sessions)
+     */
+    uint32_t addImage(uint32_t folderIndex, uint32_t imageIndex,
+                      const int32_t* classIds, const float* scores, size_t count);
+
+    /**
+     * @brief Register a class name for query parsing
+     */
+    void setClassName(int classId, const std::string& name);
+
+    void clear();
+
+    size_t imageCount() const;
+    ImageLocation location(uint32_t imageId) const;
+
+    /**
+     * @brief Parse query text against the known class names
+     * @return false with a message in error if the text is invalid
+     */
+    bool parseQuery(const std::string& text, ClassQuery& query, std::string& error) const;
+
+    /**
+     * @brief Ids of all images matching a query, in ascending order
+     * @param limit Stop after this many matches (0 = no limit)
+     */
+    std::vector<uint32_t> execute(const ClassQuery& query, size_t limit = 0) const;
+
+private:
+    void addPosting(int classId, uint32_t imageId, float confidence);
+    int findClass(const std::string& name) const;
+
+    mutable std::shared_mutex mutex_;
+    std::map<int, std::vector<Posting>> postings_;
+    std::map<int, std::string> classNames_;
+    std::vector<ImageLocation> locations_;
+};
+
+} // namespace Core
+} // namespace YoloApp
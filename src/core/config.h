@@ -2,6 +2,10 @@
 // src/core/config.h
 #pragma once
 
+#include <cstddef>
+#include <string>
+#include <vector>
+
 namespace YoloApp {
 namespace Config {
 
@@ -11,6 +15,58 @@ constexpr const char* APP_VERSION = "1.0.0";
 constexpr int DEFAULT_WINDOW_WIDTH = 1400;
 constexpr int DEFAULT_WINDOW_HEIGHT = 800;
 
+// Image viewer thumbnails
+constexpr int THUMBNAIL_SIZE = 112;                // Edge length in pixels
+constexpr int THUMBNAIL_PREFETCH_MARGIN = 32;      // Rows kept queued beyond the visible range
+constexpr int THUMBNAIL_MEMORY_CACHE_SIZE = 4000;  // Decoded thumbnails kept in memory
+constexpr int DISPLAY_CACHE_MB = 512;              // Converted full-size images kept for re-display
+constexpr int PREFETCH_RADIUS = 3;                 // Neighbors prepared on each side of the current image
+constexpr int PREFETCH_BUDGET_MB = 384;            // Memory for prepared-but-not-shown neighbors
+
+// Large image handling
+constexpr size_t RETAIN_IMAGE_MAX_PIXELS = 40000000; // Larger frames are viewed from tiles, not kept in memory
+constexpr int TILE_SIZE = 512;                       // Tile edge in pixels at every pyramid level
+constexpr int TILE_CACHE_MB = 256;                   // Decoded tiles kept by the tiled viewer
+constexpr int TILE_DECODE_BLOCK_MAX_MB = 64;         // Largest TIFF strip or tile decoded for one viewer tile
+
+// Saved sessions
+constexpr const char* SESSIONS_DIRECTORY = "sessions"; // Under the application data location
+
+// Class queries
+constexpr size_t QUERY_RESULT_LIMIT = 100000;   // Matches shown in the viewer's query folder
+
+// Model loading
+constexpr size_t MODEL_CACHE_ENTRIES = 2;   // Parsed networks of previously used models kept in memory
+
+// Live metrics
+constexpr int METRICS_EXPORT_INTERVAL_SECONDS = 15;  // Default Prometheus file refresh
+
+// Threading
+constexpr int MAX_PARALLEL_ENGINES = 8;         // Each engine holds its own copy of the network
+constexpr int CALIBRATION_SAMPLE_IMAGES = 16;   // Images timed per candidate layout
+
+// Tiled inference
+constexpr int TILE_BATCH_SIZE = 8;      // Tiles stacked into one forward pass
+
+// Rectangular inference
+constexpr int RECT_INPUT_STRIDE = 32;   // Input edges are multiples of the network's largest stride
+constexpr int RECT_PAD_VALUE = 114;     // Gray fill of the padding, as used in YOLO training
+
+// Model cascade
+constexpr float CASCADE_SCREEN_THRESHOLD = 0.1f;        // Screening score that sends an image to the large model
+constexpr int CASCADE_SCREEN_INPUT_SIZE = 416;          // Input edge of the screening model
+constexpr float CASCADE_MIN_SCREEN_THRESHOLD = 0.01f;   // Range searched when calibrating against recall
+constexpr float CASCADE_MAX_SCREEN_THRESHOLD = 0.5f;
+constexpr float CASCADE_THRESHOLD_STEP = 0.01f;
+constexpr double CASCADE_RECALL_TOLERANCE = 0.02;       // Recall the cascade may lose against the large model alone
+constexpr size_t CASCADE_VALIDATION_IMAGES = 200;       // Images sampled for the calibration
+
+// Auto-tuning
+constexpr size_t AUTO_TUNE_SAMPLE_IMAGES = 200;     // Images sampled evenly from the folder
+constexpr int AUTO_TUNE_REFERENCE_SIZE = 1280;      // Input size of the reference detections
+constexpr double AUTO_TUNE_MIN_AGREEMENT = 0.9;     // mAP@0.5 against the reference a recommendation needs
+const std::vector<int> AUTO_TUNE_INPUT_SIZES = {320, 416, 512, 640, 768, 960};
+
 // Supported image formats
 const std::vector<std::string> SUPPORTED_EXTENSIONS = {
     ".jpg", ".jpeg", ".png", ".bmp", ".tiff", ".tif", ".webp"
@@ -0,0 +1,233 @@
+// src/core/detection_metrics.cpp
+#include "detection_metrics.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <set>
+
+namespace YoloApp {
+namespace Core {
+
+namespace {
+
+/**
+ * @brief Indices of a detection list ordered by descending score (stable for ties)
+ */
+template <typename T, typename Score>
+std::vector<int> byDescendingScore(const std::vector<T>& items, Score score) {
+    std::vector<int> order(items.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+        return score(items[a]) > score(items[b]);
+    });
+    return order;
+}
+
+} // namespace
+
+float intersectionOverUnion(const cv::Rect& a, const cv::Rect& b) {
+    if (a.area() <= 0 || b.area() <= 0) {
+        return 0.0f;
+    }
+    int intersection = (a & b).area();
+    int unionArea = a.area() + b.area() - intersection;
+    return unionArea > 0 ? static_cast<float>(intersection) / unionArea : 0.0f;
+}
+
+ImageComparison DetectionMetrics::compare(const std::vector<Detection>& reference,
+                                          const std::vector<Detection>& candidate,
+                                          float iouThreshold) {
+    ImageComparison result;
+    std::vector<bool> referenceUsed(reference.size(), false);
+
+    auto confidence = [](const Detection& d) { return d.confidence; };
+    for (int c : byDescendingScore(candidate, confidence)) {
+        int best = -1;
+        float bestIou = iouThreshold;
+        for (size_t r = 0; r < reference.size(); ++r) {
+            if (referenceUsed[r] || reference[r].classId != candidate[c].classId) {
+                continue;
+            }
+            float iou = intersectionOverUnion(reference[r].boundingBox, candidate[c].boundingBox);
+            if (iou >= bestIou) {
+                bestIou = iou;
+                best = static_cast<int>(r);
+            }
+        }
+
+        if (best < 0) {
+            result.extra.push_back(c);
+            continue;
+        }
+        referenceUsed[best] = true;
+
+        DetectionMatch match;
+        match.referenceIndex = best;
+        match.candidateIndex = c;
+        match.iou = bestIou;
+        match.scoreDelta = candidate[c].confidence - reference[best].confidence;
+        result.minIou = std::min(result.minIou, match.iou);
+        result.maxAbsScoreDelta = std::max(result.maxAbsScoreDelta, std::abs(match.scoreDelta));
+        result.matches.push_back(match);
+    }
+
+    for (size_t r = 0; r < reference.size(); ++r) {
+        if (!referenceUsed[r]) {
+            result.missing.push_back(static_cast<int>(r));
+        }
+    }
+    std::sort(result.extra.begin(), result.extra.end());
+    return result;
+}
+
+void DetectionMetrics::addImage(const std::vector<Detection>& reference, const std::vector<Detection>& candidate) {
+    ImageBoxes boxes;
+    boxes.reference.reserve(reference.size());
+    boxes.candidate.reserve(candidate.size());
+    for (const Detection& d : reference) {
+        boxes.reference.push_back({d.boundingBox, d.confidence, d.classId});
+    }
+    for (const Detection& d : candidate) {
+        boxes.candidate.push_back({d.boundingBox, d.confidence, d.classId});
+    }
+    images_.push_back(std::move(boxes));
+}
+
+void DetectionMetrics::clear() {
+    images_.clear();
+}
+
+std::vector<int> DetectionMetrics::referenceClasses() const {
+    std::set<int> classes;
+    for (const ImageBoxes& image : images_) {
+        for (const Box& box : image.reference) {
+            classes.insert(box.classId);
+        }
+    }
+    return std::vector<int>(classes.begin(), classes.end());
+}
+
+double DetectionMetrics::averagePrecision(int classId, float iouThreshold,
+                                          size_t& referenceCount, size_t& truePositives) const {
+    struct Ranked {
+        float score;
+        size_t image;
+        int index;
+    };
+
+    // All candidates of the class over all images, ranked globally by score
+    std::vector<Ranked> ranked;
+    referenceCount = 0;
+    for (size_t i = 0; i < images_.size(); ++i) {
+        for (size_t c = 0; c < images_[i].candidate.size(); ++c) {
+            if (images_[i].candidate[c].classId == classId) {
+                ranked.push_back({images_[i].candidate[c].score, i, static_cast<int>(c)});
+            }
+        }
+        for (const Box& box : images_[i].reference) {
+            referenceCount += box.classId == classId;
+        }
+    }
+    std::stable_sort(ranked.begin(), ranked.end(), [](const Ranked& a, const Ranked& b) {
+        return a.score > b.score;
+    });
+
+    std::vector<std::vector<bool>> used(images_.size());
+    for (size_t i = 0; i < images_.size(); ++i) {
+        used[i].assign(images_[i].reference.size(), false);
+    }
+
+    // Precision/recall curve: each candidate takes the best unused reference box
+    std::vector<double> precision;
+    std::vector<double> recall;
+    precision.reserve(ranked.size());
+    recall.reserve(ranked.size());
+    truePositives = 0;
+    size_t falsePositives = 0;
+    for (const Ranked& r : ranked) {
+        const ImageBoxes& image = images_[r.image];
+        const cv::Rect& box = image.candidate[r.index].rect;
+        int best = -1;
+        float bestIou = iouThreshold;
+        for (size_t g = 0; g < image.reference.size(); ++g) {
+            if (used[r.image][g] || image.reference[g].classId != classId) {
+                continue;
+            }
+            float iou = intersectionOverUnion(image.reference[g].rect, box);
+            if (iou >= bestIou) {
+                bestIou = iou;
+                best = static_cast<int>(g);
+            }
+        }
+        if (best >= 0) {
+            used[r.image][best] = true;
+            ++truePositives;
+        } else {
+            ++falsePositives;
+        }
+        precision.push_back(static_cast<double>(truePositives) / (truePositives + falsePositives));
+        recall.push_back(referenceCount > 0 ? static_cast<double>(truePositives) / referenceCount : 0.0);
+    }
+
+    if (referenceCount == 0) {
+        return 0.0;
+    }
+
+    // All-point interpolation: area under the monotone precision envelope
+    for (size_t i = precision.size(); i-- > 1;) {
+        precision[i - 1] = std::max(precision[i - 1], precision[i]);
+    }
+    double ap = 0.0;
+    double previousRecall = 0.0;
+    for (size_t i = 0; i < precision.size(); ++i) {
+        ap += (recall[i] - previousRecall) * precision[i];
+        previousRecall = recall[i];
+    }
+    return ap;
+}
+
+double DetectionMetrics::meanAveragePrecision(float iouThreshold) const {
+    std::vector<int> classes = referenceClasses();
+    if (classes.empty()) {
+        // Nothing to find: perfect only if nothing was found either
+        for (const ImageBoxes& image : images_) {
+            if (!image.candidate.empty()) {
+                return 0.0;
+            }
+        }
+        return 1.0;
+    }
+
+    double sum = 0.0;
+    for (int classId : classes) {
+        size_t referenceCount = 0;
+        size_t truePositives = 0;
+        sum += averagePrecision(classId, iouThreshold, referenceCount, truePositives);
+    }
+    return sum / classes.size();
+}
+
+double DetectionMetrics::meanAveragePrecisionCoco() const {
+    double sum = 0.0;
+    const int steps = 10;
+    for (int i = 0; i < steps; ++i) {
+        sum += meanAveragePrecision(0.5f + 0.05f * i);
+    }
+    return sum / steps;
+}
+
+double DetectionMetrics::recall(float iouThreshold) const {
+    size_t references = 0;
+    size_t matched = 0;
+    for (int classId : referenceClasses()) {
+        size_t referenceCount = 0;
+        size_t truePositives = 0;
+        averagePrecision(classId, iouThreshold, referenceCount, truePositives);
+        references += referenceCount;
+        matched += truePositives;
+    }
+    return references > 0 ? static_cast<double>(matched) / references : 1.0;
+}
+
+} // namespace Core
+} // namespace YoloApp
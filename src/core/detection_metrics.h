@@ -0,0 +1,95 @@
+// src/core/detection_metrics.h
+#pragma once
+
+#include "types.h"
+#include <vector>
+
+namespace YoloApp {
+namespace Core {
+
+/**
+ * @brief Intersection over union of two boxes (0 if either is empty)
+ */
+float intersectionOverUnion(const cv::Rect& a, const cv::Rect& b);
+
+/**
+ * @brief One matched pair between a reference and a candidate detection list
+ */
+struct DetectionMatch {
+    int referenceIndex = -1;
+    int candidateIndex = -1;
+    float iou = 0.0f;
+    float scoreDelta = 0.0f;    ///< candidate - reference
+};
+
+/**
+ * @brief Result of matching the detections of one image
+ */
+struct ImageComparison {
+    std::vector<DetectionMatch> matches;
+    std::vector<int> missing;   ///< Reference detections without a candidate
+    std::vector<int> extra;     ///< Candidate detections without a reference
+    float minIou = 1.0f;        ///< Over the matches
+    float maxAbsScoreDelta = 0.0f;
+};
+
+/**
+ * @brief Agreement between a candidate detector and a reference
+ *
+ * compare() matches one image; the accumulating methods treat the reference
+ * detections as ground truth and compute COCO-style average precision over
+ * all added images (all-point interpolation, classes without reference
+ * boxes ignored). Used for golden-output regression checks and for judging
+ * faster configurations against a slower reference.
+ */
+class DetectionMetrics {
+public:
+    /**
+     * @brief Greedy one-to-one matching within each class, highest candidate score first
+     */
+    static ImageComparison compare(const std::vector<Detection>& reference,
+                                   const std::vector<Detection>& candidate,
+                                   float iouThreshold = 0.5f);
+
+    void addImage(const std::vector<Detection>& reference, const std::vector<Detection>& candidate);
+    void clear();
+
+    size_t imageCount() const { return images_.size(); }
+
+    /**
+     * @brief Mean AP over classes at one IoU threshold
+     *
+     * 1.0 when neither side has any detections.
+     */
+    double meanAveragePrecision(float iouThreshold = 0.5f) const;
+
+    /**
+     * @brief COCO mAP averaged over IoU thresholds 0.50:0.05:0.95
+     */
+    double meanAveragePrecisionCoco() const;
+
+    /**
+     * @brief Share of reference detections matched by a candidate at the threshold
+     */
+    double recall(float iouThreshold = 0.5f) const;
+
+private:
+    struct Box {
+        cv::Rect rect;
+        float score;
+        int classId;
+    };
+
+    struct ImageBoxes {
+        std::vector<Box> reference;
+        std::vector<Box> candidate;
+    };
+
+    double averagePrecision(int classId, float iouThreshold, size_t& referenceCount, size_t& truePositives) const;
+    std::vector<int> referenceClasses() const;
+
+    std::vector<ImageBoxes> images_;
+};
+
+} // namespace Core
+} // namespace YoloApp
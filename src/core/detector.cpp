@@ -1,8 +1,13 @@
-// src/core/detector.cpp - FIXED VERSION with warning fixes
+// src/core/detector.cpp
 #include "detector.h"
 #include "config.h"
+#include "detection_metrics.h"
+#include "pipeline_metrics.h"
+#include "trace.h"
 #include <fstream>
 #include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <stdexcept>
 
 namespace YoloApp {
@@ -30,91 +35,109 @@ std::string FolderResult::getSummary() const {
            std::to_string(totalDetections) + " detections)";
 }
 
+namespace {
+
+// The rows of one image in a (possibly batched) output tensor: [N, rows, cols]
+// from ONNX exports, or N images' rows stacked in 2D from Darknet
+cv::Mat outputForImage(const cv::Mat& output, int index, int count) {
+    if (output.dims == 3) {
+        return cv::Mat(output.size[1], output.size[2], CV_32F,
+                       const_cast<float*>(output.ptr<float>(index)));
+    }
+    if (count > 1) {
+        int rows = output.rows / count;
+        return output.rowRange(index * rows, (index + 1) * rows);
+    }
+    return output;
+}
+
+} // namespace
+
 // YoloDetector implementation
-YoloDetector::YoloDetector() : loaded_(false) {
+YoloDetector::YoloDetector()
+    : loaded_(false)
+    , modelKey_(0)
+    , loadedFromCache_(false)
+    , batchedTiles_(true)
+    , rectShapes_(true) {
     // Initialize with default COCO classes
     classNames_ = Config::COCO_CLASSES;
 }
 
+YoloDetector::~YoloDetector() {
+    releaseNetwork();
+}
 
-bool YOLODetector::loadModel(const std::string& modelPath, const std::string& configPath) {
-    try {
-        // Determine model type based on extension
-        std::string ext = modelPath.substr(modelPath.find_last_of(".") + 1);
-        std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
-        
-        if (ext == "onnx") {
-            return loadONNXModel(modelPath);
-        } else if (ext == "weights" && !configPath.empty()) {
-            return loadDarknetModel(modelPath, configPath);
-        } else {
-            std::cerr << "Unsupported model format: " << ext << std::endl;
-            return false;
-        }
-    } catch (const cv::Exception& e) {
-        std::cerr << "Error loading model: " << e.what() << std::endl;
-        return false;
-    }
+void YoloDetector::setModelCache(std::shared_ptr<ModelCache> cache) {
+    modelCache_ = std::move(cache);
 }
 
-bool YOLODetector::loadONNXModel(const std::string& modelPath) {
-    try {
-        net = cv::dnn::readNetFromONNX(modelPath);
-        if (net.empty()) {
-            std::cerr << "Failed to load ONNX model" << std::endl;
-            return false;
-        }
-        
-        // Set backend and target
-        net.setPreferableBackend(cv::dnn::DNN_BACKEND_OPENCV);
-        net.setPreferableTarget(cv::dnn::DNN_TARGET_CPU);
-        
-        std::cout << "ONNX model loaded successfully" << std::endl;
-        return true;
-    } catch (const cv::Exception& e) {
-        std::cerr << "Error loading ONNX model: " << e.what() << std::endl;
-        return false;
-    }
+void YoloDetector::setProgressCallback(ProgressCallback callback) {
+    progressCallback_ = std::move(callback);
 }
 
-bool YOLODetector::loadDarknetModel(const std::string& weightsPath, const std::string& configPath) {
-    try {
-        net = cv::dnn::readNetFromDarknet(configPath, weightsPath);
-        if (net.empty()) {
-            std::cerr << "Failed to load Darknet model" << std::endl;
-            return false;
-        }
-        
-        // Set backend and target
-        net.setPreferableBackend(cv::dnn::DNN_BACKEND_OPENCV);
-        net.setPreferableTarget(cv::dnn::DNN_TARGET_CPU);
-        
-        std::cout << "Darknet model loaded successfully" << std::endl;
-        return true;
-    } catch (const cv::Exception& e) {
-        std::cerr << "Error loading Darknet model: " << e.what() << std::endl;
-        return false;
+void YoloDetector::reportProgress(int percent, const std::string& step) {
+    if (progressCallback_) {
+        progressCallback_(percent, step);
     }
 }
 
-
+void YoloDetector::releaseNetwork() {
+    // Hand the parsed network back so switching to this model again is instant
+    if (modelCache_ && loaded_ && modelKey_ != 0) {
+        ModelCache::Entry entry;
+        entry.key = modelKey_;
+        entry.network = network_;
+        entry.outputNames = outputNames_;
+        modelCache_->put(std::move(entry));
+    }
+    network_ = cv::dnn::Net();
+    outputNames_.clear();
+    loaded_ = false;
+    modelKey_ = 0;
+}
 
 bool YoloDetector::loadModel(const std::string& modelPath, 
                             const std::string& configPath,
                             const std::string& classesPath) {
     try {
-        loaded_ = false;
+        releaseNetwork();
+        loadedFromCache_ = false;
+        lastError_.clear();
         modelPath_ = modelPath;
+        configPath_ = configPath;
+        classesPath_ = classesPath;
+        batchedTiles_ = true;
+        rectShapes_ = true;
         
         // Determine model type and load accordingly
-        std::string extension = modelPath.substr(modelPath.find_last_of('.'));
+        size_t dot = modelPath.find_last_of('.');
+        std::string extension = dot != std::string::npos ? modelPath.substr(dot) : std::string();
         std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
         
-        if (extension == ".onnx") {
+        uint64_t key = 0;
+        if (modelCache_) {
+            reportProgress(0, "Hashing model");
+            key = ModelCache::hashFiles({modelPath, extension == ".weights" ? configPath : std::string()});
+            
+            ModelCache::Entry cached;
+            if (modelCache_->take(key, cached)) {
+                network_ = std::move(cached.network);
+                outputNames_ = std::move(cached.outputNames);
+                loadedFromCache_ = true;
+            }
+        }
+        
+        if (loadedFromCache_) {
+            // Backend and target were set when it was first parsed
+        } else if (extension == ".onnx") {
+            reportProgress(modelCache_ ? 10 : 0, "Parsing model");
             network_ = cv::dnn::readNetFromONNX(modelPath);
         } else if (extension == ".weights" && !configPath.empty()) {
+            reportProgress(modelCache_ ? 10 : 0, "Parsing model");
             network_ = cv::dnn::readNetFromDarknet(configPath, modelPath);
         } else if (extension == ".pb") {
+            reportProgress(modelCache_ ? 10 : 0, "Parsing model");
             network_ = cv::dnn::readNetFromTensorflow(modelPath);
         } else {
             throw std::runtime_error("Unsupported model format: " + extension);
@@ -124,60 +147,280 @@ bool YoloDetector::loadModel(const std::string& modelPath,
             throw std::runtime_error("Failed to load network from: " + modelPath);
         }
         
-        // Get output layer names
-        outputNames_ = network_.getUnconnectedOutLayersNames();
+        if (!loadedFromCache_) {
+            // Get output layer names
+            outputNames_ = network_.getUnconnectedOutLayersNames();
+            
+            // Set default backend and target
+            network_.setPreferableBackend(cv::dnn::DNN_BACKEND_OPENCV);
+            network_.setPreferableTarget(cv::dnn::DNN_TARGET_CPU);
+        }
         
         // Load custom class names if provided
         if (!classesPath.empty()) {
             loadClassNames(classesPath);
         }
         
-        // Set default backend and target
-        network_.setPreferableBackend(cv::dnn::DNN_BACKEND_OPENCV);
-        network_.setPreferableTarget(cv::dnn::DNN_TARGET_CPU);
-        
+        modelKey_ = key;
         loaded_ = true;
+        reportProgress(100, loadedFromCache_ ? "Model taken from cache" : "Model parsed");
         return true;
         
     } catch (const std::exception& e) {
+        network_ = cv::dnn::Net();
+        outputNames_.clear();
         loaded_ = false;
+        lastError_ = e.what();
         return false;
     }
 }
 
+double YoloDetector::warmUp() {
+    if (!loaded_) {
+        return 0.0;
+    }
+    
+    auto start = std::chrono::steady_clock::now();
+    try {
+        DetectionConfig config = getConfig();
+        cv::Mat blank(config.inputHeight, config.inputWidth, CV_8UC3, cv::Scalar(0, 0, 0));
+        network_.setInput(createInputBlob(blank, config));
+        std::vector<cv::Mat> outputs;
+        network_.forward(outputs, outputNames_);
+    } catch (const std::exception&) {
+        // A failing forward shows up again on the first real image
+    }
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
 std::vector<Detection> YoloDetector::detectObjects(const cv::Mat& image) {
+    detectionError_.clear();
     if (!loaded_ || image.empty()) {
+        detectionError_ = loaded_ ? "Empty image" : "Model not loaded";
         return {};
     }
     
+    // One config for the whole image, even if setConfig runs meanwhile
+    DetectionConfig config = getConfig();
+    
+    if (config.tiledInference && (image.cols > config.inputWidth || image.rows > config.inputHeight)) {
+        return detectTiled(image, config);
+    }
+    if (config.rectInference && rectShapes_) {
+        return detectRect(image, config);
+    }
+    
     try {
         // Prepare input blob
-        cv::Mat blob;
-        cv::dnn::blobFromImage(image, blob, 1.0/255.0, 
-                              cv::Size(config_.inputWidth, config_.inputHeight), 
-                              cv::Scalar(0,0,0), true, false);
-        
-        network_.setInput(blob);
+        {
+            YOLO_TRACE_SPAN("preprocess");
+            StageTimer stageTimer(PipelineStage::Preprocess);
+            cv::Mat blob = createInputBlob(image, config);
+            network_.setInput(blob);
+        }
         
         // Run inference
         std::vector<cv::Mat> outputs;
-        network_.forward(outputs, outputNames_);
+        {
+            YOLO_TRACE_SPAN("forward");
+            StageTimer stageTimer(PipelineStage::Forward);
+            network_.forward(outputs, outputNames_);
+        }
+        
+        // Post-process results (box decoding and NMS)
+        YOLO_TRACE_SPAN("decode_nms");
+        StageTimer stageTimer(PipelineStage::Postprocess);
+        return postProcessDetections(outputs, image.size(), config);
+        
+    } catch (const std::exception& e) {
+        detectionError_ = e.what();
+        return {};
+    }
+}
+
+std::vector<Detection> YoloDetector::detectTiled(const cv::Mat& image, const DetectionConfig& config) {
+    cv::Size inputSize(config.inputWidth, config.inputHeight);
+    std::vector<cv::Rect> regions = tileRegions(image.size(), inputSize, config.tileOverlap);
+    if (config.tileFullFrame) {
+        // Objects larger than a tile are cut by every tile; the whole frame sees them
+        regions.insert(regions.begin(), cv::Rect(0, 0, image.cols, image.rows));
+    }
+    
+    Candidates candidates;
+    try {
+        size_t batchSize = batchedTiles_ ? static_cast<size_t>(Config::TILE_BATCH_SIZE) : 1;
+        for (size_t first = 0; first < regions.size(); ) {
+            size_t count = std::min(batchSize, regions.size() - first);
+            
+            // Tiles are views into the frame; the blob is the only copy
+            {
+                YOLO_TRACE_SPAN("preprocess");
+                StageTimer stageTimer(PipelineStage::Preprocess);
+                std::vector<cv::Mat> tiles;
+                tiles.reserve(count);
+                for (size_t i = first; i < first + count; ++i) {
+                    tiles.push_back(image(regions[i]));
+                }
+                cv::Mat blob;
+                cv::dnn::blobFromImages(tiles, blob, 1.0/255.0, inputSize, cv::Scalar(0,0,0), true, false);
+                network_.setInput(blob);
+            }
+            
+            std::vector<cv::Mat> outputs;
+            try {
+                YOLO_TRACE_SPAN("forward");
+                StageTimer stageTimer(PipelineStage::Forward);
+                network_.forward(outputs, outputNames_);
+            } catch (const cv::Exception&) {
+                if (count == 1) {
+                    throw;
+                }
+                // Exported with a fixed batch of one: go tile by tile from now on
+                batchedTiles_ = false;
+                batchSize = 1;
+                continue;
+            }
+            
+            YOLO_TRACE_SPAN("decode_nms");
+            StageTimer stageTimer(PipelineStage::Postprocess);
+            for (size_t i = 0; i < count; ++i) {
+                for (const auto& output : outputs) {
+                    decodeOutput(outputForImage(output, static_cast<int>(i), static_cast<int>(count)),
+                                 regions[first + i], inputSize, config, candidates);
+                }
+            }
+            first += count;
+        }
         
-        // Post-process results
-        return postProcessDetections(outputs, image.size());
+        // One merge over all tiles, so objects on tile seams are kept once
+        YOLO_TRACE_SPAN("decode_nms");
+        StageTimer stageTimer(PipelineStage::Postprocess);
+        return mergeCandidates(candidates, config, true);
         
     } catch (const std::exception& e) {
+        detectionError_ = e.what();
         return {};
     }
 }
 
+std::vector<Detection> YoloDetector::detectRect(const cv::Mat& image, const DetectionConfig& config) {
+    cv::Size networkSize = rectInputSize(image.size(), cv::Size(config.inputWidth, config.inputHeight));
+    double scale = std::min(static_cast<double>(config.inputWidth) / image.cols,
+                            static_cast<double>(config.inputHeight) / image.rows);
+    cv::Size scaledSize(std::max(1, std::min(networkSize.width, static_cast<int>(std::lround(image.cols * scale)))),
+                        std::max(1, std::min(networkSize.height, static_cast<int>(std::lround(image.rows * scale)))));
+    
+    try {
+        // Scaled to fit and padded on the right and bottom, so network
+        // coordinates map back with one factor per axis and no offset
+        {
+            YOLO_TRACE_SPAN("preprocess");
+            StageTimer stageTimer(PipelineStage::Preprocess);
+            cv::Mat scaled;
+            cv::resize(image, scaled, scaledSize, 0, 0, cv::INTER_LINEAR);
+            cv::Mat padded;
+            cv::copyMakeBorder(scaled, padded, 0, networkSize.height - scaledSize.height,
+                               0, networkSize.width - scaledSize.width, cv::BORDER_CONSTANT,
+                               cv::Scalar::all(Config::RECT_PAD_VALUE));
+            cv::Mat blob;
+            cv::dnn::blobFromImage(padded, blob, 1.0/255.0, cv::Size(), cv::Scalar(0,0,0), true, false);
+            network_.setInput(blob);
+        }
+        
+        // The network reshapes when the shape differs from the previous image
+        std::vector<cv::Mat> outputs;
+        try {
+            YOLO_TRACE_SPAN("forward");
+            StageTimer stageTimer(PipelineStage::Forward);
+            network_.forward(outputs, outputNames_);
+        } catch (const cv::Exception&) {
+            if (networkSize == cv::Size(config.inputWidth, config.inputHeight)) {
+                throw;
+            }
+            // Exported with a fixed input shape: stretch to the square from now on
+            rectShapes_ = false;
+            return detectObjects(image);
+        }
+        
+        YOLO_TRACE_SPAN("decode_nms");
+        StageTimer stageTimer(PipelineStage::Postprocess);
+        Candidates candidates;
+        cv::Rect frame(0, 0, image.cols, image.rows);
+        for (const auto& output : outputs) {
+            decodeOutput(outputForImage(output, 0, 1), frame, scaledSize, config, candidates);
+        }
+        return mergeCandidates(candidates, config);
+        
+    } catch (const std::exception& e) {
+        detectionError_ = e.what();
+        return {};
+    }
+}
+
+cv::Size YoloDetector::rectInputSize(const cv::Size& imageSize, const cv::Size& inputSize, int stride) {
+    if (imageSize.width <= 0 || imageSize.height <= 0 || stride <= 0) {
+        return inputSize;
+    }
+    double scale = std::min(static_cast<double>(inputSize.width) / imageSize.width,
+                            static_cast<double>(inputSize.height) / imageSize.height);
+    auto alignUp = [stride](double extent, int limit) {
+        int aligned = (static_cast<int>(std::ceil(extent - 1e-6)) + stride - 1) / stride * stride;
+        int maxAligned = (limit + stride - 1) / stride * stride;
+        return std::max(stride, std::min(aligned, maxAligned));
+    };
+    return cv::Size(alignUp(imageSize.width * scale, inputSize.width),
+                    alignUp(imageSize.height * scale, inputSize.height));
+}
+
+std::vector<cv::Rect> YoloDetector::tileRegions(const cv::Size& imageSize, const cv::Size& tileSize, float overlap) {
+    auto starts = [overlap](int extent, int tile) {
+        std::vector<int> positions;
+        if (extent <= tile) {
+            positions.push_back(0);
+            return positions;
+        }
+        // Fewest tiles that keep at least the requested overlap, spread
+        // evenly so the last one is flush with the edge
+        int stride = std::max(1, static_cast<int>(tile * (1.0f - overlap)));
+        int count = (extent - tile + stride - 1) / stride + 1;
+        for (int i = 0; i < count; ++i) {
+            positions.push_back(static_cast<int>(static_cast<int64_t>(extent - tile) * i / (count - 1)));
+        }
+        return positions;
+    };
+    
+    std::vector<cv::Rect> regions;
+    int tileWidth = std::min(tileSize.width, imageSize.width);
+    int tileHeight = std::min(tileSize.height, imageSize.height);
+    for (int y : starts(imageSize.height, tileSize.height)) {
+        for (int x : starts(imageSize.width, tileSize.width)) {
+            regions.emplace_back(x, y, tileWidth, tileHeight);
+        }
+    }
+    return regions;
+}
+
+cv::Mat YoloDetector::createInputBlob(const cv::Mat& image) const {
+    return createInputBlob(image, getConfig());
+}
+
+cv::Mat YoloDetector::createInputBlob(const cv::Mat& image, const DetectionConfig& config) {
+    cv::Mat blob;
+    cv::dnn::blobFromImage(image, blob, 1.0/255.0, 
+                          cv::Size(config.inputWidth, config.inputHeight), 
+                          cv::Scalar(0,0,0), true, false);
+    return blob;
+}
+
 void YoloDetector::setConfig(const DetectionConfig& config) {
     if (config.isValid()) {
+        std::lock_guard<std::mutex> lock(configMutex_);
         config_ = config;
     }
 }
 
 DetectionConfig YoloDetector::getConfig() const {
+    std::lock_guard<std::mutex> lock(configMutex_);
     return config_;
 }
 
@@ -190,11 +433,27 @@ std::string YoloDetector::getModelInfo() const {
         return "No model loaded";
     }
     
+    DetectionConfig config = getConfig();
     return "Model: " + modelPath_ + 
            "\nClasses: " + std::to_string(classNames_.size()) +
-           "\nInput size: " + std::to_string(config_.inputWidth) + "x" + std::to_string(config_.inputHeight) +
-           "\nConfidence threshold: " + std::to_string(config_.confidenceThreshold) +
-           "\nNMS threshold: " + std::to_string(config_.nmsThreshold);
+           "\nInput size: " + std::to_string(config.inputWidth) + "x" + std::to_string(config.inputHeight) +
+           "\nConfidence threshold: " + std::to_string(config.confidenceThreshold) +
+           "\nNMS threshold: " + std::to_string(config.nmsThreshold);
+}
+
+std::shared_ptr<IDetector> YoloDetector::clone() const {
+    if (!loaded_) {
+        return nullptr;
+    }
+
+    auto copy = std::make_shared<YoloDetector>();
+    copy->setConfig(getConfig());
+    copy->setModelCache(modelCache_);
+    if (!copy->loadModel(modelPath_, configPath_, classesPath_)) {
+        return nullptr;
+    }
+    copy->warmUp();
+    return copy;
 }
 
 void YoloDetector::loadClassNames(const std::string& classesPath) {
@@ -215,95 +474,200 @@ void YoloDetector::loadClassNames(const std::string& classesPath) {
 std::vector<Detection> YoloDetector::postProcessDetections(
     const std::vector<cv::Mat>& outputs, 
     const cv::Size& imageSize) {
+    return postProcessDetections(outputs, imageSize, getConfig());
+}
+
+std::vector<Detection> YoloDetector::postProcessDetections(
+    const std::vector<cv::Mat>& outputs, 
+    const cv::Size& imageSize,
+    const DetectionConfig& config) const {
     
-    std::vector<Detection> detections;
+    Candidates candidates;
+    cv::Rect frame(0, 0, imageSize.width, imageSize.height);
+    cv::Size networkSize(config.inputWidth, config.inputHeight);
+    for (const auto& output : outputs) {
+        decodeOutput(outputForImage(output, 0, 1), frame, networkSize, config, candidates);
+    }
+    return mergeCandidates(candidates, config);
+}
+
+void YoloDetector::decodeOutput(const cv::Mat& output, const cv::Rect& region, const cv::Size& networkSize,
+                                const DetectionConfig& config, Candidates& candidates) const {
+    // Network coordinates map onto the region the input was made from;
+    // networkSize is the part of the input the region was scaled to
+    float xFactor = static_cast<float>(region.width) / networkSize.width;
+    float yFactor = static_cast<float>(region.height) / networkSize.height;
+    int regionRight = region.x + region.width - 1;
+    int regionBottom = region.y + region.height - 1;
     
-    if (outputs.empty()) {
-        return detections;
+    const float* data = reinterpret_cast<const float*>(output.data);
+    
+    for (int i = 0; i < output.rows; ++i) {
+        const float* row = data + i * output.cols;
+        
+        // Skip if not enough columns for bbox + objectness + classes
+        if (output.cols < 5) continue;
+        
+        float objectness = row[4];
+        if (objectness < config.confidenceThreshold) continue;
+        
+        // Find best class
+        float maxClassScore = 0.0f;
+        int bestClassId = -1;
+        
+        for (int j = 5; j < output.cols; ++j) {
+            float classScore = row[j];
+            if (classScore > maxClassScore) {
+                maxClassScore = classScore;
+                bestClassId = j - 5;
+            }
+        }
+        
+        float confidence = objectness * maxClassScore;
+        if (confidence < config.confidenceThreshold) continue;
+        
+        // Check if class is in target classes (if specified)
+        if (!config.targetClasses.empty()) {
+            std::string className = (static_cast<size_t>(bestClassId) < classNames_.size()) ? 
+                                   classNames_[bestClassId] : "unknown";  // FIXED: Cast to size_t
+            
+            bool isTargetClass = std::find(config.targetClasses.begin(), 
+                                         config.targetClasses.end(), 
+                                         className) != config.targetClasses.end();
+            if (!isTargetClass) continue;
+        }
+        
+        // Extract bounding box
+        float centerX = region.x + row[0] * xFactor;
+        float centerY = region.y + row[1] * yFactor;
+        float width = row[2] * xFactor;
+        float height = row[3] * yFactor;
+        
+        int left = static_cast<int>(centerX - width / 2);
+        int top = static_cast<int>(centerY - height / 2);
+        
+        // Clamp to region bounds
+        left = std::max(region.x, std::min(left, regionRight));
+        top = std::max(region.y, std::min(top, regionBottom));
+        int right = std::max(region.x, std::min(static_cast<int>(centerX + width / 2), regionRight));
+        int bottom = std::max(region.y, std::min(static_cast<int>(centerY + height / 2), regionBottom));
+        
+        candidates.classIds.push_back(bestClassId);
+        candidates.confidences.push_back(confidence);
+        candidates.boxes.push_back(cv::Rect(left, top, right - left, bottom - top));
+    }
+}
+
+std::vector<Detection> YoloDetector::mergeCandidates(const Candidates& candidates, const DetectionConfig& config,
+                                                     bool fromTiles) const {
+    if (ImageTiming* timing = ImageTimingBinding::current()) {
+        timing->candidates += static_cast<uint32_t>(candidates.boxes.size());
     }
     
-    float xFactor = static_cast<float>(imageSize.width) / config_.inputWidth;
-    float yFactor = static_cast<float>(imageSize.height) / config_.inputHeight;
+    auto makeDetection = [this](const cv::Rect& box, float confidence, int classId) {
+        Detection det;
+        det.boundingBox = box;
+        det.confidence = confidence;
+        det.classId = classId;
+        det.className = (static_cast<size_t>(classId) < classNames_.size()) ? 
+                       classNames_[classId] : "unknown";  // FIXED: Cast to size_t
+        return det;
+    };
     
-    std::vector<int> classIds;
-    std::vector<float> confidences;
-    std::vector<cv::Rect> boxes;
+    std::vector<Detection> detections;
     
-    // Process each output
-    for (const auto& output : outputs) {
-        const float* data = reinterpret_cast<const float*>(output.data);
+    if (fromTiles && config.tileWeightedFusion) {
+        // Weighted box fusion: boxes of a class overlapping the best remaining
+        // one are averaged by confidence instead of dropped, so an object
+        // seen whole in one tile and cut in another ends up with one box
+        // spanning it. The fused box keeps the highest confidence.
+        std::vector<int> order(candidates.boxes.size());
+        for (size_t i = 0; i < order.size(); ++i) {
+            order[i] = static_cast<int>(i);
+        }
+        std::sort(order.begin(), order.end(), [&candidates](int a, int b) {
+            return candidates.confidences[a] > candidates.confidences[b];
+        });
         
-        for (int i = 0; i < output.rows; ++i) {
-            const float* row = data + i * output.cols;
-            
-            // Skip if not enough columns for bbox + objectness + classes
-            if (output.cols < 5) continue;
-            
-            float objectness = row[4];
-            if (objectness < config_.confidenceThreshold) continue;
+        struct Cluster {
+            cv::Rect box;
+            double left = 0.0, top = 0.0, right = 0.0, bottom = 0.0, weight = 0.0;
+            float confidence = 0.0f;
+            int classId = -1;
+        };
+        std::vector<Cluster> clusters;
+        for (int idx : order) {
+            const cv::Rect& box = candidates.boxes[idx];
+            float confidence = candidates.confidences[idx];
             
-            // Find best class
-            float maxClassScore = 0.0f;
-            int bestClassId = -1;
-            
-            for (int j = 5; j < output.cols; ++j) {
-                float classScore = row[j];
-                if (classScore > maxClassScore) {
-                    maxClassScore = classScore;
-                    bestClassId = j - 5;
+            Cluster* match = nullptr;
+            float bestIou = config.nmsThreshold;
+            for (auto& cluster : clusters) {
+                float iou = cluster.classId == candidates.classIds[idx] ? intersectionOverUnion(cluster.box, box) : 0.0f;
+                if (iou > bestIou) {
+                    bestIou = iou;
+                    match = &cluster;
                 }
             }
-            
-            float confidence = objectness * maxClassScore;
-            if (confidence < config_.confidenceThreshold) continue;
-            
-            // Check if class is in target classes (if specified)
-            if (!config_.targetClasses.empty()) {
-                std::string className = (static_cast<size_t>(bestClassId) < classNames_.size()) ? 
-                                       classNames_[bestClassId] : "unknown";  // FIXED: Cast to size_t
-                
-                bool isTargetClass = std::find(config_.targetClasses.begin(), 
-                                             config_.targetClasses.end(), 
-                                             className) != config_.targetClasses.end();
-                if (!isTargetClass) continue;
+            if (!match) {
+                clusters.emplace_back();
+                match = &clusters.back();
+                match->confidence = confidence;
+                match->classId = candidates.classIds[idx];
             }
-            
-            // Extract bounding box
-            float centerX = row[0] * xFactor;
-            float centerY = row[1] * yFactor;
-            float width = row[2] * xFactor;
-            float height = row[3] * yFactor;
-            
-            int left = static_cast<int>(centerX - width / 2);
-            int top = static_cast<int>(centerY - height / 2);
-            
-            // Clamp to image bounds
-            left = std::max(0, std::min(left, imageSize.width - 1));
-            top = std::max(0, std::min(top, imageSize.height - 1));
-            int right = std::max(0, std::min(static_cast<int>(centerX + width / 2), imageSize.width - 1));
-            int bottom = std::max(0, std::min(static_cast<int>(centerY + height / 2), imageSize.height - 1));
-            
-            classIds.push_back(bestClassId);
-            confidences.push_back(confidence);
-            boxes.push_back(cv::Rect(left, top, right - left, bottom - top));
+            match->left += confidence * box.x;
+            match->top += confidence * box.y;
+            match->right += confidence * (box.x + box.width);
+            match->bottom += confidence * (box.y + box.height);
+            match->weight += confidence;
+            match->box = cv::Rect(cv::Point(static_cast<int>(match->left / match->weight),
+                                            static_cast<int>(match->top / match->weight)),
+                                  cv::Point(static_cast<int>(match->right / match->weight),
+                                            static_cast<int>(match->bottom / match->weight)));
         }
+        
+        detections.reserve(clusters.size());
+        for (const auto& cluster : clusters) {
+            detections.push_back(makeDetection(cluster.box, cluster.confidence, cluster.classId));
+        }
+        return detections;
     }
     
     // Apply Non-Maximum Suppression
     std::vector<int> indices;
-    cv::dnn::NMSBoxes(boxes, confidences, config_.confidenceThreshold, 
-                      config_.nmsThreshold, indices);
+    if (fromTiles) {
+        // Per class: where tiles overlap, a box must not suppress a box of
+        // another class in the same place
+        std::vector<int> classIds = candidates.classIds;
+        std::sort(classIds.begin(), classIds.end());
+        classIds.erase(std::unique(classIds.begin(), classIds.end()), classIds.end());
+        for (int classId : classIds) {
+            std::vector<int> members;
+            std::vector<cv::Rect> boxes;
+            std::vector<float> confidences;
+            for (size_t i = 0; i < candidates.classIds.size(); ++i) {
+                if (candidates.classIds[i] == classId) {
+                    members.push_back(static_cast<int>(i));
+                    boxes.push_back(candidates.boxes[i]);
+                    confidences.push_back(candidates.confidences[i]);
+                }
+            }
+            std::vector<int> kept;
+            cv::dnn::NMSBoxes(boxes, confidences, config.confidenceThreshold, config.nmsThreshold, kept);
+            for (int k : kept) {
+                indices.push_back(members[k]);
+            }
+        }
+    } else {
+        cv::dnn::NMSBoxes(candidates.boxes, candidates.confidences, config.confidenceThreshold, 
+                          config.nmsThreshold, indices);
+    }
     
     // Create final detections
     detections.reserve(indices.size());
     for (int idx : indices) {
-        Detection det;
-        det.boundingBox = boxes[idx];
-        det.confidence = confidences[idx];
-        det.classId = classIds[idx];
-        det.className = (static_cast<size_t>(classIds[idx]) < classNames_.size()) ? 
-                       classNames_[classIds[idx]] : "unknown";  // FIXED: Cast to size_t
-        detections.push_back(det);
+        detections.push_back(makeDetection(candidates.boxes[idx], candidates.confidences[idx],
+                                           candidates.classIds[idx]));
     }
     
     return detections;
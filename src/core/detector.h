@@ -3,8 +3,13 @@
 #pragma once
 
 #include "types.h"
+#include "config.h"
+#include "model_cache.h"
 #include <opencv2/dnn.hpp>
+#include <atomic>
+#include <functional>
 #include <memory>
+#include <mutex>
 
 namespace YoloApp {
 namespace Core {
@@ -22,11 +27,28 @@ public:
     
     virtual std::vector<Detection> detectObjects(const cv::Mat& image) = 0;
     
+    /**
+     * @brief Why the last detectObjects call failed, empty if it succeeded
+     *
+     * detectObjects returns no detections when it fails; this tells a failure
+     * from an image without objects. Only meaningful on the thread that made
+     * the call.
+     */
+    virtual std::string lastDetectionError() const { return std::string(); }
+    
     virtual void setConfig(const DetectionConfig& config) = 0;
     virtual DetectionConfig getConfig() const = 0;
     
     virtual bool isLoaded() const = 0;
     virtual std::string getModelInfo() const = 0;
+    
+    /**
+     * @brief A second, independent engine for the same model and config
+     *
+     * Used to run several images in parallel; a network must not run on two
+     * threads at once. Returns null if the model cannot be loaded again.
+     */
+    virtual std::shared_ptr<IDetector> clone() const = 0;
 };
 
 /**
@@ -34,42 +56,134 @@ public:
  */
 class YoloDetector : public IDetector {
 public:
+    using ProgressCallback = std::function<void(int percent, const std::string& step)>;
+    
     YoloDetector();
-    ~YoloDetector() override = default;
+    ~YoloDetector() override;
+    
+    YoloDetector(const YoloDetector&) = delete;
+    YoloDetector& operator=(const YoloDetector&) = delete;
     
     bool loadModel(const std::string& modelPath, 
                    const std::string& configPath = "",
                    const std::string& classesPath = "") override;
     
-                       bool loadModel(const std::string& modelPath, const std::string& configPath = "");
-    bool loadONNXModel(const std::string& modelPath);
-    bool loadDarknetModel(const std::string& weightsPath, const std::string& configPath);
-    std::vector<Detection> detect(const cv::Mat& image);
-    void setConfidenceThreshold(float threshold) { confidenceThreshold = threshold; }
-    void setNMSThreshold(float threshold) { nmsThreshold = threshold; }
-    void setInputSize(int width, int height) { inputWidth = width; inputHeight = height; }
-
-    
     std::vector<Detection> detectObjects(const cv::Mat& image) override;
+    std::string lastDetectionError() const override { return detectionError_; }
     
+    // Safe while detecting on another thread; an image in progress keeps the config it started with
     void setConfig(const DetectionConfig& config) override;
     DetectionConfig getConfig() const override;
     
     bool isLoaded() const override;
     std::string getModelInfo() const override;
+    
+    // Loads the same files again (through the model cache) and warms the copy up
+    std::shared_ptr<IDetector> clone() const override;
+    
+    /**
+     * @brief Reuse parsed networks from this cache and return them to it when done
+     */
+    void setModelCache(std::shared_ptr<ModelCache> cache);
+    
+    /**
+     * @brief Report the steps of loadModel (hashing, parsing) as they happen
+     */
+    void setProgressCallback(ProgressCallback callback);
+    
+    /**
+     * @brief Run one forward pass on a blank input of the configured size
+     *
+     * The first forward allocates buffers and initializes layers; doing it
+     * here keeps that cost out of the first real image.
+     * @return Seconds taken, or 0 if no model is loaded
+     */
+    double warmUp();
+    
+    /**
+     * @brief Whether the last loadModel took its network from the model cache
+     */
+    bool wasLoadedFromCache() const { return loadedFromCache_; }
+    
+    /**
+     * @brief Why the last loadModel failed
+     */
+    std::string getLastError() const { return lastError_; }
+    
+    /**
+     * @brief Convert an image to the network input blob for the current config
+     */
+    cv::Mat createInputBlob(const cv::Mat& image) const;
+    
+    /**
+     * @brief Decode raw network outputs into detections (thresholds, class filter, NMS)
+     *
+     * Public so recorded output tensors can be replayed without a model.
+     */
+    std::vector<Detection> postProcessDetections(
+        const std::vector<cv::Mat>& outputs, 
+        const cv::Size& imageSize);
+    
+    /**
+     * @brief Tiles of tileSize covering an image, neighbors sharing overlap of their edge
+     *
+     * Edge tiles are shifted inward so every tile has the full size; along a
+     * dimension smaller than the tile there is one tile of the image's extent.
+     */
+    static std::vector<cv::Rect> tileRegions(const cv::Size& imageSize, const cv::Size& tileSize, float overlap);
+    
+    /**
+     * @brief Smallest stride-aligned network input holding the image at its aspect ratio
+     *
+     * The image is scaled to fit inputSize; each edge of the result is rounded
+     * up to a multiple of stride, so a 1920x1080 frame at 640x640 runs at 640x384.
+     */
+    static cv::Size rectInputSize(const cv::Size& imageSize, const cv::Size& inputSize,
+                                  int stride = Config::RECT_INPUT_STRIDE);
 
 private:
+    // Boxes above the confidence threshold, in image coordinates, before NMS
+    struct Candidates {
+        std::vector<int> classIds;
+        std::vector<float> confidences;
+        std::vector<cv::Rect> boxes;
+    };
+    
     cv::dnn::Net network_;
     std::vector<std::string> classNames_;
     std::vector<std::string> outputNames_;
     DetectionConfig config_;
     std::string modelPath_;
+    std::string configPath_;
+    std::string classesPath_;
     bool loaded_;
     
+    std::shared_ptr<ModelCache> modelCache_;
+    uint64_t modelKey_;
+    bool loadedFromCache_;
+    std::string lastError_;
+    std::string detectionError_;        // Of the last detectObjects call, written by the detecting thread
+    ProgressCallback progressCallback_;
+    
+    mutable std::mutex configMutex_;
+    std::atomic<bool> batchedTiles_;    // Cleared once the network rejects a batch (fixed batch size)
+    std::atomic<bool> rectShapes_;      // Cleared once the network rejects a non-square input (fixed shape)
+    
     void loadClassNames(const std::string& classesPath);
+    void releaseNetwork();
     std::vector<Detection> postProcessDetections(
-        const std::vector<cv::Mat>& outputs, 
-        const cv::Size& imageSize);
+        const std::vector<cv::Mat>& outputs,
+        const cv::Size& imageSize,
+        const DetectionConfig& config) const;
+    static cv::Mat createInputBlob(const cv::Mat& image, const DetectionConfig& config);
+    std::vector<Detection> detectTiled(const cv::Mat& image, const DetectionConfig& config);
+    std::vector<Detection> detectRect(const cv::Mat& image, const DetectionConfig& config);
+    void decodeOutput(const cv::Mat& output, const cv::Rect& region, const cv::Size& networkSize,
+                      const DetectionConfig& config, Candidates& candidates) const;
+    // fromTiles: the candidates come from several tiles of one frame (class-wise NMS or fusion)
+    std::vector<Detection> mergeCandidates(const Candidates& candidates, const DetectionConfig& config,
+                                           bool fromTiles = false) const;
+    void reportProgress(int percent, const std::string& step);
 };
 
 } // namespace Core
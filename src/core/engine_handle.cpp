@@ -0,0 +1,28 @@
+// src/core/engine_handle.cpp
+#include "engine_handle.h"
+
+namespace YoloApp {
+namespace Core {
+
+EngineHandle::EngineHandle(std::shared_ptr<IDetector> detector)
+    : detector_(std::move(detector))
+    , generation_(0) {
+}
+
+std::shared_ptr<IDetector> EngineHandle::acquire() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return detector_;
+}
+
+void EngineHandle::swap(std::shared_ptr<IDetector> detector) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        detector_.swap(detector);
+        generation_.fetch_add(1, std::memory_order_acq_rel);
+    }
+    // The previous detector is released here, outside the lock, unless an
+    // image in flight still holds it
+}
+
+} // namespace Core
+} // namespace YoloApp
@@ -0,0 +1,48 @@
+// src/core/engine_handle.h
+#pragma once
+
+#include "detector.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+namespace YoloApp {
+namespace Core {
+
+/**
+ * @brief Swappable reference to the detector a running pipeline uses
+ *
+ * The pipeline acquires the current detector once per image and keeps it
+ * for that image, so swap() takes effect at the next image boundary: the
+ * image in flight finishes on the old detector, which is released when its
+ * last user lets go. A new model or input size is therefore loaded and
+ * warmed up on the side and swapped in without stopping the run.
+ */
+class EngineHandle {
+public:
+    explicit EngineHandle(std::shared_ptr<IDetector> detector = nullptr);
+
+    /**
+     * @brief The current detector (may be null)
+     */
+    std::shared_ptr<IDetector> acquire() const;
+
+    /**
+     * @brief Make another detector current for every image started from now on
+     */
+    void swap(std::shared_ptr<IDetector> detector);
+
+    /**
+     * @brief Incremented by every swap, so users can notice a change cheaply
+     */
+    uint64_t generation() const { return generation_.load(std::memory_order_acquire); }
+
+private:
+    mutable std::mutex mutex_;
+    std::shared_ptr<IDetector> detector_;
+    std::atomic<uint64_t> generation_;
+};
+
+} // namespace Core
+} // namespace YoloApp
@@ -0,0 +1,54 @@
+// src/core/mapped_file.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace YoloApp {
+namespace Core {
+
+/**
+ * @brief Read-only memory mapping of a whole file
+ *
+ * Pages are loaded by the OS on first access, so opening is O(1) in the
+ * file size. Empty files map to a null pointer with size 0.
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    /**
+     * @brief Map a file, replacing any previous mapping
+     * @throws std::runtime_error if the file cannot be opened or mapped
+     */
+    void open(const std::string& path);
+    void close();
+
+    const uint8_t* data() const { return data_; }
+    size_t size() const { return size_; }
+    bool isOpen() const { return open_; }
+
+    template <typename T>
+    const T* as() const { return reinterpret_cast<const T*>(data_); }
+
+private:
+    void swap(MappedFile& other) noexcept;
+
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+    bool open_ = false;
+#ifdef _WIN32
+    void* fileHandle_ = nullptr;
+    void* mappingHandle_ = nullptr;
+#endif
+};
+
+} // namespace Core
+} // namespace YoloApp
@@ -0,0 +1,95 @@
+// src/core/model_cache.cpp
+#include "model_cache.h"
+#include "mapped_file.h"
+#include <cstring>
+
+namespace YoloApp {
+namespace Core {
+
+namespace {
+
+constexpr uint64_t HASH_PRIME = 0x9E3779B97F4A7C15ull;
+
+uint64_t mix(uint64_t hash, uint64_t value) {
+    hash ^= value * HASH_PRIME;
+    hash = (hash << 31) | (hash >> 33);
+    return hash * 0xC2B2AE3D27D4EB4Full;
+}
+
+// Eight bytes per step; weight files run to hundreds of megabytes
+uint64_t hashBytes(uint64_t hash, const uint8_t* data, size_t size) {
+    size_t words = size / sizeof(uint64_t);
+    for (size_t i = 0; i < words; ++i) {
+        uint64_t value;
+        std::memcpy(&value, data + i * sizeof(uint64_t), sizeof(value));
+        hash = mix(hash, value);
+    }
+    uint64_t tail = 0;
+    std::memcpy(&tail, data + words * sizeof(uint64_t), size % sizeof(uint64_t));
+    return mix(hash, tail);
+}
+
+} // namespace
+
+ModelCache::ModelCache(size_t capacity)
+    : capacity_(capacity) {
+}
+
+uint64_t ModelCache::hashFiles(const std::vector<std::string>& paths) {
+    uint64_t hash = 0xCBF29CE484222325ull;
+    for (const auto& path : paths) {
+        if (path.empty()) {
+            continue;
+        }
+        MappedFile file;
+        file.open(path);
+        hash = mix(hash, file.size());
+        if (file.size() > 0) {
+            hash = hashBytes(hash, file.data(), file.size());
+        }
+    }
+    return hash;
+}
+
+bool ModelCache::take(uint64_t key, Entry& entry) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+        if (it->key == key) {
+            entry = std::move(*it);
+            entries_.erase(it);
+            return true;
+        }
+    }
+    return false;
+}
+
+void ModelCache::put(Entry entry) {
+    if (capacity_ == 0 || entry.network.empty()) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+        if (it->key == entry.key) {
+            entries_.erase(it);
+            break;
+        }
+    }
+    entries_.push_front(std::move(entry));
+    while (entries_.size() > capacity_) {
+        entries_.pop_back();
+    }
+}
+
+void ModelCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+}
+
+size_t ModelCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+}
+
+} // namespace Core
+} // namespace YoloApp
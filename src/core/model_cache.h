@@ -0,0 +1,65 @@
+// src/core/model_cache.h
+#pragma once
+
+#include <opencv2/dnn.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace YoloApp {
+namespace Core {
+
+/**
+ * @brief Parsed networks that are not in use, keyed by model content hash
+ *
+ * A cv::dnn::Net cannot be deep-copied and must not run on two threads at
+ * once, so entries are checked out rather than shared: take() removes the
+ * network from the cache, and a detector gives it back with put() when it
+ * loads another model or is destroyed. Switching back to a recently used
+ * model then skips parsing and the one-time initialization of the first
+ * forward. The least recently returned network is dropped when full.
+ */
+class ModelCache {
+public:
+    struct Entry {
+        uint64_t key = 0;
+        cv::dnn::Net network;
+        std::vector<std::string> outputNames;
+    };
+
+    explicit ModelCache(size_t capacity);
+
+    /**
+     * @brief Content hash of the files that make up a model (weights and config)
+     *
+     * Empty paths are skipped; the file sizes are part of the hash.
+     * @throws std::runtime_error if a file cannot be read
+     */
+    static uint64_t hashFiles(const std::vector<std::string>& paths);
+
+    /**
+     * @brief Check out the network for a key
+     * @return false if none is cached
+     */
+    bool take(uint64_t key, Entry& entry);
+
+    /**
+     * @brief Return a network that is no longer used
+     */
+    void put(Entry entry);
+
+    void clear();
+    size_t size() const;
+    size_t capacity() const { return capacity_; }
+
+private:
+    mutable std::mutex mutex_;
+    std::list<Entry> entries_;  // Most recently returned first
+    size_t capacity_;
+};
+
+} // namespace Core
+} // namespace YoloApp
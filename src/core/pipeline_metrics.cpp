@@ -0,0 +1,473 @@
+// src/core/pipeline_metrics.cpp
+#include "pipeline_metrics.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace YoloApp {
+namespace Core {
+
+namespace {
+
+thread_local PipelineMetrics* t_boundMetrics = nullptr;
+thread_local ImageTiming* t_boundTiming = nullptr;
+thread_local uint32_t t_timedStages = 0;    // Bit per stage summed into t_boundTiming
+
+uint32_t stageBit(PipelineStage stage) {
+    return 1u << static_cast<unsigned>(stage);
+}
+
+uint64_t stageTime(const ImageTiming& timing, PipelineStage stage) {
+    switch (stage) {
+        case PipelineStage::Decode:      return timing.decodeMicros;
+        case PipelineStage::Preprocess:  return timing.preprocessMicros;
+        case PipelineStage::Forward:     return timing.inferenceMicros;
+        case PipelineStage::Postprocess: return timing.postprocessMicros;
+        case PipelineStage::Image:       return timing.totalMicros;
+        default: return 0;
+    }
+}
+
+int highestBit(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+    return 63 - __builtin_clzll(value);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanReverse64(&index, value);
+    return static_cast<int>(index);
+#else
+    int bit = 0;
+    while (value >>= 1) {
+        ++bit;
+    }
+    return bit;
+#endif
+}
+
+std::string escapeLabel(const std::string& value) {
+    std::string escaped;
+    escaped.reserve(value.size());
+    for (char c : value) {
+        if (c == '\\' || c == '"') {
+            escaped += '\\';
+            escaped += c;
+        } else if (c == '\n') {
+            escaped += "\\n";
+        } else {
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+double microsToMs(uint64_t micros) {
+    return micros / 1000.0;
+}
+
+const double QUANTILES[] = {0.5, 0.9, 0.95, 0.99};
+
+uint32_t saturate(uint64_t value) {
+    return static_cast<uint32_t>(std::min<uint64_t>(value, std::numeric_limits<uint32_t>::max()));
+}
+
+bool slowerThan(const PipelineMetrics::SlowImage& a, const PipelineMetrics::SlowImage& b) {
+    return a.timing.totalMicros > b.timing.totalMicros;
+}
+
+void writeSummary(std::ostream& out, const char* name, const std::string& labels, const LatencyHistogram& histogram) {
+    std::string prefix = labels.empty() ? "{" : "{" + labels + ",";
+    for (double q : QUANTILES) {
+        out << name << prefix << "quantile=\"" << q << "\"} "
+            << histogram.percentileMicros(q * 100.0) / 1e6 << "\n";
+    }
+    std::string suffix = labels.empty() ? "" : "{" + labels + "}";
+    out << name << "_sum" << suffix << " " << histogram.sumMicros() / 1e6 << "\n";
+    out << name << "_count" << suffix << " " << histogram.count() << "\n";
+}
+
+} // namespace
+
+const char* pipelineStageName(PipelineStage stage) {
+    switch (stage) {
+        case PipelineStage::Decode: return "decode";
+        case PipelineStage::Preprocess: return "preprocess";
+        case PipelineStage::Forward: return "forward";
+        case PipelineStage::Postprocess: return "postprocess";
+        case PipelineStage::Annotate: return "annotate";
+        case PipelineStage::Metadata: return "metadata";
+        case PipelineStage::Image: return "image";
+        case PipelineStage::Count: break;
+    }
+    return "unknown";
+}
+
+bool addStageTime(ImageTiming& timing, PipelineStage stage, uint64_t micros) {
+    switch (stage) {
+        case PipelineStage::Decode:      timing.decodeMicros = saturate(timing.decodeMicros + micros); return true;
+        case PipelineStage::Preprocess:  timing.preprocessMicros = saturate(timing.preprocessMicros + micros); return true;
+        case PipelineStage::Forward:     timing.inferenceMicros = saturate(timing.inferenceMicros + micros); return true;
+        case PipelineStage::Postprocess: timing.postprocessMicros = saturate(timing.postprocessMicros + micros); return true;
+        case PipelineStage::Image:       timing.totalMicros = saturate(std::max<uint64_t>(1, timing.totalMicros + micros)); return true;
+        default: return false;
+    }
+}
+
+// ImageTimingBinding implementation
+ImageTimingBinding::ImageTimingBinding(ImageTiming* timing)
+    : previous_(t_boundTiming)
+    , previousStages_(t_timedStages) {
+    t_boundTiming = timing;
+    t_timedStages = 0;
+}
+
+ImageTimingBinding::~ImageTimingBinding() {
+    // One sample per stage that ran for the image, however often it ran
+    PipelineMetrics* metrics = PipelineMetrics::current();
+    if (metrics && t_boundTiming) {
+        for (size_t i = 0; i < static_cast<size_t>(PipelineStage::Count); ++i) {
+            PipelineStage stage = static_cast<PipelineStage>(i);
+            if (t_timedStages & stageBit(stage)) {
+                metrics->recordStage(stage, stageTime(*t_boundTiming, stage));
+            }
+        }
+    }
+    t_boundTiming = previous_;
+    t_timedStages = previousStages_;
+}
+
+ImageTiming* ImageTimingBinding::current() {
+    return t_boundTiming;
+}
+
+void ImageTimingBinding::recordStage(PipelineMetrics* metrics, ImageTiming* timing, PipelineStage stage,
+                                     uint64_t micros) {
+    if (timing && addStageTime(*timing, stage, micros)) {
+        // Recorded once the image is done, as the sum over all runs
+        if (timing == t_boundTiming) {
+            t_timedStages |= stageBit(stage);
+            return;
+        }
+    }
+    if (metrics) {
+        metrics->recordStage(stage, micros);
+    }
+}
+
+// LatencyHistogram implementation
+LatencyHistogram::LatencyHistogram() {
+    reset();
+}
+
+size_t LatencyHistogram::bucketIndex(uint64_t micros) {
+    if (micros < SUB_BUCKETS) {
+        return static_cast<size_t>(micros);
+    }
+    int exponent = highestBit(micros);
+    int shift = exponent - SUB_BUCKET_BITS;
+    size_t subBucket = static_cast<size_t>(micros >> shift) & (SUB_BUCKETS - 1);
+    return SUB_BUCKETS + static_cast<size_t>(shift) * SUB_BUCKETS + subBucket;
+}
+
+uint64_t LatencyHistogram::bucketUpperBound(size_t index) {
+    if (index < SUB_BUCKETS) {
+        return index;
+    }
+    size_t shift = (index - SUB_BUCKETS) / SUB_BUCKETS;
+    uint64_t subBucket = (index - SUB_BUCKETS) % SUB_BUCKETS;
+    uint64_t lower = (SUB_BUCKETS + subBucket) << shift;
+    return lower + ((uint64_t(1) << shift) - 1);
+}
+
+void LatencyHistogram::record(uint64_t micros) {
+    buckets_[bucketIndex(micros)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    sum_.fetch_add(micros, std::memory_order_relaxed);
+
+    uint64_t previous = max_.load(std::memory_order_relaxed);
+    while (micros > previous && !max_.compare_exchange_weak(previous, micros, std::memory_order_relaxed)) {
+    }
+}
+
+void LatencyHistogram::reset() {
+    for (auto& bucket : buckets_) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    count_.store(0, std::memory_order_relaxed);
+    sum_.store(0, std::memory_order_relaxed);
+    max_.store(0, std::memory_order_relaxed);
+}
+
+double LatencyHistogram::meanMicros() const {
+    uint64_t samples = count();
+    return samples > 0 ? static_cast<double>(sumMicros()) / samples : 0.0;
+}
+
+uint64_t LatencyHistogram::percentileMicros(double p) const {
+    // Bucket counts are summed rather than taken from count_, so a concurrent
+    // record cannot make the target rank unreachable
+    uint64_t total = 0;
+    std::array<uint64_t, BUCKET_COUNT> counts;
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+        counts[i] = buckets_[i].load(std::memory_order_relaxed);
+        total += counts[i];
+    }
+    if (total == 0) {
+        return 0;
+    }
+
+    uint64_t rank = static_cast<uint64_t>(std::max(1.0, std::min(100.0, p) / 100.0 * total + 0.5));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+        seen += counts[i];
+        if (seen >= rank) {
+            return std::min(bucketUpperBound(i), maxMicros());
+        }
+    }
+    return maxMicros();
+}
+
+// PipelineMetrics implementation
+PipelineMetrics::Binding::Binding(PipelineMetrics* metrics)
+    : previous_(t_boundMetrics) {
+    t_boundMetrics = metrics;
+}
+
+PipelineMetrics::Binding::~Binding() {
+    t_boundMetrics = previous_;
+}
+
+PipelineMetrics::PipelineMetrics()
+    : slowestKept_(DEFAULT_SLOWEST_IMAGES) {
+    reset();
+}
+
+void PipelineMetrics::reset() {
+    for (auto& histogram : stages_) {
+        histogram.reset();
+    }
+    currentFolder_.reset();
+    for (auto& depth : queues_) {
+        depth.store(0, std::memory_order_relaxed);
+    }
+    for (auto& slot : window_) {
+        slot.second.store(-1, std::memory_order_relaxed);
+        slot.images.store(0, std::memory_order_relaxed);
+    }
+    imagesCompleted_.store(0, std::memory_order_relaxed);
+    startNanos_.store(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        Clock::now().time_since_epoch()).count(), std::memory_order_relaxed);
+
+    {
+        std::lock_guard<std::mutex> lock(folderMutex_);
+        currentFolderName_.clear();
+        completedFolders_.clear();
+    }
+
+    std::lock_guard<std::mutex> lock(slowestMutex_);
+    slowest_.clear();
+    slowestThreshold_.store(0, std::memory_order_relaxed);
+}
+
+PipelineMetrics* PipelineMetrics::current() {
+    return t_boundMetrics;
+}
+
+void PipelineMetrics::recordStage(PipelineStage stage, uint64_t micros) {
+    stages_[static_cast<size_t>(stage)].record(micros);
+    if (stage == PipelineStage::Image) {
+        currentFolder_.record(micros);
+    }
+}
+
+void PipelineMetrics::beginFolder(const std::string& name) {
+    currentFolder_.reset();
+    std::lock_guard<std::mutex> lock(folderMutex_);
+    currentFolderName_ = name;
+}
+
+void PipelineMetrics::endFolder() {
+    FolderLatency latency;
+    latency.images = currentFolder_.count();
+    latency.p50Ms = microsToMs(currentFolder_.percentileMicros(50));
+    latency.p95Ms = microsToMs(currentFolder_.percentileMicros(95));
+    latency.p99Ms = microsToMs(currentFolder_.percentileMicros(99));
+    latency.maxMs = microsToMs(currentFolder_.maxMicros());
+
+    std::lock_guard<std::mutex> lock(folderMutex_);
+    latency.name = currentFolderName_;
+    completedFolders_.push_back(std::move(latency));
+    currentFolderName_.clear();
+}
+
+std::string PipelineMetrics::currentFolderName() const {
+    std::lock_guard<std::mutex> lock(folderMutex_);
+    return currentFolderName_;
+}
+
+std::vector<PipelineMetrics::FolderLatency> PipelineMetrics::completedFolders() const {
+    std::lock_guard<std::mutex> lock(folderMutex_);
+    return completedFolders_;
+}
+
+void PipelineMetrics::setQueueDepth(Queue queue, int64_t depth) {
+    queues_[static_cast<size_t>(queue)].store(depth, std::memory_order_relaxed);
+}
+
+void PipelineMetrics::addQueueDepth(Queue queue, int64_t delta) {
+    queues_[static_cast<size_t>(queue)].fetch_add(delta, std::memory_order_relaxed);
+}
+
+int64_t PipelineMetrics::queueDepth(Queue queue) const {
+    return queues_[static_cast<size_t>(queue)].load(std::memory_order_relaxed);
+}
+
+int64_t PipelineMetrics::secondsSinceStart() const {
+    int64_t nowNanos = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+    return (nowNanos - startNanos_.load(std::memory_order_relaxed)) / 1000000000;
+}
+
+void PipelineMetrics::markImageCompleted(const ImageResult& image) {
+    imagesCompleted_.fetch_add(1, std::memory_order_relaxed);
+    trackSlowImage(image);
+
+    // The first image of a new second claims the slot and clears it; an
+    // increment racing with the claim may be lost, which a rate estimate tolerates
+    int64_t second = secondsSinceStart();
+    WindowSlot& slot = window_[static_cast<size_t>(second) % WINDOW_SLOTS];
+    int64_t stamp = slot.second.load(std::memory_order_acquire);
+    if (stamp != second && slot.second.compare_exchange_strong(stamp, second, std::memory_order_acq_rel)) {
+        slot.images.store(0, std::memory_order_relaxed);
+    }
+    slot.images.fetch_add(1, std::memory_order_relaxed);
+}
+
+void PipelineMetrics::setSlowestImagesKept(size_t count) {
+    std::lock_guard<std::mutex> lock(slowestMutex_);
+    slowestKept_ = count;
+    slowest_.clear();
+    slowestThreshold_.store(0, std::memory_order_relaxed);
+}
+
+std::vector<PipelineMetrics::SlowImage> PipelineMetrics::slowestImages() const {
+    std::vector<SlowImage> images;
+    {
+        std::lock_guard<std::mutex> lock(slowestMutex_);
+        images = slowest_;
+    }
+    std::sort(images.begin(), images.end(), slowerThan);
+    return images;
+}
+
+void PipelineMetrics::trackSlowImage(const ImageResult& image) {
+    uint32_t total = image.timing.totalMicros;
+    if (total == 0 || total <= slowestThreshold_.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(slowestMutex_);
+    if (slowestKept_ == 0) {
+        return;
+    }
+    if (slowest_.size() == slowestKept_) {
+        if (total <= slowest_.front().timing.totalMicros) {
+            return;
+        }
+        std::pop_heap(slowest_.begin(), slowest_.end(), slowerThan);
+        slowest_.pop_back();
+    }
+    slowest_.push_back(SlowImage{image.imagePath, image.imageSize, image.timing});
+    std::push_heap(slowest_.begin(), slowest_.end(), slowerThan);
+
+    // Only once the set is full can anything be ruled out without the lock
+    if (slowest_.size() == slowestKept_) {
+        slowestThreshold_.store(slowest_.front().timing.totalMicros, std::memory_order_relaxed);
+    }
+}
+
+double PipelineMetrics::imagesPerSecond(int windowSeconds) const {
+    int64_t now = secondsSinceStart();
+    int64_t window = std::min<int64_t>(std::max(1, std::min(windowSeconds, THROUGHPUT_WINDOW_SECONDS)), now);
+    if (window <= 0) {
+        // Still inside the first second
+        double elapsed = elapsedSeconds();
+        return elapsed > 0.0 ? imagesCompleted() / elapsed : 0.0;
+    }
+
+    // Whole seconds only; the one in progress would read low
+    uint64_t images = 0;
+    for (int64_t second = now - window; second < now; ++second) {
+        const WindowSlot& slot = window_[static_cast<size_t>(second) % WINDOW_SLOTS];
+        if (slot.second.load(std::memory_order_acquire) == second) {
+            images += slot.images.load(std::memory_order_relaxed);
+        }
+    }
+    return static_cast<double>(images) / window;
+}
+
+double PipelineMetrics::elapsedSeconds() const {
+    int64_t nowNanos = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+    return (nowNanos - startNanos_.load(std::memory_order_relaxed)) / 1e9;
+}
+
+void PipelineMetrics::writePrometheus(std::ostream& out) const {
+    out << "# HELP yolo_stage_latency_seconds Per-image latency of each pipeline stage\n"
+        << "# TYPE yolo_stage_latency_seconds summary\n";
+    for (size_t i = 0; i < stages_.size(); ++i) {
+        std::string labels = std::string("stage=\"") + pipelineStageName(static_cast<PipelineStage>(i)) + "\"";
+        writeSummary(out, "yolo_stage_latency_seconds", labels, stages_[i]);
+    }
+
+    std::string folderName = currentFolderName();
+    if (!folderName.empty()) {
+        out << "# HELP yolo_folder_latency_seconds Per-image latency in the folder being processed\n"
+            << "# TYPE yolo_folder_latency_seconds summary\n";
+        writeSummary(out, "yolo_folder_latency_seconds", "folder=\"" + escapeLabel(folderName) + "\"", currentFolder_);
+    }
+
+    out << "# HELP yolo_images_processed_total Images processed in this run\n"
+        << "# TYPE yolo_images_processed_total counter\n"
+        << "yolo_images_processed_total " << imagesCompleted() << "\n"
+        << "# HELP yolo_folders_completed_total Folders completed in this run\n"
+        << "# TYPE yolo_folders_completed_total counter\n"
+        << "yolo_folders_completed_total " << completedFolders().size() << "\n"
+        << "# HELP yolo_throughput_images_per_second Images per second over a rolling window\n"
+        << "# TYPE yolo_throughput_images_per_second gauge\n"
+        << "yolo_throughput_images_per_second{window=\"10s\"} " << imagesPerSecond(10) << "\n"
+        << "yolo_throughput_images_per_second{window=\"60s\"} " << imagesPerSecond(60) << "\n"
+        << "# HELP yolo_queue_depth Items waiting in each pipeline queue\n"
+        << "# TYPE yolo_queue_depth gauge\n"
+        << "yolo_queue_depth{queue=\"pending_images\"} " << queueDepth(Queue::PendingImages) << "\n"
+        << "yolo_queue_depth{queue=\"ui_backlog\"} " << queueDepth(Queue::UiBacklog) << "\n"
+        << "# HELP yolo_run_elapsed_seconds Time since the run started\n"
+        << "# TYPE yolo_run_elapsed_seconds gauge\n"
+        << "yolo_run_elapsed_seconds " << elapsedSeconds() << "\n";
+}
+
+void PipelineMetrics::writePrometheusFile(const std::string& path) const {
+    std::string temporary = path + ".tmp";
+    {
+        std::ofstream out(temporary, std::ios::trunc);
+        writePrometheus(out);
+        if (!out) {
+            throw std::runtime_error("Cannot write metrics: " + temporary);
+        }
+    }
+
+    std::error_code error;
+    fs::rename(temporary, path, error);
+    if (error) {
+        fs::remove(temporary, error);
+        throw std::runtime_error("Cannot write metrics: " + path);
+    }
+}
+
+} // namespace Core
+} // namespace YoloApp
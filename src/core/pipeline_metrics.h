@@ -0,0 +1,299 @@
+// src/core/pipeline_metrics.h
+#pragma once
+
+#include "types.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace YoloApp {
+namespace Core {
+
+/**
+ * @brief Timed stages of processing one image
+ */
+enum class PipelineStage {
+    Decode,
+    Preprocess,
+    Forward,
+    Postprocess,    ///< Box decoding and NMS
+    Annotate,
+    Metadata,
+    Image,          ///< Whole image, end to end
+    Count
+};
+
+const char* pipelineStageName(PipelineStage stage);
+
+/**
+ * @brief Add a stage duration to the matching ImageTiming field
+ * @return false for stages without a field, which are ignored
+ */
+bool addStageTime(ImageTiming& timing, PipelineStage stage, uint64_t micros);
+
+class PipelineMetrics;
+
+/**
+ * @brief Makes an ImageTiming the target of StageTimer on the calling thread
+ *
+ * The detector also reports its NMS candidate count to it. A stage with an
+ * ImageTiming field may run several times for one image (once per tile, or
+ * once per model of a cascade); its times are summed into the timing and
+ * recorded into the bound PipelineMetrics as one sample when the binding
+ * ends, so stage histograms hold one sample per image. Restores the
+ * previous binding on destruction.
+ */
+class ImageTimingBinding {
+public:
+    explicit ImageTimingBinding(ImageTiming* timing);
+    ~ImageTimingBinding();
+
+    ImageTimingBinding(const ImageTimingBinding&) = delete;
+    ImageTimingBinding& operator=(const ImageTimingBinding&) = delete;
+
+    /**
+     * @brief Timing bound to the calling thread, or null
+     */
+    static ImageTiming* current();
+
+    /**
+     * @brief Record a stage duration into the bound timing and metrics (either may be null)
+     */
+    static void recordStage(PipelineMetrics* metrics, ImageTiming* timing, PipelineStage stage, uint64_t micros);
+
+private:
+    ImageTiming* previous_;
+    uint32_t previousStages_;
+};
+
+/**
+ * @brief Lock-free log-linear latency histogram in microseconds
+ *
+ * HDR-style bucketing: exact below 16 us, then 16 buckets per power of two,
+ * so any recorded value is reported within 6.25% over the full 64-bit range.
+ * record() is a few relaxed atomic adds and may be called from any thread.
+ */
+class LatencyHistogram {
+public:
+    static constexpr int SUB_BUCKET_BITS = 4;
+    static constexpr size_t SUB_BUCKETS = size_t(1) << SUB_BUCKET_BITS;
+    static constexpr size_t BUCKET_COUNT = SUB_BUCKETS + (64 - SUB_BUCKET_BITS) * SUB_BUCKETS;
+
+    LatencyHistogram();
+
+    void record(uint64_t micros);
+
+    /**
+     * @brief Zero all counters (not atomic with respect to concurrent record calls)
+     */
+    void reset();
+
+    uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+    uint64_t sumMicros() const { return sum_.load(std::memory_order_relaxed); }
+    uint64_t maxMicros() const { return max_.load(std::memory_order_relaxed); }
+    double meanMicros() const;
+
+    /**
+     * @brief Value at or below which p percent of the samples fall (0 when empty)
+     */
+    uint64_t percentileMicros(double p) const;
+
+private:
+    static size_t bucketIndex(uint64_t micros);
+    static uint64_t bucketUpperBound(size_t index);
+
+    std::array<std::atomic<uint64_t>, BUCKET_COUNT> buckets_;
+    std::atomic<uint64_t> count_;
+    std::atomic<uint64_t> sum_;
+    std::atomic<uint64_t> max_;
+};
+
+/**
+ * @brief Live metrics of a detection run
+ *
+ * Stage latency histograms, a latency histogram of the folder in progress
+ * and percentile summaries of completed folders, queue depth gauges and a
+ * rolling images-per-second window. Everything except folder bookkeeping is
+ * lock-free, so the processing thread records while the UI or a file writer
+ * reads. Stages are timed with StageTimer on threads bound with Binding.
+ */
+class PipelineMetrics {
+public:
+    enum class Queue {
+        PendingImages,  ///< Scanned images not yet processed
+        UiBacklog,      ///< Per-image notifications not yet handled by the UI
+        Count
+    };
+
+    struct FolderLatency {
+        std::string name;
+        uint64_t images = 0;
+        double p50Ms = 0.0;
+        double p95Ms = 0.0;
+        double p99Ms = 0.0;
+        double maxMs = 0.0;
+    };
+
+    struct SlowImage {
+        std::string imagePath;
+        cv::Size imageSize;
+        ImageTiming timing;
+    };
+
+    /**
+     * @brief Makes a metrics object the target of StageTimer on the calling thread
+     *
+     * Restores the previous binding on destruction; a null target disables
+     * recording.
+     */
+    class Binding {
+    public:
+        explicit Binding(PipelineMetrics* metrics);
+        ~Binding();
+
+        Binding(const Binding&) = delete;
+        Binding& operator=(const Binding&) = delete;
+
+    private:
+        PipelineMetrics* previous_;
+    };
+
+    static constexpr int THROUGHPUT_WINDOW_SECONDS = 60;
+    static constexpr size_t DEFAULT_SLOWEST_IMAGES = 10;
+
+    PipelineMetrics();
+
+    /**
+     * @brief Start over for a new run (not while another thread records)
+     */
+    void reset();
+
+    /**
+     * @brief Metrics bound to the calling thread, or null
+     */
+    static PipelineMetrics* current();
+
+    void recordStage(PipelineStage stage, uint64_t micros);
+    const LatencyHistogram& stage(PipelineStage stage) const { return stages_[static_cast<size_t>(stage)]; }
+
+    void beginFolder(const std::string& name);
+    void endFolder();
+    const LatencyHistogram& currentFolder() const { return currentFolder_; }
+    std::string currentFolderName() const;
+    std::vector<FolderLatency> completedFolders() const;
+
+    void setQueueDepth(Queue queue, int64_t depth);
+    void addQueueDepth(Queue queue, int64_t delta);
+    int64_t queueDepth(Queue queue) const;
+
+    /**
+     * @brief Count a finished image and keep it if it is among the slowest so far
+     */
+    void markImageCompleted(const ImageResult& image);
+    uint64_t imagesCompleted() const { return imagesCompleted_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief How many of the slowest images to keep (0 keeps none); call before the run
+     */
+    void setSlowestImagesKept(size_t count);
+
+    /**
+     * @brief The slowest images so far by total time, slowest first
+     */
+    std::vector<SlowImage> slowestImages() const;
+
+    /**
+     * @brief Images per second over the last whole seconds (at most THROUGHPUT_WINDOW_SECONDS)
+     */
+    double imagesPerSecond(int windowSeconds) const;
+    double elapsedSeconds() const;
+
+    /**
+     * @brief Prometheus text exposition format (version 0.0.4)
+     */
+    void writePrometheus(std::ostream& out) const;
+
+    /**
+     * @brief Write the Prometheus text to a file, replacing it atomically
+     *
+     * Suits the node_exporter textfile collector, which must never see a
+     * partially written file.
+     *
+     * @throws std::runtime_error if the file cannot be written
+     */
+    void writePrometheusFile(const std::string& path) const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    // Slots are reused round-robin; one slot is the second being filled
+    static constexpr size_t WINDOW_SLOTS = THROUGHPUT_WINDOW_SECONDS + 4;
+
+    struct WindowSlot {
+        std::atomic<int64_t> second{-1};
+        std::atomic<uint64_t> images{0};
+    };
+
+    int64_t secondsSinceStart() const;
+    void trackSlowImage(const ImageResult& image);
+
+    std::array<LatencyHistogram, static_cast<size_t>(PipelineStage::Count)> stages_;
+    LatencyHistogram currentFolder_;
+    std::array<std::atomic<int64_t>, static_cast<size_t>(Queue::Count)> queues_;
+    std::array<WindowSlot, WINDOW_SLOTS> window_;
+    std::atomic<uint64_t> imagesCompleted_;
+    std::atomic<int64_t> startNanos_;
+
+    mutable std::mutex folderMutex_;
+    std::string currentFolderName_;
+    std::vector<FolderLatency> completedFolders_;
+
+    // Min-heap on total time; images at or below the threshold skip the lock
+    mutable std::mutex slowestMutex_;
+    std::vector<SlowImage> slowest_;
+    size_t slowestKept_;
+    std::atomic<uint32_t> slowestThreshold_;
+};
+
+/**
+ * @brief Records the lifetime of a scope into the thread's bound PipelineMetrics and ImageTiming
+ *
+ * Costs two thread-local reads when neither is bound.
+ */
+class StageTimer {
+public:
+    explicit StageTimer(PipelineStage stage)
+        : metrics_(PipelineMetrics::current())
+        , timing_(ImageTimingBinding::current())
+        , stage_(stage) {
+        if (metrics_ || timing_) {
+            start_ = std::chrono::steady_clock::now();
+        }
+    }
+
+    ~StageTimer() {
+        if (metrics_ || timing_) {
+            auto elapsed = std::chrono::steady_clock::now() - start_;
+            uint64_t micros = static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+            ImageTimingBinding::recordStage(metrics_, timing_, stage_, micros);
+        }
+    }
+
+    StageTimer(const StageTimer&) = delete;
+    StageTimer& operator=(const StageTimer&) = delete;
+
+private:
+    PipelineMetrics* metrics_;
+    ImageTiming* timing_;
+    PipelineStage stage_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+} // namespace Core
+} // namespace YoloApp
@@ -0,0 +1,323 @@
+// src/core/results_store.cpp
+#include "results_store.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+namespace fs = std::filesystem;
+
+namespace YoloApp {
+namespace Core {
+
+namespace {
+constexpr size_t COLUMN_BUFFER_SIZE = 1024 * 1024;
+
+// first + count <= total, without overflowing on corrupt values
+bool rangeFits(uint64_t first, uint64_t count, uint64_t total) {
+    return first <= total && count <= total - first;
+}
+}
+
+// ResultsStoreWriter implementation
+
+ResultsStoreWriter::ResultsStoreWriter(const std::string& directory)
+    : directory_(directory)
+    , manifest_{} {
+    std::error_code error;
+    fs::create_directories(directory_, error);
+    if (error) {
+        throw std::runtime_error("Cannot create session directory: " + directory_);
+    }
+
+    std::memcpy(manifest_.magic, StoreFormat::MAGIC, sizeof(manifest_.magic));
+    manifest_.version = StoreFormat::VERSION;
+
+    openColumn(folders_, StoreFormat::FOLDERS_FILE);
+    openColumn(images_, StoreFormat::IMAGES_FILE);
+    openColumn(strings_, StoreFormat::STRINGS_FILE);
+    openColumn(classes_, StoreFormat::CLASSES_FILE);
+    openColumn(boxes_, StoreFormat::BOXES_FILE);
+    openColumn(scores_, StoreFormat::SCORES_FILE);
+    openColumn(classIds_, StoreFormat::CLASS_IDS_FILE);
+
+    // An empty but valid session from the start
+    commit();
+}
+
+ResultsStoreWriter::~ResultsStoreWriter() {
+    for (Column* column : {&folders_, &images_, &strings_, &classes_, &boxes_, &scores_, &classIds_}) {
+        if (column->file) {
+            std::fclose(column->file);
+        }
+    }
+}
+
+void ResultsStoreWriter::appendFolder(const FolderResult& folder) {
+    StoreFormat::FolderRecord folderRecord{};
+    folderRecord.nameOffset = appendString(folder.folderName);
+    folderRecord.nameLength = static_cast<uint32_t>(folder.folderName.size());
+    folderRecord.pathOffset = appendString(folder.folderPath);
+    folderRecord.pathLength = static_cast<uint32_t>(folder.folderPath.size());
+    folderRecord.firstImage = manifest_.imageCount;
+
+    for (const auto& image : folder.images) {
+        if (!image) {
+            continue;
+        }
+
+        StoreFormat::ImageRecord imageRecord{};
+        imageRecord.pathOffset = appendString(image->imagePath);
+        imageRecord.pathLength = static_cast<uint32_t>(image->imagePath.size());
+        imageRecord.firstDetection = manifest_.detectionCount;
+        imageRecord.detectionCount = static_cast<uint32_t>(image->detections.size());
+        imageRecord.width = image->imageSize.width;
+        imageRecord.height = image->imageSize.height;
+        imageRecord.folderIndex = static_cast<uint32_t>(manifest_.folderCount);
+        imageRecord.flags = image->processed ? StoreFormat::IMAGE_PROCESSED : 0u;
+        write(images_, &imageRecord, sizeof(imageRecord));
+
+        for (const auto& detection : image->detections) {
+            if (knownClasses_.insert(detection.classId).second) {
+                StoreFormat::ClassRecord classRecord{};
+                classRecord.nameOffset = appendString(detection.className);
+                classRecord.nameLength = static_cast<uint32_t>(detection.className.size());
+                classRecord.classId = detection.classId;
+                write(classes_, &classRecord, sizeof(classRecord));
+                ++manifest_.classCount;
+            }
+
+            const cv::Rect& box = detection.boundingBox;
+            StoreFormat::BoxRecord boxRecord{box.x, box.y, box.width, box.height};
+            int32_t classId = detection.classId;
+            write(boxes_, &boxRecord, sizeof(boxRecord));
+            write(scores_, &detection.confidence, sizeof(float));
+            write(classIds_, &classId, sizeof(classId));
+        }
+
+        manifest_.detectionCount += image->detections.size();
+        folderRecord.detectionCount += image->detections.size();
+        ++manifest_.imageCount;
+    }
+
+    folderRecord.imageCount = manifest_.imageCount - folderRecord.firstImage;
+    write(folders_, &folderRecord, sizeof(folderRecord));
+    ++manifest_.folderCount;
+
+    commit();
+}
+
+void ResultsStoreWriter::openColumn(Column& column, const char* name) {
+    column.path = (fs::path(directory_) / name).string();
+    column.file = std::fopen(column.path.c_str(), "wb");
+    if (!column.file) {
+        throw std::runtime_error("Cannot create session file: " + column.path);
+    }
+    std::setvbuf(column.file, nullptr, _IOFBF, COLUMN_BUFFER_SIZE);
+}
+
+void ResultsStoreWriter::write(Column& column, const void* data, size_t bytes) {
+    if (bytes > 0 && std::fwrite(data, 1, bytes, column.file) != bytes) {
+        throw std::runtime_error("Failed to write session file: " + column.path);
+    }
+}
+
+uint64_t ResultsStoreWriter::appendString(const std::string& text) {
+    uint64_t offset = manifest_.stringBytes;
+    write(strings_, text.data(), text.size());
+    manifest_.stringBytes += text.size();
+    return offset;
+}
+
+void ResultsStoreWriter::commit() {
+    // Column data must reach the files before the manifest points past it
+    for (Column* column : {&folders_, &images_, &strings_, &classes_, &boxes_, &scores_, &classIds_}) {
+        if (std::fflush(column->file) != 0) {
+            throw std::runtime_error("Failed to write session file: " + column->path);
+        }
+    }
+
+    fs::path manifestPath = fs::path(directory_) / StoreFormat::MANIFEST_FILE;
+    fs::path tempPath = manifestPath;
+    tempPath += ".tmp";
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(&manifest_), sizeof(manifest_));
+        if (!out) {
+            throw std::runtime_error("Failed to write session manifest: " + tempPath.string());
+        }
+    }
+
+    std::error_code error;
+    fs::rename(tempPath, manifestPath, error);
+    if (error) {
+        throw std::runtime_error("Failed to commit session manifest: " + manifestPath.string());
+    }
+}
+
+// ResultsStore implementation
+
+void ResultsStore::open(const std::string& directory) {
+    close();
+
+    fs::path manifestPath = fs::path(directory) / StoreFormat::MANIFEST_FILE;
+    std::ifstream in(manifestPath, std::ios::binary);
+    StoreFormat::Manifest manifest{};
+    in.read(reinterpret_cast<char*>(&manifest), sizeof(manifest));
+    if (!in || std::memcmp(manifest.magic, StoreFormat::MAGIC, sizeof(manifest.magic)) != 0) {
+        throw std::runtime_error("Not a results session: " + directory);
+    }
+    if (manifest.version != StoreFormat::VERSION) {
+        throw std::runtime_error("Unsupported session version in: " + directory);
+    }
+
+    directory_ = directory;
+    try {
+        mapColumn(folders_, StoreFormat::FOLDERS_FILE, manifest.folderCount, sizeof(StoreFormat::FolderRecord));
+        mapColumn(images_, StoreFormat::IMAGES_FILE, manifest.imageCount, sizeof(StoreFormat::ImageRecord));
+        mapColumn(strings_, StoreFormat::STRINGS_FILE, manifest.stringBytes, 1);
+        mapColumn(classes_, StoreFormat::CLASSES_FILE, manifest.classCount, sizeof(StoreFormat::ClassRecord));
+        mapColumn(boxes_, StoreFormat::BOXES_FILE, manifest.detectionCount, sizeof(StoreFormat::BoxRecord));
+        mapColumn(scores_, StoreFormat::SCORES_FILE, manifest.detectionCount, sizeof(float));
+        mapColumn(classIds_, StoreFormat::CLASS_IDS_FILE, manifest.detectionCount, sizeof(int32_t));
+        manifest_ = manifest;
+        validateRecords();
+    } catch (...) {
+        close();
+        throw;
+    }
+}
+
+void ResultsStore::close() {
+    directory_.clear();
+    manifest_ = StoreFormat::Manifest{};
+    classNames_.clear();
+    for (MappedFile* file : {&folders_, &images_, &strings_, &classes_, &boxes_, &scores_, &classIds_}) {
+        file->close();
+    }
+}
+
+std::string_view ResultsStore::string(uint64_t offset, uint32_t length) const {
+    if (!rangeFits(offset, length, manifest_.stringBytes)) {
+        return std::string_view();
+    }
+    return std::string_view(reinterpret_cast<const char*>(strings_.data()) + offset, length);
+}
+
+std::string_view ResultsStore::className(int classId) const {
+    auto it = classNames_.find(classId);
+    return it != classNames_.end() ? it->second : std::string_view();
+}
+
+FolderResult ResultsStore::folderSummary(size_t index) const {
+    const StoreFormat::FolderRecord& record = folder(index);
+
+    FolderResult result;
+    result.folderPath = std::string(string(record.pathOffset, record.pathLength));
+    result.folderName = std::string(string(record.nameOffset, record.nameLength));
+    result.imageCount = static_cast<int>(record.imageCount);
+    result.totalDetections = static_cast<int>(record.detectionCount);
+    result.processed = true;
+    return result;
+}
+
+std::vector<FolderResult> ResultsStore::folderSummaries() const {
+    std::vector<FolderResult> summaries;
+    summaries.reserve(folderCount());
+    for (size_t i = 0; i < folderCount(); ++i) {
+        summaries.push_back(folderSummary(i));
+    }
+    return summaries;
+}
+
+FolderResult ResultsStore::loadFolder(size_t index) const {
+    FolderResult result = folderSummary(index);
+    const StoreFormat::FolderRecord& record = folder(index);
+
+    result.images.reserve(static_cast<size_t>(record.imageCount));
+    for (uint64_t i = 0; i < record.imageCount; ++i) {
+        result.images.push_back(loadImage(index, static_cast<size_t>(i)));
+    }
+    return result;
+}
+
+std::shared_ptr<ImageResult> ResultsStore::loadImage(size_t folderIndex, size_t imageIndex) const {
+    const StoreFormat::FolderRecord& folderRecord = folder(folderIndex);
+    const StoreFormat::ImageRecord& imageRecord = image(static_cast<size_t>(folderRecord.firstImage) + imageIndex);
+
+    auto imageResult = std::make_shared<ImageResult>(
+        std::string(string(imageRecord.pathOffset, imageRecord.pathLength)));
+    imageResult->imageSize = cv::Size(imageRecord.width, imageRecord.height);
+    imageResult->processed = (imageRecord.flags & StoreFormat::IMAGE_PROCESSED) != 0;
+
+    imageResult->detections.reserve(imageRecord.detectionCount);
+    for (uint64_t d = imageRecord.firstDetection;
+         d < imageRecord.firstDetection + imageRecord.detectionCount; ++d) {
+        const StoreFormat::BoxRecord& box = boxes()[d];
+        int classId = classIds()[d];
+        imageResult->detections.emplace_back(cv::Rect(box.x, box.y, box.width, box.height),
+                                             scores()[d], classId, std::string(className(classId)));
+    }
+    return imageResult;
+}
+
+void ResultsStore::indexClasses(ClassIndex& index) const {
+    for (const auto& [classId, name] : classNames_) {
+        index.setClassName(classId, std::string(name));
+    }
+
+    // Straight from the mapped columns, no image results are built
+    for (size_t f = 0; f < folderCount(); ++f) {
+        const StoreFormat::FolderRecord& folderRecord = folder(f);
+        for (uint64_t i = 0; i < folderRecord.imageCount; ++i) {
+            const StoreFormat::ImageRecord& imageRecord = image(static_cast<size_t>(folderRecord.firstImage + i));
+            index.addImage(static_cast<uint32_t>(f), static_cast<uint32_t>(i),
+                           classIds() + imageRecord.firstDetection,
+                           scores() + imageRecord.firstDetection,
+                           imageRecord.detectionCount);
+        }
+    }
+}
+
+void ResultsStore::mapColumn(MappedFile& file, const char* name, uint64_t count, size_t recordSize) {
+    std::string path = (fs::path(directory_) / name).string();
+    file.open(path);
+    if (count > file.size() / recordSize) {
+        throw std::runtime_error("Session file is truncated: " + path);
+    }
+}
+
+void ResultsStore::validateRecords() {
+    // loadImage and indexClasses index the columns with these offsets unchecked
+    auto corrupt = [this](const char* name, uint64_t record) {
+        return std::runtime_error("Session file is corrupt: " + (fs::path(directory_) / name).string() +
+                                  " (record " + std::to_string(record) + ")");
+    };
+
+    const auto* folderRecords = folders_.as<StoreFormat::FolderRecord>();
+    for (uint64_t i = 0; i < manifest_.folderCount; ++i) {
+        if (!rangeFits(folderRecords[i].firstImage, folderRecords[i].imageCount, manifest_.imageCount)) {
+            throw corrupt(StoreFormat::FOLDERS_FILE, i);
+        }
+    }
+
+    const auto* imageRecords = images_.as<StoreFormat::ImageRecord>();
+    for (uint64_t i = 0; i < manifest_.imageCount; ++i) {
+        if (!rangeFits(imageRecords[i].firstDetection, imageRecords[i].detectionCount, manifest_.detectionCount)) {
+            throw corrupt(StoreFormat::IMAGES_FILE, i);
+        }
+    }
+
+    // The writer stores each class once, with a non-negative model class id
+    const auto* classRecords = classes_.as<StoreFormat::ClassRecord>();
+    for (uint64_t i = 0; i < manifest_.classCount; ++i) {
+        const StoreFormat::ClassRecord& record = classRecords[i];
+        if (record.classId < 0 || !rangeFits(record.nameOffset, record.nameLength, manifest_.stringBytes) ||
+            !classNames_.emplace(record.classId, string(record.nameOffset, record.nameLength)).second) {
+            throw corrupt(StoreFormat::CLASSES_FILE, i);
+        }
+    }
+}
+
+} // namespace Core
+} // namespace YoloApp
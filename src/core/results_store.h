@@ -0,0 +1,225 @@
+// src/core/results_store.h
+#pragma once
+
+#include "types.h"
+#include "mapped_file.h"
+#include "class_index.h"
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace YoloApp {
+namespace Core {
+
+/**
+ * @brief On-disk layout of a results session
+ *
+ * A session is a directory of flat little-endian arrays of fixed-width
+ * records. Folder and image records index into the detection columns
+ * (boxes, scores, class ids) by offset and count, and into a shared
+ * string blob. The manifest holds the committed record counts; anything
+ * past them (an interrupted append) is ignored by readers.
+ */
+namespace StoreFormat {
+
+constexpr char MAGIC[4] = {'Y', 'R', 'S', '1'};
+constexpr uint32_t VERSION = 1;
+
+constexpr const char* MANIFEST_FILE = "manifest.bin";
+constexpr const char* FOLDERS_FILE = "folders.bin";
+constexpr const char* IMAGES_FILE = "images.bin";
+constexpr const char* STRINGS_FILE = "strings.bin";
+constexpr const char* CLASSES_FILE = "classes.bin";
+constexpr const char* BOXES_FILE = "det_boxes.bin";
+constexpr const char* SCORES_FILE = "det_scores.bin";
+constexpr const char* CLASS_IDS_FILE = "det_class_ids.bin";
+
+struct Manifest {
+    char magic[4];
+    uint32_t version;
+    uint64_t folderCount;
+    uint64_t imageCount;
+    uint64_t detectionCount;
+    uint64_t stringBytes;
+    uint64_t classCount;
+};
+
+struct FolderRecord {
+    uint64_t nameOffset;
+    uint64_t pathOffset;
+    uint32_t nameLength;
+    uint32_t pathLength;
+    uint64_t firstImage;
+    uint64_t imageCount;
+    uint64_t detectionCount;
+};
+
+enum ImageFlags : uint32_t {
+    IMAGE_PROCESSED = 1u << 0
+};
+
+struct ImageRecord {
+    uint64_t pathOffset;
+    uint64_t firstDetection;
+    uint32_t pathLength;
+    uint32_t detectionCount;
+    int32_t width;
+    int32_t height;
+    uint32_t folderIndex;
+    uint32_t flags;
+};
+
+struct ClassRecord {
+    uint64_t nameOffset;
+    uint32_t nameLength;
+    int32_t classId;
+};
+
+struct BoxRecord {
+    int32_t x;
+    int32_t y;
+    int32_t width;
+    int32_t height;
+};
+
+static_assert(sizeof(Manifest) == 48, "Manifest layout changed");
+static_assert(sizeof(FolderRecord) == 48, "FolderRecord layout changed");
+static_assert(sizeof(ImageRecord) == 40, "ImageRecord layout changed");
+static_assert(sizeof(ClassRecord) == 16, "ClassRecord layout changed");
+static_assert(sizeof(BoxRecord) == 16, "BoxRecord layout changed");
+
+} // namespace StoreFormat
+
+/**
+ * @brief Appends folder results to a session directory during a run
+ *
+ * Each appendFolder() writes the records and then atomically replaces the
+ * manifest, so a crash loses at most the folder being written.
+ */
+class ResultsStoreWriter {
+public:
+    /**
+     * @brief Create (or truncate) a session in a directory
+     * @throws std::runtime_error if the files cannot be created
+     */
+    explicit ResultsStoreWriter(const std::string& directory);
+    ~ResultsStoreWriter();
+
+    ResultsStoreWriter(const ResultsStoreWriter&) = delete;
+    ResultsStoreWriter& operator=(const ResultsStoreWriter&) = delete;
+
+    /**
+     * @brief Append one completed folder and commit it
+     * @throws std::runtime_error on write errors
+     */
+    void appendFolder(const FolderResult& folder);
+
+    const std::string& directory() const { return directory_; }
+
+private:
+    struct Column {
+        std::FILE* file = nullptr;
+        std::string path;
+    };
+
+    void openColumn(Column& column, const char* name);
+    void write(Column& column, const void* data, size_t bytes);
+    uint64_t appendString(const std::string& text);
+    void commit();
+
+    std::string directory_;
+    Column folders_;
+    Column images_;
+    Column strings_;
+    Column classes_;
+    Column boxes_;
+    Column scores_;
+    Column classIds_;
+
+    StoreFormat::Manifest manifest_;
+    std::set<int> knownClasses_;
+};
+
+/**
+ * @brief Memory-mapped, read-only view of a results session
+ *
+ * Opening maps the column files without reading or parsing them; records
+ * are accessed in place. Image results are only materialized per folder,
+ * when a folder is shown.
+ */
+class ResultsStore {
+public:
+    ResultsStore() = default;
+
+    /**
+     * @brief Map a session directory
+     * @throws std::runtime_error if the session is missing, truncated or has
+     *         records pointing outside their columns
+     */
+    void open(const std::string& directory);
+    void close();
+
+    bool isOpen() const { return manifest_.version != 0; }
+    const std::string& directory() const { return directory_; }
+
+    size_t folderCount() const { return static_cast<size_t>(manifest_.folderCount); }
+    size_t imageCount() const { return static_cast<size_t>(manifest_.imageCount); }
+    size_t detectionCount() const { return static_cast<size_t>(manifest_.detectionCount); }
+
+    const StoreFormat::FolderRecord& folder(size_t index) const { return folders_.as<StoreFormat::FolderRecord>()[index]; }
+    const StoreFormat::ImageRecord& image(size_t index) const { return images_.as<StoreFormat::ImageRecord>()[index]; }
+    const StoreFormat::BoxRecord* boxes() const { return boxes_.as<StoreFormat::BoxRecord>(); }
+    const float* scores() const { return scores_.as<float>(); }
+    const int32_t* classIds() const { return classIds_.as<int32_t>(); }
+
+    std::string_view string(uint64_t offset, uint32_t length) const;
+    std::string_view className(int classId) const;
+
+    /**
+     * @brief Folder name and counts only, without image records
+     */
+    FolderResult folderSummary(size_t index) const;
+    std::vector<FolderResult> folderSummaries() const;
+
+    /**
+     * @brief Build full image results (paths, sizes, detections) for one folder
+     */
+    FolderResult loadFolder(size_t index) const;
+
+    /**
+     * @brief Build the result of a single image
+     */
+    std::shared_ptr<ImageResult> loadImage(size_t folderIndex, size_t imageIndex) const;
+
+    /**
+     * @brief Add every image of the session to a class index
+     */
+    void indexClasses(ClassIndex& index) const;
+
+private:
+    void mapColumn(MappedFile& file, const char* name, uint64_t count, size_t recordSize);
+
+    /**
+     * @brief Check that record offsets stay inside the columns and build the class names
+     * @throws std::runtime_error naming the first bad record
+     */
+    void validateRecords();
+
+    std::string directory_;
+    StoreFormat::Manifest manifest_{};
+    MappedFile folders_;
+    MappedFile images_;
+    MappedFile strings_;
+    MappedFile classes_;
+    MappedFile boxes_;
+    MappedFile scores_;
+    MappedFile classIds_;
+    std::map<int, std::string_view> classNames_;
+};
+
+} // namespace Core
+} // namespace YoloApp
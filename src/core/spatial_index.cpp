@@ -0,0 +1,170 @@
+// src/core/spatial_index.cpp
+#include "spatial_index.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace YoloApp {
+namespace Core {
+
+DetectionSpatialIndex::DetectionSpatialIndex(const std::vector<Detection>& detections) {
+    build(detections);
+}
+
+void DetectionSpatialIndex::build(const std::vector<Detection>& detections) {
+    boxes_.clear();
+    cellStart_.clear();
+    cellItems_.clear();
+    visited_.clear();
+    stamp_ = 0;
+    cols_ = rows_ = 0;
+
+    if (detections.empty()) {
+        return;
+    }
+
+    boxes_.reserve(detections.size());
+    std::vector<int> extents;
+    extents.reserve(detections.size());
+
+    bounds_ = detections.front().boundingBox;
+    for (const auto& detection : detections) {
+        const cv::Rect& box = detection.boundingBox;
+        boxes_.push_back(box);
+        bounds_ |= box;
+        extents.push_back(std::max(box.width, box.height));
+    }
+
+    // Cells about the size of a typical box keep both the per-cell lists
+    // and the number of cells each box is copied into small
+    auto median = extents.begin() + extents.size() / 2;
+    std::nth_element(extents.begin(), median, extents.end());
+    double areaPerBox = static_cast<double>(bounds_.area()) / boxes_.size();
+    cellSize_ = std::max({8, *median, static_cast<int>(std::sqrt(areaPerBox) / 2)});
+
+    cols_ = std::max(1, (bounds_.width + cellSize_ - 1) / cellSize_);
+    rows_ = std::max(1, (bounds_.height + cellSize_ - 1) / cellSize_);
+
+    // Counting pass, then prefix sums, then fill (CSR layout)
+    std::vector<uint32_t> counts(static_cast<size_t>(cols_) * rows_ + 1, 0);
+    for (const auto& box : boxes_) {
+        int x0, y0, x1, y1;
+        if (!cellRange(box, x0, y0, x1, y1)) {
+            continue;
+        }
+        for (int cy = y0; cy <= y1; ++cy) {
+            for (int cx = x0; cx <= x1; ++cx) {
+                ++counts[static_cast<size_t>(cy) * cols_ + cx + 1];
+            }
+        }
+    }
+    for (size_t i = 1; i < counts.size(); ++i) {
+        counts[i] += counts[i - 1];
+    }
+
+    cellStart_ = counts;
+    cellItems_.resize(cellStart_.back());
+    for (uint32_t i = 0; i < boxes_.size(); ++i) {
+        int x0, y0, x1, y1;
+        if (!cellRange(boxes_[i], x0, y0, x1, y1)) {
+            continue;
+        }
+        for (int cy = y0; cy <= y1; ++cy) {
+            for (int cx = x0; cx <= x1; ++cx) {
+                cellItems_[counts[static_cast<size_t>(cy) * cols_ + cx]++] = i;
+            }
+        }
+    }
+
+    visited_.assign(boxes_.size(), 0);
+}
+
+int DetectionSpatialIndex::hitTest(float x, float y) const {
+    int best = -1;
+    int bestArea = std::numeric_limits<int>::max();
+    for (int index : queryPoint(x, y)) {
+        int area = boxes_[index].area();
+        if (area < bestArea) {
+            bestArea = area;
+            best = index;
+        }
+    }
+    return best;
+}
+
+std::vector<int> DetectionSpatialIndex::queryPoint(float x, float y) const {
+    std::vector<int> result;
+    if (boxes_.empty()) {
+        return result;
+    }
+
+    int cx = static_cast<int>(std::floor((x - bounds_.x) / cellSize_));
+    int cy = static_cast<int>(std::floor((y - bounds_.y) / cellSize_));
+    if (cx < 0 || cy < 0 || cx >= cols_ || cy >= rows_) {
+        return result;
+    }
+
+    size_t cell = static_cast<size_t>(cy) * cols_ + cx;
+    for (uint32_t i = cellStart_[cell]; i < cellStart_[cell + 1]; ++i) {
+        const cv::Rect& box = boxes_[cellItems_[i]];
+        if (x >= box.x && x < box.x + box.width && y >= box.y && y < box.y + box.height) {
+            result.push_back(static_cast<int>(cellItems_[i]));
+        }
+    }
+    return result;
+}
+
+std::vector<int> DetectionSpatialIndex::queryRect(const cv::Rect& rect, bool fullyContained) const {
+    std::vector<int> result;
+    int x0, y0, x1, y1;
+    if (boxes_.empty() || !cellRange(rect, x0, y0, x1, y1)) {
+        return result;
+    }
+
+    if (++stamp_ == 0) {
+        std::fill(visited_.begin(), visited_.end(), 0);
+        stamp_ = 1;
+    }
+
+    for (int cy = y0; cy <= y1; ++cy) {
+        for (int cx = x0; cx <= x1; ++cx) {
+            size_t cell = static_cast<size_t>(cy) * cols_ + cx;
+            for (uint32_t i = cellStart_[cell]; i < cellStart_[cell + 1]; ++i) {
+                uint32_t index = cellItems_[i];
+                if (visited_[index] == stamp_) {
+                    continue;
+                }
+                visited_[index] = stamp_;
+
+                const cv::Rect& box = boxes_[index];
+                bool match = fullyContained ? (box & rect) == box : (box & rect).area() > 0;
+                if (match) {
+                    result.push_back(static_cast<int>(index));
+                }
+            }
+        }
+    }
+
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+bool DetectionSpatialIndex::cellRange(const cv::Rect& rect, int& x0, int& y0, int& x1, int& y1) const {
+    cv::Rect clipped = rect & bounds_;
+    if (clipped.width <= 0 || clipped.height <= 0) {
+        // Degenerate boxes still belong to the cell they sit in
+        if (!bounds_.contains(rect.tl())) {
+            return false;
+        }
+        clipped = cv::Rect(rect.x, rect.y, 1, 1);
+    }
+
+    x0 = (clipped.x - bounds_.x) / cellSize_;
+    y0 = (clipped.y - bounds_.y) / cellSize_;
+    x1 = std::min(cols_ - 1, (clipped.x + clipped.width - 1 - bounds_.x) / cellSize_);
+    y1 = std::min(rows_ - 1, (clipped.y + clipped.height - 1 - bounds_.y) / cellSize_);
+    return true;
+}
+
+} // namespace Core
+} // namespace YoloApp
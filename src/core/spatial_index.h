@@ -0,0 +1,70 @@
+// src/core/spatial_index.h
+#pragma once
+
+#include "types.h"
+#include <cstdint>
+#include <vector>
+
+namespace YoloApp {
+namespace Core {
+
+/**
+ * @brief Uniform-grid spatial index over the boxes of one image
+ *
+ * Boxes are bucketed into square cells sized from the box statistics and
+ * stored in a compact CSR layout (cell offsets + item array). Point and
+ * rectangle queries touch only the overlapping cells, which keeps them
+ * well under a millisecond for tens of thousands of boxes.
+ *
+ * Queries are const but reuse an internal scratch buffer, so one index
+ * must not be queried from several threads at once.
+ */
+class DetectionSpatialIndex {
+public:
+    DetectionSpatialIndex() = default;
+    explicit DetectionSpatialIndex(const std::vector<Detection>& detections);
+
+    /**
+     * @brief (Re)build the index for a set of detections
+     */
+    void build(const std::vector<Detection>& detections);
+
+    /**
+     * @brief Index of the smallest box containing the point, or -1
+     *
+     * Preferring the smallest box makes nested and overlapping boxes
+     * selectable in dense scenes.
+     */
+    int hitTest(float x, float y) const;
+
+    /**
+     * @brief Indices of all boxes containing the point
+     */
+    std::vector<int> queryPoint(float x, float y) const;
+
+    /**
+     * @brief Indices of boxes intersecting (or fully inside) a rectangle
+     */
+    std::vector<int> queryRect(const cv::Rect& rect, bool fullyContained = false) const;
+
+    size_t size() const { return boxes_.size(); }
+    bool empty() const { return boxes_.empty(); }
+
+private:
+    bool cellRange(const cv::Rect& rect, int& x0, int& y0, int& x1, int& y1) const;
+
+    std::vector<cv::Rect> boxes_;
+    cv::Rect bounds_;
+    int cellSize_ = 1;
+    int cols_ = 0;
+    int rows_ = 0;
+    std::vector<uint32_t> cellStart_;
+    std::vector<uint32_t> cellItems_;
+
+    // Per-box visit stamps to de-duplicate boxes spanning several cells
+    mutable std::vector<uint32_t> visited_;
+    mutable uint32_t stamp_ = 0;
+};
+
+} // namespace Core
+} // namespace YoloApp
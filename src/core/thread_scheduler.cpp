@@ -0,0 +1,274 @@
+// src/core/thread_scheduler.cpp
+#include "thread_scheduler.h"
+#include "config.h"
+#include <opencv2/core.hpp>
+#include <algorithm>
+#include <thread>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#include <fstream>
+#include <sstream>
+#endif
+
+namespace YoloApp {
+namespace Core {
+
+namespace {
+
+#ifdef _WIN32
+
+bool pinToMask(DWORD_PTR mask) {
+    return mask != 0 && SetThreadAffinityMask(GetCurrentThread(), mask) != 0;
+}
+
+DWORD_PTR coreMask(int first, int count) {
+    const int bits = static_cast<int>(sizeof(DWORD_PTR) * 8);
+    DWORD_PTR mask = 0;
+    for (int i = 0; i < count; ++i) {
+        mask |= DWORD_PTR(1) << ((first + i) % bits);
+    }
+    return mask;
+}
+
+bool pinToNumaNode(int engineIndex) {
+    ULONG highestNode = 0;
+    if (!GetNumaHighestNodeNumber(&highestNode)) {
+        return false;
+    }
+    ULONGLONG mask = 0;
+    UCHAR node = static_cast<UCHAR>(engineIndex % (static_cast<int>(highestNode) + 1));
+    if (!GetNumaNodeProcessorMask(node, &mask)) {
+        return false;
+    }
+    return pinToMask(static_cast<DWORD_PTR>(mask));
+}
+
+#elif defined(__linux__)
+
+bool pinToSet(const cpu_set_t& set) {
+    return CPU_COUNT(&set) > 0 && pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+}
+
+// Parses the kernel's cpulist format, e.g. "0-7,16-23"
+bool parseCpuList(const std::string& text, cpu_set_t& set) {
+    CPU_ZERO(&set);
+    std::istringstream stream(text);
+    std::string range;
+    while (std::getline(stream, range, ',')) {
+        if (range.empty() || range == "\n") {
+            continue;
+        }
+        int first = 0;
+        int last = 0;
+        char dash = 0;
+        std::istringstream rangeStream(range);
+        if (!(rangeStream >> first)) {
+            return false;
+        }
+        last = first;
+        if (rangeStream >> dash && dash == '-' && !(rangeStream >> last)) {
+            return false;
+        }
+        for (int cpu = first; cpu <= last && cpu < CPU_SETSIZE; ++cpu) {
+            CPU_SET(cpu, &set);
+        }
+    }
+    return CPU_COUNT(&set) > 0;
+}
+
+int numaNodeCount() {
+    int nodes = 0;
+    while (std::ifstream("/sys/devices/system/node/node" + std::to_string(nodes) + "/cpulist")) {
+        ++nodes;
+    }
+    return nodes;
+}
+
+bool pinToNumaNode(int engineIndex) {
+    int nodes = numaNodeCount();
+    if (nodes == 0) {
+        return false;
+    }
+    std::ifstream file("/sys/devices/system/node/node" + std::to_string(engineIndex % nodes) + "/cpulist");
+    std::string text;
+    std::getline(file, text);
+    cpu_set_t set;
+    return parseCpuList(text, set) && pinToSet(set);
+}
+
+#endif
+
+} // namespace
+
+ThreadScheduler::ThreadScheduler(int coreBudget)
+    : coreBudget_(coreBudget > 0 ? coreBudget : hardwareThreads())
+    , maxEngines_(Config::MAX_PARALLEL_ENGINES)
+    , pinning_(Pinning::None)
+    , decided_(false) {
+    layout_.threadsPerEngine = coreBudget_;
+}
+
+int ThreadScheduler::hardwareThreads() {
+    return std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+}
+
+const char* ThreadScheduler::pinningName(Pinning pinning) {
+    switch (pinning) {
+        case Pinning::Cores: return "cores";
+        case Pinning::NumaNodes: return "numa";
+        case Pinning::None: break;
+    }
+    return "none";
+}
+
+bool ThreadScheduler::parsePinning(const std::string& name, Pinning& pinning) {
+    if (name == "none") {
+        pinning = Pinning::None;
+    } else if (name == "cores") {
+        pinning = Pinning::Cores;
+    } else if (name == "numa") {
+        pinning = Pinning::NumaNodes;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+void ThreadScheduler::setMaxEngines(int maxEngines) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    maxEngines_ = std::max(1, maxEngines);
+    layout_ = clamp(layout_, coreBudget_, maxEngines_);
+}
+
+int ThreadScheduler::maxEngines() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return maxEngines_;
+}
+
+void ThreadScheduler::setPinning(Pinning pinning) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pinning_ = pinning;
+}
+
+ThreadScheduler::Pinning ThreadScheduler::pinning() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pinning_;
+}
+
+void ThreadScheduler::setLayout(Layout layout) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    layout_ = clamp(layout, coreBudget_, maxEngines_);
+    decided_ = true;
+    measurements_.clear();
+}
+
+void ThreadScheduler::setAuto() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    decided_ = false;
+    measurements_.clear();
+}
+
+bool ThreadScheduler::isDecided() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return decided_;
+}
+
+ThreadScheduler::Layout ThreadScheduler::layout() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return layout_;
+}
+
+std::vector<ThreadScheduler::Layout> ThreadScheduler::candidateLayouts() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<Layout> layouts;
+    int limit = std::min(coreBudget_, maxEngines_);
+    for (int engines = 1; engines <= limit; engines *= 2) {
+        layouts.push_back(clamp({engines, 0}, coreBudget_, maxEngines_));
+    }
+    // Always try one engine per thread (up to the limit), even off the power-of-two steps
+    if (layouts.back().engines != limit) {
+        layouts.push_back(clamp({limit, 0}, coreBudget_, maxEngines_));
+    }
+    return layouts;
+}
+
+ThreadScheduler::Layout ThreadScheduler::choose(const std::function<double(const Layout&)>& measure) {
+    std::vector<Measurement> results;
+    Measurement best;
+    for (const auto& candidate : candidateLayouts()) {
+        Measurement measurement{candidate, measure(candidate)};
+        results.push_back(measurement);
+        // Prefer fewer engines on a tie; they need less memory
+        if (results.size() == 1 || measurement.imagesPerSecond > best.imagesPerSecond) {
+            best = measurement;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    layout_ = best.layout;
+    decided_ = true;
+    measurements_ = std::move(results);
+    return layout_;
+}
+
+std::vector<ThreadScheduler::Measurement> ThreadScheduler::measurements() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return measurements_;
+}
+
+void ThreadScheduler::applyIntraOpThreads() const {
+    cv::setNumThreads(layout().threadsPerEngine);
+}
+
+bool ThreadScheduler::pinEngineThread(int engineIndex) const {
+    Layout current;
+    Pinning mode;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        current = layout_;
+        mode = pinning_;
+    }
+    if (mode == Pinning::None) {
+        return false;
+    }
+
+    int cpus = hardwareThreads();
+    int first = (engineIndex * current.threadsPerEngine) % cpus;
+    int count = std::min(current.threadsPerEngine, cpus);
+
+#ifdef _WIN32
+    return mode == Pinning::NumaNodes ? pinToNumaNode(engineIndex) : pinToMask(coreMask(first, count));
+#elif defined(__linux__)
+    if (mode == Pinning::NumaNodes) {
+        return pinToNumaNode(engineIndex);
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int i = 0; i < count; ++i) {
+        CPU_SET((first + i) % cpus, &set);
+    }
+    return pinToSet(set);
+#else
+    (void)first;
+    (void)count;
+    return false;
+#endif
+}
+
+ThreadScheduler::Layout ThreadScheduler::clamp(Layout layout, int coreBudget, int maxEngines) {
+    layout.engines = std::max(1, std::min({layout.engines, coreBudget, maxEngines}));
+    if (layout.threadsPerEngine <= 0) {
+        layout.threadsPerEngine = coreBudget / layout.engines;
+    }
+    layout.threadsPerEngine = std::max(1, std::min(layout.threadsPerEngine, coreBudget / layout.engines));
+    return layout;
+}
+
+} // namespace Core
+} // namespace YoloApp
@@ -0,0 +1,124 @@
+// src/core/thread_scheduler.h
+#pragma once
+
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace YoloApp {
+namespace Core {
+
+/**
+ * @brief Splits the core budget between parallel engines and OpenCV's intra-op threads
+ *
+ * A run uses either a few engines that each spread a forward pass over many
+ * threads, or many engines (one image each) with little intra-op threading,
+ * or something in between. The layout is either fixed or chosen by measuring
+ * every candidate on a sample of real images (see DetectionPipeline), so the
+ * two layers of parallelism never add up to more threads than the budget.
+ *
+ * OpenCV keeps a single process-wide thread pool, so every engine gets the
+ * same intra-op thread count and the engines share that pool. Pinning
+ * applies to the engine threads only: the pool's workers serve every engine
+ * and are left to the OS scheduler.
+ */
+class ThreadScheduler {
+public:
+    enum class Pinning {
+        None,
+        Cores,      ///< Engine i's thread runs on its own block of threadsPerEngine logical CPUs
+        NumaNodes   ///< Engine threads are spread round-robin over NUMA nodes
+    };
+
+    struct Layout {
+        int engines = 1;
+        int threadsPerEngine = 1;
+    };
+
+    struct Measurement {
+        Layout layout;
+        double imagesPerSecond = 0.0;
+    };
+
+    /**
+     * @param coreBudget Threads the run may use in total; 0 for all hardware threads
+     */
+    explicit ThreadScheduler(int coreBudget = 0);
+
+    static int hardwareThreads();
+    static const char* pinningName(Pinning pinning);
+    static bool parsePinning(const std::string& name, Pinning& pinning);
+
+    int coreBudget() const { return coreBudget_; }
+
+    /**
+     * @brief Upper bound on parallel engines; each holds its own copy of the network
+     */
+    void setMaxEngines(int maxEngines);
+    int maxEngines() const;
+
+    void setPinning(Pinning pinning);
+    Pinning pinning() const;
+
+    /**
+     * @brief Use a fixed layout; engines are clamped to the budget and maxEngines
+     * @param layout threadsPerEngine <= 0 divides the budget evenly
+     */
+    void setLayout(Layout layout);
+
+    /**
+     * @brief Forget the layout, so the next run measures the candidates again
+     */
+    void setAuto();
+
+    /**
+     * @brief Whether a layout is set (fixed or measured)
+     */
+    bool isDecided() const;
+    Layout layout() const;
+
+    /**
+     * @brief 1, 2, 4, ... engines up to the limit, each with an even share of the budget
+     */
+    std::vector<Layout> candidateLayouts() const;
+
+    /**
+     * @brief Measure each candidate and keep the fastest
+     * @param measure Images per second of a layout
+     */
+    Layout choose(const std::function<double(const Layout&)>& measure);
+
+    /**
+     * @brief Throughput of each candidate from the last choose()
+     */
+    std::vector<Measurement> measurements() const;
+
+    /**
+     * @brief Size OpenCV's thread pool for the current layout
+     */
+    void applyIntraOpThreads() const;
+
+    /**
+     * @brief Pin the calling thread as engine engineIndex according to pinning()
+     *
+     * Only the calling thread is pinned, not OpenCV's shared worker threads.
+     *
+     * @return false if pinning is off, unsupported on this platform or refused by the OS
+     */
+    bool pinEngineThread(int engineIndex) const;
+
+private:
+    static Layout clamp(Layout layout, int coreBudget, int maxEngines);
+
+    mutable std::mutex mutex_;
+    int coreBudget_;
+    int maxEngines_;
+    Pinning pinning_;
+    Layout layout_;
+    bool decided_;
+    std::vector<Measurement> measurements_;
+};
+
+} // namespace Core
+} // namespace YoloApp
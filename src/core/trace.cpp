@@ -0,0 +1,231 @@
+// src/core/trace.cpp
+#include "trace.h"
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace YoloApp {
+namespace Core {
+
+namespace {
+
+std::atomic<bool> g_enabled{false};
+
+constexpr size_t BUFFER_CAPACITY = size_t(1) << 15;   // Spans kept per thread (1 MB)
+constexpr size_t BUFFER_MASK = BUFFER_CAPACITY - 1;
+
+struct Event {
+    const char* name;
+    uint64_t start;
+    uint64_t end;
+    uint32_t threadId;
+};
+
+/**
+ * @brief Single-writer ring of spans
+ *
+ * Only the owning thread writes; written is published with release order so
+ * a reader sees complete events up to it. Buffers of exited threads are
+ * handed to new threads with their events intact (each event carries its
+ * thread id), so memory is bounded by the peak number of live threads.
+ */
+struct ThreadBuffer {
+    std::unique_ptr<Event[]> events{new Event[BUFFER_CAPACITY]};
+    std::atomic<uint64_t> written{0};
+    std::atomic<uint64_t> clearedAt{0};
+    uint32_t threadId = 0;
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+    std::vector<ThreadBuffer*> freeBuffers;
+    std::map<uint32_t, std::string> threadNames;
+    uint32_t nextThreadId = 1;
+
+    // Tick to wall clock mapping, taken at startup and again at dump time
+    uint64_t epochTicks = Trace::now();
+    std::chrono::steady_clock::time_point epochTime = std::chrono::steady_clock::now();
+};
+
+Registry& registry() {
+    static Registry* instance = new Registry();  // Never destroyed: threads may record during exit
+    return *instance;
+}
+
+/**
+ * @brief Gives the calling thread a buffer and returns it on thread exit
+ */
+struct ThreadSlot {
+    ThreadBuffer* buffer = nullptr;
+
+    ThreadBuffer* acquire() {
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        if (!r.freeBuffers.empty()) {
+            buffer = r.freeBuffers.back();
+            r.freeBuffers.pop_back();
+        } else {
+            r.buffers.push_back(std::make_unique<ThreadBuffer>());
+            buffer = r.buffers.back().get();
+        }
+        buffer->threadId = r.nextThreadId++;
+        return buffer;
+    }
+
+    ~ThreadSlot() {
+        if (buffer) {
+            Registry& r = registry();
+            std::lock_guard<std::mutex> lock(r.mutex);
+            r.freeBuffers.push_back(buffer);
+        }
+    }
+};
+
+thread_local ThreadSlot t_slot;
+
+ThreadBuffer& threadBuffer() {
+    return t_slot.buffer ? *t_slot.buffer : *t_slot.acquire();
+}
+
+void writeJsonString(std::ostream& out, const std::string& text) {
+    out << '"';
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            out << '\\' << c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            out << ' ';
+        } else {
+            out << c;
+        }
+    }
+    out << '"';
+}
+
+} // namespace
+
+bool Trace::isEnabled() {
+    return g_enabled.load(std::memory_order_relaxed);
+}
+
+void Trace::setEnabled(bool enabled) {
+    g_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void Trace::record(const char* name, uint64_t startTicks, uint64_t endTicks) {
+    ThreadBuffer& buffer = threadBuffer();
+    uint64_t index = buffer.written.load(std::memory_order_relaxed);
+    Event& event = buffer.events[index & BUFFER_MASK];
+    event.name = name;
+    event.start = startTicks;
+    event.end = endTicks;
+    event.threadId = buffer.threadId;
+    buffer.written.store(index + 1, std::memory_order_release);
+}
+
+void Trace::setThreadName(const std::string& name) {
+    ThreadBuffer& buffer = threadBuffer();
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    r.threadNames[buffer.threadId] = name;
+}
+
+void Trace::clear() {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    for (const auto& buffer : r.buffers) {
+        buffer->clearedAt.store(buffer->written.load(std::memory_order_acquire), std::memory_order_relaxed);
+    }
+}
+
+size_t Trace::eventCount() {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    size_t count = 0;
+    for (const auto& buffer : r.buffers) {
+        uint64_t written = buffer->written.load(std::memory_order_acquire);
+        uint64_t first = std::max(buffer->clearedAt.load(std::memory_order_relaxed),
+                                  written > BUFFER_CAPACITY ? written - BUFFER_CAPACITY : 0);
+        count += static_cast<size_t>(written - first);
+    }
+    return count;
+}
+
+void Trace::writeChromeJson(const std::string& path) {
+    Registry& r = registry();
+    std::vector<Event> events;
+    std::map<uint32_t, std::string> threadNames;
+    double ticksPerMicrosecond = 1000.0;
+    {
+        std::lock_guard<std::mutex> lock(r.mutex);
+        for (const auto& buffer : r.buffers) {
+            uint64_t written = buffer->written.load(std::memory_order_acquire);
+            uint64_t first = std::max(buffer->clearedAt.load(std::memory_order_relaxed),
+                                      written > BUFFER_CAPACITY ? written - BUFFER_CAPACITY : 0);
+            size_t copiedFrom = events.size();
+            for (uint64_t i = first; i < written; ++i) {
+                events.push_back(buffer->events[i & BUFFER_MASK]);
+            }
+
+            // The owner may have wrapped over the oldest copied slots meanwhile
+            uint64_t writtenAfter = buffer->written.load(std::memory_order_acquire);
+            if (writtenAfter >= first + BUFFER_CAPACITY) {
+                uint64_t stale = std::min<uint64_t>(written - first, writtenAfter + 1 - BUFFER_CAPACITY - first);
+                events.erase(events.begin() + copiedFrom, events.begin() + copiedFrom + stale);
+            }
+        }
+        threadNames = r.threadNames;
+
+#ifdef YOLO_TRACE_TSC
+        double elapsedUs = std::chrono::duration<double, std::micro>(
+            std::chrono::steady_clock::now() - r.epochTime).count();
+        uint64_t elapsedTicks = now() - r.epochTicks;
+        if (elapsedUs > 0.0 && elapsedTicks > 0) {
+            ticksPerMicrosecond = elapsedTicks / elapsedUs;
+        }
+#endif
+    }
+
+    std::sort(events.begin(), events.end(), [](const Event& a, const Event& b) {
+        return a.start < b.start;
+    });
+
+    std::ofstream out(path, std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("Cannot write trace: " + path);
+    }
+    out.setf(std::ios::fixed);
+    out.precision(3);
+
+    out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n";
+    bool first = true;
+    for (const auto& thread : threadNames) {
+        out << (first ? "" : ",\n") << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": "
+            << thread.first << ", \"args\": {\"name\": ";
+        writeJsonString(out, thread.second);
+        out << "}}";
+        first = false;
+    }
+    for (const Event& event : events) {
+        double ts = static_cast<double>(static_cast<int64_t>(event.start - r.epochTicks)) / ticksPerMicrosecond;
+        double dur = static_cast<double>(event.end - event.start) / ticksPerMicrosecond;
+        out << (first ? "" : ",\n") << "{\"name\": ";
+        writeJsonString(out, event.name);
+        out << ", \"ph\": \"X\", \"pid\": 1, \"tid\": " << event.threadId
+            << ", \"ts\": " << ts << ", \"dur\": " << dur << "}";
+        first = false;
+    }
+    out << "\n]}\n";
+
+    if (!out) {
+        throw std::runtime_error("Cannot write trace: " + path);
+    }
+}
+
+} // namespace Core
+} // namespace YoloApp
@@ -24,15 +24,35 @@ struct Detection {
         : boundingBox(bbox), confidence(conf), classId(id), className(name) {}
 };
 
+/**
+ * @brief Where the time of one image went, in microseconds
+ *
+ * Filled while the image is processed; all zero for results reopened from a
+ * session. The decoded dimensions are ImageResult::imageSize.
+ */
+struct ImageTiming {
+    uint32_t decodeMicros = 0;
+    uint32_t preprocessMicros = 0;
+    uint32_t inferenceMicros = 0;
+    uint32_t postprocessMicros = 0;     // Box decoding and NMS
+    uint32_t totalMicros = 0;           // End to end, including annotation and metadata
+    uint32_t candidates = 0;            // Boxes above the confidence threshold going into NMS
+    uint64_t fileBytes = 0;
+
+    bool isRecorded() const { return totalMicros > 0; }
+};
+
 /**
  * @brief Contains results for a single image
  */
 struct ImageResult {
     std::string imagePath;
+    cv::Size imageSize;     // Known once processed, even if the pixels are released
     std::vector<Detection> detections;
     cv::Mat originalImage;
     cv::Mat annotatedImage;
     std::string metadata;
+    ImageTiming timing;
     bool processed = false;
     
     ImageResult() = default;
@@ -70,10 +90,23 @@ struct DetectionConfig {
     int inputHeight = 640;
     std::vector<std::string> targetClasses; // Empty means all classes
     
+    // Sliced inference: frames larger than the input are cut into overlapping
+    // input-sized tiles at full resolution, so small objects stay visible
+    bool tiledInference = false;
+    float tileOverlap = 0.2f;           // Share of the tile edge shared with its neighbor
+    bool tileFullFrame = true;          // Also detect on the whole frame, for objects larger than a tile
+    bool tileWeightedFusion = false;    // Merge tile boxes by weighted box fusion instead of NMS
+    
+    // Rectangular inference: the input keeps the image's aspect ratio within
+    // inputWidth x inputHeight, rounded up to the network stride, instead of
+    // stretching every image to the full square
+    bool rectInference = false;
+    
     bool isValid() const {
         return confidenceThreshold > 0.0f && confidenceThreshold <= 1.0f &&
                nmsThreshold > 0.0f && nmsThreshold <= 1.0f &&
-               inputWidth > 0 && inputHeight > 0;
+               inputWidth > 0 && inputHeight > 0 &&
+               tileOverlap >= 0.0f && tileOverlap < 1.0f;
     }
 };
 
@@ -1,6 +1,7 @@
 // src/main.cpp
 #include "ui/main_window.h"
 #include "core/config.h"
+#include "cli/batch_runner.h"
 #include <QApplication>
 #include <QStyleFactory>
 #include <QDir>
@@ -8,9 +9,17 @@
 #include <QMessageBox>
 #include <QCommandLineParser>
 #include <QCommandLineOption>
+#include <cstring>
 #include <iostream>
 
 int main(int argc, char *argv[]) {
+    // Headless batch mode never creates a QApplication, so no display is needed
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--headless") == 0) {
+            return YoloApp::Cli::BatchRunner::main(argc, argv);
+        }
+    }
+    
     QApplication app(argc, argv);
     
     // Set application properties
@@ -37,6 +46,10 @@ int main(int argc, char *argv[]) {
                                       "Start processing automatically");
     parser.addOption(autoStartOption);
     
+    QCommandLineOption headlessOption("headless",
+                                     "Run detection without a GUI (see --headless --help)");
+    parser.addOption(headlessOption);
+    
     parser.process(app);
     
     // Set application style
@@ -67,8 +80,7 @@ int main(int argc, char *argv[]) {
     if (parser.isSet(modelOption)) {
         QString modelPath = parser.value(modelOption);
         if (QFile::exists(modelPath)) {
-            // Load model (would need to add public method to MainWindow)
-            std::cout << "Loading model: " << modelPath.toStdString() << std::endl;
+            window.loadModel(modelPath);
         } else {
             QMessageBox::warning(&window, "Error", "Model file not found: " + modelPath);
         }
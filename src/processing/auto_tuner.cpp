@@ -0,0 +1,287 @@
+// src/processing/auto_tuner.cpp
+#include "auto_tuner.h"
+#include "image_processor.h"
+#include "../core/detection_metrics.h"
+#include "../core/trace.h"
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+namespace YoloApp {
+namespace Processing {
+
+namespace {
+
+// Share of the progress bar for decoding the samples and the reference pass
+constexpr int DECODE_PROGRESS_PERCENT = 10;
+constexpr int REFERENCE_PROGRESS_PERCENT = 25;
+
+} // namespace
+
+AutoTuner::AutoTuner(std::shared_ptr<Core::IDetector> detector, Options options)
+    : detector_(std::move(detector))
+    , options_(std::move(options))
+    , cancelled_(nullptr) {
+}
+
+void AutoTuner::setProgressCallback(ProgressCallback callback) {
+    progressCallback_ = std::move(callback);
+}
+
+void AutoTuner::setCancellationFlag(const std::atomic<bool>* cancelled) {
+    cancelled_ = cancelled;
+}
+
+std::vector<std::string> AutoTuner::sampleImages(const std::vector<Core::FolderResult>& folders, size_t count) {
+    std::vector<std::string> paths;
+    for (const auto& folder : folders) {
+        for (const auto& image : folder.images) {
+            paths.push_back(image->imagePath);
+        }
+    }
+    if (paths.size() <= count) {
+        return paths;
+    }
+
+    // Every n-th image, so long sequences from one camera do not dominate
+    std::vector<std::string> samples;
+    samples.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        samples.push_back(paths[i * paths.size() / count]);
+    }
+    return samples;
+}
+
+AutoTuner::Result AutoTuner::run(const std::vector<std::string>& imagePaths) {
+    if (!detector_ || !detector_->isLoaded()) {
+        throw std::runtime_error("Detector not loaded");
+    }
+
+    YOLO_TRACE_SPAN("auto tune");
+    Result result;
+    result.referenceSize = options_.referenceSize;
+    int previousThreads = cv::getNumThreads();
+
+    // Decoded once; larger frames are reduced to the reference size, which
+    // no candidate exceeds, so a few hundred samples fit in memory
+    samples_.clear();
+    for (size_t i = 0; i < imagePaths.size() && !isCancelled(); ++i) {
+        reportProgress(static_cast<int>(i * DECODE_PROGRESS_PERCENT / imagePaths.size()), "Reading sample images");
+        try {
+            cv::Mat image = ImageProcessor::loadImage(imagePaths[i]);
+            double scale = static_cast<double>(options_.referenceSize) / std::max(image.cols, image.rows);
+            if (scale < 1.0) {
+                cv::resize(image, image, cv::Size(), scale, scale, cv::INTER_AREA);
+            }
+            samples_.push_back(std::move(image));
+        } catch (const std::exception&) {
+            // Unreadable samples are skipped
+        }
+    }
+    result.sampleImages = samples_.size();
+    if (samples_.empty() && !isCancelled()) {
+        throw std::runtime_error("None of the sample images could be read");
+    }
+
+    Core::ThreadScheduler scheduler(options_.coreBudget);
+    std::vector<Core::ThreadScheduler::Layout> layouts = scheduler.candidateLayouts();
+    if (!options_.tuneLayout) {
+        layouts = {{1, scheduler.coreBudget()}};
+    }
+    std::vector<int> inputSizes = options_.inputSizes;
+    inputSizes.erase(std::remove_if(inputSizes.begin(), inputSizes.end(),
+                                    [this](int size) { return size <= 0 || size > options_.referenceSize; }),
+                     inputSizes.end());
+
+    size_t engineCount = 1;
+    for (const auto& layout : layouts) {
+        engineCount = std::max(engineCount, static_cast<size_t>(layout.engines));
+    }
+    engines_.clear();
+    for (size_t i = 0; i < engineCount && !isCancelled(); ++i) {
+        reportProgress(DECODE_PROGRESS_PERCENT, "Copying the model");
+        std::shared_ptr<Core::IDetector> engine = detector_->clone();
+        if (!engine) {
+            throw std::runtime_error("The model could not be loaded a second time");
+        }
+        engines_.push_back(std::move(engine));
+    }
+
+    // Reference: one engine with every thread at the largest input size
+    std::vector<std::vector<Core::Detection>> reference(samples_.size());
+    if (!isCancelled()) {
+        reportProgress(DECODE_PROGRESS_PERCENT, "Detecting the reference at " + std::to_string(options_.referenceSize));
+        Core::DetectionConfig config = detector_->getConfig();
+        config.inputWidth = options_.referenceSize;
+        config.inputHeight = options_.referenceSize;
+        engines_.front()->setConfig(config);
+        cv::setNumThreads(scheduler.coreBudget());
+        std::string error;
+        detectSamples(1, reference, error);
+
+        // Every trial is scored against the reference; without it there is nothing to compare
+        if (!error.empty()) {
+            cv::setNumThreads(previousThreads);
+            samples_.clear();
+            engines_.clear();
+            throw std::runtime_error("Detection failed at the reference size of " +
+                                     std::to_string(options_.referenceSize) + " px: " + error);
+        }
+    }
+
+    size_t trialCount = inputSizes.size() * layouts.size();
+    for (size_t sizeIndex = 0; sizeIndex < inputSizes.size() && !isCancelled(); ++sizeIndex) {
+        Core::DetectionConfig config = detector_->getConfig();
+        config.inputWidth = inputSizes[sizeIndex];
+        config.inputHeight = inputSizes[sizeIndex];
+        std::string error;
+        std::vector<Core::Detection> warmUpDetections;
+        for (auto& engine : engines_) {
+            engine->setConfig(config);
+            // Keep the reshape of the first forward at this size out of the timing
+            error = detectOne(*engine, samples_.front(), warmUpDetections);
+            if (!error.empty()) {
+                break;
+            }
+        }
+
+        // Trials of a size are kept only if no detection at that size failed
+        Core::DetectionMetrics agreement;
+        std::vector<Trial> sizeTrials;
+        for (size_t layoutIndex = 0; layoutIndex < layouts.size() && error.empty() && !isCancelled(); ++layoutIndex) {
+            const auto& layout = layouts[layoutIndex];
+            size_t done = sizeIndex * layouts.size() + layoutIndex;
+            reportProgress(REFERENCE_PROGRESS_PERCENT +
+                           static_cast<int>(done * (100 - REFERENCE_PROGRESS_PERCENT) / trialCount),
+                           "Timing " + std::to_string(inputSizes[sizeIndex]) + " px, " +
+                           std::to_string(layout.engines) + " x " + std::to_string(layout.threadsPerEngine) +
+                           " threads");
+
+            cv::setNumThreads(layout.threadsPerEngine);
+            std::vector<std::vector<Core::Detection>> detections(samples_.size());
+            Trial trial;
+            trial.inputSize = inputSizes[sizeIndex];
+            trial.layout = layout;
+            trial.imagesPerSecond = detectSamples(static_cast<size_t>(layout.engines), detections, error);
+            if (isCancelled() || !error.empty()) {
+                break;
+            }
+
+            // The layout does not change the boxes; compare once per input size
+            if (layoutIndex == 0) {
+                for (size_t i = 0; i < samples_.size(); ++i) {
+                    agreement.addImage(reference[i], detections[i]);
+                }
+            }
+            trial.meanAveragePrecision = agreement.meanAveragePrecision(0.5f);
+            trial.recall = agreement.recall(0.5f);
+            sizeTrials.push_back(trial);
+        }
+
+        if (!error.empty()) {
+            result.failedSizes.push_back(std::to_string(inputSizes[sizeIndex]) + " px: " + error);
+        } else {
+            result.trials.insert(result.trials.end(), sizeTrials.begin(), sizeTrials.end());
+        }
+    }
+
+    cv::setNumThreads(previousThreads);
+    samples_.clear();
+    engines_.clear();
+
+    result.cancelled = isCancelled();
+    if (!result.cancelled && result.trials.empty() && !result.failedSizes.empty()) {
+        throw std::runtime_error("Detection failed at every input size; first: " + result.failedSizes.front());
+    }
+    markParetoFront(result.trials);
+    result.recommended = recommend(result.trials, options_.minAgreement);
+    reportProgress(100, result.cancelled ? "Cancelled" : "Done");
+    return result;
+}
+
+double AutoTuner::detectSamples(size_t engines, std::vector<std::vector<Core::Detection>>& detections,
+                                std::string& error) {
+    std::atomic<size_t> nextSample{0};
+    std::atomic<bool> failed{false};
+    std::mutex errorMutex;
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> threads;
+    for (size_t engineIndex = 0; engineIndex < engines; ++engineIndex) {
+        threads.emplace_back([this, engineIndex, &nextSample, &detections, &failed, &errorMutex, &error]() {
+            Core::IDetector& engine = *engines_[engineIndex];
+            for (size_t sample = nextSample++; sample < samples_.size() && !failed && !isCancelled();
+                 sample = nextSample++) {
+                std::string sampleError = detectOne(engine, samples_[sample], detections[sample]);
+                if (!sampleError.empty()) {
+                    std::lock_guard<std::mutex> lock(errorMutex);
+                    if (error.empty()) {
+                        error = sampleError;
+                    }
+                    failed = true;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return seconds > 0.0 ? samples_.size() / seconds : 0.0;
+}
+
+std::string AutoTuner::detectOne(Core::IDetector& engine, const cv::Mat& image,
+                                 std::vector<Core::Detection>& detections) {
+    try {
+        detections = engine.detectObjects(image);
+        return engine.lastDetectionError();
+    } catch (const std::exception& e) {
+        return e.what();
+    }
+}
+
+void AutoTuner::markParetoFront(std::vector<Trial>& trials) {
+    for (auto& trial : trials) {
+        trial.paretoOptimal = std::none_of(trials.begin(), trials.end(), [&trial](const Trial& other) {
+            return other.imagesPerSecond >= trial.imagesPerSecond &&
+                   other.meanAveragePrecision >= trial.meanAveragePrecision &&
+                   (other.imagesPerSecond > trial.imagesPerSecond ||
+                    other.meanAveragePrecision > trial.meanAveragePrecision);
+        });
+    }
+}
+
+int AutoTuner::recommend(const std::vector<Trial>& trials, double minAgreement) {
+    int fastest = -1;
+    int mostAccurate = -1;
+    for (size_t i = 0; i < trials.size(); ++i) {
+        const Trial& trial = trials[i];
+        if (!trial.paretoOptimal) {
+            continue;
+        }
+        if (trial.meanAveragePrecision >= minAgreement &&
+            (fastest < 0 || trial.imagesPerSecond > trials[fastest].imagesPerSecond)) {
+            fastest = static_cast<int>(i);
+        }
+        if (mostAccurate < 0 || trial.meanAveragePrecision > trials[mostAccurate].meanAveragePrecision) {
+            mostAccurate = static_cast<int>(i);
+        }
+    }
+    return fastest >= 0 ? fastest : mostAccurate;
+}
+
+void AutoTuner::reportProgress(int percent, const std::string& step) {
+    if (progressCallback_) {
+        progressCallback_(percent, step);
+    }
+}
+
+bool AutoTuner::isCancelled() const {
+    return cancelled_ && cancelled_->load();
+}
+
+} // namespace Processing
+} // namespace YoloApp
@@ -0,0 +1,117 @@
+// src/processing/auto_tuner.h
+#pragma once
+
+#include "../core/types.h"
+#include "../core/config.h"
+#include "../core/detector.h"
+#include "../core/thread_scheduler.h"
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace YoloApp {
+namespace Processing {
+
+/**
+ * @brief Sweeps input size and thread layout for a model on sample images
+ *
+ * The samples are decoded once and detected at a high reference input size;
+ * every candidate (input size x thread layout) is then timed on the same
+ * samples and its detections are compared to the reference with
+ * DetectionMetrics. The candidates on the Pareto front of throughput and
+ * agreement are marked, and the fastest one that still agrees well enough
+ * is recommended. An input size at which any detection fails is dropped
+ * from the trials (see Result::failedSizes) rather than timed as if the
+ * failed images had no objects.
+ *
+ * The loaded detector itself is never touched: all detection runs on
+ * clones, so the tuner can run while the detector is idle in the GUI.
+ */
+class AutoTuner {
+public:
+    using ProgressCallback = std::function<void(int percent, const std::string& step)>;
+
+    struct Options {
+        std::vector<int> inputSizes = Config::AUTO_TUNE_INPUT_SIZES;  ///< Square input edges to try
+        int referenceSize = Config::AUTO_TUNE_REFERENCE_SIZE;
+        double minAgreement = Config::AUTO_TUNE_MIN_AGREEMENT;        ///< mAP@0.5 a recommendation must reach
+        int coreBudget = 0;         ///< Threads for the layouts, 0 for all hardware threads
+        bool tuneLayout = true;     ///< false times one engine with the whole budget only
+    };
+
+    struct Trial {
+        int inputSize = 0;
+        Core::ThreadScheduler::Layout layout;
+        double imagesPerSecond = 0.0;
+        double meanAveragePrecision = 0.0;  ///< mAP@0.5 against the reference
+        double recall = 0.0;                ///< Share of reference boxes found at IoU 0.5
+        bool paretoOptimal = false;
+    };
+
+    struct Result {
+        std::vector<Trial> trials;
+        int recommended = -1;       ///< Index into trials, -1 if none ran
+        size_t sampleImages = 0;    ///< Samples that could be decoded
+        int referenceSize = 0;
+        std::vector<std::string> failedSizes;   ///< Input sizes dropped after a failed detection, with the reason
+        bool cancelled = false;
+    };
+
+    AutoTuner(std::shared_ptr<Core::IDetector> detector, Options options);
+
+    void setProgressCallback(ProgressCallback callback);
+    void setCancellationFlag(const std::atomic<bool>* cancelled);
+
+    /**
+     * @brief Up to count image paths spread evenly over all scanned folders
+     */
+    static std::vector<std::string> sampleImages(const std::vector<Core::FolderResult>& folders,
+                                                 size_t count = Config::AUTO_TUNE_SAMPLE_IMAGES);
+
+    /**
+     * @brief Run the sweep on these images
+     * @throws std::runtime_error if the detector is not loaded, cannot be
+     *         copied, none of the images can be read, or detection fails at
+     *         the reference size or at every input size
+     */
+    Result run(const std::vector<std::string>& imagePaths);
+
+    /**
+     * @brief Flag the trials that no other trial beats on both throughput and agreement
+     */
+    static void markParetoFront(std::vector<Trial>& trials);
+
+    /**
+     * @brief Fastest Pareto-optimal trial reaching minAgreement, else the most accurate one
+     * @return Index into trials, -1 if empty
+     */
+    static int recommend(const std::vector<Trial>& trials, double minAgreement);
+
+private:
+    /**
+     * @return Images per second; on a failed detection error holds the first reason and the rest is skipped
+     */
+    double detectSamples(size_t engines, std::vector<std::vector<Core::Detection>>& detections, std::string& error);
+
+    /**
+     * @brief Detect one image, returning why it failed or an empty string
+     */
+    static std::string detectOne(Core::IDetector& engine, const cv::Mat& image,
+                                 std::vector<Core::Detection>& detections);
+
+    void reportProgress(int percent, const std::string& step);
+    bool isCancelled() const;
+
+    std::shared_ptr<Core::IDetector> detector_;
+    Options options_;
+    ProgressCallback progressCallback_;
+    const std::atomic<bool>* cancelled_;
+
+    std::vector<cv::Mat> samples_;
+    std::vector<std::shared_ptr<Core::IDetector>> engines_;
+};
+
+} // namespace Processing
+} // namespace YoloApp
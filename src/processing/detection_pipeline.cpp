@@ -0,0 +1,435 @@
+// src/processing/detection_pipeline.cpp
+#include "detection_pipeline.h"
+#include "folder_scanner.h"
+#include "image_processor.h"
+#include "../core/config.h"
+#include "../core/trace.h"
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <mutex>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+
+namespace YoloApp {
+namespace Processing {
+
+DetectionPipeline::DetectionPipeline(std::shared_ptr<Core::IDetector> detector, Options options)
+    : DetectionPipeline(std::make_shared<Core::EngineHandle>(std::move(detector)), options) {
+}
+
+DetectionPipeline::DetectionPipeline(std::shared_ptr<Core::EngineHandle> engine, Options options)
+    : engine_(std::move(engine))
+    , options_(options)
+    , cancelled_(nullptr) {
+}
+
+DetectionPipeline::~DetectionPipeline() {
+    {
+        std::lock_guard<std::mutex> lock(engineMutex_);
+        stopping_ = true;
+    }
+    engineWake_.notify_all();
+    for (auto& thread : engineThreads_) {
+        thread.join();
+    }
+}
+
+void DetectionPipeline::setCallbacks(Callbacks callbacks) {
+    callbacks_ = std::move(callbacks);
+}
+
+void DetectionPipeline::setCancellationFlag(const std::atomic<bool>* cancelled) {
+    cancelled_ = cancelled;
+}
+
+void DetectionPipeline::setClassIndex(std::shared_ptr<Core::ClassIndex> classIndex) {
+    classIndex_ = std::move(classIndex);
+}
+
+void DetectionPipeline::setMetrics(std::shared_ptr<Core::PipelineMetrics> metrics) {
+    metrics_ = std::move(metrics);
+}
+
+void DetectionPipeline::setScheduler(std::shared_ptr<Core::ThreadScheduler> scheduler) {
+    scheduler_ = std::move(scheduler);
+    if (scheduler_) {
+        scheduler_->applyIntraOpThreads();
+    }
+}
+
+std::vector<Core::FolderResult> DetectionPipeline::scan(const std::string& rootPath) {
+    std::shared_ptr<Core::IDetector> detector = engine_ ? engine_->acquire() : nullptr;
+    if (!detector || !detector->isLoaded()) {
+        throw std::runtime_error("Detector not loaded");
+    }
+
+    YOLO_TRACE_SPAN("scan");
+    FolderScanner scanner;
+    if (callbacks_.scanProgress) {
+        scanner.setProgressCallback([this](int current, int total, const std::string& currentPath) {
+            if (!isCancelled()) {
+                callbacks_.scanProgress(current, total, currentPath);
+            }
+        });
+    }
+    std::vector<Core::FolderResult> folders = scanner.scanForImages(rootPath, options_.recursive);
+
+    if (metrics_) {
+        int64_t images = 0;
+        for (const auto& folder : folders) {
+            images += static_cast<int64_t>(folder.images.size());
+        }
+        metrics_->setQueueDepth(Core::PipelineMetrics::Queue::PendingImages, images);
+    }
+    return folders;
+}
+
+void DetectionPipeline::calibrate(const std::vector<Core::FolderResult>& folders) {
+    if (!scheduler_ || scheduler_->isDecided()) {
+        return;
+    }
+
+    YOLO_TRACE_SPAN("calibrate");
+    std::vector<cv::Mat> samples;
+    for (const auto& folder : folders) {
+        for (const auto& image : folder.images) {
+            if (samples.size() >= static_cast<size_t>(Config::CALIBRATION_SAMPLE_IMAGES) || isCancelled()) {
+                break;
+            }
+            try {
+                samples.push_back(ImageProcessor::loadImage(image->imagePath));
+            } catch (const std::exception&) {
+                // Unreadable images fail again, and are reported, in the real run
+            }
+        }
+    }
+    if (samples.empty() || isCancelled()) {
+        return;
+    }
+
+    // Copies are made up front so loading them is not part of any measurement
+    std::vector<Core::ThreadScheduler::Layout> candidates = scheduler_->candidateLayouts();
+    size_t maxEngines = static_cast<size_t>(candidates.back().engines);
+    engineSlots_.resize(std::max(engineSlots_.size(), maxEngines));
+    for (size_t engineIndex = 1; engineIndex < maxEngines; ++engineIndex) {
+        engineFor(engineIndex);
+    }
+
+    scheduler_->choose([this, &samples](const Core::ThreadScheduler::Layout& layout) {
+        if (isCancelled()) {
+            return 0.0;
+        }
+        cv::setNumThreads(layout.threadsPerEngine);
+
+        std::atomic<size_t> nextSample{0};
+        std::atomic<size_t> detected{0};
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> engines;
+        for (int engineIndex = 0; engineIndex < layout.engines; ++engineIndex) {
+            engines.emplace_back([this, &samples, &nextSample, &detected, engineIndex]() {
+                std::shared_ptr<Core::IDetector> detector = engineFor(static_cast<size_t>(engineIndex));
+                if (!detector) {
+                    return;
+                }
+                for (size_t sample = nextSample++; sample < samples.size(); sample = nextSample++) {
+                    try {
+                        detector->detectObjects(samples[sample]);
+                        ++detected;
+                    } catch (const std::exception&) {
+                    }
+                }
+            });
+        }
+        for (auto& engine : engines) {
+            engine.join();
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return seconds > 0.0 ? static_cast<double>(detected.load()) / seconds : 0.0;
+    });
+    if (isCancelled()) {
+        scheduler_->setAuto();  // A partial measurement must not stick
+    }
+    scheduler_->applyIntraOpThreads();
+}
+
+void DetectionPipeline::processFolder(size_t folderIndex, Core::FolderResult& folder) {
+    // Stage timers in the detector and image processor report to this run's metrics
+    Core::PipelineMetrics::Binding metricsBinding(metrics_.get());
+    if (metrics_) {
+        metrics_->beginFolder(folder.folderName);
+    }
+
+    std::vector<size_t> order = processingOrder(folder);
+    size_t engines = engineCount(folder.images.size());
+    if (engines > 1) {
+        processFolderParallel(folderIndex, folder, order, engines);
+    } else {
+        for (size_t imageIndex : order) {
+            if (isCancelled()) {
+                break;
+            }
+            std::string error;
+            bool succeeded = processImage(folder.images[imageIndex], error);
+            completeImage(folderIndex, imageIndex, *folder.images[imageIndex], succeeded, error);
+        }
+    }
+
+    folder.updateCounts();
+    folder.processed = true;
+    if (metrics_) {
+        metrics_->endFolder();
+    }
+
+    if (callbacks_.folderCompleted) {
+        callbacks_.folderCompleted(folderIndex, folder);
+    }
+}
+
+void DetectionPipeline::processFolderParallel(size_t folderIndex, Core::FolderResult& folder,
+                                              const std::vector<size_t>& order, size_t engines) {
+    std::mutex mutex;
+    std::condition_variable completed;
+    std::deque<Completion> completions;
+    size_t running = engines;
+    std::atomic<size_t> nextImage{0};
+
+    engineSlots_.resize(std::max(engineSlots_.size(), engines));
+    startEngineThreads(engines);
+    {
+        std::lock_guard<std::mutex> lock(engineMutex_);
+        engineJob_ = [&](size_t engineIndex) {
+            Core::PipelineMetrics::Binding metricsBinding(metrics_.get());
+
+            // An engine whose copy cannot be made leaves its share to the others
+            while (!isCancelled() && (engineIndex == 0 || engineFor(engineIndex))) {
+                size_t position = nextImage++;
+                if (position >= order.size()) {
+                    break;
+                }
+                size_t imageIndex = order[position];
+                Completion completion;
+                completion.imageIndex = imageIndex;
+                completion.succeeded = processImageWith(folder.images[imageIndex], engineIndex, completion.error);
+
+                std::lock_guard<std::mutex> lock(mutex);
+                completions.push_back(std::move(completion));
+                completed.notify_one();
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            --running;
+            completed.notify_one();
+        };
+        jobEngines_ = engines;
+        ++jobGeneration_;
+    }
+    engineWake_.notify_all();
+
+    // Callbacks, the class index and metrics bookkeeping stay on this thread
+    std::unique_lock<std::mutex> lock(mutex);
+    while (running > 0 || !completions.empty()) {
+        completed.wait(lock, [&]() { return running == 0 || !completions.empty(); });
+        std::deque<Completion> ready;
+        ready.swap(completions);
+        lock.unlock();
+        for (const auto& completion : ready) {
+            completeImage(folderIndex, completion.imageIndex, *folder.images[completion.imageIndex],
+                          completion.succeeded, completion.error);
+        }
+        lock.lock();
+    }
+    lock.unlock();
+
+    // Every engine of the job is done with it; the captured locals go out of scope next
+    std::lock_guard<std::mutex> jobLock(engineMutex_);
+    engineJob_ = nullptr;
+}
+
+void DetectionPipeline::startEngineThreads(size_t engines) {
+    if (engineThreads_.size() >= engines) {
+        return;
+    }
+
+    // OpenCV's pool threads are created by the first parallel call after the
+    // pool is sized and inherit the affinity of the calling thread; create
+    // them here, unpinned, so they are not confined to one engine's cores
+    cv::parallel_for_(cv::Range(0, std::max(1, cv::getNumThreads())), [](const cv::Range&) {});
+
+    // New threads skip jobs posted before they started
+    for (size_t engineIndex = engineThreads_.size(); engineIndex < engines; ++engineIndex) {
+        engineThreads_.emplace_back(&DetectionPipeline::engineThreadMain, this, engineIndex, jobGeneration_);
+    }
+}
+
+void DetectionPipeline::engineThreadMain(size_t engineIndex, uint64_t startGeneration) {
+    Core::Trace::setThreadName("engine " + std::to_string(engineIndex));
+    if (scheduler_) {
+        scheduler_->pinEngineThread(static_cast<int>(engineIndex));
+    }
+
+    uint64_t seenGeneration = startGeneration;
+    std::unique_lock<std::mutex> lock(engineMutex_);
+    while (true) {
+        engineWake_.wait(lock, [&]() { return stopping_ || jobGeneration_ != seenGeneration; });
+        if (stopping_) {
+            return;
+        }
+        seenGeneration = jobGeneration_;
+        if (engineIndex >= jobEngines_) {
+            continue;
+        }
+
+        // The job stays valid until every engine below jobEngines_ has run it
+        std::function<void(size_t)> job = engineJob_;
+        lock.unlock();
+        job(engineIndex);
+        lock.lock();
+    }
+}
+
+void DetectionPipeline::completeImage(size_t folderIndex, size_t imageIndex, const Core::ImageResult& image,
+                                      bool succeeded, const std::string& error) {
+    if (metrics_) {
+        metrics_->markImageCompleted(image);
+        metrics_->addQueueDepth(Core::PipelineMetrics::Queue::PendingImages, -1);
+    }
+
+    if (succeeded) {
+        if (classIndex_) {
+            classIndex_->addImage(static_cast<uint32_t>(folderIndex),
+                                  static_cast<uint32_t>(imageIndex),
+                                  image.detections);
+        }
+    } else if (callbacks_.imageFailed) {
+        callbacks_.imageFailed(image.imagePath, error);
+    }
+
+    if (callbacks_.imageProcessed) {
+        callbacks_.imageProcessed(folderIndex, imageIndex, image);
+    }
+}
+
+size_t DetectionPipeline::engineCount(size_t images) const {
+    if (!scheduler_) {
+        return 1;
+    }
+    size_t engines = static_cast<size_t>(scheduler_->layout().engines);
+    return std::max<size_t>(1, std::min(engines, images));
+}
+
+std::vector<size_t> DetectionPipeline::processingOrder(const Core::FolderResult& folder) const {
+    std::vector<size_t> order(folder.images.size());
+    std::iota(order.begin(), order.end(), 0);
+
+    std::shared_ptr<Core::IDetector> detector = engine_->acquire();
+    if (!detector || !detector->getConfig().rectInference || order.size() < 2) {
+        return order;
+    }
+
+    // Headers only; images of unknown size keep their place at the end
+    Core::DetectionConfig config = detector->getConfig();
+    cv::Size inputSize(config.inputWidth, config.inputHeight);
+    std::vector<std::pair<int, int>> shapes(order.size());
+    for (size_t i = 0; i < order.size() && !isCancelled(); ++i) {
+        cv::Size imageSize = ImageProcessor::readImageSize(folder.images[i]->imagePath);
+        if (imageSize.area() > 0) {
+            cv::Size shape = Core::YoloDetector::rectInputSize(imageSize, inputSize);
+            shapes[i] = {shape.width, shape.height};
+        } else {
+            shapes[i] = {INT_MAX, INT_MAX};
+        }
+    }
+    std::stable_sort(order.begin(), order.end(), [&shapes](size_t a, size_t b) { return shapes[a] < shapes[b]; });
+    return order;
+}
+
+std::shared_ptr<Core::IDetector> DetectionPipeline::engineFor(size_t engineIndex) {
+    std::shared_ptr<Core::IDetector> source = engine_->acquire();
+    if (engineIndex == 0 || !source) {
+        return source;
+    }
+
+    EngineSlot& slot = engineSlots_[engineIndex];
+    uint64_t generation = engine_->generation();
+    if (!slot.detector || slot.generation != generation) {
+        slot.detector.reset();  // Free the old copy before loading the new one
+        slot.detector = source->clone();
+        slot.generation = generation;
+    }
+    if (slot.detector) {
+        // Threshold changes on the current detector apply to the copies too
+        slot.detector->setConfig(source->getConfig());
+    }
+    return slot.detector;
+}
+
+std::vector<Core::FolderResult> DetectionPipeline::run(const std::string& rootPath) {
+    std::vector<Core::FolderResult> folders = scan(rootPath);
+    calibrate(folders);
+    for (size_t folderIndex = 0; folderIndex < folders.size() && !isCancelled(); ++folderIndex) {
+        processFolder(folderIndex, folders[folderIndex]);
+    }
+    return folders;
+}
+
+bool DetectionPipeline::processImage(const std::shared_ptr<Core::ImageResult>& image, std::string& error) {
+    return processImageWith(image, 0, error);
+}
+
+bool DetectionPipeline::processImageWith(const std::shared_ptr<Core::ImageResult>& image, size_t engineIndex,
+                                         std::string& error) {
+    // Stage timers below and in the detector fill in the image's timing
+    image->timing = Core::ImageTiming();
+    std::error_code sizeError;
+    uintmax_t fileBytes = std::filesystem::file_size(image->imagePath, sizeError);
+    image->timing.fileBytes = sizeError ? 0 : static_cast<uint64_t>(fileBytes);
+    Core::ImageTimingBinding timingBinding(&image->timing);
+
+    YOLO_TRACE_SPAN("image");
+    Core::StageTimer imageTimer(Core::PipelineStage::Image);
+
+    // Held for the whole image, so a swap mid-image takes effect on the next one
+    std::shared_ptr<Core::IDetector> detector = engineFor(engineIndex);
+    if (!detector) {
+        error = "Detector not loaded";
+        return false;
+    }
+
+    if (options_.retainImages) {
+        if (!ImageProcessor::processImageResult(image, *detector)) {
+            error = image->metadata;
+            return false;
+        }
+        return true;
+    }
+
+    // Only the boxes and the frame size are kept; the pixels go right away
+    try {
+        cv::Mat pixels;
+        {
+            YOLO_TRACE_SPAN("decode");
+            Core::StageTimer stageTimer(Core::PipelineStage::Decode);
+            pixels = ImageProcessor::loadImage(image->imagePath);
+        }
+        image->imageSize = pixels.size();
+        image->detections = detector->detectObjects(pixels);
+        image->processed = true;
+        return true;
+    } catch (const std::exception& e) {
+        // Left unprocessed so exporters skip it
+        error = e.what();
+        return false;
+    }
+}
+
+bool DetectionPipeline::isCancelled() const {
+    return cancelled_ && cancelled_->load();
+}
+
+} // namespace Processing
+} // namespace YoloApp
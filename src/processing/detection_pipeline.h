@@ -0,0 +1,170 @@
+// src/processing/detection_pipeline.h
+#pragma once
+
+#include "../core/types.h"
+#include "../core/detector.h"
+#include "../core/engine_handle.h"
+#include "../core/class_index.h"
+#include "../core/pipeline_metrics.h"
+#include "../core/thread_scheduler.h"
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace YoloApp {
+namespace Processing {
+
+/**
+ * @brief Qt-free processing loop: scan a folder tree and run detection over it
+ *
+ * This is the engine behind DetectionWorker (GUI) and BatchRunner (CLI), and
+ * is what services embedding yolo_core should drive. By default it has no
+ * threads of its own: the caller decides which thread runs it and observes
+ * progress through the callbacks, which are invoked on that thread. With a
+ * ThreadScheduler that asks for several engines, processFolder runs images
+ * on that many worker threads (each with its own copy of the detector), but
+ * the callbacks are still invoked on the calling thread. The engine threads
+ * are started by the first folder that needs them and live until the
+ * pipeline is destroyed, so they are pinned once per run, not per folder.
+ */
+class DetectionPipeline {
+public:
+    struct Options {
+        bool recursive = true;
+        bool retainImages = true;   ///< Keep pixels, annotated image and metadata (viewer); false keeps boxes and size only
+    };
+
+    /**
+     * @brief Progress hooks; imageProcessed fires for every image, failed or not
+     */
+    struct Callbacks {
+        std::function<void(int current, int total, const std::string& folderPath)> scanProgress;
+        std::function<void(size_t folderIndex, size_t imageIndex, const Core::ImageResult& image)> imageProcessed;
+        std::function<void(const std::string& imagePath, const std::string& error)> imageFailed;
+        std::function<void(size_t folderIndex, const Core::FolderResult& folder)> folderCompleted;
+    };
+
+    DetectionPipeline(std::shared_ptr<Core::IDetector> detector, Options options);
+
+    /**
+     * @brief Detect with whatever detector the handle holds when each image starts
+     */
+    DetectionPipeline(std::shared_ptr<Core::EngineHandle> engine, Options options);
+    ~DetectionPipeline();
+
+    DetectionPipeline(const DetectionPipeline&) = delete;
+    DetectionPipeline& operator=(const DetectionPipeline&) = delete;
+
+    void setCallbacks(Callbacks callbacks);
+
+    /**
+     * @brief Flag polled between images to stop early
+     */
+    void setCancellationFlag(const std::atomic<bool>* cancelled);
+
+    /**
+     * @brief Index every processed image into this class index
+     */
+    void setClassIndex(std::shared_ptr<Core::ClassIndex> classIndex);
+
+    /**
+     * @brief Record stage latencies, folder latencies, pending images and throughput here
+     */
+    void setMetrics(std::shared_ptr<Core::PipelineMetrics> metrics);
+
+    /**
+     * @brief Split the cores between parallel engines and OpenCV threads as this scheduler says
+     */
+    void setScheduler(std::shared_ptr<Core::ThreadScheduler> scheduler);
+
+    /**
+     * @brief Find all folders with images under a root path
+     * @throws std::runtime_error if the detector is not loaded
+     */
+    std::vector<Core::FolderResult> scan(const std::string& rootPath);
+
+    /**
+     * @brief Pick the scheduler's layout by timing each candidate on sample images
+     *
+     * Does nothing without a scheduler or when its layout is already decided.
+     * Up to Config::CALIBRATION_SAMPLE_IMAGES images of the scanned folders are
+     * decoded once and detected under every layout; the results are discarded.
+     * The chosen layout is then applied to OpenCV's thread pool.
+     */
+    void calibrate(const std::vector<Core::FolderResult>& folders);
+
+    /**
+     * @brief Run detection over every image of one folder
+     *
+     * Image results are updated in place. When the loop ends (also when it
+     * was cancelled part-way) the folder's counts are refreshed, it is marked
+     * processed and folderCompleted is invoked. With rectangular inference
+     * the images run grouped by input shape (read from the file headers), so
+     * the network reshapes once per group; imageProcessed then arrives in
+     * that order, with the images' own indices.
+     */
+    void processFolder(size_t folderIndex, Core::FolderResult& folder);
+
+    /**
+     * @brief Scan, calibrate and process everything under a root path
+     */
+    std::vector<Core::FolderResult> run(const std::string& rootPath);
+
+    /**
+     * @brief Detect one image with the current detector of the engine handle
+     * @return false if the image could not be read or detection failed
+     */
+    bool processImage(const std::shared_ptr<Core::ImageResult>& image, std::string& error);
+
+    bool isCancelled() const;
+
+private:
+    // Copy of the handle's detector for one extra engine; remade after a swap
+    struct EngineSlot {
+        std::shared_ptr<Core::IDetector> detector;
+        uint64_t generation = 0;
+    };
+
+    struct Completion {
+        size_t imageIndex = 0;
+        bool succeeded = false;
+        std::string error;
+    };
+
+    size_t engineCount(size_t images) const;
+    std::vector<size_t> processingOrder(const Core::FolderResult& folder) const;
+    std::shared_ptr<Core::IDetector> engineFor(size_t engineIndex);
+    void startEngineThreads(size_t engines);
+    void engineThreadMain(size_t engineIndex, uint64_t startGeneration);
+    bool processImageWith(const std::shared_ptr<Core::ImageResult>& image, size_t engineIndex, std::string& error);
+    void processFolderParallel(size_t folderIndex, Core::FolderResult& folder,
+                               const std::vector<size_t>& order, size_t engines);
+    void completeImage(size_t folderIndex, size_t imageIndex, const Core::ImageResult& image,
+                       bool succeeded, const std::string& error);
+
+    std::shared_ptr<Core::EngineHandle> engine_;
+    Options options_;
+    Callbacks callbacks_;
+    const std::atomic<bool>* cancelled_;
+    std::shared_ptr<Core::ClassIndex> classIndex_;
+    std::shared_ptr<Core::PipelineMetrics> metrics_;
+    std::shared_ptr<Core::ThreadScheduler> scheduler_;
+    std::vector<EngineSlot> engineSlots_;   // Slot i is only touched by engine i's thread during a folder
+
+    // Engine threads, idle between folders; each folder is posted as a new job generation
+    std::vector<std::thread> engineThreads_;
+    std::mutex engineMutex_;
+    std::condition_variable engineWake_;
+    std::function<void(size_t engineIndex)> engineJob_;
+    size_t jobEngines_ = 0;         // Threads with a lower index run the job, the others sit it out
+    uint64_t jobGeneration_ = 0;
+    bool stopping_ = false;
+};
+
+} // namespace Processing
+} // namespace YoloApp
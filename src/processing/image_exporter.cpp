@@ -0,0 +1,304 @@
+// src/processing/image_exporter.cpp
+#include "image_exporter.h"
+#include "image_processor.h"
+#include "../core/trace.h"
+#include <algorithm>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <filesystem>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+
+namespace fs = std::filesystem;
+
+namespace YoloApp {
+namespace Processing {
+
+namespace {
+
+constexpr size_t PROGRESS_INTERVAL = 64;
+
+std::string sanitizeFileName(std::string name) {
+    for (char& c : name) {
+        if (c == '/' || c == '\\' || c == ':' || c == '*' || c == '?' ||
+            c == '"' || c == '<' || c == '>' || c == '|') {
+            c = '_';
+        }
+    }
+    return name.empty() ? std::string("unnamed") : name;
+}
+
+} // namespace
+
+struct ImageExporter::Job {
+    std::shared_ptr<Core::ImageResult> image;
+    fs::path annotatedDir;
+    fs::path cropsDir;
+    std::string cropPrefix;
+    std::string stem;           ///< Output name of the image, unique within its folder
+};
+
+struct ImageExporter::Stats {
+    std::atomic<size_t> done{0};
+    std::atomic<size_t> images{0};
+    std::atomic<size_t> crops{0};
+    std::atomic<size_t> failed{0};
+    std::atomic<uint64_t> bytesWritten{0};
+};
+
+ImageExporter::ImageExporter(const Options& options)
+    : options_(options)
+    , cancelled_(nullptr) {
+}
+
+void ImageExporter::setProgressCallback(ProgressCallback callback) {
+    progressCallback_ = std::move(callback);
+}
+
+void ImageExporter::setCancellationFlag(const std::atomic<bool>* cancelled) {
+    cancelled_ = cancelled;
+}
+
+ImageExporter::Summary ImageExporter::exportImages(const std::vector<Core::FolderResult>& folders,
+                                                   const std::string& outputDirectory) {
+    size_t imageCount = 0;
+    for (const auto& folder : folders) {
+        imageCount += folder.images.size();
+    }
+    return exportImages(folders.size(), imageCount,
+                        [&folders](size_t folderIndex) { return folders[folderIndex]; },
+                        outputDirectory);
+}
+
+ImageExporter::Summary ImageExporter::exportImages(size_t folderCount, size_t imageCount,
+                                                   FolderLoader loadFolder,
+                                                   const std::string& outputDirectory) {
+    fs::path root(outputDirectory);
+    std::error_code error;
+    fs::create_directories(root, error);
+    if (error) {
+        throw std::runtime_error("Cannot create output directory: " + outputDirectory);
+    }
+
+    const std::vector<int> params = encodeParams(options_.encoding, options_.quality);
+    int threadCount = options_.threadCount > 0
+                      ? options_.threadCount
+                      : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+
+    // Bounded queue: enough to keep every worker busy without loading the whole run
+    const size_t maxQueued = static_cast<size_t>(threadCount) * 2;
+    std::deque<Job> queue;
+    std::mutex queueMutex;
+    std::condition_variable jobAvailable;
+    std::condition_variable spaceAvailable;
+    bool producerDone = false;
+    Stats stats;
+
+    std::vector<std::thread> workers;
+    workers.reserve(threadCount);
+    for (int i = 0; i < threadCount; ++i) {
+        workers.emplace_back([&, i]() {
+            Core::Trace::setThreadName("image export " + std::to_string(i));
+            for (;;) {
+                Job job;
+                {
+                    std::unique_lock<std::mutex> lock(queueMutex);
+                    jobAvailable.wait(lock, [&]() { return !queue.empty() || producerDone; });
+                    if (queue.empty()) {
+                        return;
+                    }
+                    job = std::move(queue.front());
+                    queue.pop_front();
+                }
+                spaceAvailable.notify_one();
+
+                if (!isCancelled()) {
+                    YOLO_TRACE_SPAN("export_image");
+                    processJob(job, params, stats);
+                }
+                ++stats.done;
+            }
+        });
+    }
+
+    size_t lastReported = 0;
+    auto reportProgress = [&](bool force) {
+        size_t done = stats.done.load();
+        if (progressCallback_ && (force || done >= lastReported + PROGRESS_INTERVAL)) {
+            lastReported = done;
+            progressCallback_(done, imageCount);
+        }
+    };
+
+    std::set<std::string> usedFolderNames;
+    for (size_t folderIndex = 0; folderIndex < folderCount && !isCancelled(); ++folderIndex) {
+        Core::FolderResult folder = loadFolder(folderIndex);
+
+        // Folders are flattened into the output root; keep same-named ones apart
+        std::string folderName = sanitizeFileName(folder.folderName);
+        std::string uniqueName = folderName;
+        for (int suffix = 2; !usedFolderNames.insert(uniqueName).second; ++suffix) {
+            uniqueName = folderName + "_" + std::to_string(suffix);
+        }
+        fs::path annotatedDir = root / "annotated" / fs::u8path(uniqueName);
+        std::set<std::string> usedStems;
+
+        for (const auto& image : folder.images) {
+            if (isCancelled()) {
+                break;
+            }
+            if (!image || !image->processed) {
+                ++stats.done;
+                continue;
+            }
+
+            Job job;
+            job.image = image;
+            job.annotatedDir = annotatedDir;
+            job.cropsDir = root / "crops";
+            job.cropPrefix = uniqueName + "_";
+
+            // a.jpg and a.png would share a name in the output; later ones get a suffix
+            std::string stem = fs::u8path(image->imagePath).stem().u8string();
+            job.stem = stem;
+            for (int suffix = 2; !usedStems.insert(job.stem).second; ++suffix) {
+                job.stem = stem + "_" + std::to_string(suffix);
+            }
+
+            std::unique_lock<std::mutex> lock(queueMutex);
+            spaceAvailable.wait(lock, [&]() { return queue.size() < maxQueued; });
+            queue.push_back(std::move(job));
+            lock.unlock();
+            jobAvailable.notify_one();
+
+            reportProgress(false);
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        producerDone = true;
+    }
+    jobAvailable.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    reportProgress(true);
+
+    Summary summary;
+    summary.images = stats.images;
+    summary.crops = stats.crops;
+    summary.failedImages = stats.failed;
+    summary.bytesWritten = stats.bytesWritten;
+    summary.cancelled = isCancelled();
+    return summary;
+}
+
+const char* ImageExporter::fileExtension(Encoding encoding) {
+    switch (encoding) {
+        case Encoding::Jpeg: return "jpg";
+        case Encoding::Png:  return "png";
+        case Encoding::Webp: return "webp";
+    }
+    return "";
+}
+
+std::vector<int> ImageExporter::encodeParams(Encoding encoding, int quality) {
+    quality = std::clamp(quality, 1, 100);
+    switch (encoding) {
+        case Encoding::Jpeg:
+            return {cv::IMWRITE_JPEG_QUALITY, quality};
+        case Encoding::Png:
+            // Higher quality means less effort spent compressing: 100 -> 0, 1 -> 9
+            return {cv::IMWRITE_PNG_COMPRESSION, (100 - quality) * 9 / 99};
+        case Encoding::Webp:
+            return {cv::IMWRITE_WEBP_QUALITY, quality};
+    }
+    return {};
+}
+
+void ImageExporter::processJob(const Job& job, const std::vector<int>& params, Stats& stats) const {
+    const Core::ImageResult& imageResult = *job.image;
+    const std::string extension = std::string(".") + fileExtension(options_.encoding);
+    const std::string& stem = job.stem;
+
+    try {
+        cv::Mat original = imageResult.originalImage;
+        if (original.empty()) {
+            original = ImageProcessor::loadImage(imageResult.imagePath);
+        }
+
+        std::vector<uchar> encoded;
+        if (options_.annotatedImages) {
+            cv::Mat annotated = imageResult.annotatedImage;
+            if (annotated.empty()) {
+                annotated = ImageProcessor::createAnnotatedImage(original, imageResult.detections);
+            }
+
+            std::error_code error;
+            fs::create_directories(job.annotatedDir, error);
+            if (!cv::imencode(extension, annotated, encoded, params) ||
+                !writeEncoded((job.annotatedDir / fs::u8path(stem + extension)).string(), encoded, stats)) {
+                ++stats.failed;
+                return;
+            }
+        }
+
+        if (options_.crops) {
+            const cv::Rect bounds(0, 0, original.cols, original.rows);
+            for (size_t i = 0; i < imageResult.detections.size(); ++i) {
+                const Core::Detection& detection = imageResult.detections[i];
+                cv::Rect box = detection.boundingBox;
+                box.x -= options_.cropPadding;
+                box.y -= options_.cropPadding;
+                box.width += 2 * options_.cropPadding;
+                box.height += 2 * options_.cropPadding;
+                box &= bounds;
+                if (box.width <= 0 || box.height <= 0) {
+                    continue;
+                }
+
+                fs::path classDir = job.cropsDir / fs::u8path(sanitizeFileName(detection.className));
+                std::error_code error;
+                fs::create_directories(classDir, error);
+
+                std::string fileName = job.cropPrefix + stem + "_" + std::to_string(i) + extension;
+                if (cv::imencode(extension, original(box), encoded, params) &&
+                    writeEncoded((classDir / fs::u8path(fileName)).string(), encoded, stats)) {
+                    ++stats.crops;
+                }
+            }
+        }
+
+        ++stats.images;
+    } catch (const std::exception&) {
+        ++stats.failed;
+    }
+}
+
+bool ImageExporter::writeEncoded(const std::string& path, const std::vector<uchar>& data, Stats& stats) const {
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        return false;
+    }
+
+    // The encoded image is already one contiguous buffer: hand it to the OS in a
+    // single write instead of copying it through a stdio buffer
+    std::setvbuf(file, nullptr, _IONBF, 0);
+    bool ok = std::fwrite(data.data(), 1, data.size(), file) == data.size();
+    ok = (std::fclose(file) == 0) && ok;
+    if (ok) {
+        stats.bytesWritten += data.size();
+    }
+    return ok;
+}
+
+bool ImageExporter::isCancelled() const {
+    return cancelled_ && cancelled_->load(std::memory_order_relaxed);
+}
+
+} // namespace Processing
+} // namespace YoloApp
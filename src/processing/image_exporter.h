@@ -0,0 +1,95 @@
+// src/processing/image_exporter.h
+#pragma once
+
+#include "../core/types.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace YoloApp {
+namespace Processing {
+
+/**
+ * @brief Writes annotated images and per-detection crops on a thread pool
+ *
+ * The calling thread walks the results and feeds a bounded queue; worker
+ * threads decode (when the pixels are not in memory), annotate, crop,
+ * encode and write each image, so decoding and encoding scale with cores
+ * and the disk sees one large write per output file.
+ *
+ * Output layout under the target directory:
+ *   annotated/<folder>/<image>.<ext>
+ *   crops/<class>/<folder>_<image>_<n>.<ext>
+ * Images of a folder sharing a stem (a.jpg, a.png) become <image>, <image>_2...
+ */
+class ImageExporter {
+public:
+    enum class Encoding {
+        Jpeg,
+        Png,
+        Webp
+    };
+
+    struct Options {
+        bool annotatedImages = true;
+        bool crops = false;
+        Encoding encoding = Encoding::Jpeg;
+        int quality = 90;           ///< JPEG/WebP quality 1-100; PNG maps it to compression
+        int threadCount = 0;        ///< 0 = one per hardware thread
+        int cropPadding = 0;        ///< Extra pixels around each crop
+    };
+
+    struct Summary {
+        size_t images = 0;
+        size_t crops = 0;
+        size_t failedImages = 0;
+        uint64_t bytesWritten = 0;
+        bool cancelled = false;
+    };
+
+    using ProgressCallback = std::function<void(size_t doneImages, size_t totalImages)>;
+    using FolderLoader = std::function<Core::FolderResult(size_t folderIndex)>;
+
+    explicit ImageExporter(const Options& options);
+    ~ImageExporter() = default;
+
+    void setProgressCallback(ProgressCallback callback);
+    void setCancellationFlag(const std::atomic<bool>* cancelled);
+
+    /**
+     * @brief Export all processed images of the given folders
+     * @throws std::runtime_error if the output directory cannot be created
+     */
+    Summary exportImages(const std::vector<Core::FolderResult>& folders,
+                         const std::string& outputDirectory);
+
+    /**
+     * @brief Export folders fetched one at a time, e.g. from a results store
+     */
+    Summary exportImages(size_t folderCount, size_t imageCount, FolderLoader loadFolder,
+                         const std::string& outputDirectory);
+
+    static const char* fileExtension(Encoding encoding);
+
+    /**
+     * @brief cv::imencode parameters for an encoding and quality
+     */
+    static std::vector<int> encodeParams(Encoding encoding, int quality);
+
+private:
+    struct Job;
+    struct Stats;
+
+    void processJob(const Job& job, const std::vector<int>& params, Stats& stats) const;
+    bool writeEncoded(const std::string& path, const std::vector<uchar>& data, Stats& stats) const;
+    bool isCancelled() const;
+
+    Options options_;
+    ProgressCallback progressCallback_;
+    const std::atomic<bool>* cancelled_;
+};
+
+} // namespace Processing
+} // namespace YoloApp
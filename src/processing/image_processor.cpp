@@ -1,6 +1,12 @@
 
 // src/processing/image_processor.cpp
 #include "image_processor.h"
+#include "../core/config.h"
+#include "../core/pipeline_metrics.h"
+#include "../core/trace.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
 #include <filesystem>
 #include <fstream>
 #include <iomanip>
@@ -33,6 +39,13 @@ cv::Mat ImageProcessor::createAnnotatedImage(const cv::Mat& originalImage,
 std::string ImageProcessor::generateMetadata(const std::string& imagePath, 
                                            const cv::Mat& image,
                                            const std::vector<Core::Detection>& detections) {
+    return generateMetadata(imagePath, image.size(), image.channels(), detections);
+}
+
+std::string ImageProcessor::generateMetadata(const std::string& imagePath,
+                                           const cv::Size& imageSize,
+                                           int channels,
+                                           const std::vector<Core::Detection>& detections) {
     std::ostringstream metadata;
     
     // File information
@@ -41,8 +54,10 @@ std::string ImageProcessor::generateMetadata(const std::string& imagePath,
     metadata << "Path: " << imagePath << "\n";
     
     // Image dimensions
-    metadata << "Dimensions: " << image.cols << " x " << image.rows << "\n";
-    metadata << "Channels: " << image.channels() << "\n";
+    metadata << "Dimensions: " << imageSize.width << " x " << imageSize.height << "\n";
+    if (channels > 0) {
+        metadata << "Channels: " << channels << "\n";
+    }
     
     // File size
     try {
@@ -70,34 +85,84 @@ std::string ImageProcessor::generateMetadata(const std::string& imagePath,
     return metadata.str();
 }
 
-void ImageProcessor::processImageResult(std::shared_ptr<Core::ImageResult> imageResult,
+std::string ImageProcessor::generateTimingReport(const Core::ImageResult& imageResult) {
+    const Core::ImageTiming& timing = imageResult.timing;
+    if (!timing.isRecorded()) {
+        return std::string();
+    }
+    
+    auto ms = [](uint32_t micros) { return micros / 1000.0; };
+    uint32_t staged = timing.decodeMicros + timing.preprocessMicros
+                    + timing.inferenceMicros + timing.postprocessMicros;
+    
+    std::ostringstream report;
+    report << std::fixed << std::setprecision(1);
+    report << "Processing Time: " << ms(timing.totalMicros) << " ms\n";
+    report << "  Decode: " << ms(timing.decodeMicros) << " ms\n";
+    report << "  Preprocess: " << ms(timing.preprocessMicros) << " ms\n";
+    report << "  Inference: " << ms(timing.inferenceMicros) << " ms\n";
+    report << "  Postprocess: " << ms(timing.postprocessMicros) << " ms\n";
+    report << "  Other: " << ms(timing.totalMicros > staged ? timing.totalMicros - staged : 0) << " ms\n";
+    report << "NMS Candidates: " << timing.candidates << "\n";
+    report << "Decoded: " << imageResult.imageSize.width << " x " << imageResult.imageSize.height
+           << " (" << (imageResult.imageSize.area() / 1e6) << " MP)\n";
+    if (timing.fileBytes > 0) {
+        report << "File: " << (timing.fileBytes / (1024.0 * 1024.0)) << " MB\n";
+    }
+    return report.str();
+}
+
+bool ImageProcessor::processImageResult(std::shared_ptr<Core::ImageResult> imageResult,
                                        Core::IDetector& detector) {
     if (!imageResult || imageResult->processed) {
-        return;
+        return true;
     }
     
     try {
         // Load original image
-        imageResult->originalImage = loadImage(imageResult->imagePath);
+        {
+            YOLO_TRACE_SPAN("decode");
+            Core::StageTimer stageTimer(Core::PipelineStage::Decode);
+            imageResult->originalImage = loadImage(imageResult->imagePath);
+            imageResult->imageSize = imageResult->originalImage.size();
+        }
         
         // Perform detection
         imageResult->detections = detector.detectObjects(imageResult->originalImage);
         
+        // Very large frames are not kept in memory; the viewer renders them
+        // from tiles and draws the boxes as an overlay instead
+        bool retainPixels = imageResult->originalImage.total() <= Config::RETAIN_IMAGE_MAX_PIXELS;
+        
         // Create annotated image
-        imageResult->annotatedImage = createAnnotatedImage(imageResult->originalImage, 
-                                                          imageResult->detections);
+        if (retainPixels) {
+            YOLO_TRACE_SPAN("annotate");
+            Core::StageTimer stageTimer(Core::PipelineStage::Annotate);
+            imageResult->annotatedImage = createAnnotatedImage(imageResult->originalImage, 
+                                                              imageResult->detections);
+        }
         
         // Generate metadata
-        imageResult->metadata = generateMetadata(imageResult->imagePath, 
-                                               imageResult->originalImage,
-                                               imageResult->detections);
+        {
+            YOLO_TRACE_SPAN("metadata");
+            Core::StageTimer stageTimer(Core::PipelineStage::Metadata);
+            imageResult->metadata = generateMetadata(imageResult->imagePath, 
+                                                   imageResult->originalImage,
+                                                   imageResult->detections);
+        }
+        
+        if (!retainPixels) {
+            imageResult->originalImage.release();
+        }
         
         imageResult->processed = true;
+        return true;
         
     } catch (const std::exception& e) {
         // Mark as processed even if failed to avoid retrying
         imageResult->processed = true;
         imageResult->metadata = "Error processing image: " + std::string(e.what());
+        return false;
     }
 }
 
@@ -140,6 +205,74 @@ std::pair<cv::Size, size_t> ImageProcessor::getImageInfo(const std::string& imag
     return {size, fileSize};
 }
 
+cv::Size ImageProcessor::readImageSize(const std::string& imagePath) {
+    std::ifstream file(imagePath, std::ios::binary);
+    unsigned char header[30] = {};
+    if (!file.read(reinterpret_cast<char*>(header), sizeof(header)) && file.gcount() < 26) {
+        return cv::Size(0, 0);
+    }
+    auto bigEndian16 = [](const unsigned char* p) { return (p[0] << 8) | p[1]; };
+    auto bigEndian32 = [](const unsigned char* p) {
+        return static_cast<int>((static_cast<uint32_t>(p[0]) << 24) | (p[1] << 16) | (p[2] << 8) | p[3]);
+    };
+    auto littleEndian32 = [](const unsigned char* p) {
+        return static_cast<int32_t>(p[0] | (p[1] << 8) | (p[2] << 16) | (static_cast<uint32_t>(p[3]) << 24));
+    };
+    
+    // PNG: the IHDR chunk comes first
+    if (header[0] == 0x89 && header[1] == 'P' && header[2] == 'N' && header[3] == 'G') {
+        return cv::Size(bigEndian32(header + 16), bigEndian32(header + 20));
+    }
+    
+    // BMP: BITMAPINFOHEADER; a negative height means top-down rows
+    if (header[0] == 'B' && header[1] == 'M') {
+        return cv::Size(littleEndian32(header + 18), std::abs(littleEndian32(header + 22)));
+    }
+    
+    // WebP: lossy, lossless or extended
+    if (std::equal(header, header + 4, "RIFF") && std::equal(header + 8, header + 12, "WEBP")) {
+        if (std::equal(header + 12, header + 16, "VP8 ")) {
+            return cv::Size(((header[27] << 8) | header[26]) & 0x3fff, ((header[29] << 8) | header[28]) & 0x3fff);
+        }
+        if (std::equal(header + 12, header + 16, "VP8L")) {
+            uint32_t bits = static_cast<uint32_t>(littleEndian32(header + 21));
+            return cv::Size(static_cast<int>((bits & 0x3fff) + 1), static_cast<int>(((bits >> 14) & 0x3fff) + 1));
+        }
+        if (std::equal(header + 12, header + 16, "VP8X")) {
+            return cv::Size(1 + (header[24] | (header[25] << 8) | (header[26] << 16)),
+                            1 + (header[27] | (header[28] << 8) | (header[29] << 16)));
+        }
+        return cv::Size(0, 0);
+    }
+    
+    // JPEG: walk the segments up to the start-of-frame marker
+    if (header[0] == 0xFF && header[1] == 0xD8) {
+        file.clear();
+        file.seekg(2);
+        unsigned char marker[4];
+        while (file.read(reinterpret_cast<char*>(marker), sizeof(marker))) {
+            if (marker[0] != 0xFF) {
+                break;
+            }
+            int type = marker[1];
+            int length = bigEndian16(marker + 2);
+            bool startOfFrame = type >= 0xC0 && type <= 0xCF && type != 0xC4 && type != 0xC8 && type != 0xCC;
+            if (startOfFrame) {
+                unsigned char frame[5];
+                if (!file.read(reinterpret_cast<char*>(frame), sizeof(frame))) {
+                    break;
+                }
+                return cv::Size(bigEndian16(frame + 3), bigEndian16(frame + 1));
+            }
+            if (length < 2) {
+                break;
+            }
+            file.seekg(length - 2, std::ios::cur);
+        }
+    }
+    return cv::Size(0, 0);
+}
+
 void ImageProcessor::drawDetectionBox(cv::Mat& image, const Core::Detection& detection) {
     cv::Scalar color = getClassColor(detection.classId);
     
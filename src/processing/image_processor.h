@@ -35,10 +35,26 @@ public:
                                        const cv::Mat& image,
                                        const std::vector<Core::Detection>& detections);
     
+    /**
+     * @brief Generate metadata without the pixels (e.g. for a reopened session)
+     * @param channels Channel count, or 0 if unknown
+     */
+    static std::string generateMetadata(const std::string& imagePath,
+                                       const cv::Size& imageSize,
+                                       int channels,
+                                       const std::vector<Core::Detection>& detections);
+    
+    /**
+     * @brief Describe where the processing time of an image went
+     * @return Empty if no timing was recorded (e.g. a reopened session)
+     */
+    static std::string generateTimingReport(const Core::ImageResult& imageResult);
+    
     /**
      * @brief Process a single image result (load, detect, annotate)
+     * @return false if it failed; the reason is then in the metadata
      */
-    static void processImageResult(std::shared_ptr<Core::ImageResult> imageResult,
+    static bool processImageResult(std::shared_ptr<Core::ImageResult> imageResult,
                                   Core::IDetector& detector);  // FIXED: Proper reference
     
     /**
@@ -50,10 +66,20 @@ public:
      * @brief Get image file information
      */
     static std::pair<cv::Size, size_t> getImageInfo(const std::string& imagePath);
+    
+    /**
+     * @brief Image dimensions from the file header, without decoding
+     * @return (0, 0) for unreadable files and formats other than JPEG, PNG, BMP and WebP
+     */
+    static cv::Size readImageSize(const std::string& imagePath);
+    
+    /**
+     * @brief Consistent annotation color for a class id (BGR)
+     */
+    static cv::Scalar getClassColor(int classId);
 
 private:
     static void drawDetectionBox(cv::Mat& image, const Core::Detection& detection);
-    static cv::Scalar getClassColor(int classId);
 };
 
 } // namespace Processing
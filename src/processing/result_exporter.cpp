@@ -0,0 +1,583 @@
+// src/processing/result_exporter.cpp
+#include "result_exporter.h"
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <map>
+#include <set>
+#include <stdexcept>
+
+namespace YoloApp {
+namespace Processing {
+
+namespace {
+constexpr size_t WRITE_BUFFER_SIZE = 4 * 1024 * 1024;
+constexpr size_t PROGRESS_INTERVAL = 256;
+}
+
+/**
+ * @brief Append-only file writer with a large user-space buffer
+ *
+ * Formatting goes into the buffer with no allocation per record and the
+ * file sees only multi-megabyte writes.
+ */
+class ResultExporter::Writer {
+public:
+    explicit Writer(size_t capacity = WRITE_BUFFER_SIZE)
+        : file_(nullptr), size_(0), bytesWritten_(0) {
+        buffer_.resize(capacity);
+    }
+
+    ~Writer() {
+        if (file_) {
+            std::fclose(file_);
+        }
+    }
+
+    void open(const std::filesystem::path& path) {
+        close();
+#ifdef _WIN32
+        file_ = _wfopen(path.c_str(), L"wb");
+#else
+        file_ = std::fopen(path.c_str(), "wb");
+#endif
+        if (!file_) {
+            throw std::runtime_error("Cannot open output file: " + path.string());
+        }
+        path_ = path.string();
+    }
+
+    void close() {
+        if (!file_) {
+            return;
+        }
+        flush();
+        bool failed = std::fclose(file_) != 0;
+        file_ = nullptr;
+        if (failed) {
+            throw std::runtime_error("Failed to write output file: " + path_);
+        }
+    }
+
+    void write(const char* data, size_t length) {
+        if (size_ + length > buffer_.size()) {
+            flush();
+            if (length > buffer_.size()) {
+                writeThrough(data, length);
+                return;
+            }
+        }
+        std::memcpy(buffer_.data() + size_, data, length);
+        size_ += length;
+    }
+
+    void write(const char* text) { write(text, std::strlen(text)); }
+    void write(const std::string& text) { write(text.data(), text.size()); }
+
+    void put(char c) {
+        if (size_ == buffer_.size()) {
+            flush();
+        }
+        buffer_[size_++] = c;
+    }
+
+    template <typename Int>
+    void writeInt(Int value) {
+        char digits[24];
+        auto result = std::to_chars(digits, digits + sizeof(digits), value);
+        write(digits, static_cast<size_t>(result.ptr - digits));
+    }
+
+    void writeFloat(double value, int decimals) {
+        char digits[32];
+        int length = std::snprintf(digits, sizeof(digits), "%.*f", decimals, value);
+        write(digits, static_cast<size_t>(length));
+    }
+
+    void writeJsonString(const std::string& text) {
+        put('"');
+        for (char c : text) {
+            switch (c) {
+                case '"':  write("\\\"", 2); break;
+                case '\\': write("\\\\", 2); break;
+                case '\n': write("\\n", 2); break;
+                case '\r': write("\\r", 2); break;
+                case '\t': write("\\t", 2); break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20) {
+                        char escaped[8];
+                        std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned char>(c));
+                        write(escaped, 6);
+                    } else {
+                        put(c);
+                    }
+            }
+        }
+        put('"');
+    }
+
+    void writeCsvField(const std::string& text) {
+        if (text.find_first_of(",\"\n\r") == std::string::npos) {
+            write(text);
+            return;
+        }
+        put('"');
+        for (char c : text) {
+            if (c == '"') {
+                put('"');
+            }
+            put(c);
+        }
+        put('"');
+    }
+
+    uint64_t bytesWritten() const { return bytesWritten_ + size_; }
+
+private:
+    void flush() {
+        if (size_ > 0) {
+            writeThrough(buffer_.data(), size_);
+            size_ = 0;
+        }
+    }
+
+    void writeThrough(const char* data, size_t length) {
+        if (std::fwrite(data, 1, length, file_) != length) {
+            throw std::runtime_error("Failed to write output file: " + path_);
+        }
+        bytesWritten_ += length;
+    }
+
+    std::FILE* file_;
+    std::string path_;
+    std::vector<char> buffer_;
+    size_t size_;
+    uint64_t bytesWritten_;
+};
+
+ResultExporter::ResultExporter(Format format)
+    : format_(format)
+    , folderCount_(0)
+    , cancelled_(nullptr)
+    , totalImages_(0) {
+}
+
+void ResultExporter::setProgressCallback(ProgressCallback callback) {
+    progressCallback_ = std::move(callback);
+}
+
+void ResultExporter::setCancellationFlag(const std::atomic<bool>* cancelled) {
+    cancelled_ = cancelled;
+}
+
+ResultExporter::Summary ResultExporter::exportResults(const std::vector<Core::FolderResult>& folders,
+                                                      const std::string& outputPath) {
+    size_t imageCount = 0;
+    for (const auto& folder : folders) {
+        imageCount += folder.images.size();
+    }
+    return exportResults(folders.size(), imageCount,
+                         [&folders](size_t folderIndex) { return folders[folderIndex]; },
+                         outputPath);
+}
+
+ResultExporter::Summary ResultExporter::exportResults(size_t folderCount, size_t imageCount,
+                                                      FolderLoader loadFolder,
+                                                      const std::string& outputPath) {
+    Summary summary;
+    folderCount_ = folderCount;
+    loadFolder_ = std::move(loadFolder);
+    totalImages_ = imageCount;
+
+    switch (format_) {
+        case Format::Csv:
+            exportCsv(outputPath, summary);
+            break;
+        case Format::JsonLines:
+            exportJsonLines(outputPath, summary);
+            break;
+        case Format::Coco:
+            exportCoco(outputPath, summary);
+            break;
+        case Format::YoloTxt:
+            exportYolo(outputPath, summary);
+            break;
+    }
+    loadFolder_ = nullptr;
+
+    summary.cancelled = isCancelled();
+    reportProgress(totalImages_, true);
+    return summary;
+}
+
+const char* ResultExporter::formatName(Format format) {
+    switch (format) {
+        case Format::Csv:       return "CSV";
+        case Format::JsonLines: return "JSON Lines";
+        case Format::Coco:      return "COCO JSON";
+        case Format::YoloTxt:   return "YOLO txt";
+    }
+    return "";
+}
+
+const char* ResultExporter::fileExtension(Format format) {
+    switch (format) {
+        case Format::Csv:       return "csv";
+        case Format::JsonLines: return "jsonl";
+        case Format::Coco:      return "json";
+        case Format::YoloTxt:   return "txt";
+    }
+    return "";
+}
+
+void ResultExporter::exportCsv(const std::string& outputPath, Summary& summary) {
+    Writer out;
+    out.open(outputPath);
+    out.write("folder,image,image_width,image_height,class_id,class_name,confidence,x,y,width,height\n");
+
+    size_t done = 0;
+    for (size_t folderIndex = 0; folderIndex < folderCount_; ++folderIndex) {
+        if (isCancelled()) {
+            break;
+        }
+        Core::FolderResult folder = loadFolder_(folderIndex);
+        for (const auto& image : folder.images) {
+            reportProgress(++done);
+            if (isCancelled()) {
+                break;
+            }
+            if (!image || !image->processed) {
+                ++summary.skippedImages;
+                continue;
+            }
+
+            for (const auto& detection : image->detections) {
+                const cv::Rect& box = detection.boundingBox;
+                out.writeCsvField(folder.folderName);
+                out.put(',');
+                out.writeCsvField(image->imagePath);
+                out.put(',');
+                out.writeInt(image->imageSize.width);
+                out.put(',');
+                out.writeInt(image->imageSize.height);
+                out.put(',');
+                out.writeInt(detection.classId);
+                out.put(',');
+                out.writeCsvField(detection.className);
+                out.put(',');
+                out.writeFloat(detection.confidence, 4);
+                out.put(',');
+                out.writeInt(box.x);
+                out.put(',');
+                out.writeInt(box.y);
+                out.put(',');
+                out.writeInt(box.width);
+                out.put(',');
+                out.writeInt(box.height);
+                out.put('\n');
+            }
+            ++summary.images;
+            summary.detections += image->detections.size();
+        }
+    }
+
+    summary.bytesWritten = out.bytesWritten();
+    out.close();
+}
+
+void ResultExporter::exportJsonLines(const std::string& outputPath, Summary& summary) {
+    Writer out;
+    out.open(outputPath);
+
+    size_t done = 0;
+    for (size_t folderIndex = 0; folderIndex < folderCount_; ++folderIndex) {
+        if (isCancelled()) {
+            break;
+        }
+        Core::FolderResult folder = loadFolder_(folderIndex);
+        for (const auto& image : folder.images) {
+            reportProgress(++done);
+            if (isCancelled()) {
+                break;
+            }
+            if (!image || !image->processed) {
+                ++summary.skippedImages;
+                continue;
+            }
+
+            // One self-contained object per image and line
+            out.write("{\"folder\":");
+            out.writeJsonString(folder.folderName);
+            out.write(",\"image\":");
+            out.writeJsonString(image->imagePath);
+            out.write(",\"width\":");
+            out.writeInt(image->imageSize.width);
+            out.write(",\"height\":");
+            out.writeInt(image->imageSize.height);
+            if (image->timing.isRecorded()) {
+                const Core::ImageTiming& timing = image->timing;
+                out.write(",\"timing\":{\"total_ms\":");
+                out.writeFloat(timing.totalMicros / 1000.0, 3);
+                out.write(",\"decode_ms\":");
+                out.writeFloat(timing.decodeMicros / 1000.0, 3);
+                out.write(",\"preprocess_ms\":");
+                out.writeFloat(timing.preprocessMicros / 1000.0, 3);
+                out.write(",\"inference_ms\":");
+                out.writeFloat(timing.inferenceMicros / 1000.0, 3);
+                out.write(",\"postprocess_ms\":");
+                out.writeFloat(timing.postprocessMicros / 1000.0, 3);
+                out.write(",\"candidates\":");
+                out.writeInt(timing.candidates);
+                out.write(",\"file_bytes\":");
+                out.writeInt(timing.fileBytes);
+                out.put('}');
+            }
+            out.write(",\"detections\":[");
+            bool first = true;
+            for (const auto& detection : image->detections) {
+                const cv::Rect& box = detection.boundingBox;
+                out.write(first ? "{\"class_id\":" : ",{\"class_id\":");
+                first = false;
+                out.writeInt(detection.classId);
+                out.write(",\"class_name\":");
+                out.writeJsonString(detection.className);
+                out.write(",\"confidence\":");
+                out.writeFloat(detection.confidence, 4);
+                out.write(",\"bbox\":[");
+                out.writeInt(box.x);
+                out.put(',');
+                out.writeInt(box.y);
+                out.put(',');
+                out.writeInt(box.width);
+                out.put(',');
+                out.writeInt(box.height);
+                out.write("]}");
+            }
+            out.write("]}\n");
+
+            ++summary.images;
+            summary.detections += image->detections.size();
+        }
+    }
+
+    summary.bytesWritten = out.bytesWritten();
+    out.close();
+}
+
+void ResultExporter::exportCoco(const std::string& outputPath, Summary& summary) {
+    Writer out;
+    out.open(outputPath);
+
+    // COCO puts images and annotations in separate arrays, so the results are
+    // walked twice; categories are collected along the way and written last.
+    // COCO category ids start at 1, so model class ids are shifted by one.
+    totalImages_ *= 2;
+    out.write("{\"info\":{\"description\":\"YOLO detection results\"},\"images\":[\n");
+
+    size_t done = 0;
+    uint64_t imageId = 0;
+    for (size_t folderIndex = 0; folderIndex < folderCount_; ++folderIndex) {
+        if (isCancelled()) {
+            break;
+        }
+        Core::FolderResult folder = loadFolder_(folderIndex);
+        for (const auto& image : folder.images) {
+            reportProgress(++done);
+            if (isCancelled()) {
+                break;
+            }
+            if (!image || !image->processed) {
+                ++summary.skippedImages;
+                continue;
+            }
+
+            out.write(imageId == 0 ? "{\"id\":" : ",\n{\"id\":");
+            out.writeInt(++imageId);
+            out.write(",\"file_name\":");
+            out.writeJsonString(image->imagePath);
+            out.write(",\"width\":");
+            out.writeInt(image->imageSize.width);
+            out.write(",\"height\":");
+            out.writeInt(image->imageSize.height);
+            out.put('}');
+        }
+    }
+
+    out.write("\n],\"annotations\":[\n");
+
+    std::map<int, std::string> categories;
+    uint64_t annotationId = 0;
+    imageId = 0;
+    for (size_t folderIndex = 0; folderIndex < folderCount_; ++folderIndex) {
+        if (isCancelled()) {
+            break;
+        }
+        Core::FolderResult folder = loadFolder_(folderIndex);
+        for (const auto& image : folder.images) {
+            reportProgress(++done);
+            if (isCancelled()) {
+                break;
+            }
+            if (!image || !image->processed) {
+                continue;
+            }
+
+            ++imageId;
+            for (const auto& detection : image->detections) {
+                const cv::Rect& box = detection.boundingBox;
+                categories.emplace(detection.classId, detection.className);
+
+                out.write(annotationId == 0 ? "{\"id\":" : ",\n{\"id\":");
+                out.writeInt(++annotationId);
+                out.write(",\"image_id\":");
+                out.writeInt(imageId);
+                out.write(",\"category_id\":");
+                out.writeInt(detection.classId + 1);
+                out.write(",\"bbox\":[");
+                out.writeInt(box.x);
+                out.put(',');
+                out.writeInt(box.y);
+                out.put(',');
+                out.writeInt(box.width);
+                out.put(',');
+                out.writeInt(box.height);
+                out.write("],\"area\":");
+                out.writeInt(static_cast<int64_t>(box.width) * box.height);
+                out.write(",\"score\":");
+                out.writeFloat(detection.confidence, 4);
+                out.write(",\"iscrowd\":0}");
+            }
+            ++summary.images;
+            summary.detections += image->detections.size();
+        }
+    }
+
+    out.write("\n],\"categories\":[\n");
+    bool first = true;
+    for (const auto& [classId, className] : categories) {
+        out.write(first ? "{\"id\":" : ",\n{\"id\":");
+        first = false;
+        out.writeInt(classId + 1);
+        out.write(",\"name\":");
+        out.writeJsonString(className);
+        out.put('}');
+    }
+    out.write("\n]}\n");
+
+    summary.bytesWritten = out.bytesWritten();
+    out.close();
+}
+
+void ResultExporter::exportYolo(const std::string& outputPath, Summary& summary) {
+    namespace fs = std::filesystem;
+    fs::path root(outputPath);
+    std::error_code error;
+    fs::create_directories(root, error);
+    if (error) {
+        throw std::runtime_error("Cannot create output directory: " + outputPath);
+    }
+
+    // Label files are tiny, so one small buffer is reused for all of them
+    Writer out(64 * 1024);
+    std::map<int, std::string> classNames;
+    std::set<std::string> usedFolderNames;
+
+    size_t done = 0;
+    for (size_t folderIndex = 0; folderIndex < folderCount_; ++folderIndex) {
+        if (isCancelled()) {
+            break;
+        }
+        Core::FolderResult folder = loadFolder_(folderIndex);
+        // Folders are flattened into the output root; keep same-named ones apart
+        std::string folderName = folder.folderName.empty() ? "images" : folder.folderName;
+        std::string uniqueName = folderName;
+        for (int suffix = 2; !usedFolderNames.insert(uniqueName).second; ++suffix) {
+            uniqueName = folderName + "_" + std::to_string(suffix);
+        }
+        fs::path folderDir = root / fs::u8path(uniqueName);
+        bool folderCreated = false;
+        std::set<std::string> usedLabelNames;
+
+        for (const auto& image : folder.images) {
+            reportProgress(++done);
+            if (isCancelled()) {
+                break;
+            }
+            // YOLO coordinates are relative, so images without a known size cannot be written
+            if (!image || !image->processed || image->imageSize.empty()) {
+                ++summary.skippedImages;
+                continue;
+            }
+
+            if (!folderCreated) {
+                fs::create_directories(folderDir, error);
+                if (error) {
+                    throw std::runtime_error("Cannot create output directory: " + folderDir.string());
+                }
+                folderCreated = true;
+            }
+
+            // a.jpg and a.png would both map to a.txt; later ones get a suffix
+            std::string stem = fs::u8path(image->imagePath).stem().u8string();
+            std::string labelName = stem;
+            for (int suffix = 2; !usedLabelNames.insert(labelName).second; ++suffix) {
+                labelName = stem + "_" + std::to_string(suffix);
+            }
+            fs::path labelPath = folderDir / fs::u8path(labelName + ".txt");
+            out.open(labelPath);
+
+            const double width = image->imageSize.width;
+            const double height = image->imageSize.height;
+            for (const auto& detection : image->detections) {
+                const cv::Rect& box = detection.boundingBox;
+                classNames.emplace(detection.classId, detection.className);
+
+                out.writeInt(detection.classId);
+                out.put(' ');
+                out.writeFloat((box.x + box.width / 2.0) / width, 6);
+                out.put(' ');
+                out.writeFloat((box.y + box.height / 2.0) / height, 6);
+                out.put(' ');
+                out.writeFloat(box.width / width, 6);
+                out.put(' ');
+                out.writeFloat(box.height / height, 6);
+                out.put('\n');
+            }
+            out.close();
+
+            ++summary.images;
+            summary.detections += image->detections.size();
+        }
+    }
+
+    // Class names by id, one per line, with gaps for ids that never occurred
+    out.open(root / "classes.txt");
+    int nextId = 0;
+    for (const auto& [classId, className] : classNames) {
+        for (; nextId < classId; ++nextId) {
+            out.put('\n');
+        }
+        if (classId >= 0) {
+            out.write(className);
+            out.put('\n');
+            nextId = classId + 1;
+        }
+    }
+    out.close();
+
+    summary.bytesWritten = out.bytesWritten();
+}
+
+bool ResultExporter::isCancelled() const {
+    return cancelled_ && cancelled_->load(std::memory_order_relaxed);
+}
+
+void ResultExporter::reportProgress(size_t done, bool force) {
+    if (progressCallback_ && (force || done % PROGRESS_INTERVAL == 0)) {
+        progressCallback_(done, totalImages_);
+    }
+}
+
+} // namespace Processing
+} // namespace YoloApp
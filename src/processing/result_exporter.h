@@ -0,0 +1,93 @@
+// src/processing/result_exporter.h
+#pragma once
+
+#include "../core/types.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace YoloApp {
+namespace Processing {
+
+/**
+ * @brief Streams detection results to CSV, JSON Lines, COCO-JSON or YOLO-txt
+ *
+ * Records are formatted straight into a large write buffer and flushed in
+ * big blocks, so no document is built in memory and memory use does not
+ * grow with the number of detections. Meant to run off the GUI thread.
+ */
+class ResultExporter {
+public:
+    enum class Format {
+        Csv,
+        JsonLines,
+        Coco,       ///< category_id is the model class id plus one, as COCO ids start at 1
+        YoloTxt     ///< One label file per image; the output path is a directory.
+                    ///< Images sharing a stem in a folder get "_2", "_3"... label names
+    };
+
+    struct Summary {
+        size_t images = 0;
+        size_t detections = 0;
+        size_t skippedImages = 0;   ///< Unprocessed, or no known size for YOLO
+        uint64_t bytesWritten = 0;
+        bool cancelled = false;
+    };
+
+    using ProgressCallback = std::function<void(size_t doneImages, size_t totalImages)>;
+    using FolderLoader = std::function<Core::FolderResult(size_t folderIndex)>;
+
+    explicit ResultExporter(Format format);
+    ~ResultExporter() = default;
+
+    /**
+     * @brief Set progress callback, called every few hundred images
+     */
+    void setProgressCallback(ProgressCallback callback);
+
+    /**
+     * @brief Flag polled between images to stop the export early
+     */
+    void setCancellationFlag(const std::atomic<bool>* cancelled);
+
+    /**
+     * @brief Write all processed images of the given folders
+     * @throws std::runtime_error if the output cannot be created or written
+     */
+    Summary exportResults(const std::vector<Core::FolderResult>& folders,
+                          const std::string& outputPath);
+
+    /**
+     * @brief Write folders fetched one at a time, e.g. from a results store
+     *
+     * Only one folder is held at a time; COCO export fetches each folder twice.
+     */
+    Summary exportResults(size_t folderCount, size_t imageCount, FolderLoader loadFolder,
+                          const std::string& outputPath);
+
+    static const char* formatName(Format format);
+    static const char* fileExtension(Format format);
+
+private:
+    class Writer;
+
+    void exportCsv(const std::string& outputPath, Summary& summary);
+    void exportJsonLines(const std::string& outputPath, Summary& summary);
+    void exportCoco(const std::string& outputPath, Summary& summary);
+    void exportYolo(const std::string& outputPath, Summary& summary);
+
+    bool isCancelled() const;
+    void reportProgress(size_t done, bool force = false);
+
+    Format format_;
+    ProgressCallback progressCallback_;
+    FolderLoader loadFolder_;
+    size_t folderCount_;
+    const std::atomic<bool>* cancelled_;
+    size_t totalImages_;
+};
+
+} // namespace Processing
+} // namespace YoloApp
@@ -0,0 +1,165 @@
+// src/ui/auto_tune_dialog.cpp
+#include "auto_tune_dialog.h"
+#include "../core/config.h"
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QHeaderView>
+
+namespace YoloApp {
+namespace UI {
+
+namespace {
+
+const QStringList TRIAL_COLUMNS = {"Input", "Engines", "Threads", "Images/s", "mAP@0.5", "Recall"};
+
+QTableWidgetItem* numberItem(const QString& text) {
+    QTableWidgetItem* item = new QTableWidgetItem(text);
+    item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+    return item;
+}
+
+} // namespace
+
+AutoTuneDialog::AutoTuneDialog(const QString& folderPath,
+                               std::shared_ptr<Core::IDetector> detector,
+                               QWidget* parent)
+    : QDialog(parent)
+    , worker_(std::make_unique<Workers::AutoTuneWorker>()) {
+    setWindowTitle("Auto-Tune");
+    setModal(true);
+    setupUI();
+
+    connect(worker_.get(), &Workers::AutoTuneWorker::tuneProgress,
+            this, &AutoTuneDialog::onTuneProgress);
+    connect(worker_.get(), &Workers::AutoTuneWorker::tuneCompleted,
+            this, &AutoTuneDialog::onTuneCompleted);
+    worker_->startTuning(folderPath, std::move(detector), Processing::AutoTuner::Options());
+}
+
+void AutoTuneDialog::setupUI() {
+    QVBoxLayout* layout = new QVBoxLayout(this);
+
+    statusLabel_ = new QLabel(QString("Sampling up to %1 images; every input size is compared "
+                                      "with detections at %2 px")
+                              .arg(Config::AUTO_TUNE_SAMPLE_IMAGES)
+                              .arg(Config::AUTO_TUNE_REFERENCE_SIZE));
+    statusLabel_->setWordWrap(true);
+    layout->addWidget(statusLabel_);
+
+    progressBar_ = new QProgressBar();
+    progressBar_->setRange(0, 100);
+    layout->addWidget(progressBar_);
+
+    trialTable_ = new QTableWidget();
+    trialTable_->setColumnCount(TRIAL_COLUMNS.size());
+    trialTable_->setHorizontalHeaderLabels(TRIAL_COLUMNS);
+    trialTable_->verticalHeader()->setVisible(false);
+    trialTable_->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    trialTable_->setSelectionBehavior(QAbstractItemView::SelectRows);
+    trialTable_->setSelectionMode(QAbstractItemView::SingleSelection);
+    trialTable_->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    trialTable_->setMinimumSize(480, 260);
+    trialTable_->setVisible(false);
+    layout->addWidget(trialTable_);
+
+    QHBoxLayout* buttonLayout = new QHBoxLayout();
+    buttonLayout->addStretch();
+    applyButton_ = new QPushButton("Apply");
+    applyButton_->setEnabled(false);
+    closeButton_ = new QPushButton("Cancel");
+    buttonLayout->addWidget(applyButton_);
+    buttonLayout->addWidget(closeButton_);
+    layout->addLayout(buttonLayout);
+
+    connect(applyButton_, &QPushButton::clicked, this, &QDialog::accept);
+    connect(closeButton_, &QPushButton::clicked, this, &QDialog::reject);
+    connect(trialTable_, &QTableWidget::itemSelectionChanged, this, [this]() {
+        applyButton_->setEnabled(!trialTable_->selectedItems().isEmpty());
+    });
+}
+
+void AutoTuneDialog::reject() {
+    // Closing while the sweep runs stops it; the worker finishes the image in flight
+    if (worker_->isRunning()) {
+        worker_->requestCancellation();
+        worker_->wait();
+    }
+    QDialog::reject();
+}
+
+void AutoTuneDialog::onTuneProgress(int percent, QString step) {
+    progressBar_->setValue(percent);
+    statusLabel_->setText(step);
+}
+
+void AutoTuneDialog::onTuneCompleted(bool success, QString error) {
+    result_ = worker_->result();
+    progressBar_->setVisible(false);
+    closeButton_->setText("Close");
+
+    if (!success) {
+        statusLabel_->setText("Auto-tune failed: " + error);
+        return;
+    }
+    showResult();
+}
+
+void AutoTuneDialog::showResult() {
+    const auto& trials = result_.trials;
+    trialTable_->setRowCount(static_cast<int>(trials.size()));
+    for (int row = 0; row < static_cast<int>(trials.size()); ++row) {
+        const auto& trial = trials[row];
+        QList<QTableWidgetItem*> items = {
+            numberItem(QString("%1x%1").arg(trial.inputSize)),
+            numberItem(QString::number(trial.layout.engines)),
+            numberItem(QString::number(trial.layout.threadsPerEngine)),
+            numberItem(QString::number(trial.imagesPerSecond, 'f', 1)),
+            numberItem(QString::number(trial.meanAveragePrecision, 'f', 3)),
+            numberItem(QString::number(trial.recall, 'f', 3))
+        };
+        for (int column = 0; column < items.size(); ++column) {
+            if (trial.paretoOptimal) {
+                QFont font = items[column]->font();
+                font.setBold(true);
+                items[column]->setFont(font);
+            }
+            trialTable_->setItem(row, column, items[column]);
+        }
+    }
+    trialTable_->setVisible(true);
+    trialTable_->selectRow(result_.recommended);
+
+    const auto& best = trials[result_.recommended];
+    QString status = QString("%1 samples. Recommended: %2x%2 input, %3 engine(s) x %4 thread(s), "
+                             "%5 images/s at mAP@0.5 %6 against %7 px. Bold rows are Pareto-optimal.")
+                         .arg(result_.sampleImages)
+                         .arg(best.inputSize)
+                         .arg(best.layout.engines)
+                         .arg(best.layout.threadsPerEngine)
+                         .arg(best.imagesPerSecond, 0, 'f', 1)
+                         .arg(best.meanAveragePrecision, 0, 'f', 3)
+                         .arg(result_.referenceSize);
+    for (const auto& failure : result_.failedSizes) {
+        status += "\nDropped " + QString::fromStdString(failure);
+    }
+    statusLabel_->setText(status);
+    adjustSize();
+}
+
+Processing::AutoTuner::Trial AutoTuneDialog::selectedTrial() const {
+    int row = trialTable_->currentRow();
+    if (row < 0 || row >= static_cast<int>(result_.trials.size())) {
+        return recommendedTrial();
+    }
+    return result_.trials[row];
+}
+
+Processing::AutoTuner::Trial AutoTuneDialog::recommendedTrial() const {
+    if (result_.recommended < 0) {
+        return Processing::AutoTuner::Trial();
+    }
+    return result_.trials[result_.recommended];
+}
+
+} // namespace UI
+} // namespace YoloApp
@@ -0,0 +1,66 @@
+// src/ui/auto_tune_dialog.h
+#pragma once
+
+#include "../core/detector.h"
+#include "../processing/auto_tuner.h"
+#include "../workers/auto_tune_worker.h"
+#include <QDialog>
+#include <QLabel>
+#include <QProgressBar>
+#include <QPushButton>
+#include <QTableWidget>
+#include <memory>
+
+namespace YoloApp {
+namespace UI {
+
+/**
+ * @brief Runs the auto-tuner on a folder and lets the user apply a result
+ *
+ * Shows progress while the sweep runs, then every trial with its throughput
+ * and agreement with the reference. Pareto-optimal rows are bold and the
+ * recommended one is preselected; Apply accepts the dialog with the selected
+ * trial.
+ */
+class AutoTuneDialog : public QDialog {
+    Q_OBJECT
+
+public:
+    AutoTuneDialog(const QString& folderPath,
+                   std::shared_ptr<Core::IDetector> detector,
+                   QWidget* parent = nullptr);
+    ~AutoTuneDialog() override = default;
+
+    /**
+     * @brief The trial to apply (valid after the dialog was accepted)
+     */
+    Processing::AutoTuner::Trial selectedTrial() const;
+
+    /**
+     * @brief The trial the tuner recommended
+     */
+    Processing::AutoTuner::Trial recommendedTrial() const;
+
+protected:
+    void reject() override;
+
+private slots:
+    void onTuneProgress(int percent, QString step);
+    void onTuneCompleted(bool success, QString error);
+
+private:
+    void setupUI();
+    void showResult();
+
+    std::unique_ptr<Workers::AutoTuneWorker> worker_;
+    Processing::AutoTuner::Result result_;
+
+    QLabel* statusLabel_;
+    QProgressBar* progressBar_;
+    QTableWidget* trialTable_;
+    QPushButton* applyButton_;
+    QPushButton* closeButton_;
+};
+
+} // namespace UI
+} // namespace YoloApp
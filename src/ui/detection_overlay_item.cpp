@@ -0,0 +1,204 @@
+// src/ui/detection_overlay_item.cpp
+#include "detection_overlay_item.h"
+#include "../processing/image_processor.h"
+#include <QFontMetrics>
+#include <QGraphicsScene>
+#include <QGraphicsView>
+#include <QPainter>
+#include <QStyleOptionGraphicsItem>
+#include <algorithm>
+#include <cmath>
+
+namespace YoloApp {
+namespace UI {
+
+namespace {
+
+QColor toQColor(const cv::Scalar& bgr) {
+    return QColor(static_cast<int>(bgr[2]), static_cast<int>(bgr[1]), static_cast<int>(bgr[0]));
+}
+
+QRectF toQRectF(const cv::Rect& rect) {
+    return QRectF(rect.x, rect.y, rect.width, rect.height);
+}
+
+cv::Rect toCvRect(const QRectF& rect) {
+    int left = static_cast<int>(std::floor(rect.left()));
+    int top = static_cast<int>(std::floor(rect.top()));
+    int right = static_cast<int>(std::ceil(rect.right()));
+    int bottom = static_cast<int>(std::ceil(rect.bottom()));
+    return cv::Rect(left, top, right - left, bottom - top);
+}
+
+} // namespace
+
+DetectionOverlayItem::DetectionOverlayItem(QGraphicsItem* parent)
+    : QGraphicsItem(parent)
+    , drawAllBoxes_(false)
+    , indexDirty_(false)
+    , hovered_(-1) {
+    setFlag(QGraphicsItem::ItemUsesExtendedStyleOption);
+    setZValue(1.0);
+}
+
+void DetectionOverlayItem::setDetections(const std::vector<Core::Detection>& detections,
+                                         const QSize& imageSize, bool drawAllBoxes) {
+    prepareGeometryChange();
+    detections_ = detections;
+    imageSize_ = imageSize;
+    drawAllBoxes_ = drawAllBoxes;
+    indexDirty_ = true;
+    hovered_ = -1;
+    selection_.clear();
+    selectedMask_.assign(detections_.size(), 0);
+    update();
+}
+
+void DetectionOverlayItem::clear() {
+    prepareGeometryChange();
+    detections_.clear();
+    imageSize_ = QSize();
+    index_.build(detections_);
+    indexDirty_ = false;
+    hovered_ = -1;
+    selection_.clear();
+    selectedMask_.clear();
+}
+
+int DetectionOverlayItem::hitTest(const QPointF& point) const {
+    if (detections_.empty()) {
+        return -1;
+    }
+    return index().hitTest(static_cast<float>(point.x()), static_cast<float>(point.y()));
+}
+
+std::vector<int> DetectionOverlayItem::indicesInRect(const QRectF& rect) const {
+    if (detections_.empty()) {
+        return {};
+    }
+    return index().queryRect(toCvRect(rect.normalized()), true);
+}
+
+void DetectionOverlayItem::setHovered(int index) {
+    if (index == hovered_) {
+        return;
+    }
+    // Repaint only the boxes that change, not the whole overlay. The label
+    // sits above the box at a fixed screen size, so pad by it in item units.
+    qreal scale = 1.0;
+    if (scene() && !scene()->views().isEmpty()) {
+        scale = std::max<qreal>(scene()->views().first()->transform().m11(), 1e-3);
+    }
+    qreal pad = 4.0 / scale;
+    qreal labelPad = 32.0 / scale;
+    auto dirty = [&](int i) {
+        QRectF box = toQRectF(detections_[i].boundingBox);
+        update(box.adjusted(-pad, -labelPad, std::max(pad, 400.0 / scale - box.width()), pad));
+    };
+
+    if (hovered_ >= 0) {
+        dirty(hovered_);
+    }
+    hovered_ = (index >= 0 && index < static_cast<int>(detections_.size())) ? index : -1;
+    if (hovered_ >= 0) {
+        dirty(hovered_);
+    }
+}
+
+void DetectionOverlayItem::setSelection(const std::vector<int>& indices) {
+    selectedMask_.assign(detections_.size(), 0);
+    selection_.clear();
+    for (int index : indices) {
+        if (index >= 0 && index < static_cast<int>(detections_.size()) && !selectedMask_[index]) {
+            selectedMask_[index] = 1;
+            selection_.push_back(index);
+        }
+    }
+    update();
+}
+
+QRectF DetectionOverlayItem::boundingRect() const {
+    if (!imageSize_.isValid()) {
+        return QRectF();
+    }
+    return QRectF(QPointF(0, 0), imageSize_);
+}
+
+void DetectionOverlayItem::paint(QPainter* painter, const QStyleOptionGraphicsItem* option,
+                                 QWidget* widget) {
+    Q_UNUSED(widget)
+    if (detections_.empty()) {
+        return;
+    }
+
+    cv::Rect exposed = toCvRect(option->exposedRect);
+
+    if (drawAllBoxes_) {
+        for (int i : index().queryRect(exposed)) {
+            drawDetection(painter, detections_[i], selectedMask_[i] != 0);
+        }
+    } else if (!selection_.empty()) {
+        // A large selection is cheaper to cull through the index than by scanning it
+        if (selection_.size() > 64) {
+            for (int i : index().queryRect(exposed)) {
+                if (selectedMask_[i]) {
+                    drawDetection(painter, detections_[i], true);
+                }
+            }
+        } else {
+            for (int i : selection_) {
+                if ((detections_[i].boundingBox & exposed).area() > 0) {
+                    drawDetection(painter, detections_[i], true);
+                }
+            }
+        }
+    }
+
+    // Hovered box goes on top of everything else
+    if (hovered_ >= 0) {
+        drawDetection(painter, detections_[hovered_], true);
+    }
+}
+
+const Core::DetectionSpatialIndex& DetectionOverlayItem::index() const {
+    if (indexDirty_) {
+        index_.build(detections_);
+        indexDirty_ = false;
+    }
+    return index_;
+}
+
+void DetectionOverlayItem::drawDetection(QPainter* painter, const Core::Detection& detection,
+                                         bool highlighted) const {
+    QColor color = toQColor(Processing::ImageProcessor::getClassColor(detection.classId));
+
+    // Draw in device space so line width and label size do not scale with zoom
+    QRectF deviceRect = painter->worldTransform().mapRect(toQRectF(detection.boundingBox));
+
+    painter->save();
+    painter->resetTransform();
+
+    if (highlighted) {
+        QColor fill = color;
+        fill.setAlpha(60);
+        painter->fillRect(deviceRect, fill);
+    }
+    painter->setPen(QPen(color, highlighted ? 3 : 2));
+    painter->setBrush(Qt::NoBrush);
+    painter->drawRect(deviceRect);
+
+    QString label = QString("%1 %2%")
+                    .arg(QString::fromStdString(detection.className))
+                    .arg(qRound(detection.confidence * 100));
+    QFontMetrics metrics(painter->font());
+    QRectF labelRect(deviceRect.left(), deviceRect.top() - metrics.height() - 2,
+                     metrics.horizontalAdvance(label) + 4, metrics.height() + 2);
+    painter->fillRect(labelRect, color);
+    painter->setPen(Qt::white);
+    painter->drawText(labelRect.adjusted(2, 0, 0, 0), Qt::AlignLeft | Qt::AlignVCenter, label);
+
+    painter->restore();
+}
+
+} // namespace UI
+} // namespace YoloApp
@@ -0,0 +1,74 @@
+// src/ui/detection_overlay_item.h
+#pragma once
+
+#include "../core/types.h"
+#include "../core/spatial_index.h"
+#include <QGraphicsItem>
+#include <QSize>
+#include <vector>
+
+namespace YoloApp {
+namespace UI {
+
+/**
+ * @brief Draws detection boxes as vector overlays on top of the image
+ *
+ * When the image is not held in memory (tiled view) boxes cannot be baked
+ * into an annotated copy, so all of them are drawn here. Otherwise only the
+ * hovered and selected boxes are highlighted. Boxes are looked up through a
+ * spatial index built on first use, for painting and for hit-testing alike,
+ * with screen-constant line widths and label sizes.
+ */
+class DetectionOverlayItem : public QGraphicsItem {
+public:
+    explicit DetectionOverlayItem(QGraphicsItem* parent = nullptr);
+    ~DetectionOverlayItem() override = default;
+
+    /**
+     * @brief Replace the detections, resetting hover and selection
+     * @param drawAllBoxes Draw every box, not just hovered and selected ones
+     */
+    void setDetections(const std::vector<Core::Detection>& detections, const QSize& imageSize,
+                       bool drawAllBoxes);
+    void clear();
+
+    /**
+     * @brief Index of the detection under an item-space point, or -1
+     */
+    int hitTest(const QPointF& point) const;
+
+    /**
+     * @brief Indices of detections lying fully inside an item-space rectangle
+     */
+    std::vector<int> indicesInRect(const QRectF& rect) const;
+
+    const Core::Detection& detection(int index) const { return detections_[index]; }
+
+    void setHovered(int index);
+    int hovered() const { return hovered_; }
+
+    void setSelection(const std::vector<int>& indices);
+    const std::vector<int>& selection() const { return selection_; }
+
+    QRectF boundingRect() const override;
+    void paint(QPainter* painter, const QStyleOptionGraphicsItem* option,
+               QWidget* widget = nullptr) override;
+
+private:
+    const Core::DetectionSpatialIndex& index() const;
+    void drawDetection(QPainter* painter, const Core::Detection& detection, bool highlighted) const;
+
+    std::vector<Core::Detection> detections_;
+    QSize imageSize_;
+    bool drawAllBoxes_;
+
+    mutable Core::DetectionSpatialIndex index_;
+    mutable bool indexDirty_;
+
+    int hovered_;
+    std::vector<int> selection_;
+    std::vector<char> selectedMask_;
+};
+
+} // namespace UI
+} // namespace YoloApp
@@ -0,0 +1,125 @@
+// src/ui/display_image.cpp
+#include "display_image.h"
+#include <algorithm>
+#include <cmath>
+
+namespace YoloApp {
+namespace UI {
+
+namespace {
+constexpr int MIN_LEVEL_EDGE = 256;
+}
+
+std::shared_ptr<DisplayImage> DisplayImage::fromMat(const cv::Mat& mat, bool ownsMat) {
+    QImage wrapped = wrapMat(mat);
+    if (wrapped.isNull()) {
+        return nullptr;
+    }
+
+    std::shared_ptr<DisplayImage> image(new DisplayImage());
+    image->mat_ = mat;  // Shares the pixel buffer, keeps it alive for the wrap
+    image->ownsMat_ = ownsMat;
+    image->size_ = wrapped.size();
+    image->images_.push_back(wrapped);
+    image->initLevels();
+    return image;
+}
+
+std::shared_ptr<DisplayImage> DisplayImage::fromImage(const QImage& source) {
+    if (source.isNull()) {
+        return nullptr;
+    }
+
+    std::shared_ptr<DisplayImage> image(new DisplayImage());
+    image->size_ = source.size();
+    image->images_.push_back(source);
+    image->initLevels();
+    return image;
+}
+
+QImage DisplayImage::wrapMat(const cv::Mat& mat) {
+    if (mat.empty()) {
+        return QImage();
+    }
+
+    auto step = static_cast<qsizetype>(mat.step);
+    switch (mat.type()) {
+        case CV_8UC1:
+            return QImage(mat.data, mat.cols, mat.rows, step, QImage::Format_Grayscale8);
+        case CV_8UC3:
+            return QImage(mat.data, mat.cols, mat.rows, step, QImage::Format_BGR888);
+        case CV_8UC4:
+            // BGRA byte order matches ARGB32 on little-endian hosts
+            return QImage(mat.data, mat.cols, mat.rows, step, QImage::Format_ARGB32);
+        default:
+            return QImage();
+    }
+}
+
+int DisplayImage::levelForScale(qreal scale) const {
+    if (scale >= 1.0 || levelCount_ <= 1) {
+        return 0;
+    }
+
+    // Pick the smallest level that is still at least as large as the target
+    int level = static_cast<int>(std::floor(std::log2(1.0 / scale)));
+    return std::clamp(level, 0, levelCount_ - 1);
+}
+
+const QPixmap& DisplayImage::pixmap(int level) {
+    level = std::clamp(level, 0, std::max(0, levelCount_ - 1));
+    if (pixmaps_[level].isNull()) {
+        pixmaps_[level] = QPixmap::fromImage(levelImage(level));
+    }
+    return pixmaps_[level];
+}
+
+void DisplayImage::prepareLevels(int maxLevel) {
+    maxLevel = std::min(maxLevel, levelCount_ - 1);
+    for (int level = 0; level <= maxLevel; ++level) {
+        levelImage(level);
+    }
+}
+
+size_t DisplayImage::byteCost() const {
+    size_t cost = 0;
+    for (const QPixmap& pm : pixmaps_) {
+        if (!pm.isNull()) {
+            cost += static_cast<size_t>(pm.width()) * pm.height() * 4;
+        }
+    }
+    // Level 0 only owns memory when it is not a view of a Mat held elsewhere
+    if (ownsMat_) {
+        cost += mat_.total() * mat_.elemSize();
+    }
+    for (size_t level = mat_.empty() ? 0 : 1; level < images_.size(); ++level) {
+        cost += static_cast<size_t>(images_[level].sizeInBytes());
+    }
+    return cost;
+}
+
+void DisplayImage::initLevels() {
+    levelCount_ = 1;
+    int edge = std::max(size_.width(), size_.height());
+    while (edge / 2 >= MIN_LEVEL_EDGE) {
+        edge /= 2;
+        ++levelCount_;
+    }
+
+    images_.resize(levelCount_);
+    pixmaps_.resize(levelCount_);
+}
+
+const QImage& DisplayImage::levelImage(int level) {
+    if (images_[level].isNull()) {
+        // Each level halves the previous one, so building is cheap and cumulative
+        const QImage& previous = levelImage(level - 1);
+        images_[level] = previous.scaled(std::max(1, previous.width() / 2),
+                                         std::max(1, previous.height() / 2),
+                                         Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+    }
+    return images_[level];
+}
+
+} // namespace UI
+} // namespace YoloApp
@@ -0,0 +1,81 @@
+// src/ui/display_image.h
+#pragma once
+
+#include <opencv2/core.hpp>
+#include <QImage>
+#include <QPixmap>
+#include <memory>
+#include <vector>
+
+namespace YoloApp {
+namespace UI {
+
+/**
+ * @brief Display-ready image with a lazily built mip pyramid
+ *
+ * Level 0 wraps the cv::Mat pixels without copying (BGR888/Grayscale8/
+ * ARGB32); the Mat is kept alive by this object. Each further level halves
+ * the previous one. Level images can be prepared on any thread, while the
+ * pixmaps are created on first use on the GUI thread and then reused, so
+ * zooming never re-converts pixels.
+ */
+class DisplayImage {
+public:
+    /**
+     * @brief Wrap a BGR/BGRA/grayscale 8-bit Mat, or return nullptr for other types
+     * @param ownsMat The Mat was decoded for this image alone, so byteCost counts its pixels
+     */
+    static std::shared_ptr<DisplayImage> fromMat(const cv::Mat& mat, bool ownsMat = false);
+
+    /**
+     * @brief Wrap an already decoded QImage
+     */
+    static std::shared_ptr<DisplayImage> fromImage(const QImage& image);
+
+    /**
+     * @brief Zero-copy QImage view of a Mat (caller keeps the Mat alive)
+     */
+    static QImage wrapMat(const cv::Mat& mat);
+
+    QSize size() const { return size_; }
+
+    /**
+     * @brief Number of pyramid levels down to roughly 256 px
+     */
+    int levelCount() const { return levelCount_; }
+
+    /**
+     * @brief Pyramid level best suited for drawing at the given scale
+     */
+    int levelForScale(qreal scale) const;
+
+    /**
+     * @brief Pixmap for a pyramid level (GUI thread only)
+     */
+    const QPixmap& pixmap(int level);
+
+    /**
+     * @brief Build level images up to maxLevel (any thread)
+     */
+    void prepareLevels(int maxLevel);
+
+    /**
+     * @brief Approximate memory held by converted pixels, in bytes
+     */
+    size_t byteCost() const;
+
+private:
+    DisplayImage() = default;
+    void initLevels();
+    const QImage& levelImage(int level);
+
+    cv::Mat mat_;
+    bool ownsMat_ = false;
+    QSize size_;
+    int levelCount_ = 0;
+    std::vector<QImage> images_;
+    std::vector<QPixmap> pixmaps_;
+};
+
+} // namespace UI
+} // namespace YoloApp
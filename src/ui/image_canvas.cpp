@@ -0,0 +1,200 @@
+// src/ui/image_canvas.cpp
+#include "image_canvas.h"
+#include <QMouseEvent>
+#include <QToolTip>
+#include <QWheelEvent>
+
+namespace YoloApp {
+namespace UI {
+
+namespace {
+constexpr int CLICK_TOLERANCE = 3;
+}
+
+ImageCanvas::ImageCanvas(QWidget* parent)
+    : QGraphicsView(parent)
+    , scene_(new QGraphicsScene(this))
+    , imageItem_(new PyramidPixmapItem())
+    , tiledItem_(new TiledImageItem())
+    , overlayItem_(new DetectionOverlayItem())
+    , messageItem_(new QGraphicsSimpleTextItem())
+    , rubberBand_(nullptr)
+    , zoom_(1.0)
+    , rubberBandActive_(false) {
+    scene_->addItem(imageItem_);
+    scene_->addItem(tiledItem_);
+    scene_->addItem(overlayItem_);
+    scene_->addItem(messageItem_);
+    tiledItem_->setVisible(false);
+    setScene(scene_);
+
+    setDragMode(QGraphicsView::ScrollHandDrag);
+    setTransformationAnchor(QGraphicsView::AnchorViewCenter);
+    setViewportUpdateMode(QGraphicsView::SmartViewportUpdate);
+    setOptimizationFlag(QGraphicsView::DontSavePainterState);
+    setBackgroundBrush(QColor(240, 240, 240));
+    setMinimumSize(400, 300);
+
+    // Hover highlighting needs move events without a pressed button
+    viewport()->setMouseTracking(true);
+    rubberBand_ = new QRubberBand(QRubberBand::Rectangle, viewport());
+}
+
+void ImageCanvas::setDisplayImage(std::shared_ptr<DisplayImage> image) {
+    messageItem_->setVisible(false);
+    tiledItem_->clear();
+    tiledItem_->setVisible(false);
+    imageItem_->setDisplayImage(std::move(image));
+    imageItem_->setVisible(true);
+    scene_->setSceneRect(imageItem_->boundingRect());
+}
+
+void ImageCanvas::setTiledImage(const QString& imagePath, const QSize& imageSize) {
+    messageItem_->setVisible(false);
+    imageItem_->setDisplayImage(nullptr);
+    imageItem_->setVisible(false);
+    tiledItem_->setSource(imagePath, imageSize);
+    tiledItem_->setVisible(true);
+    scene_->setSceneRect(tiledItem_->boundingRect());
+}
+
+void ImageCanvas::setDetections(const std::vector<Core::Detection>& detections, bool drawBoxes) {
+    QSize imageSize = tiledItem_->isVisible() ? tiledItem_->boundingRect().size().toSize()
+                                              : imageItem_->boundingRect().size().toSize();
+    overlayItem_->setDetections(detections, imageSize, drawBoxes);
+    overlayItem_->setVisible(true);
+    QToolTip::hideText();
+}
+
+void ImageCanvas::clearDetections() {
+    overlayItem_->clear();
+    overlayItem_->setVisible(false);
+    QToolTip::hideText();
+}
+
+void ImageCanvas::showMessage(const QString& message) {
+    imageItem_->setDisplayImage(nullptr);
+    imageItem_->setVisible(false);
+    tiledItem_->clear();
+    tiledItem_->setVisible(false);
+    clearDetections();
+
+    messageItem_->setText(message);
+    messageItem_->setVisible(true);
+
+    // The message ignores zoom so it stays readable
+    messageItem_->setFlag(QGraphicsItem::ItemIgnoresTransformations);
+    scene_->setSceneRect(messageItem_->boundingRect());
+    centerOn(messageItem_);
+}
+
+void ImageCanvas::setZoom(double zoom) {
+    if (zoom <= 0.0) {
+        return;
+    }
+    zoom_ = zoom;
+    setTransform(QTransform::fromScale(zoom_, zoom_));
+}
+
+void ImageCanvas::wheelEvent(QWheelEvent* event) {
+    if (event->modifiers() & Qt::ControlModifier) {
+        int steps = event->angleDelta().y() / 120;
+        if (steps != 0) {
+            emit zoomStepRequested(steps);
+        }
+        event->accept();
+        return;
+    }
+    QGraphicsView::wheelEvent(event);
+}
+
+void ImageCanvas::mousePressEvent(QMouseEvent* event) {
+    pressPos_ = event->pos();
+
+    if (event->button() == Qt::LeftButton && (event->modifiers() & Qt::ShiftModifier) &&
+        overlayItem_->isVisible()) {
+        rubberBandActive_ = true;
+        rubberBand_->setGeometry(QRect(pressPos_, QSize()));
+        rubberBand_->show();
+        event->accept();
+        return;
+    }
+    QGraphicsView::mousePressEvent(event);
+}
+
+void ImageCanvas::mouseMoveEvent(QMouseEvent* event) {
+    if (rubberBandActive_) {
+        rubberBand_->setGeometry(QRect(pressPos_, event->pos()).normalized());
+        event->accept();
+        return;
+    }
+
+    if (event->buttons() == Qt::NoButton) {
+        updateHover(event->pos(), event->globalPosition().toPoint());
+    }
+    QGraphicsView::mouseMoveEvent(event);
+}
+
+void ImageCanvas::mouseReleaseEvent(QMouseEvent* event) {
+    if (rubberBandActive_) {
+        rubberBandActive_ = false;
+        rubberBand_->hide();
+
+        QRect viewRect = QRect(pressPos_, event->pos()).normalized();
+        QRectF itemRect = overlayItem_->mapFromScene(mapToScene(viewRect)).boundingRect();
+        selectDetections(overlayItem_->indicesInRect(itemRect));
+        event->accept();
+        return;
+    }
+
+    QGraphicsView::mouseReleaseEvent(event);
+
+    // A press that did not pan the view is a click on whatever box is under it
+    bool isClick = (event->pos() - pressPos_).manhattanLength() < CLICK_TOLERANCE;
+    if (event->button() == Qt::LeftButton && isClick && overlayItem_->isVisible()) {
+        int hit = overlayItem_->hitTest(overlayItem_->mapFromScene(mapToScene(event->pos())));
+        selectDetections(hit >= 0 ? std::vector<int>{hit} : std::vector<int>{});
+    }
+}
+
+void ImageCanvas::leaveEvent(QEvent* event) {
+    overlayItem_->setHovered(-1);
+    QGraphicsView::leaveEvent(event);
+}
+
+void ImageCanvas::updateHover(const QPoint& viewPos, const QPoint& globalPos) {
+    if (!overlayItem_->isVisible()) {
+        return;
+    }
+
+    int hit = overlayItem_->hitTest(overlayItem_->mapFromScene(mapToScene(viewPos)));
+    if (hit == overlayItem_->hovered()) {
+        return;
+    }
+    overlayItem_->setHovered(hit);
+
+    if (hit < 0) {
+        QToolTip::hideText();
+        return;
+    }
+    const Core::Detection& detection = overlayItem_->detection(hit);
+    const cv::Rect& box = detection.boundingBox;
+    QToolTip::showText(globalPos,
+                       QString("%1 (%2%)\n%3 x %4 at (%5, %6)")
+                       .arg(QString::fromStdString(detection.className))
+                       .arg(detection.confidence * 100, 0, 'f', 1)
+                       .arg(box.width).arg(box.height)
+                       .arg(box.x).arg(box.y),
+                       viewport());
+}
+
+void ImageCanvas::selectDetections(const std::vector<int>& indices) {
+    if (indices.empty() && overlayItem_->selection().empty()) {
+        return;
+    }
+    overlayItem_->setSelection(indices);
+    emit detectionSelectionChanged(overlayItem_->selection());
+}
+
+} // namespace UI
+} // namespace YoloApp
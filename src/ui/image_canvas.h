@@ -0,0 +1,101 @@
+// src/ui/image_canvas.h
+#pragma once
+
+#include "display_image.h"
+#include "pyramid_pixmap_item.h"
+#include "tiled_image_item.h"
+#include "detection_overlay_item.h"
+#include <QGraphicsView>
+#include <QGraphicsScene>
+#include <QGraphicsSimpleTextItem>
+#include <QRubberBand>
+#include <memory>
+#include <vector>
+
+namespace YoloApp {
+namespace UI {
+
+/**
+ * @brief Zoomable image surface used by ImageViewer
+ *
+ * Zoom is applied as a view transform; the image itself is converted once
+ * and drawn from its mip pyramid at whatever scale the view uses.
+ */
+class ImageCanvas : public QGraphicsView {
+    Q_OBJECT
+
+public:
+    explicit ImageCanvas(QWidget* parent = nullptr);
+    ~ImageCanvas() override = default;
+
+    /**
+     * @brief Show an image, keeping the current zoom
+     */
+    void setDisplayImage(std::shared_ptr<DisplayImage> image);
+
+    /**
+     * @brief Show a large image file from tiles without decoding the full frame
+     */
+    void setTiledImage(const QString& imagePath, const QSize& imageSize);
+
+    /**
+     * @brief Make the detections of the shown image hoverable and selectable
+     * @param drawBoxes Also draw every box (for images shown without baked annotations)
+     */
+    void setDetections(const std::vector<Core::Detection>& detections, bool drawBoxes);
+
+    /**
+     * @brief Remove the detection overlay
+     */
+    void clearDetections();
+
+    /**
+     * @brief Replace the image with a centered message
+     */
+    void showMessage(const QString& message);
+
+    /**
+     * @brief Set the zoom factor (1.0 = 100%)
+     */
+    void setZoom(double zoom);
+    double zoom() const { return zoom_; }
+
+    const std::shared_ptr<DisplayImage>& displayImage() const { return imageItem_->displayImage(); }
+
+signals:
+    /**
+     * @brief Ctrl+wheel zoom request, in slider steps (positive zooms in)
+     */
+    void zoomStepRequested(int steps);
+
+    /**
+     * @brief Selected detections changed (click or Shift+drag); empty when cleared
+     */
+    void detectionSelectionChanged(const std::vector<int>& indices);
+
+protected:
+    void wheelEvent(QWheelEvent* event) override;
+    void mousePressEvent(QMouseEvent* event) override;
+    void mouseMoveEvent(QMouseEvent* event) override;
+    void mouseReleaseEvent(QMouseEvent* event) override;
+    void leaveEvent(QEvent* event) override;
+
+private:
+    void updateHover(const QPoint& viewPos, const QPoint& globalPos);
+    void selectDetections(const std::vector<int>& indices);
+
+    QGraphicsScene* scene_;
+    PyramidPixmapItem* imageItem_;
+    TiledImageItem* tiledItem_;
+    DetectionOverlayItem* overlayItem_;
+    QGraphicsSimpleTextItem* messageItem_;
+    QRubberBand* rubberBand_;
+    double zoom_;
+
+    // Mouse state: a press that barely moves is a click, Shift+drag selects
+    QPoint pressPos_;
+    bool rubberBandActive_;
+};
+
+} // namespace UI
+} // namespace YoloApp
@@ -0,0 +1,238 @@
+// src/ui/image_prefetcher.cpp
+#include "image_prefetcher.h"
+#include "../core/config.h"
+#include "../processing/image_processor.h"
+#include <QImageReader>
+#include <QRunnable>
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+
+namespace YoloApp {
+namespace UI {
+
+namespace {
+
+/**
+ * @brief Pool task preparing one neighbor image
+ */
+class PrefetchTask : public QRunnable {
+public:
+    PrefetchTask(ImagePrefetcher* prefetcher, std::shared_ptr<Core::ImageResult> imageResult,
+                 bool annotated, quint64 generation, quint64 key,
+                 std::shared_ptr<std::atomic<bool>> cancelled,
+                 std::function<void(quint64, quint64, std::shared_ptr<DisplayImage>)> deliver)
+        : prefetcher_(prefetcher)
+        , imageResult_(std::move(imageResult))
+        , annotated_(annotated)
+        , generation_(generation)
+        , key_(key)
+        , cancelled_(std::move(cancelled))
+        , deliver_(std::move(deliver)) {
+    }
+
+    void run() override {
+        if (cancelled_->load()) {
+            return;
+        }
+
+        std::shared_ptr<DisplayImage> image = ImagePrefetcher::prepare(*imageResult_, annotated_);
+        if (cancelled_->load()) {
+            return;
+        }
+
+        QMetaObject::invokeMethod(prefetcher_, [deliver = deliver_, generation = generation_,
+                                                key = key_, image]() {
+            deliver(generation, key, image);
+        }, Qt::QueuedConnection);
+    }
+
+private:
+    ImagePrefetcher* prefetcher_;
+    std::shared_ptr<Core::ImageResult> imageResult_;
+    bool annotated_;
+    quint64 generation_;
+    quint64 key_;
+    std::shared_ptr<std::atomic<bool>> cancelled_;
+    std::function<void(quint64, quint64, std::shared_ptr<DisplayImage>)> deliver_;
+};
+
+} // namespace
+
+ImagePrefetcher::ImagePrefetcher(QObject* parent)
+    : QObject(parent)
+    , generation_(0)
+    , currentIndex_(-1)
+    , readyBytes_(0) {
+    pool_.setMaxThreadCount(2);
+}
+
+ImagePrefetcher::~ImagePrefetcher() {
+    cancelAll();
+    pool_.waitForDone();
+}
+
+void ImagePrefetcher::setImages(const std::vector<std::shared_ptr<Core::ImageResult>>& images) {
+    cancelAll();
+    images_ = images;
+    currentIndex_ = -1;
+}
+
+void ImagePrefetcher::prefetchAround(int imageIndex, bool annotated) {
+    currentIndex_ = imageIndex;
+    const int radius = Config::PREFETCH_RADIUS;
+
+    // Cancel work and drop images that fell out of the window
+    for (auto it = pending_.begin(); it != pending_.end();) {
+        if (std::abs(indexOf(it->first) - imageIndex) > radius) {
+            it->second.cancelled->store(true);
+            it = pending_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    for (auto it = ready_.begin(); it != ready_.end();) {
+        if (std::abs(indexOf(it->first) - imageIndex) > radius) {
+            readyBytes_ -= it->second.bytes;
+            it = ready_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    // Nearest neighbors first, forward before backward
+    for (int distance = 1; distance <= radius; ++distance) {
+        schedule(imageIndex + distance, annotated);
+        schedule(imageIndex - distance, annotated);
+    }
+}
+
+std::shared_ptr<DisplayImage> ImagePrefetcher::take(int imageIndex, bool annotated) {
+    auto it = ready_.find(key(imageIndex, annotated));
+    if (it == ready_.end()) {
+        return nullptr;
+    }
+
+    std::shared_ptr<DisplayImage> image = it->second.image;
+    readyBytes_ -= it->second.bytes;
+    ready_.erase(it);
+    return image;
+}
+
+bool ImagePrefetcher::isPending(int imageIndex, bool annotated) const {
+    return pending_.count(key(imageIndex, annotated)) > 0;
+}
+
+std::shared_ptr<DisplayImage> ImagePrefetcher::prepare(const Core::ImageResult& imageResult, bool annotated) {
+    if (!imageResult.processed) {
+        return nullptr;
+    }
+
+    cv::Mat source = annotated ? imageResult.annotatedImage : imageResult.originalImage;
+    if (!source.empty()) {
+        return DisplayImage::fromMat(source);
+    }
+
+    // Not held in memory: decode from disk unless the frame needs the tiled viewer
+    QSize size = QImageReader(QString::fromStdString(imageResult.imagePath)).size();
+    if (!size.isValid() ||
+        static_cast<size_t>(size.width()) * size.height() > Config::RETAIN_IMAGE_MAX_PIXELS) {
+        return nullptr;
+    }
+
+    try {
+        source = Processing::ImageProcessor::loadImage(imageResult.imagePath);
+    } catch (const std::exception&) {
+        return nullptr;
+    }
+    if (annotated) {
+        source = Processing::ImageProcessor::createAnnotatedImage(source, imageResult.detections);
+    }
+
+    // Wrapped as decoded; converting here would hold a second copy until display
+    return DisplayImage::fromMat(source, true);
+}
+
+quint64 ImagePrefetcher::key(int imageIndex, bool annotated) {
+    return (static_cast<quint64>(imageIndex) << 1) | (annotated ? 1u : 0u);
+}
+
+void ImagePrefetcher::schedule(int imageIndex, bool annotated) {
+    if (imageIndex < 0 || imageIndex >= static_cast<int>(images_.size())) {
+        return;
+    }
+
+    const auto& imageResult = images_[imageIndex];
+    if (!imageResult || !imageResult->processed) {
+        return;
+    }
+
+    quint64 k = key(imageIndex, annotated);
+    if (pending_.count(k) || ready_.count(k)) {
+        return;
+    }
+
+    auto cancelled = std::make_shared<std::atomic<bool>>(false);
+    pending_[k] = Pending{cancelled};
+
+    auto deliver = [this](quint64 generation, quint64 readyKey, std::shared_ptr<DisplayImage> image) {
+        onPrepared(generation, readyKey, std::move(image));
+    };
+
+    // Closer neighbors get higher priority
+    int priority = Config::PREFETCH_RADIUS - std::abs(imageIndex - currentIndex_);
+    pool_.start(new PrefetchTask(this, imageResult, annotated, generation_, k, cancelled, deliver),
+                priority);
+}
+
+void ImagePrefetcher::onPrepared(quint64 generation, quint64 key, std::shared_ptr<DisplayImage> image) {
+    if (generation != generation_) {
+        return;
+    }
+
+    auto it = pending_.find(key);
+    if (it == pending_.end()) {
+        return;  // Cancelled while the task was finishing
+    }
+    pending_.erase(it);
+
+    if (image) {
+        Ready entry;
+        entry.bytes = image->byteCost();
+        entry.image = std::move(image);
+        readyBytes_ += entry.bytes;
+        ready_[key] = std::move(entry);
+
+        enforceBudget();
+    }
+
+    // Also on failure, so a viewer waiting for it falls back to its own path
+    emit imagePrepared(indexOf(key), (key & 1u) != 0);
+}
+
+void ImagePrefetcher::enforceBudget() {
+    const size_t budget = static_cast<size_t>(Config::PREFETCH_BUDGET_MB) * 1024 * 1024;
+
+    while (readyBytes_ > budget && !ready_.empty()) {
+        auto farthest = std::max_element(ready_.begin(), ready_.end(),
+            [this](const auto& a, const auto& b) {
+                return std::abs(indexOf(a.first) - currentIndex_) <
+                       std::abs(indexOf(b.first) - currentIndex_);
+            });
+        readyBytes_ -= farthest->second.bytes;
+        ready_.erase(farthest);
+    }
+}
+
+void ImagePrefetcher::cancelAll() {
+    ++generation_;
+    for (auto& entry : pending_) {
+        entry.second.cancelled->store(true);
+    }
+    pending_.clear();
+    ready_.clear();
+    readyBytes_ = 0;
+}
+
+} // namespace UI
+} // namespace YoloApp
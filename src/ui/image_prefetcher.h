@@ -0,0 +1,97 @@
+// src/ui/image_prefetcher.h
+#pragma once
+
+#include "../core/types.h"
+#include "display_image.h"
+#include <QObject>
+#include <QThreadPool>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace YoloApp {
+namespace UI {
+
+/**
+ * @brief Prepares display-ready images for the neighbors of the current image
+ *
+ * When the viewer shows image i, the next and previous Config::PREFETCH_RADIUS
+ * images are decoded (if not in memory), annotated if needed and wrapped
+ * without conversion on a background pool,
+ * nearest first; the pixmap conversion happens only when an image is shown.
+ * Work for images that left the window is cancelled, and prepared images
+ * are evicted farthest-first once Config::PREFETCH_BUDGET_MB is exceeded.
+ * An image that becomes current while still being prepared is waited for
+ * (see isPending and imagePrepared) rather than decoded a second time.
+ */
+class ImagePrefetcher : public QObject {
+    Q_OBJECT
+
+public:
+    explicit ImagePrefetcher(QObject* parent = nullptr);
+    ~ImagePrefetcher() override;
+
+    /**
+     * @brief Switch to a new folder, dropping all prepared and pending images
+     */
+    void setImages(const std::vector<std::shared_ptr<Core::ImageResult>>& images);
+
+    /**
+     * @brief Move the prefetch window to be centered on an image
+     */
+    void prefetchAround(int imageIndex, bool annotated);
+
+    /**
+     * @brief Hand over a prepared image, or nullptr if it is not ready
+     */
+    std::shared_ptr<DisplayImage> take(int imageIndex, bool annotated);
+
+    /**
+     * @brief Whether the image is being prepared; imagePrepared follows when it is done
+     */
+    bool isPending(int imageIndex, bool annotated) const;
+
+    /**
+     * @brief Prepare an image synchronously (used on a prefetch miss)
+     *
+     * Returns nullptr for unprocessed images, unreadable files and frames
+     * too large to decode whole (those are shown by the tiled viewer).
+     */
+    static std::shared_ptr<DisplayImage> prepare(const Core::ImageResult& imageResult, bool annotated);
+
+signals:
+    /**
+     * @brief A pending image finished; take() has it unless it could not be prepared
+     */
+    void imagePrepared(int imageIndex, bool annotated);
+
+private:
+    struct Pending {
+        std::shared_ptr<std::atomic<bool>> cancelled;
+    };
+
+    struct Ready {
+        std::shared_ptr<DisplayImage> image;
+        size_t bytes = 0;
+    };
+
+    static quint64 key(int imageIndex, bool annotated);
+    static int indexOf(quint64 key) { return static_cast<int>(key >> 1); }
+
+    void schedule(int imageIndex, bool annotated);
+    void onPrepared(quint64 generation, quint64 key, std::shared_ptr<DisplayImage> image);
+    void enforceBudget();
+    void cancelAll();
+
+    std::vector<std::shared_ptr<Core::ImageResult>> images_;
+    quint64 generation_;
+    int currentIndex_;
+    QThreadPool pool_;
+    std::map<quint64, Pending> pending_;
+    std::map<quint64, Ready> ready_;
+    size_t readyBytes_;
+};
+
+} // namespace UI
+} // namespace YoloApp
@@ -2,10 +2,15 @@
 // src/ui/image_viewer.cpp
 #include "image_viewer.h"
 #include "../processing/image_processor.h"
+#include "../core/config.h"
+#include "../core/trace.h"
 #include <QFileDialog>
+#include <QItemSelectionModel>
+#include <QScrollBar>
 #include <QMessageBox>
 #include <QPixmap>
 #include <QApplication>
+#include <map>
 
 namespace YoloApp {
 namespace UI {
@@ -14,7 +19,11 @@ ImageViewer::ImageViewer(QWidget* parent)
     : QWidget(parent)
     , currentImageIndex_(-1)
     , showAnnotations_(true)
-    , currentZoom_(1.0) {
+    , currentZoom_(1.0)
+    , waitingForPrefetch_(false)
+    , prefetcher_(new ImagePrefetcher(this))
+    , displayedCacheKey_(0)
+    , displayCache_(Config::DISPLAY_CACHE_MB) {
     setupUI();
 }
 
@@ -24,9 +33,6 @@ void ImageViewer::setupUI() {
     // Controls
     controlsLayout_ = new QHBoxLayout();
     
-    imageSelector_ = new QComboBox();
-    imageSelector_->setMinimumWidth(200);
-    
     zoomSlider_ = new QSlider(Qt::Horizontal);
     zoomSlider_->setRange(10, 500);  // 10% to 500%
     zoomSlider_->setValue(100);      // 100%
@@ -38,8 +44,6 @@ void ImageViewer::setupUI() {
     toggleAnnotationsButton_ = new QPushButton("Hide Annotations");
     saveButton_ = new QPushButton("Save Image");
     
-    controlsLayout_->addWidget(new QLabel("Image:"));
-    controlsLayout_->addWidget(imageSelector_);
     controlsLayout_->addStretch();
     controlsLayout_->addWidget(new QLabel("Zoom:"));
     controlsLayout_->addWidget(zoomSlider_);
@@ -48,18 +52,13 @@ void ImageViewer::setupUI() {
     controlsLayout_->addWidget(saveButton_);
     
     // Content
-    contentLayout_ = new QHBoxLayout();
+    QWidget* contentWidget = new QWidget();
+    contentLayout_ = new QHBoxLayout(contentWidget);
+    contentLayout_->setContentsMargins(0, 0, 0, 0);
     
     // Image display
-    imageScrollArea_ = new QScrollArea();
-    imageLabel_ = new QLabel();
-    imageLabel_->setAlignment(Qt::AlignCenter);
-    imageLabel_->setMinimumSize(400, 300);
-    imageLabel_->setText("Select a folder to view images");
-    imageLabel_->setStyleSheet("border: 1px solid gray; background-color: #f0f0f0;");
-    
-    imageScrollArea_->setWidget(imageLabel_);
-    imageScrollArea_->setWidgetResizable(false);
+    imageCanvas_ = new ImageCanvas();
+    imageCanvas_->showMessage("Select a folder to view images");
     
     // Metadata
     metadataText_ = new QTextEdit();
@@ -67,60 +66,128 @@ void ImageViewer::setupUI() {
     metadataText_->setMaximumWidth(300);
     metadataText_->setMinimumWidth(250);
     
-    contentLayout_->addWidget(imageScrollArea_, 3);
+    contentLayout_->addWidget(imageCanvas_, 3);
     contentLayout_->addWidget(metadataText_, 1);
     
+    // Thumbnail grid: the view only asks the model for visible cells
+    thumbnailModel_ = new ThumbnailModel(Config::THUMBNAIL_SIZE, this);
+    
+    thumbnailView_ = new QListView();
+    thumbnailView_->setModel(thumbnailModel_);
+    thumbnailView_->setViewMode(QListView::IconMode);
+    thumbnailView_->setFlow(QListView::LeftToRight);
+    thumbnailView_->setWrapping(true);
+    thumbnailView_->setResizeMode(QListView::Adjust);
+    thumbnailView_->setMovement(QListView::Static);
+    thumbnailView_->setUniformItemSizes(true);
+    thumbnailView_->setLayoutMode(QListView::Batched);
+    thumbnailView_->setBatchSize(512);
+    thumbnailView_->setIconSize(QSize(Config::THUMBNAIL_SIZE, Config::THUMBNAIL_SIZE));
+    thumbnailView_->setGridSize(QSize(Config::THUMBNAIL_SIZE + 12, Config::THUMBNAIL_SIZE + 28));
+    thumbnailView_->setSelectionMode(QAbstractItemView::SingleSelection);
+    thumbnailView_->setVerticalScrollMode(QAbstractItemView::ScrollPerPixel);
+    thumbnailView_->setMinimumHeight(Config::THUMBNAIL_SIZE + 40);
+    
+    viewerSplitter_ = new QSplitter(Qt::Vertical);
+    viewerSplitter_->addWidget(contentWidget);
+    viewerSplitter_->addWidget(thumbnailView_);
+    viewerSplitter_->setStretchFactor(0, 3);
+    viewerSplitter_->setStretchFactor(1, 1);
+    
     mainLayout_->addLayout(controlsLayout_);
-    mainLayout_->addLayout(contentLayout_);
+    mainLayout_->addWidget(viewerSplitter_);
     
     // Connect signals
-    connect(imageSelector_, QOverload<int>::of(&QComboBox::currentIndexChanged),
-            this, &ImageViewer::onImageSelectionChanged);
+    connect(thumbnailView_->selectionModel(), &QItemSelectionModel::currentChanged,
+            this, &ImageViewer::onThumbnailCurrentChanged);
+    connect(thumbnailView_->verticalScrollBar(), &QScrollBar::valueChanged,
+            this, &ImageViewer::updateVisibleThumbnailRange);
+    connect(thumbnailView_->verticalScrollBar(), &QScrollBar::rangeChanged,
+            this, &ImageViewer::updateVisibleThumbnailRange);
     connect(zoomSlider_, &QSlider::valueChanged, this, &ImageViewer::onZoomChanged);
+    connect(imageCanvas_, &ImageCanvas::zoomStepRequested, this, [this](int steps) {
+        zoomSlider_->setValue(zoomSlider_->value() + steps * 10);
+    });
+    connect(imageCanvas_, &ImageCanvas::detectionSelectionChanged,
+            this, &ImageViewer::onDetectionSelectionChanged);
+    connect(prefetcher_, &ImagePrefetcher::imagePrepared, this, [this](int imageIndex, bool annotated) {
+        if (waitingForPrefetch_ && imageIndex == currentImageIndex_ && annotated == showAnnotations_) {
+            updateImageDisplay();
+        }
+    });
     connect(toggleAnnotationsButton_, &QPushButton::clicked, this, &ImageViewer::onToggleAnnotations);
     connect(saveButton_, &QPushButton::clicked, this, &ImageViewer::onSaveImage);
     
     // Initial state
-    imageSelector_->setEnabled(false);
+    thumbnailView_->setEnabled(false);
     saveButton_->setEnabled(false);
 }
 
-void ImageViewer::displayFolder(const Core::FolderResult& folderResult) {
-    currentFolder_ = folderResult;
+void ImageViewer::displayFolder(Core::FolderResult folderResult) {
+    currentFolder_ = std::move(folderResult);
     currentImageIndex_ = -1;
+    displayCache_.clear();
+    prefetcher_->setImages(currentFolder_.images);
     
-    // Populate image selector
-    imageSelector_->clear();
-    for (int i = 0; i < static_cast<int>(folderResult.images.size()); ++i) {
-        const auto& img = folderResult.images[i];
-        QString itemText = QString("Image %1").arg(i + 1);
-        if (img && img->processed) {
-            itemText += QString(" (%1 detections)").arg(img->getDetectionCount());
-        }
-        imageSelector_->addItem(itemText);
-    }
-    
-    imageSelector_->setEnabled(!folderResult.images.empty());
+    thumbnailModel_->setImages(currentFolder_.images);
+    thumbnailView_->setEnabled(!currentFolder_.images.empty());
+    updateVisibleThumbnailRange();
     
     // Select first image if available
-    if (!folderResult.images.empty()) {
-        imageSelector_->setCurrentIndex(0);
-        onImageSelectionChanged(0);
+    if (!currentFolder_.images.empty()) {
+        thumbnailView_->setCurrentIndex(thumbnailModel_->index(0));
+        thumbnailView_->scrollToTop();
     } else {
         clear();
     }
 }
 
+void ImageViewer::updateFolder(Core::FolderResult folderResult) {
+    if (currentFolder_.images.empty() || folderResult.folderPath != currentFolder_.folderPath ||
+        folderResult.images.size() != currentFolder_.images.size()) {
+        return;
+    }
+    
+    currentFolder_ = std::move(folderResult);
+    displayCache_.clear();
+    prefetcher_->setImages(currentFolder_.images);
+    thumbnailModel_->updateImages(currentFolder_.images);
+    
+    updateImageDisplay();
+    updateMetadata();
+}
+
+void ImageViewer::markImageProcessed(const QString& imagePath, int detectionCount) {
+    thumbnailModel_->setImageProcessed(imagePath, detectionCount);
+}
+
 void ImageViewer::clear() {
-    imageLabel_->clear();
-    imageLabel_->setText("Select a folder to view images");
+    imageCanvas_->showMessage("Select a folder to view images");
+    displayCache_.clear();
+    prefetcher_->setImages({});
     metadataText_->clear();
-    imageSelector_->clear();
-    imageSelector_->setEnabled(false);
+    thumbnailModel_->clear();
+    thumbnailView_->setEnabled(false);
     saveButton_->setEnabled(false);
     currentImageIndex_ = -1;
 }
 
+void ImageViewer::onThumbnailCurrentChanged(const QModelIndex& current) {
+    if (current.isValid()) {
+        onImageSelectionChanged(current.row());
+    }
+}
+
+void ImageViewer::updateVisibleThumbnailRange() {
+    QRect viewport = thumbnailView_->viewport()->rect();
+    QModelIndex first = thumbnailView_->indexAt(viewport.topLeft() + QPoint(4, 4));
+    QModelIndex last = thumbnailView_->indexAt(viewport.bottomRight() - QPoint(4, 4));
+    
+    int firstRow = first.isValid() ? first.row() : 0;
+    int lastRow = last.isValid() ? last.row() : thumbnailModel_->rowCount() - 1;
+    thumbnailModel_->setVisibleRange(firstRow, lastRow);
+}
+
 void ImageViewer::onImageSelectionChanged(int index) {
     if (index < 0 || index >= static_cast<int>(currentFolder_.images.size())) {
         return;
@@ -137,7 +204,9 @@ void ImageViewer::onImageSelectionChanged(int index) {
 void ImageViewer::onZoomChanged(int value) {
     currentZoom_ = value / 100.0;
     zoomLabel_->setText(QString("%1%").arg(value));
-    updateImageDisplay();
+    
+    // Zoom is a view transform; the cached pixmap pyramid is reused as-is
+    imageCanvas_->setZoom(currentZoom_);
 }
 
 void ImageViewer::onToggleAnnotations(bool show) {
@@ -164,7 +233,9 @@ void ImageViewer::onSaveImage() {
     
     if (!fileName.isEmpty()) {
         cv::Mat imageToSave = showAnnotations_ ? imageResult->annotatedImage : imageResult->originalImage;
-        if (!imageToSave.empty()) {
+        if (imageToSave.empty()) {
+            QMessageBox::warning(this, "Warning", "Image is too large to be kept in memory and cannot be saved from the viewer.");
+        } else {
             if (cv::imwrite(fileName.toStdString(), imageToSave)) {
                 QMessageBox::information(this, "Success", "Image saved successfully.");
             } else {
@@ -175,31 +246,93 @@ void ImageViewer::onSaveImage() {
 }
 
 void ImageViewer::updateImageDisplay() {
+    YOLO_TRACE_SPAN("ui_display_image");
     if (currentImageIndex_ < 0 || currentImageIndex_ >= static_cast<int>(currentFolder_.images.size())) {
         return;
     }
     
     const auto& imageResult = currentFolder_.images[currentImageIndex_];
     if (!imageResult || !imageResult->processed) {
-        imageLabel_->setText("Image processing...");
+        imageCanvas_->showMessage("Image processing...");
+        return;
+    }
+    
+    // A neighbor still being prepared is waited for instead of decoded a second time
+    waitingForPrefetch_ = !displayCache_.contains(displayCacheKey(currentImageIndex_, showAnnotations_)) &&
+                          prefetcher_->isPending(currentImageIndex_, showAnnotations_);
+    if (waitingForPrefetch_) {
+        imageCanvas_->showMessage("Loading image...");
+        prefetcher_->prefetchAround(currentImageIndex_, showAnnotations_);
         return;
     }
     
-    cv::Mat displayImage = showAnnotations_ ? imageResult->annotatedImage : imageResult->originalImage;
+    std::shared_ptr<DisplayImage> displayImage = displayImageFor(currentImageIndex_, showAnnotations_);
+    
+    // Start preparing the neighbors while the user looks at this one
+    prefetcher_->prefetchAround(currentImageIndex_, showAnnotations_);
+    
+    if (displayImage) {
+        // Boxes are baked into the annotated image; the overlay only adds hover and selection
+        imageCanvas_->setDisplayImage(displayImage);
+        imageCanvas_->setDetections(imageResult->detections, false);
+        imageCanvas_->setZoom(currentZoom_);
+        return;
+    }
     
-    if (displayImage.empty()) {
-        imageLabel_->setText("Failed to load image");
+    // Frames too large to decode whole are rendered from tiles with a box overlay
+    QString imagePath = QString::fromStdString(imageResult->imagePath);
+    QSize imageSize = TiledImageItem::probeImageSize(imagePath);
+    if (!imageResult->originalImage.empty() || !imageSize.isValid()) {
+        imageCanvas_->showMessage("Failed to load image");
         return;
     }
     
-    // Apply zoom
-    if (currentZoom_ != 1.0) {
-        displayImage = scaleImage(displayImage, currentZoom_);
+    imageCanvas_->setTiledImage(imagePath, imageSize);
+    imageCanvas_->setDetections(imageResult->detections, showAnnotations_);
+    imageCanvas_->setZoom(currentZoom_);
+}
+
+quint64 ImageViewer::displayCacheKey(int imageIndex, bool annotated) {
+    return (static_cast<quint64>(imageIndex) << 1) | (annotated ? 1u : 0u);
+}
+
+std::shared_ptr<DisplayImage> ImageViewer::displayImageFor(int imageIndex, bool annotated) {
+    quint64 key = displayCacheKey(imageIndex, annotated);
+    
+    // Pixmaps are built on paint, so the entry shown last has grown since it was charged
+    if (std::shared_ptr<DisplayImage>* shown = displayCache_.object(displayedCacheKey_)) {
+        std::shared_ptr<DisplayImage> image = *shown;
+        cacheDisplayImage(displayedCacheKey_, image);
+    }
+    displayedCacheKey_ = key;
+    
+    if (std::shared_ptr<DisplayImage>* cached = displayCache_.object(key)) {
+        return *cached;
     }
     
-    QPixmap pixmap = matToQPixmap(displayImage);
-    imageLabel_->setPixmap(pixmap);
-    imageLabel_->resize(pixmap.size());
+    std::shared_ptr<DisplayImage> displayImage = prefetcher_->take(imageIndex, annotated);
+    
+    if (!displayImage) {
+        const auto& imageResult = currentFolder_.images[imageIndex];
+        const cv::Mat& mat = annotated ? imageResult->annotatedImage : imageResult->originalImage;
+        
+        // Wraps the Mat without copying; pixmaps are created once on first paint.
+        // Images not held in memory are decoded from disk on a prefetch miss.
+        displayImage = mat.empty() ? ImagePrefetcher::prepare(*imageResult, annotated)
+                                   : DisplayImage::fromMat(mat);
+        if (!displayImage) {
+            return nullptr;
+        }
+    }
+    
+    cacheDisplayImage(key, displayImage);
+    return displayImage;
+}
+
+void ImageViewer::cacheDisplayImage(quint64 key, const std::shared_ptr<DisplayImage>& displayImage) {
+    // Replacing an entry re-charges it with what its levels and pixmaps hold now
+    int costMb = std::max(1, static_cast<int>(displayImage->byteCost() / (1024 * 1024)));
+    displayCache_.insert(key, new std::shared_ptr<DisplayImage>(displayImage), costMb);
 }
 
 void ImageViewer::updateMetadata() {
@@ -219,43 +352,64 @@ void ImageViewer::updateMetadata() {
         return;
     }
     
-    metadataText_->setText(QString::fromStdString(imageResult->metadata));
+    // Results loaded from a saved session carry no metadata text; build it on first view
+    if (imageResult->metadata.empty()) {
+        imageResult->metadata = Processing::ImageProcessor::generateMetadata(
+            imageResult->imagePath, imageResult->imageSize, 0, imageResult->detections);
+    }
+    
+    std::string text = imageResult->metadata;
+    std::string timing = Processing::ImageProcessor::generateTimingReport(*imageResult);
+    if (!timing.empty()) {
+        text += "\n" + timing;
+    }
+    metadataText_->setText(QString::fromStdString(text));
 }
 
-QPixmap ImageViewer::matToQPixmap(const cv::Mat& mat) {
-    if (mat.empty()) {
-        return QPixmap();
+void ImageViewer::onDetectionSelectionChanged(const std::vector<int>& indices) {
+    if (indices.empty()) {
+        updateMetadata();
+        return;
     }
     
-    QImage qimg;
-    
-    if (mat.type() == CV_8UC1) {
-        qimg = QImage(mat.data, mat.cols, mat.rows, mat.step, QImage::Format_Grayscale8);
-    } else if (mat.type() == CV_8UC3) {
-        cv::Mat rgbMat;
-        cv::cvtColor(mat, rgbMat, cv::COLOR_BGR2RGB);
-        qimg = QImage(rgbMat.data, rgbMat.cols, rgbMat.rows, rgbMat.step, QImage::Format_RGB888);
-    } else if (mat.type() == CV_8UC4) {
-        cv::Mat rgbaMat;
-        cv::cvtColor(mat, rgbaMat, cv::COLOR_BGRA2RGBA);
-        qimg = QImage(rgbaMat.data, rgbaMat.cols, rgbaMat.rows, rgbaMat.step, QImage::Format_RGBA8888);
-    } else {
-        return QPixmap();
+    if (currentImageIndex_ < 0 || currentImageIndex_ >= static_cast<int>(currentFolder_.images.size())) {
+        return;
     }
+    const auto& imageResult = currentFolder_.images[currentImageIndex_];
+    if (!imageResult) {
+        return;
+    }
+    const auto& detections = imageResult->detections;
     
-    return QPixmap::fromImage(qimg);
-}
-
-cv::Mat ImageViewer::scaleImage(const cv::Mat& image, double scale) {
-    if (scale == 1.0) {
-        return image;
+    std::map<std::string, int> classCounts;
+    for (int index : indices) {
+        classCounts[detections[index].className]++;
+    }
+    
+    QString text = QString("Selected %1 of %2 detections\n\n")
+                   .arg(indices.size()).arg(detections.size());
+    for (const auto& [className, count] : classCounts) {
+        text += QString("  %1: %2\n").arg(QString::fromStdString(className)).arg(count);
+    }
+    text += "\n";
+    
+    // Listing every box of a huge rectangle selection would only stall the text widget
+    const size_t maxListed = 200;
+    for (size_t i = 0; i < indices.size() && i < maxListed; ++i) {
+        const Core::Detection& detection = detections[indices[i]];
+        const cv::Rect& box = detection.boundingBox;
+        text += QString("#%1 %2 %3%  [%4, %5, %6 x %7]\n")
+                .arg(indices[i])
+                .arg(QString::fromStdString(detection.className))
+                .arg(detection.confidence * 100, 0, 'f', 1)
+                .arg(box.x).arg(box.y).arg(box.width).arg(box.height);
+    }
+    if (indices.size() > maxListed) {
+        text += QString("... and %1 more\n").arg(indices.size() - maxListed);
     }
     
-    cv::Mat scaled;
-    cv::Size newSize(static_cast<int>(image.cols * scale), static_cast<int>(image.rows * scale));
-    cv::resize(image, scaled, newSize, 0, 0, cv::INTER_LINEAR);
-    return scaled;
+    metadataText_->setPlainText(text);
 }
 
 } // namespace UI
-} // namespace YoloApp
\ No newline at end of file
+} // namespace YoloApp
@@ -3,8 +3,10 @@
 #pragma once
 
 #include "../core/types.h"
+#include "thumbnail_model.h"
+#include "image_canvas.h"
+#include "image_prefetcher.h"
 #include <QWidget>
-#include <QScrollArea>
 #include <QLabel>
 #include <QTextEdit>
 #include <QVBoxLayout>
@@ -12,9 +14,11 @@
 #include <QGridLayout>
 #include <QPushButton>
 #include <QSlider>
-#include <QComboBox>
-#include <QPixmap>
+#include <QListView>
+#include <QSplitter>
+#include <QCache>
 #include <memory>
+#include <vector>
 
 namespace YoloApp {
 namespace UI {
@@ -32,7 +36,19 @@ public:
     /**
      * @brief Display images from a folder result
      */
-    void displayFolder(const Core::FolderResult& folderResult);
+    void displayFolder(Core::FolderResult folderResult);
+    
+    /**
+     * @brief Swap in the completed results of the folder on display, keeping the selection
+     *
+     * Ignored unless it is the same folder with the same images.
+     */
+    void updateFolder(Core::FolderResult folderResult);
+    
+    /**
+     * @brief Update the thumbnail label of an image the worker just processed
+     */
+    void markImageProcessed(const QString& imagePath, int detectionCount);
     
     /**
      * @brief Clear the display
@@ -44,31 +60,36 @@ signals:
 
 private slots:
     void onImageSelectionChanged(int index);
+    void onThumbnailCurrentChanged(const QModelIndex& current);
+    void updateVisibleThumbnailRange();
     void onZoomChanged(int value);
     void onToggleAnnotations(bool show);
     void onSaveImage();
+    void onDetectionSelectionChanged(const std::vector<int>& indices);
 
 private:
     void setupUI();
     void updateImageDisplay();
     void updateMetadata();
-    QPixmap matToQPixmap(const cv::Mat& mat);
-    cv::Mat scaleImage(const cv::Mat& image, double scale);
+    static quint64 displayCacheKey(int imageIndex, bool annotated);
+    std::shared_ptr<DisplayImage> displayImageFor(int imageIndex, bool annotated);
+    void cacheDisplayImage(quint64 key, const std::shared_ptr<DisplayImage>& displayImage);
     
     QVBoxLayout* mainLayout_;
     QHBoxLayout* controlsLayout_;
     QHBoxLayout* contentLayout_;
+    QSplitter* viewerSplitter_;
     
     // Controls
-    QComboBox* imageSelector_;
+    QListView* thumbnailView_;
+    ThumbnailModel* thumbnailModel_;
     QSlider* zoomSlider_;
     QPushButton* toggleAnnotationsButton_;
     QPushButton* saveButton_;
     QLabel* zoomLabel_;
     
     // Display
-    QScrollArea* imageScrollArea_;
-    QLabel* imageLabel_;
+    ImageCanvas* imageCanvas_;
     QTextEdit* metadataText_;
     
     // Data
@@ -76,6 +97,14 @@ private:
     int currentImageIndex_;
     bool showAnnotations_;
     double currentZoom_;
+    bool waitingForPrefetch_;   // The current image is still being prepared by the prefetcher
+    
+    // Background preparation of the neighbors of the current image
+    ImagePrefetcher* prefetcher_;
+    
+    // Converted images keyed by (image index, annotated), cost in MB of DisplayImage::byteCost
+    quint64 displayedCacheKey_;
+    QCache<quint64, std::shared_ptr<DisplayImage>> displayCache_;
 };
 } // namespace UI
 } // namespace YoloApp
\ No newline at end of file
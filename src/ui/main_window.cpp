@@ -1,6 +1,8 @@
 // src/ui/main_window.cpp
 #include "main_window.h"
+#include "auto_tune_dialog.h"
 #include "../core/config.h"
+#include "../core/trace.h"
 #include <QApplication>
 #include <QCloseEvent>
 #include <QStandardPaths>
@@ -11,6 +13,10 @@
 #include <QFormLayout>
 #include <QDialogButtonBox>
 #include <QDialog>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QCryptographicHash>
 
 namespace YoloApp {
 namespace UI {
@@ -18,23 +24,43 @@ namespace UI {
 MainWindow::MainWindow(QWidget* parent)
     : QMainWindow(parent)
     , detector_(std::make_shared<Core::YoloDetector>())
+    , engine_(std::make_shared<Core::EngineHandle>(detector_))
     , worker_(nullptr)
-    , processingActive_(false) {
+    , modelCache_(std::make_shared<Core::ModelCache>(Config::MODEL_CACHE_ENTRIES))
+    , scheduler_(std::make_shared<Core::ThreadScheduler>())
+    , parallelEngines_(1)
+    , displayedFolderIndex_(-1)
+    , processingActive_(false)
+    , modelLoading_(false) {
     
     // Initialize settings
     QString configPath = QStandardPaths::writableLocation(QStandardPaths::AppConfigLocation);
     QDir().mkpath(configPath);
     settings_ = new QSettings(configPath + "/settings.ini", QSettings::IniFormat, this);
     
+    Core::Trace::setThreadName("ui");
+    
     setupUI();
     connectSignals();
     loadSettings();
     updateModelStatus();
     updateFolderStatus();
     updateProcessingControls();
+    
+    // Reload the last model in the background once the window is up, unless
+    // a model was requested on the command line meanwhile
+    QTimer::singleShot(0, this, [this]() {
+        if (!modelLoading_ && !detector_->isLoaded() && QFileInfo::exists(lastModelPath_)) {
+            loadModel(lastModelPath_, lastConfigPath_, lastClassesPath_);
+        }
+    });
 }
 
 MainWindow::~MainWindow() {
+    if (exportWorker_) {
+        exportWorker_->requestCancellation();
+        exportWorker_->wait();
+    }
     if (worker_) {
         worker_->requestCancellation();
         worker_->quit();
@@ -51,10 +77,10 @@ void MainWindow::setupUI() {
     setCentralWidget(centralWidget_);
     mainLayout_ = new QVBoxLayout(centralWidget_);
     
-    setupMenuBar();
     setupMainControls();
     setupContentArea();
     setupStatusBar();
+    setupMenuBar();     // Last: the View menu lists the docks
 }
 
 void MainWindow::setupMenuBar() {
@@ -66,14 +92,36 @@ void MainWindow::setupMenuBar() {
     // FIXED: Use the correct Qt6 addAction syntax
     fileMenu->addAction("&Load Model...", QKeySequence::Open, this, &MainWindow::onLoadModel);
     fileMenu->addAction("&Select Folder...", QKeySequence("Ctrl+F"), this, &MainWindow::onSelectFolder);
+    fileMenu->addAction("Open Sess&ion...", QKeySequence("Ctrl+Shift+O"), this, &MainWindow::onOpenSession);
     fileMenu->addSeparator();
     fileMenu->addAction("&Export Results...", QKeySequence("Ctrl+E"), this, &MainWindow::onExportResults);
+    fileMenu->addAction("Export &Images...", QKeySequence("Ctrl+Shift+E"), this, &MainWindow::onExportImages);
     fileMenu->addSeparator();
     fileMenu->addAction("E&xit", QKeySequence::Quit, this, &MainWindow::onExit);
     
     // Settings menu
     QMenu* settingsMenu = menuBar->addMenu("&Settings");
     settingsMenu->addAction("&Model Settings...", this, &MainWindow::onModelSettings);
+    settingsMenu->addAction("&Auto-Tune...", this, &MainWindow::onAutoTune);
+    settingsMenu->addSeparator();
+    
+    // Span tracing (compiled in with YOLO_TRACING)
+    QAction* recordTraceAction = settingsMenu->addAction("Record &Trace");
+    recordTraceAction->setCheckable(true);
+    recordTraceAction->setChecked(Core::Trace::isEnabled());
+    connect(recordTraceAction, &QAction::toggled, this, &MainWindow::onRecordTraceToggled);
+    QAction* saveTraceAction = settingsMenu->addAction("Save Trace...", this, &MainWindow::onSaveTrace);
+    if (!Core::Trace::compiledIn()) {
+        recordTraceAction->setEnabled(false);
+        saveTraceAction->setEnabled(false);
+        recordTraceAction->setToolTip("Built without YOLO_TRACING");
+    }
+    
+    // View menu
+    QMenu* viewMenu = menuBar->addMenu("&View");
+    QAction* metricsAction = metricsDock_->toggleViewAction();
+    metricsAction->setShortcut(QKeySequence("Ctrl+M"));
+    viewMenu->addAction(metricsAction);
     
     // Help menu
     QMenu* helpMenu = menuBar->addMenu("&Help");
@@ -103,9 +151,14 @@ void MainWindow::setupMainControls() {
     modelStatusLabel_ = new QLabel("No model loaded");
     modelStatusLabel_->setStyleSheet(Config::WARNING_COLOR);
     
+    modelLoadProgress_ = new QProgressBar();
+    modelLoadProgress_->setRange(0, 100);
+    modelLoadProgress_->setVisible(false);
+    
     modelLayout->addLayout(modelButtonLayout);
     modelLayout->addWidget(modelPathEdit_);
     modelLayout->addWidget(modelStatusLabel_);
+    modelLayout->addWidget(modelLoadProgress_);
     
     // Folder controls
     folderGroup_ = new QGroupBox("Input Folder");
@@ -170,6 +223,11 @@ void MainWindow::setupContentArea() {
     mainSplitter_->setStretchFactor(1, 2);
     
     mainLayout_->addWidget(mainSplitter_);
+    
+    // Live metrics, hidden until opened from the View menu
+    metricsDock_ = new MetricsDock(this);
+    addDockWidget(Qt::RightDockWidgetArea, metricsDock_);
+    metricsDock_->hide();
 }
 
 void MainWindow::setupStatusBar() {
@@ -198,101 +256,201 @@ void MainWindow::connectSignals() {
     connect(resultsWidget_, &ResultsWidget::folderSelected, this, &MainWindow::onFolderSelected);
     connect(resultsWidget_, &ResultsWidget::exportRequested, this, &MainWindow::onExportResults);
     connect(resultsWidget_, &ResultsWidget::refreshRequested, this, &MainWindow::onRefreshResults);
+    connect(resultsWidget_, &ResultsWidget::queryRequested, this, &MainWindow::onQueryRequested);
 }
 
-// void MainWindow::onLoadModel() {
-//     QString modelPath = QFileDialog::getOpenFileName(this,
-//         "Select YOLO Model",
-//         lastModelPath_.isEmpty() ? QDir::homePath() : QFileInfo(lastModelPath_).dir().path(),
-//         "Model Files (*.onnx *.weights *.pt *.pb);;All Files (*)");
-    
-//     if (modelPath.isEmpty()) {
-//         return;
-//     }
-    
-//     // Check for config file for Darknet models
-//     QString configPath;
-//     if (modelPath.endsWith(".weights", Qt::CaseInsensitive)) {
-//         QString configFile = QFileDialog::getOpenFileName(this,
-//             "Select Config File (Optional)",
-//             QFileInfo(modelPath).dir().path(),
-//             "Config Files (*.cfg);;All Files (*)");
-//         if (!configFile.isEmpty()) {
-//             configPath = configFile;
-//         }
-//     }
-    
-//     // Check for custom class names
-//     QString classesPath;
-//     QMessageBox::StandardButton reply = QMessageBox::question(this,
-//         "Class Names", "Do you want to load custom class names?",
-//         QMessageBox::Yes | QMessageBox::No);
-    
-//     if (reply == QMessageBox::Yes) {
-//         classesPath = QFileDialog::getOpenFileName(this,
-//             "Select Class Names File",
-//             QFileInfo(modelPath).dir().path(),
-//             "Text Files (*.txt *.names);;All Files (*)");
-//     }
-    
-//     // Load the model
-//     bool success = detector_->loadModel(modelPath.toStdString(),
-//                                        configPath.toStdString(),
-//                                        classesPath.toStdString());
-    
-//     if (success) {
-//         lastModelPath_ = modelPath;
-//         modelPathEdit_->setText(modelPath);
-//         updateModelStatus();
-//         updateProcessingControls();
-        
-//         QMessageBox::information(this, "Success", "Model loaded successfully!");
-//     } else {
-//         QMessageBox::critical(this, "Error", "Failed to load model. Please check the file format and try again.");
-//     }
-// }
-
-void MainWindow::loadModel() {
-    QString filter = "Model Files (*.onnx *.weights);;ONNX Files (*.onnx);;Darknet Weights (*.weights);;All Files (*)";
-    QString fileName = QFileDialog::getOpenFileName(this, "Open YOLO Model", "", filter);
-    
-    if (!fileName.isEmpty()) {
-        std::string modelPath = fileName.toStdString();
-        std::string configPath;
-        
-        // If it's a weights file, we need a config file too
-        if (fileName.endsWith(".weights")) {
-            QString cfgFilter = "Config Files (*.cfg);;All Files (*)";
-            QString cfgFile = QFileDialog::getOpenFileName(this, "Open Config File", "", cfgFilter);
-            if (cfgFile.isEmpty()) {
-                QMessageBox::warning(this, "Warning", "Config file is required for .weights files");
-                return;
-            }
-            configPath = cfgFile.toStdString();
+void MainWindow::onLoadModel() {
+    QString modelPath = QFileDialog::getOpenFileName(this,
+        "Select YOLO Model",
+        lastModelPath_.isEmpty() ? QDir::homePath() : QFileInfo(lastModelPath_).dir().path(),
+        "Model Files (*.onnx *.weights *.pb);;All Files (*)");
+    
+    if (modelPath.isEmpty()) {
+        return;
+    }
+    
+    // Darknet weights need their network description
+    QString configPath;
+    if (modelPath.endsWith(".weights", Qt::CaseInsensitive)) {
+        QString siblingConfig = QFileInfo(modelPath).dir().filePath(QFileInfo(modelPath).completeBaseName() + ".cfg");
+        configPath = QFileDialog::getOpenFileName(this,
+            "Select Config File",
+            QFileInfo::exists(siblingConfig) ? siblingConfig : QFileInfo(modelPath).dir().path(),
+            "Config Files (*.cfg);;All Files (*)");
+        if (configPath.isEmpty()) {
+            QMessageBox::warning(this, "Warning", "A config file is required for .weights files");
+            return;
         }
+    }
+    
+    // Check for custom class names
+    QString classesPath;
+    QMessageBox::StandardButton reply = QMessageBox::question(this,
+        "Class Names", "Do you want to load custom class names?",
+        QMessageBox::Yes | QMessageBox::No);
+    
+    if (reply == QMessageBox::Yes) {
+        classesPath = QFileDialog::getOpenFileName(this,
+            "Select Class Names File",
+            QFileInfo(modelPath).dir().path(),
+            "Names Files (*.names *.txt);;All Files (*)");
+    }
+    
+    loadModel(modelPath, configPath, classesPath);
+}
+
+void MainWindow::loadModel(const QString& modelPath, const QString& configPath, const QString& classesPath) {
+    if (modelLoadWorker_ && modelLoadWorker_->isRunning()) {
+        statusLabel_->setText("A model is already loading");
+        return;
+    }
+    
+    Workers::ModelLoadWorker::Request request;
+    request.modelPath = modelPath;
+    request.configPath = configPath;
+    request.classesPath = classesPath;
+    request.config = detectionConfig_;
+    
+    if (request.configPath.isEmpty() && modelPath.endsWith(".weights", Qt::CaseInsensitive)) {
+        QFileInfo modelInfo(modelPath);
+        request.configPath = modelInfo.dir().filePath(modelInfo.completeBaseName() + ".cfg");
+    }
+    
+    if (!modelLoadWorker_) {
+        modelLoadWorker_ = std::make_unique<Workers::ModelLoadWorker>(modelCache_);
+        connect(modelLoadWorker_.get(), &Workers::ModelLoadWorker::loadProgress,
+                this, &MainWindow::onModelLoadProgress);
+        connect(modelLoadWorker_.get(), &Workers::ModelLoadWorker::loadCompleted,
+                this, &MainWindow::onModelLoadCompleted);
+    }
+    
+    modelLoading_ = true;
+    modelLoadProgress_->setValue(0);
+    modelLoadProgress_->setVisible(true);
+    modelStatusLabel_->setText(QString("Loading %1...").arg(QFileInfo(modelPath).fileName()));
+    modelStatusLabel_->setStyleSheet(Config::WARNING_COLOR);
+    updateProcessingControls();
+    
+    modelLoadWorker_->startLoading(request);
+}
+
+void MainWindow::onModelLoadProgress(int percent, QString step) {
+    modelLoadProgress_->setValue(percent);
+    modelLoadProgress_->setFormat(QString("%1 (%p%)").arg(step));
+}
+
+void MainWindow::onModelLoadCompleted(bool success, QString error, double loadSeconds,
+                                      double warmUpSeconds, bool fromCache) {
+    modelLoading_ = false;
+    modelLoadProgress_->setVisible(false);
+    Workers::ModelLoadWorker::Request request = modelLoadWorker_->request();
+    
+    std::shared_ptr<Core::YoloDetector> detector = modelLoadWorker_->takeDetector();
+    if (success && detector) {
+        // The settings may have changed while the model was loading
+        detector->setConfig(detectionConfig_);
+        detector_ = std::move(detector);
         
-        if (detector->loadModel(modelPath, configPath)) {
-            QMessageBox::information(this, "Success", "Model loaded successfully!");
-            
-            // Ask for class names file
-            QString namesFilter = "Names Files (*.names *.txt);;All Files (*)";
-            QString namesFile = QFileDialog::getOpenFileName(this, "Open Class Names File (Optional)", "", namesFilter);
-            if (!namesFile.isEmpty()) {
-                loadClassNames(namesFile.toStdString());
-            }
-        } else {
-            QMessageBox::critical(this, "Error", "Failed to load model. Please check:\n"
-                                                "1. Model file format is supported\n"
-                                                "2. For ONNX: Model was exported with static shapes\n"
-                                                "3. For Darknet: Both .weights and .cfg files are provided");
+        // A running batch picks the new detector up at its next image; the
+        // image in flight finishes on the old one
+        engine_->swap(detector_);
+        if (parallelEngines_ == 0) {
+            scheduler_->setAuto();  // Measured for the previous model; the next run measures again
         }
+        
+        lastModelPath_ = request.modelPath;
+        lastConfigPath_ = request.configPath;
+        lastClassesPath_ = request.classesPath;
+        modelPathEdit_->setText(request.modelPath);
+        
+        // Settings tuned for this model before; a running batch keeps its own
+        bool tuned = !processingActive_ && applyStoredTuning();
+        statusLabel_->setText(QString("Model %1 in %2 s, warm-up %3 s%4")
+                              .arg(fromCache ? "reused from cache" : "loaded")
+                              .arg(loadSeconds, 0, 'f', 2)
+                              .arg(warmUpSeconds, 0, 'f', 2)
+                              .arg(processingActive_ ? " - used from the next image"
+                                   : tuned ? " - tuned settings applied" : ""));
+    } else {
+        statusLabel_->setText("Failed to load model");
+        QMessageBox::critical(this, "Error",
+            QString("Failed to load model %1.\n\n%2\n\n"
+                    "Check that the format is supported, that ONNX models were exported with "
+                    "static shapes and that Darknet models have both .weights and .cfg files.")
+            .arg(request.modelPath, error.isEmpty() ? QString("Unknown error") : error));
     }
+    
+    updateModelStatus();
+    updateProcessingControls();
 }
 
 void MainWindow::onModelSettings() {
     showModelSettingsDialog();
 }
 
+void MainWindow::onAutoTune() {
+    if (!detector_->isLoaded() || modelLoading_) {
+        QMessageBox::information(this, "Auto-Tune", "Load a model first.");
+        return;
+    }
+    if (lastFolderPath_.isEmpty() || !QDir(lastFolderPath_).exists()) {
+        QMessageBox::information(this, "Auto-Tune", "Select a folder with representative images first.");
+        return;
+    }
+    if (processingActive_) {
+        // A running batch would skew every measurement
+        QMessageBox::information(this, "Auto-Tune", "Wait for the running detection to finish.");
+        return;
+    }
+    
+    AutoTuneDialog dialog(lastFolderPath_, detector_, this);
+    if (dialog.exec() != QDialog::Accepted) {
+        return;
+    }
+    
+    Processing::AutoTuner::Trial trial = dialog.selectedTrial();
+    if (trial.inputSize <= 0) {
+        return;
+    }
+    
+    QString key = tuningKey(lastModelPath_);
+    settings_->setValue(key + "/model", lastModelPath_);
+    settings_->setValue(key + "/inputSize", trial.inputSize);
+    settings_->setValue(key + "/engines", trial.layout.engines);
+    settings_->setValue(key + "/imagesPerSecond", trial.imagesPerSecond);
+    settings_->setValue(key + "/meanAveragePrecision", trial.meanAveragePrecision);
+    settings_->setValue(key + "/tunedAt", QDateTime::currentDateTime().toString(Qt::ISODate));
+    
+    applyStoredTuning();
+    statusLabel_->setText(QString("Tuned: %1x%1 input, %2 engine(s), %3 images/s")
+                          .arg(trial.inputSize)
+                          .arg(trial.layout.engines)
+                          .arg(trial.imagesPerSecond, 0, 'f', 1));
+}
+
+QString MainWindow::tuningKey(const QString& modelPath) const {
+    // Paths contain separators QSettings would read as groups
+    QByteArray hash = QCryptographicHash::hash(QFileInfo(modelPath).absoluteFilePath().toUtf8(),
+                                               QCryptographicHash::Sha1);
+    return "autoTune/" + QString::fromLatin1(hash.toHex().left(16));
+}
+
+bool MainWindow::applyStoredTuning() {
+    QString key = tuningKey(lastModelPath_);
+    int inputSize = settings_->value(key + "/inputSize", 0).toInt();
+    if (inputSize <= 0) {
+        return false;
+    }
+    
+    Core::DetectionConfig previous = detectionConfig_;
+    detectionConfig_.inputWidth = inputSize;
+    detectionConfig_.inputHeight = inputSize;
+    parallelEngines_ = qBound(1, settings_->value(key + "/engines", 1).toInt(), Config::MAX_PARALLEL_ENGINES);
+    applyThreadLayout();
+    applyDetectionConfig(previous);
+    return true;
+}
+
 void MainWindow::onSelectFolder() {
     QString folderPath = QFileDialog::getExistingDirectory(this,
         "Select Image Folder",
@@ -337,11 +495,21 @@ void MainWindow::onStartProcessing() {
             this, &MainWindow::onProcessingError);
     
     // Clear previous results
+    session_.reset();
+    classIndex_ = std::make_shared<Core::ClassIndex>();
+    worker_->setClassIndex(classIndex_);
+    metrics_ = std::make_shared<Core::PipelineMetrics>();
+    worker_->setMetrics(metrics_);
+    worker_->setScheduler(scheduler_);
+    metricsDock_->setMetrics(metrics_);
     resultsWidget_->clearResults();
     imageViewer_->clear();
+    displayedFolderIndex_ = -1;
     
-    // Start processing
-    worker_->startProcessing(lastFolderPath_.toStdString(), detector_, true);
+    // Start processing; completed folders are saved as a session as they finish
+    QString sessionPath = QDir(sessionsDirectory())
+                          .filePath(QDateTime::currentDateTime().toString("yyyyMMdd-HHmmss"));
+    worker_->startProcessing(lastFolderPath_.toStdString(), engine_, true, sessionPath.toStdString());
     
     processingActive_ = true;
     updateProcessingControls();
@@ -378,6 +546,11 @@ void MainWindow::onFolderScanned(QString folderName, int imageCount) {
 }
 
 void MainWindow::onProcessingStarted(int totalImages) {
+    // Scanning is done: add one row per folder, later updates patch rows in place
+    if (worker_) {
+        resultsWidget_->appendFolders(worker_->getResults());
+    }
+    
     progressBar_->setMaximum(totalImages);
     progressBar_->setValue(0);
     progressLabel_->setText(QString("Processing images... (0/%1)").arg(totalImages));
@@ -388,8 +561,13 @@ void MainWindow::onProcessingStarted(int totalImages) {
 }
 
 void MainWindow::onImageProcessed(QString imagePath, int detectionCount) {
-    Q_UNUSED(imagePath)
-    Q_UNUSED(detectionCount)
+    YOLO_TRACE_SPAN("ui_image_processed");
+    if (metrics_) {
+        metrics_->addQueueDepth(Core::PipelineMetrics::Queue::UiBacklog, -1);
+    }
+    if (displayedFolderIndex_ >= 0) {
+        imageViewer_->markImageProcessed(imagePath, detectionCount);
+    }
     int current = progressBar_->value() + 1;
     progressBar_->setValue(current);
     progressLabel_->setText(QString("Processing images... (%1/%2)")
@@ -398,10 +576,11 @@ void MainWindow::onImageProcessed(QString imagePath, int detectionCount) {
     statusProgress_->setValue(current);
 }
 
-void MainWindow::onFolderCompleted(QString folderName, int totalDetections) {
-    // Update results table with latest data
-    if (worker_) {
-        resultsWidget_->updateResults(worker_->getResults());
+void MainWindow::onFolderCompleted(int folderIndex, QString folderName, int imageCount, int totalDetections) {
+    YOLO_TRACE_SPAN("ui_folder_completed");
+    resultsWidget_->updateFolder(folderIndex, imageCount, totalDetections, true);
+    if (folderIndex == displayedFolderIndex_ && worker_) {
+        imageViewer_->updateFolder(worker_->getFolderResult(folderIndex));
     }
     
     statusLabel_->setText(QString("Completed: %1 (%2 detections)")
@@ -424,11 +603,6 @@ void MainWindow::onProcessingCompleted(Core::ProcessingStats stats) {
     progressLabel_->setText(summary);
     statusLabel_->setText("Processing completed");
     
-    // Final update of results
-    if (worker_) {
-        resultsWidget_->updateResults(worker_->getResults());
-    }
-    
     QMessageBox::information(this, "Processing Complete", summary);
 }
 
@@ -438,25 +612,348 @@ void MainWindow::onProcessingError(QString error) {
 }
 
 void MainWindow::onFolderSelected(int folderIndex) {
+    if (session_) {
+        if (folderIndex >= 0 && folderIndex < static_cast<int>(session_->folderCount())) {
+            displayedFolderIndex_ = -1;
+            imageViewer_->displayFolder(session_->loadFolder(folderIndex));
+        }
+        return;
+    }
+    
     if (worker_) {
-        auto results = worker_->getResults();
-        if (folderIndex >= 0 && folderIndex < static_cast<int>(results.size())) {
-            imageViewer_->displayFolder(results[folderIndex]);
+        Core::FolderResult folder = worker_->getFolderResult(folderIndex);
+        if (!folder.folderPath.empty()) {
+            displayedFolderIndex_ = folderIndex;
+            imageViewer_->displayFolder(std::move(folder));
         }
     }
 }
 
 void MainWindow::onExportResults() {
-    // Implementation for exporting results to CSV/JSON
-    QMessageBox::information(this, "Export", "Export functionality to be implemented");
+    using Format = Processing::ResultExporter::Format;
+    
+    if (!canStartExport()) {
+        return;
+    }
+    
+    const std::vector<Format> formats = {Format::Csv, Format::JsonLines, Format::Coco, Format::YoloTxt};
+    QStringList formatNames;
+    for (Format format : formats) {
+        formatNames << Processing::ResultExporter::formatName(format);
+    }
+    
+    bool ok = false;
+    QString chosen = QInputDialog::getItem(this, "Export Results", "Format:", formatNames, 0, false, &ok);
+    if (!ok) {
+        return;
+    }
+    Format format = formats[formatNames.indexOf(chosen)];
+    
+    QString startDir = lastFolderPath_.isEmpty() ? QDir::homePath() : lastFolderPath_;
+    QString outputPath;
+    if (format == Format::YoloTxt) {
+        outputPath = QFileDialog::getExistingDirectory(this, "Select Label Output Folder", startDir);
+    } else {
+        QString extension = Processing::ResultExporter::fileExtension(format);
+        outputPath = QFileDialog::getSaveFileName(this, "Export Results",
+            QDir(startDir).filePath("detections." + extension),
+            QString("%1 Files (*.%2);;All Files (*)").arg(chosen, extension));
+    }
+    if (outputPath.isEmpty()) {
+        return;
+    }
+    
+    ensureExportWorker();
+    if (session_) {
+        exportWorker_->startExport(session_, format, outputPath);
+    } else {
+        // The worker gets its own snapshot; image results are shared, not copied
+        exportWorker_->startExport(worker_->getResults(), format, outputPath);
+    }
+    
+    statusProgress_->setVisible(true);
+    statusProgress_->setMaximum(0);
+    statusLabel_->setText(QString("Exporting %1...").arg(chosen));
+}
+
+void MainWindow::onExportImages() {
+    using Encoding = Processing::ImageExporter::Encoding;
+    
+    if (!canStartExport()) {
+        return;
+    }
+    
+    QDialog dialog(this);
+    dialog.setWindowTitle("Export Images");
+    dialog.setModal(true);
+    
+    QFormLayout* layout = new QFormLayout(&dialog);
+    
+    QCheckBox* annotatedCheckBox = new QCheckBox("Images with boxes drawn");
+    annotatedCheckBox->setChecked(true);
+    layout->addRow("Annotated:", annotatedCheckBox);
+    
+    QCheckBox* cropsCheckBox = new QCheckBox("One file per detection, grouped by class");
+    layout->addRow("Crops:", cropsCheckBox);
+    
+    const std::vector<Encoding> encodings = {Encoding::Jpeg, Encoding::Png, Encoding::Webp};
+    QComboBox* encodingCombo = new QComboBox();
+    for (Encoding encoding : encodings) {
+        encodingCombo->addItem(QString(Processing::ImageExporter::fileExtension(encoding)).toUpper());
+    }
+    layout->addRow("Format:", encodingCombo);
+    
+    QSpinBox* qualitySpinBox = new QSpinBox();
+    qualitySpinBox->setRange(1, 100);
+    qualitySpinBox->setValue(90);
+    layout->addRow("Quality:", qualitySpinBox);
+    
+    QSpinBox* paddingSpinBox = new QSpinBox();
+    paddingSpinBox->setRange(0, 512);
+    paddingSpinBox->setSuffix(" px");
+    layout->addRow("Crop Padding:", paddingSpinBox);
+    
+    QDialogButtonBox* buttonBox = new QDialogButtonBox(QDialogButtonBox::Ok | QDialogButtonBox::Cancel);
+    connect(buttonBox, &QDialogButtonBox::accepted, &dialog, &QDialog::accept);
+    connect(buttonBox, &QDialogButtonBox::rejected, &dialog, &QDialog::reject);
+    layout->addRow(buttonBox);
+    
+    if (dialog.exec() != QDialog::Accepted) {
+        return;
+    }
+    
+    Processing::ImageExporter::Options options;
+    options.annotatedImages = annotatedCheckBox->isChecked();
+    options.crops = cropsCheckBox->isChecked();
+    options.encoding = encodings[encodingCombo->currentIndex()];
+    options.quality = qualitySpinBox->value();
+    options.cropPadding = paddingSpinBox->value();
+    if (!options.annotatedImages && !options.crops) {
+        QMessageBox::information(this, "Export Images", "Select annotated images, crops or both.");
+        return;
+    }
+    
+    QString startDir = lastFolderPath_.isEmpty() ? QDir::homePath() : lastFolderPath_;
+    QString outputDir = QFileDialog::getExistingDirectory(this, "Select Image Output Folder", startDir);
+    if (outputDir.isEmpty()) {
+        return;
+    }
+    
+    ensureExportWorker();
+    if (session_) {
+        exportWorker_->startImageExport(session_, options, outputDir);
+    } else {
+        exportWorker_->startImageExport(worker_->getResults(), options, outputDir);
+    }
+    
+    statusProgress_->setVisible(true);
+    statusProgress_->setMaximum(0);
+    statusLabel_->setText("Exporting images...");
+}
+
+bool MainWindow::canStartExport() {
+    if (!session_ && (!worker_ || worker_->getResults().empty())) {
+        QMessageBox::information(this, "Export", "There are no results to export yet.");
+        return false;
+    }
+    if (processingActive_) {
+        QMessageBox::information(this, "Export", "Please wait for processing to finish before exporting.");
+        return false;
+    }
+    if (exportWorker_ && exportWorker_->isRunning()) {
+        QMessageBox::information(this, "Export", "An export is already running.");
+        return false;
+    }
+    return true;
+}
+
+void MainWindow::ensureExportWorker() {
+    if (exportWorker_) {
+        return;
+    }
+    
+    exportWorker_ = std::make_unique<Workers::ExportWorker>();
+    connect(exportWorker_.get(), &Workers::ExportWorker::exportProgress,
+            this, &MainWindow::onExportProgress);
+    connect(exportWorker_.get(), &Workers::ExportWorker::exportCompleted,
+            this, &MainWindow::onExportCompleted);
+    connect(exportWorker_.get(), &Workers::ExportWorker::imageExportCompleted,
+            this, &MainWindow::onImageExportCompleted);
+    connect(exportWorker_.get(), &Workers::ExportWorker::errorOccurred,
+            this, &MainWindow::onExportError);
+}
+
+void MainWindow::onExportProgress(int doneImages, int totalImages) {
+    statusProgress_->setMaximum(totalImages);
+    statusProgress_->setValue(doneImages);
+}
+
+void MainWindow::onExportCompleted(QString outputPath, qint64 images, qint64 detections,
+                                   qint64 bytesWritten, double seconds, bool cancelled) {
+    statusProgress_->setVisible(false);
+    
+    QString summary = QString("%1 %2 images, %3 detections (%4 MB) in %5 seconds")
+                     .arg(cancelled ? "Export cancelled after" : "Exported")
+                     .arg(images)
+                     .arg(detections)
+                     .arg(bytesWritten / (1024.0 * 1024.0), 0, 'f', 1)
+                     .arg(seconds, 0, 'f', 1);
+    statusLabel_->setText(summary);
+    QMessageBox::information(this, "Export", summary + "\n\n" + outputPath);
+}
+
+void MainWindow::onImageExportCompleted(QString outputDirectory, qint64 images, qint64 crops,
+                                        qint64 failedImages, qint64 bytesWritten, double seconds,
+                                        bool cancelled) {
+    statusProgress_->setVisible(false);
+    
+    QString summary = QString("%1 %2 images, %3 crops (%4 MB) in %5 seconds")
+                     .arg(cancelled ? "Image export cancelled after" : "Exported")
+                     .arg(images)
+                     .arg(crops)
+                     .arg(bytesWritten / (1024.0 * 1024.0), 0, 'f', 1)
+                     .arg(seconds, 0, 'f', 1);
+    if (failedImages > 0) {
+        summary += QString(", %1 images could not be read or written").arg(failedImages);
+    }
+    statusLabel_->setText(summary);
+    QMessageBox::information(this, "Export Images", summary + "\n\n" + outputDirectory);
+}
+
+void MainWindow::onExportError(QString error) {
+    statusProgress_->setVisible(false);
+    statusLabel_->setText("Export failed");
+    QMessageBox::warning(this, "Export Error", error);
+}
+
+void MainWindow::onQueryRequested(QString query) {
+    if (!classIndex_ || classIndex_->imageCount() == 0) {
+        statusLabel_->setText("No results to search yet");
+        return;
+    }
+    
+    Core::ClassQuery classQuery;
+    std::string error;
+    if (!classIndex_->parseQuery(query.toStdString(), classQuery, error)) {
+        QMessageBox::warning(this, "Search", QString::fromStdString(error));
+        return;
+    }
+    
+    QElapsedTimer timer;
+    timer.start();
+    std::vector<uint32_t> matches = classIndex_->execute(classQuery, Config::QUERY_RESULT_LIMIT);
+    double queryMs = timer.nsecsElapsed() / 1e6;
+    
+    std::vector<Core::ClassIndex::ImageLocation> locations;
+    locations.reserve(matches.size());
+    for (uint32_t imageId : matches) {
+        locations.push_back(classIndex_->location(imageId));
+    }
+    
+    // Matches are shown as a virtual folder in the viewer
+    Core::FolderResult queryFolder;
+    queryFolder.folderName = "Query: " + query.toStdString();
+    if (session_) {
+        queryFolder.images.reserve(locations.size());
+        for (const auto& location : locations) {
+            queryFolder.images.push_back(session_->loadImage(location.folderIndex, location.imageIndex));
+        }
+    } else if (worker_) {
+        queryFolder.images = worker_->getImageResults(locations);
+    }
+    queryFolder.updateCounts();
+    queryFolder.processed = true;
+    displayedFolderIndex_ = -1;
+    imageViewer_->displayFolder(std::move(queryFolder));
+    
+    QString limitNote = matches.size() >= Config::QUERY_RESULT_LIMIT
+                        ? QString(" (showing first %1)").arg(Config::QUERY_RESULT_LIMIT) : QString();
+    statusLabel_->setText(QString("%1 images match \"%2\"%3 - searched %4 images in %5 ms")
+                         .arg(matches.size())
+                         .arg(query)
+                         .arg(limitNote)
+                         .arg(classIndex_->imageCount())
+                         .arg(queryMs, 0, 'f', 2));
+}
+
+void MainWindow::onOpenSession() {
+    if (processingActive_) {
+        QMessageBox::information(this, "Open Session", "Please wait for processing to finish first.");
+        return;
+    }
+    
+    QString directory = QFileDialog::getExistingDirectory(this, "Open Session", sessionsDirectory());
+    if (directory.isEmpty()) {
+        return;
+    }
+    
+    auto store = std::make_shared<Core::ResultsStore>();
+    try {
+        store->open(directory.toStdString());
+    } catch (const std::exception& e) {
+        QMessageBox::warning(this, "Open Session", QString("Failed to open session: %1").arg(e.what()));
+        return;
+    }
+    
+    session_ = std::move(store);
+    classIndex_ = std::make_shared<Core::ClassIndex>();
+    session_->indexClasses(*classIndex_);
+    imageViewer_->clear();
+    displayedFolderIndex_ = -1;
+    resultsWidget_->updateResults(session_->folderSummaries());
+    
+    statusLabel_->setText(QString("Session %1: %2 folders, %3 images, %4 detections")
+                         .arg(QDir(directory).dirName())
+                         .arg(session_->folderCount())
+                         .arg(session_->imageCount())
+                         .arg(session_->detectionCount()));
+}
+
+QString MainWindow::sessionsDirectory() const {
+    QString path = QDir(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation))
+                   .filePath(Config::SESSIONS_DIRECTORY);
+    QDir().mkpath(path);
+    return path;
 }
 
 void MainWindow::onRefreshResults() {
+    if (session_) {
+        resultsWidget_->updateResults(session_->folderSummaries());
+        return;
+    }
     if (worker_) {
         resultsWidget_->updateResults(worker_->getResults());
     }
 }
 
+void MainWindow::onRecordTraceToggled(bool enabled) {
+    if (enabled) {
+        Core::Trace::clear();
+    }
+    Core::Trace::setEnabled(enabled);
+    statusLabel_->setText(enabled ? "Recording trace" : "Trace recording stopped");
+}
+
+void MainWindow::onSaveTrace() {
+    QString defaultPath = QDir(QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation))
+                          .filePath(QString("trace-%1.json")
+                                    .arg(QDateTime::currentDateTime().toString("yyyyMMdd-HHmmss")));
+    QString path = QFileDialog::getSaveFileName(this, "Save Trace", defaultPath,
+                                                "Chrome Trace (*.json)");
+    if (path.isEmpty()) {
+        return;
+    }
+    
+    try {
+        size_t spans = Core::Trace::eventCount();
+        Core::Trace::writeChromeJson(path.toStdString());
+        statusLabel_->setText(QString("Saved %1 spans to %2 (open in ui.perfetto.dev)")
+                             .arg(spans).arg(QFileInfo(path).fileName()));
+    } catch (const std::exception& e) {
+        QMessageBox::warning(this, "Save Trace", e.what());
+    }
+}
+
 void MainWindow::onAbout() {
     QString aboutText = QString(
         "<h3>%1 v%2</h3>"
@@ -505,6 +1002,8 @@ void MainWindow::loadSettings() {
     
     // Paths
     lastModelPath_ = settings_->value("lastModelPath").toString();
+    lastConfigPath_ = settings_->value("lastConfigPath").toString();
+    lastClassesPath_ = settings_->value("lastClassesPath").toString();
     lastFolderPath_ = settings_->value("lastFolderPath").toString();
     
     // Detection configuration
@@ -512,6 +1011,18 @@ void MainWindow::loadSettings() {
     detectionConfig_.nmsThreshold = settings_->value("nmsThreshold", 0.4f).toFloat();
     detectionConfig_.inputWidth = settings_->value("inputWidth", 640).toInt();
     detectionConfig_.inputHeight = settings_->value("inputHeight", 640).toInt();
+    detectionConfig_.rectInference = settings_->value("rectInference", false).toBool();
+    detectionConfig_.tiledInference = settings_->value("tiledInference", false).toBool();
+    detectionConfig_.tileOverlap = settings_->value("tileOverlap", 0.2f).toFloat();
+    detectionConfig_.tileFullFrame = settings_->value("tileFullFrame", true).toBool();
+    detectionConfig_.tileWeightedFusion = settings_->value("tileWeightedFusion", false).toBool();
+    
+    // Threading
+    parallelEngines_ = qBound(0, settings_->value("parallelEngines", 1).toInt(), Config::MAX_PARALLEL_ENGINES);
+    Core::ThreadScheduler::Pinning pinning = Core::ThreadScheduler::Pinning::None;
+    Core::ThreadScheduler::parsePinning(settings_->value("threadPinning", "none").toString().toStdString(), pinning);
+    scheduler_->setPinning(pinning);
+    applyThreadLayout();
     
     // Update UI
     if (!lastModelPath_.isEmpty()) {
@@ -521,6 +1032,11 @@ void MainWindow::loadSettings() {
         folderPathEdit_->setText(lastFolderPath_);
     }
     
+    // Prometheus metrics file
+    metricsDock_->setPrometheusOutput(settings_->value("metricsFileEnabled", false).toBool(),
+                                      settings_->value("metricsFile").toString(),
+                                      settings_->value("metricsInterval", Config::METRICS_EXPORT_INTERVAL_SECONDS).toInt());
+    
     detector_->setConfig(detectionConfig_);
 }
 
@@ -531,6 +1047,8 @@ void MainWindow::saveSettings() {
     
     // Paths
     settings_->setValue("lastModelPath", lastModelPath_);
+    settings_->setValue("lastConfigPath", lastConfigPath_);
+    settings_->setValue("lastClassesPath", lastClassesPath_);
     settings_->setValue("lastFolderPath", lastFolderPath_);
     
     // Detection configuration
@@ -538,9 +1056,26 @@ void MainWindow::saveSettings() {
     settings_->setValue("nmsThreshold", detectionConfig_.nmsThreshold);
     settings_->setValue("inputWidth", detectionConfig_.inputWidth);
     settings_->setValue("inputHeight", detectionConfig_.inputHeight);
+    settings_->setValue("rectInference", detectionConfig_.rectInference);
+    settings_->setValue("tiledInference", detectionConfig_.tiledInference);
+    settings_->setValue("tileOverlap", detectionConfig_.tileOverlap);
+    settings_->setValue("tileFullFrame", detectionConfig_.tileFullFrame);
+    settings_->setValue("tileWeightedFusion", detectionConfig_.tileWeightedFusion);
+    
+    // Threading
+    settings_->setValue("parallelEngines", parallelEngines_);
+    settings_->setValue("threadPinning", Core::ThreadScheduler::pinningName(scheduler_->pinning()));
+    
+    // Prometheus metrics file
+    settings_->setValue("metricsFileEnabled", metricsDock_->prometheusEnabled());
+    settings_->setValue("metricsFile", metricsDock_->prometheusPath());
+    settings_->setValue("metricsInterval", metricsDock_->prometheusInterval());
 }
 
 void MainWindow::updateModelStatus() {
+    if (modelLoading_) {
+        return;     // The loader reports progress itself
+    }
     if (detector_->isLoaded()) {
         modelStatusLabel_->setText("Model loaded and ready");
         modelStatusLabel_->setStyleSheet(Config::SUCCESS_COLOR);
@@ -566,11 +1101,11 @@ void MainWindow::updateFolderStatus() {
 }
 
 void MainWindow::updateProcessingControls() {
-    bool canStart = detector_->isLoaded() && !lastFolderPath_.isEmpty() && !processingActive_;
+    bool canStart = detector_->isLoaded() && !lastFolderPath_.isEmpty() && !processingActive_ && !modelLoading_;
     
     startButton_->setEnabled(canStart);
     stopButton_->setEnabled(processingActive_);
-    loadModelButton_->setEnabled(!processingActive_);
+    loadModelButton_->setEnabled(!modelLoading_);     // Also mid-run: the new model is swapped in
     selectFolderButton_->setEnabled(!processingActive_);
 }
 
@@ -594,6 +1129,15 @@ bool MainWindow::validateConfiguration() {
     return true;
 }
 
+void MainWindow::applyThreadLayout() {
+    if (parallelEngines_ == 0) {
+        scheduler_->setAuto();
+    } else {
+        scheduler_->setLayout({parallelEngines_, 0});
+        scheduler_->applyIntraOpThreads();
+    }
+}
+
 void MainWindow::showModelSettingsDialog() {
     QDialog dialog(this);
     dialog.setWindowTitle("Model Settings");
@@ -630,6 +1174,60 @@ void MainWindow::showModelSettingsDialog() {
     heightSpinBox->setValue(detectionConfig_.inputHeight);
     layout->addRow("Input Height:", heightSpinBox);
     
+    QCheckBox* rectCheckBox = new QCheckBox("Keep each image's aspect ratio");
+    rectCheckBox->setChecked(detectionConfig_.rectInference);
+    rectCheckBox->setToolTip("Runs wide or tall images at a smaller input instead of stretching them to the full size");
+    layout->addRow("Rectangular Input:", rectCheckBox);
+    
+    // Tiled inference: frames larger than the input are cut into input-sized tiles
+    QCheckBox* tiledCheckBox = new QCheckBox("Detect large images in tiles");
+    tiledCheckBox->setChecked(detectionConfig_.tiledInference);
+    tiledCheckBox->setToolTip("Finds small objects that shrinking the whole frame would lose; slower");
+    layout->addRow("Tiled Inference:", tiledCheckBox);
+    
+    QDoubleSpinBox* overlapSpinBox = new QDoubleSpinBox();
+    overlapSpinBox->setRange(0.0, 0.9);
+    overlapSpinBox->setSingleStep(0.05);
+    overlapSpinBox->setDecimals(2);
+    overlapSpinBox->setValue(detectionConfig_.tileOverlap);
+    layout->addRow("Tile Overlap:", overlapSpinBox);
+    
+    QCheckBox* fullFrameCheckBox = new QCheckBox("Also detect on the whole frame");
+    fullFrameCheckBox->setChecked(detectionConfig_.tileFullFrame);
+    fullFrameCheckBox->setToolTip("Keeps large objects that no single tile contains");
+    layout->addRow("Full Frame:", fullFrameCheckBox);
+    
+    QComboBox* tileMergeCombo = new QComboBox();
+    tileMergeCombo->addItem("Non-maximum suppression", false);
+    tileMergeCombo->addItem("Weighted box fusion", true);
+    tileMergeCombo->setCurrentIndex(detectionConfig_.tileWeightedFusion ? 1 : 0);
+    layout->addRow("Tile Merge:", tileMergeCombo);
+    
+    auto updateTileControls = [=](bool enabled) {
+        overlapSpinBox->setEnabled(enabled);
+        fullFrameCheckBox->setEnabled(enabled);
+        tileMergeCombo->setEnabled(enabled);
+    };
+    connect(tiledCheckBox, &QCheckBox::toggled, &dialog, updateTileControls);
+    updateTileControls(tiledCheckBox->isChecked());
+    
+    // Parallel engines: each runs one image at a time with cores / engines OpenCV threads
+    QComboBox* enginesCombo = new QComboBox();
+    enginesCombo->addItem("Auto (measure)", 0);
+    for (int engines = 1; engines <= qMin(Config::MAX_PARALLEL_ENGINES, scheduler_->coreBudget()); ++engines) {
+        enginesCombo->addItem(QString::number(engines), engines);
+    }
+    enginesCombo->setCurrentIndex(qMax(0, enginesCombo->findData(parallelEngines_)));
+    enginesCombo->setToolTip(QString("%1 threads are shared between the engines").arg(scheduler_->coreBudget()));
+    layout->addRow("Parallel Engines:", enginesCombo);
+    
+    QComboBox* pinningCombo = new QComboBox();
+    pinningCombo->addItem("None", static_cast<int>(Core::ThreadScheduler::Pinning::None));
+    pinningCombo->addItem("Cores", static_cast<int>(Core::ThreadScheduler::Pinning::Cores));
+    pinningCombo->addItem("NUMA nodes", static_cast<int>(Core::ThreadScheduler::Pinning::NumaNodes));
+    pinningCombo->setCurrentIndex(pinningCombo->findData(static_cast<int>(scheduler_->pinning())));
+    layout->addRow("Thread Pinning:", pinningCombo);
+    
     // Dialog buttons
     QDialogButtonBox* buttonBox = new QDialogButtonBox(QDialogButtonBox::Ok | QDialogButtonBox::Cancel);
     connect(buttonBox, &QDialogButtonBox::accepted, &dialog, &QDialog::accept);
@@ -637,11 +1235,43 @@ void MainWindow::showModelSettingsDialog() {
     layout->addRow(buttonBox);
     
     if (dialog.exec() == QDialog::Accepted) {
+        Core::DetectionConfig previous = detectionConfig_;
         detectionConfig_.confidenceThreshold = static_cast<float>(confidenceSpinBox->value());
         detectionConfig_.nmsThreshold = static_cast<float>(nmsSpinBox->value());
         detectionConfig_.inputWidth = widthSpinBox->value();
         detectionConfig_.inputHeight = heightSpinBox->value();
+        detectionConfig_.rectInference = rectCheckBox->isChecked();
+        detectionConfig_.tiledInference = tiledCheckBox->isChecked();
+        detectionConfig_.tileOverlap = static_cast<float>(overlapSpinBox->value());
+        detectionConfig_.tileFullFrame = fullFrameCheckBox->isChecked();
+        detectionConfig_.tileWeightedFusion = tileMergeCombo->currentData().toBool();
         
+        // A fixed split applies to a running batch from its next folder; Auto measures at the next start
+        scheduler_->setPinning(static_cast<Core::ThreadScheduler::Pinning>(pinningCombo->currentData().toInt()));
+        int engines = enginesCombo->currentData().toInt();
+        if (engines != parallelEngines_) {
+            parallelEngines_ = engines;
+            applyThreadLayout();
+        }
+        
+        applyDetectionConfig(previous);
+    }
+}
+
+void MainWindow::applyDetectionConfig(const Core::DetectionConfig& previous) {
+    bool inputSizeChanged = detectionConfig_.inputWidth != previous.inputWidth ||
+                            detectionConfig_.inputHeight != previous.inputHeight;
+    if (inputSizeChanged && processingActive_ && !modelLoading_ && detector_->isLoaded()) {
+        // Reshaping the running network would stall the run at the next
+        // image; thresholds apply right away, and a copy of the model is
+        // warmed up at the new size and swapped in when ready
+        Core::DetectionConfig running = detectionConfig_;
+        running.inputWidth = previous.inputWidth;
+        running.inputHeight = previous.inputHeight;
+        detector_->setConfig(running);
+        loadModel(lastModelPath_, lastConfigPath_, lastClassesPath_);
+    } else {
+        // Thread-safe; a running batch uses it from the next image
         detector_->setConfig(detectionConfig_);
     }
 }
@@ -3,9 +3,14 @@
 #pragma once
 
 #include "../core/detector.h"
+#include "../core/results_store.h"
+#include "../core/thread_scheduler.h"
 #include "../workers/detection_worker.h"
+#include "../workers/export_worker.h"
+#include "../workers/model_load_worker.h"
 #include "results_widget.h"
 #include "image_viewer.h"
+#include "metrics_dock.h"
 #include <QMainWindow>
 #include <QVBoxLayout>
 #include <QHBoxLayout>
@@ -38,6 +43,14 @@ class MainWindow : public QMainWindow {
 public:
     explicit MainWindow(QWidget* parent = nullptr);
     ~MainWindow() override;
+    
+    /**
+     * @brief Load a model in the background; the current one stays active until it is ready
+     * @param configPath Darknet .cfg; for .weights a .cfg next to the model is used when empty
+     */
+    void loadModel(const QString& modelPath,
+                   const QString& configPath = QString(),
+                   const QString& classesPath = QString());
 
 protected:
     void closeEvent(QCloseEvent* event) override;
@@ -46,9 +59,13 @@ private slots:
     // Model management
     void onLoadModel();
     void onModelSettings();
+    void onAutoTune();
+    void onModelLoadProgress(int percent, QString step);
+    void onModelLoadCompleted(bool success, QString error, double loadSeconds, double warmUpSeconds, bool fromCache);
     
     // Folder operations
     void onSelectFolder();
+    void onOpenSession();
     void onStartProcessing();
     void onStopProcessing();
     
@@ -57,15 +74,27 @@ private slots:
     void onFolderScanned(QString folderName, int imageCount);
     void onProcessingStarted(int totalImages);
     void onImageProcessed(QString imagePath, int detectionCount);
-    void onFolderCompleted(QString folderName, int totalDetections);
+    void onFolderCompleted(int folderIndex, QString folderName, int imageCount, int totalDetections);
     void onProcessingCompleted(Core::ProcessingStats stats);
     void onProcessingError(QString error);
+    void onExportProgress(int doneImages, int totalImages);
+    void onExportCompleted(QString outputPath, qint64 images, qint64 detections,
+                           qint64 bytesWritten, double seconds, bool cancelled);
+    void onImageExportCompleted(QString outputDirectory, qint64 images, qint64 crops, qint64 failedImages,
+                                qint64 bytesWritten, double seconds, bool cancelled);
+    void onExportError(QString error);
     
     // UI interactions
     void onFolderSelected(int folderIndex);
     void onExportResults();
+    void onExportImages();
+    void onQueryRequested(QString query);
     void onRefreshResults();
     
+    // Tracing
+    void onRecordTraceToggled(bool enabled);
+    void onSaveTrace();
+    
     // Menu actions
     void onAbout();
     void onExit();
@@ -86,11 +115,36 @@ private:
     void updateProcessingControls();
     
     bool validateConfiguration();
+    QString sessionsDirectory() const;
+    bool canStartExport();
+    void ensureExportWorker();
     void showModelSettingsDialog();
+    void applyThreadLayout();
+    void applyDetectionConfig(const Core::DetectionConfig& previous);
+    QString tuningKey(const QString& modelPath) const;
+    bool applyStoredTuning();
     
     // Core components
     std::shared_ptr<Core::YoloDetector> detector_;
+    std::shared_ptr<Core::EngineHandle> engine_;    // What the worker detects with; follows detector_
     std::unique_ptr<Workers::DetectionWorker> worker_;
+    std::unique_ptr<Workers::ExportWorker> exportWorker_;
+    std::unique_ptr<Workers::ModelLoadWorker> modelLoadWorker_;
+    
+    // Parsed networks of recently used models, for instant switching back
+    std::shared_ptr<Core::ModelCache> modelCache_;
+    
+    // Split of the cores between parallel engines and OpenCV threads
+    std::shared_ptr<Core::ThreadScheduler> scheduler_;
+    
+    // Saved session being browsed instead of live results (null otherwise)
+    std::shared_ptr<Core::ResultsStore> session_;
+    
+    // Class index over the live run or the open session
+    std::shared_ptr<Core::ClassIndex> classIndex_;
+    
+    // Live metrics of the current run
+    std::shared_ptr<Core::PipelineMetrics> metrics_;
     
     // UI components
     QWidget* centralWidget_;
@@ -106,6 +160,7 @@ private:
     QPushButton* modelSettingsButton_;
     QLabel* modelStatusLabel_;
     QLineEdit* modelPathEdit_;
+    QProgressBar* modelLoadProgress_;
     
     QPushButton* selectFolderButton_;
     QLabel* folderStatusLabel_;
@@ -119,6 +174,7 @@ private:
     // Content area
     ResultsWidget* resultsWidget_;
     ImageViewer* imageViewer_;
+    MetricsDock* metricsDock_;
     
     // Status
     QLabel* statusLabel_;
@@ -127,11 +183,16 @@ private:
     // Settings
     QSettings* settings_;
     QString lastModelPath_;
+    QString lastConfigPath_;
+    QString lastClassesPath_;
     QString lastFolderPath_;
     Core::DetectionConfig detectionConfig_;
+    int parallelEngines_;   // 0 measures the layout at the start of a run
     
     // State
+    int displayedFolderIndex_;  // Worker folder shown in the viewer, -1 for none
     bool processingActive_;
+    bool modelLoading_;
 };
 
 } // namespace UI
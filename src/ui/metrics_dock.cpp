@@ -0,0 +1,294 @@
+// src/ui/metrics_dock.cpp
+#include "metrics_dock.h"
+#include "../core/config.h"
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QGroupBox>
+#include <QHeaderView>
+#include <QFileDialog>
+#include <QFileInfo>
+#include <QTime>
+#include <algorithm>
+
+namespace YoloApp {
+namespace UI {
+
+namespace {
+
+constexpr int REFRESH_INTERVAL_MS = 1000;
+constexpr int RECENT_FOLDERS = 20;
+
+const QStringList LATENCY_COLUMNS = {"Count", "p50", "p95", "p99", "Max", "Mean"};
+const QStringList SLOWEST_COLUMNS = {"Image", "Total", "Decode", "Inference", "NMS", "Candidates", "Size", "MB"};
+
+QTableWidgetItem* numberItem(const QString& text) {
+    QTableWidgetItem* item = new QTableWidgetItem(text);
+    item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+    return item;
+}
+
+QString ms(uint64_t micros) {
+    return QString::number(micros / 1000.0, 'f', 1);
+}
+
+void setupLatencyTable(QTableWidget* table, const QString& firstColumn) {
+    table->setColumnCount(LATENCY_COLUMNS.size() + 1);
+    table->setHorizontalHeaderLabels(QStringList{firstColumn} + LATENCY_COLUMNS);
+    table->verticalHeader()->setVisible(false);
+    table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    table->setSelectionMode(QAbstractItemView::NoSelection);
+    table->horizontalHeader()->setSectionResizeMode(0, QHeaderView::Stretch);
+    for (int column = 1; column < table->columnCount(); ++column) {
+        table->horizontalHeader()->setSectionResizeMode(column, QHeaderView::ResizeToContents);
+    }
+}
+
+} // namespace
+
+MetricsDock::MetricsDock(QWidget* parent)
+    : QDockWidget("Metrics", parent)
+    , refreshTimer_(new QTimer(this))
+    , prometheusTimer_(new QTimer(this)) {
+    setObjectName("metricsDock");
+    setupUI();
+
+    refreshTimer_->setInterval(REFRESH_INTERVAL_MS);
+    connect(refreshTimer_, &QTimer::timeout, this, &MetricsDock::refresh);
+    connect(prometheusTimer_, &QTimer::timeout, this, &MetricsDock::writePrometheusFile);
+
+    // Only redraw while someone can see it
+    connect(this, &QDockWidget::visibilityChanged, this, [this](bool visible) {
+        if (visible) {
+            refresh();
+            refreshTimer_->start();
+        } else {
+            refreshTimer_->stop();
+        }
+    });
+}
+
+void MetricsDock::setupUI() {
+    QWidget* content = new QWidget();
+    QVBoxLayout* layout = new QVBoxLayout(content);
+
+    throughputLabel_ = new QLabel("No run yet");
+    queueLabel_ = new QLabel();
+    layout->addWidget(throughputLabel_);
+    layout->addWidget(queueLabel_);
+
+    // Latency per stage, in milliseconds
+    QGroupBox* stageGroup = new QGroupBox("Stage latency (ms)");
+    QVBoxLayout* stageLayout = new QVBoxLayout(stageGroup);
+    stageTable_ = new QTableWidget();
+    setupLatencyTable(stageTable_, "Stage");
+    stageTable_->setRowCount(static_cast<int>(Core::PipelineStage::Count));
+    for (int row = 0; row < stageTable_->rowCount(); ++row) {
+        stageTable_->setItem(row, 0, new QTableWidgetItem(
+            Core::pipelineStageName(static_cast<Core::PipelineStage>(row))));
+    }
+    stageLayout->addWidget(stageTable_);
+    layout->addWidget(stageGroup);
+
+    // Image latency per folder, in progress first
+    QGroupBox* folderGroup = new QGroupBox("Folder image latency (ms)");
+    QVBoxLayout* folderLayout = new QVBoxLayout(folderGroup);
+    folderTable_ = new QTableWidget();
+    setupLatencyTable(folderTable_, "Folder");
+    folderLayout->addWidget(folderTable_);
+    layout->addWidget(folderGroup, 1);
+
+    // Slowest images so far, to see whether decode, inference or NMS is to blame
+    QGroupBox* slowestGroup = new QGroupBox("Slowest images (ms)");
+    QVBoxLayout* slowestLayout = new QVBoxLayout(slowestGroup);
+    slowestTable_ = new QTableWidget();
+    slowestTable_->setColumnCount(SLOWEST_COLUMNS.size());
+    slowestTable_->setHorizontalHeaderLabels(SLOWEST_COLUMNS);
+    slowestTable_->verticalHeader()->setVisible(false);
+    slowestTable_->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    slowestTable_->setSelectionMode(QAbstractItemView::NoSelection);
+    slowestTable_->horizontalHeader()->setSectionResizeMode(0, QHeaderView::Stretch);
+    for (int column = 1; column < slowestTable_->columnCount(); ++column) {
+        slowestTable_->horizontalHeader()->setSectionResizeMode(column, QHeaderView::ResizeToContents);
+    }
+    slowestLayout->addWidget(slowestTable_);
+    layout->addWidget(slowestGroup, 1);
+
+    // Periodic Prometheus text file for unattended runs
+    QGroupBox* prometheusGroup = new QGroupBox("Prometheus file");
+    QVBoxLayout* prometheusLayout = new QVBoxLayout(prometheusGroup);
+    QHBoxLayout* pathLayout = new QHBoxLayout();
+    prometheusCheck_ = new QCheckBox("Write");
+    prometheusPathEdit_ = new QLineEdit();
+    prometheusPathEdit_->setPlaceholderText("/var/lib/node_exporter/textfile/yolo.prom");
+    prometheusBrowseButton_ = new QPushButton("...");
+    prometheusIntervalSpin_ = new QSpinBox();
+    prometheusIntervalSpin_->setRange(1, 3600);
+    prometheusIntervalSpin_->setValue(Config::METRICS_EXPORT_INTERVAL_SECONDS);
+    prometheusIntervalSpin_->setSuffix(" s");
+    pathLayout->addWidget(prometheusCheck_);
+    pathLayout->addWidget(prometheusPathEdit_, 1);
+    pathLayout->addWidget(prometheusBrowseButton_);
+    pathLayout->addWidget(prometheusIntervalSpin_);
+    prometheusStatusLabel_ = new QLabel();
+    prometheusLayout->addLayout(pathLayout);
+    prometheusLayout->addWidget(prometheusStatusLabel_);
+    layout->addWidget(prometheusGroup);
+
+    connect(prometheusCheck_, &QCheckBox::toggled, this, &MetricsDock::onPrometheusSettingsChanged);
+    connect(prometheusPathEdit_, &QLineEdit::editingFinished, this, &MetricsDock::onPrometheusSettingsChanged);
+    connect(prometheusIntervalSpin_, QOverload<int>::of(&QSpinBox::valueChanged),
+            this, &MetricsDock::onPrometheusSettingsChanged);
+    connect(prometheusBrowseButton_, &QPushButton::clicked, this, &MetricsDock::onBrowsePrometheusFile);
+
+    setWidget(content);
+}
+
+void MetricsDock::setMetrics(std::shared_ptr<Core::PipelineMetrics> metrics) {
+    metrics_ = std::move(metrics);
+    refresh();
+}
+
+void MetricsDock::setPrometheusOutput(bool enabled, const QString& path, int intervalSeconds) {
+    prometheusPathEdit_->setText(path);
+    prometheusIntervalSpin_->setValue(intervalSeconds);
+    prometheusCheck_->setChecked(enabled);
+    onPrometheusSettingsChanged();
+}
+
+bool MetricsDock::prometheusEnabled() const {
+    return prometheusCheck_->isChecked();
+}
+
+QString MetricsDock::prometheusPath() const {
+    return prometheusPathEdit_->text();
+}
+
+int MetricsDock::prometheusInterval() const {
+    return prometheusIntervalSpin_->value();
+}
+
+void MetricsDock::refresh() {
+    if (!metrics_) {
+        return;
+    }
+
+    throughputLabel_->setText(QString("%1 images in %2 — %3 images/s (10 s), %4 images/s (60 s)")
+                              .arg(metrics_->imagesCompleted())
+                              .arg(QTime(0, 0).addSecs(static_cast<int>(metrics_->elapsedSeconds())).toString("hh:mm:ss"))
+                              .arg(metrics_->imagesPerSecond(10), 0, 'f', 1)
+                              .arg(metrics_->imagesPerSecond(60), 0, 'f', 1));
+    queueLabel_->setText(QString("Pending images: %1   UI backlog: %2")
+                         .arg(metrics_->queueDepth(Core::PipelineMetrics::Queue::PendingImages))
+                         .arg(metrics_->queueDepth(Core::PipelineMetrics::Queue::UiBacklog)));
+
+    updateStageTable();
+    updateFolderTable();
+    updateSlowestTable();
+}
+
+void MetricsDock::updateStageTable() {
+    for (int row = 0; row < stageTable_->rowCount(); ++row) {
+        const Core::LatencyHistogram& histogram = metrics_->stage(static_cast<Core::PipelineStage>(row));
+        stageTable_->setItem(row, 1, numberItem(QString::number(histogram.count())));
+        stageTable_->setItem(row, 2, numberItem(ms(histogram.percentileMicros(50))));
+        stageTable_->setItem(row, 3, numberItem(ms(histogram.percentileMicros(95))));
+        stageTable_->setItem(row, 4, numberItem(ms(histogram.percentileMicros(99))));
+        stageTable_->setItem(row, 5, numberItem(ms(histogram.maxMicros())));
+        stageTable_->setItem(row, 6, numberItem(QString::number(histogram.meanMicros() / 1000.0, 'f', 1)));
+    }
+}
+
+void MetricsDock::updateFolderTable() {
+    std::vector<Core::PipelineMetrics::FolderLatency> completed = metrics_->completedFolders();
+    QString current = QString::fromStdString(metrics_->currentFolderName());
+
+    int recent = std::min(RECENT_FOLDERS, static_cast<int>(completed.size()));
+    int rows = recent + (current.isEmpty() ? 0 : 1);
+    folderTable_->setRowCount(rows);
+
+    int row = 0;
+    if (!current.isEmpty()) {
+        const Core::LatencyHistogram& histogram = metrics_->currentFolder();
+        QTableWidgetItem* name = new QTableWidgetItem(current + " (in progress)");
+        QFont font = name->font();
+        font.setItalic(true);
+        name->setFont(font);
+        folderTable_->setItem(row, 0, name);
+        folderTable_->setItem(row, 1, numberItem(QString::number(histogram.count())));
+        folderTable_->setItem(row, 2, numberItem(ms(histogram.percentileMicros(50))));
+        folderTable_->setItem(row, 3, numberItem(ms(histogram.percentileMicros(95))));
+        folderTable_->setItem(row, 4, numberItem(ms(histogram.percentileMicros(99))));
+        folderTable_->setItem(row, 5, numberItem(ms(histogram.maxMicros())));
+        folderTable_->setItem(row, 6, numberItem(QString::number(histogram.meanMicros() / 1000.0, 'f', 1)));
+        ++row;
+    }
+
+    // Newest completed first
+    for (int i = 0; i < recent; ++i, ++row) {
+        const auto& folder = completed[completed.size() - 1 - i];
+        folderTable_->setItem(row, 0, new QTableWidgetItem(QString::fromStdString(folder.name)));
+        folderTable_->setItem(row, 1, numberItem(QString::number(folder.images)));
+        folderTable_->setItem(row, 2, numberItem(QString::number(folder.p50Ms, 'f', 1)));
+        folderTable_->setItem(row, 3, numberItem(QString::number(folder.p95Ms, 'f', 1)));
+        folderTable_->setItem(row, 4, numberItem(QString::number(folder.p99Ms, 'f', 1)));
+        folderTable_->setItem(row, 5, numberItem(QString::number(folder.maxMs, 'f', 1)));
+        folderTable_->setItem(row, 6, numberItem(QString()));
+    }
+}
+
+void MetricsDock::updateSlowestTable() {
+    std::vector<Core::PipelineMetrics::SlowImage> slowest = metrics_->slowestImages();
+    slowestTable_->setRowCount(static_cast<int>(slowest.size()));
+
+    for (int row = 0; row < slowestTable_->rowCount(); ++row) {
+        const auto& image = slowest[row];
+        const Core::ImageTiming& timing = image.timing;
+        QString path = QString::fromStdString(image.imagePath);
+        QTableWidgetItem* name = new QTableWidgetItem(QFileInfo(path).fileName());
+        name->setToolTip(path);
+        slowestTable_->setItem(row, 0, name);
+        slowestTable_->setItem(row, 1, numberItem(ms(timing.totalMicros)));
+        slowestTable_->setItem(row, 2, numberItem(ms(timing.decodeMicros)));
+        slowestTable_->setItem(row, 3, numberItem(ms(timing.inferenceMicros)));
+        slowestTable_->setItem(row, 4, numberItem(ms(timing.postprocessMicros)));
+        slowestTable_->setItem(row, 5, numberItem(QString::number(timing.candidates)));
+        slowestTable_->setItem(row, 6, numberItem(QString("%1 x %2").arg(image.imageSize.width).arg(image.imageSize.height)));
+        slowestTable_->setItem(row, 7, numberItem(QString::number(timing.fileBytes / (1024.0 * 1024.0), 'f', 1)));
+    }
+}
+
+void MetricsDock::writePrometheusFile() {
+    QString path = prometheusPath();
+    if (!metrics_ || path.isEmpty()) {
+        return;
+    }
+
+    try {
+        metrics_->writePrometheusFile(path.toStdString());
+        prometheusStatusLabel_->setText(QString("Written %1").arg(QTime::currentTime().toString("hh:mm:ss")));
+    } catch (const std::exception& e) {
+        prometheusStatusLabel_->setText(QString::fromStdString(e.what()));
+    }
+}
+
+void MetricsDock::onBrowsePrometheusFile() {
+    QString path = QFileDialog::getSaveFileName(this, "Prometheus Metrics File", prometheusPath(),
+                                                "Prometheus text (*.prom);;All Files (*)");
+    if (!path.isEmpty()) {
+        prometheusPathEdit_->setText(path);
+        onPrometheusSettingsChanged();
+    }
+}
+
+void MetricsDock::onPrometheusSettingsChanged() {
+    bool active = prometheusCheck_->isChecked() && !prometheusPath().isEmpty();
+    if (active) {
+        prometheusTimer_->start(prometheusInterval() * 1000);
+    } else {
+        prometheusTimer_->stop();
+        prometheusStatusLabel_->clear();
+    }
+}
+
+} // namespace UI
+} // namespace YoloApp
@@ -0,0 +1,80 @@
+// src/ui/metrics_dock.h
+#pragma once
+
+#include "../core/pipeline_metrics.h"
+#include <QDockWidget>
+#include <QLabel>
+#include <QTableWidget>
+#include <QCheckBox>
+#include <QLineEdit>
+#include <QSpinBox>
+#include <QPushButton>
+#include <QTimer>
+#include <memory>
+
+namespace YoloApp {
+namespace UI {
+
+/**
+ * @brief Dock showing live pipeline metrics of the current run
+ *
+ * Refreshes once a second while visible: rolling throughput, queue depths,
+ * per-stage latency percentiles, and per-folder latency of the folder in
+ * progress and the most recently completed ones, and the slowest images
+ * with their time breakdown. Optionally writes the
+ * metrics as a Prometheus text file on an interval, whether or not the dock
+ * is shown.
+ */
+class MetricsDock : public QDockWidget {
+    Q_OBJECT
+
+public:
+    explicit MetricsDock(QWidget* parent = nullptr);
+    ~MetricsDock() override = default;
+
+    /**
+     * @brief Show (and export) the metrics of a new run
+     */
+    void setMetrics(std::shared_ptr<Core::PipelineMetrics> metrics);
+
+    /**
+     * @brief Configure the Prometheus file; an empty path or disabled turns writing off
+     */
+    void setPrometheusOutput(bool enabled, const QString& path, int intervalSeconds);
+
+    bool prometheusEnabled() const;
+    QString prometheusPath() const;
+    int prometheusInterval() const;
+
+private slots:
+    void refresh();
+    void writePrometheusFile();
+    void onBrowsePrometheusFile();
+    void onPrometheusSettingsChanged();
+
+private:
+    void setupUI();
+    void updateStageTable();
+    void updateFolderTable();
+    void updateSlowestTable();
+
+    std::shared_ptr<Core::PipelineMetrics> metrics_;
+
+    QLabel* throughputLabel_;
+    QLabel* queueLabel_;
+    QTableWidget* stageTable_;
+    QTableWidget* folderTable_;
+    QTableWidget* slowestTable_;
+
+    QCheckBox* prometheusCheck_;
+    QLineEdit* prometheusPathEdit_;
+    QSpinBox* prometheusIntervalSpin_;
+    QPushButton* prometheusBrowseButton_;
+    QLabel* prometheusStatusLabel_;
+
+    QTimer* refreshTimer_;
+    QTimer* prometheusTimer_;
+};
+
+} // namespace UI
+} // namespace YoloApp
@@ -0,0 +1,53 @@
+// src/ui/pyramid_pixmap_item.cpp
+#include "pyramid_pixmap_item.h"
+#include <QPainter>
+#include <QStyleOptionGraphicsItem>
+
+namespace YoloApp {
+namespace UI {
+
+PyramidPixmapItem::PyramidPixmapItem(QGraphicsItem* parent)
+    : QGraphicsItem(parent) {
+    setFlag(QGraphicsItem::ItemUsesExtendedStyleOption);
+}
+
+void PyramidPixmapItem::setDisplayImage(std::shared_ptr<DisplayImage> image) {
+    prepareGeometryChange();
+    image_ = std::move(image);
+    update();
+}
+
+QRectF PyramidPixmapItem::boundingRect() const {
+    if (!image_) {
+        return QRectF();
+    }
+    return QRectF(QPointF(0, 0), image_->size());
+}
+
+void PyramidPixmapItem::paint(QPainter* painter, const QStyleOptionGraphicsItem* option,
+                              QWidget* widget) {
+    Q_UNUSED(widget)
+    if (!image_) {
+        return;
+    }
+
+    qreal scale = QStyleOptionGraphicsItem::levelOfDetailFromTransform(painter->worldTransform());
+    int level = image_->levelForScale(scale);
+    const QPixmap& pixmap = image_->pixmap(level);
+    if (pixmap.isNull()) {
+        return;
+    }
+
+    // Map the exposed item area into the chosen level's pixel space
+    QRectF target = option->exposedRect.intersected(boundingRect());
+    qreal levelScaleX = static_cast<qreal>(pixmap.width()) / image_->size().width();
+    qreal levelScaleY = static_cast<qreal>(pixmap.height()) / image_->size().height();
+    QRectF source(target.x() * levelScaleX, target.y() * levelScaleY,
+                  target.width() * levelScaleX, target.height() * levelScaleY);
+
+    painter->setRenderHint(QPainter::SmoothPixmapTransform, scale < 1.0 || level > 0);
+    painter->drawPixmap(target, pixmap, source);
+}
+
+} // namespace UI
+} // namespace YoloApp
@@ -0,0 +1,35 @@
+// src/ui/pyramid_pixmap_item.h
+#pragma once
+
+#include "display_image.h"
+#include <QGraphicsItem>
+#include <memory>
+
+namespace YoloApp {
+namespace UI {
+
+/**
+ * @brief Graphics item drawing a DisplayImage from its mip pyramid
+ *
+ * The item always has the full-resolution geometry; on paint it picks the
+ * pyramid level matching the view's scale and draws only the exposed part,
+ * so zooming is a view transform and never re-converts the image.
+ */
+class PyramidPixmapItem : public QGraphicsItem {
+public:
+    explicit PyramidPixmapItem(QGraphicsItem* parent = nullptr);
+    ~PyramidPixmapItem() override = default;
+
+    void setDisplayImage(std::shared_ptr<DisplayImage> image);
+    const std::shared_ptr<DisplayImage>& displayImage() const { return image_; }
+
+    QRectF boundingRect() const override;
+    void paint(QPainter* painter, const QStyleOptionGraphicsItem* option,
+               QWidget* widget = nullptr) override;
+
+private:
+    std::shared_ptr<DisplayImage> image_;
+};
+
+} // namespace UI
+} // namespace YoloApp
@@ -0,0 +1,464 @@
+// src/ui/region_image_reader.cpp
+#include "region_image_reader.h"
+#include "../core/config.h"
+#include <QFile>
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+
+#ifdef YOLO_HAVE_PNG
+#include <png.h>
+#endif
+
+#ifdef YOLO_HAVE_TIFF
+#include <tiffio.h>
+#endif
+
+namespace YoloApp {
+namespace UI {
+
+namespace {
+
+uint32_t readLe32(const uchar* data) {
+    return static_cast<uint32_t>(data[0]) | (static_cast<uint32_t>(data[1]) << 8) |
+           (static_cast<uint32_t>(data[2]) << 16) | (static_cast<uint32_t>(data[3]) << 24);
+}
+
+uint16_t readLe16(const uchar* data) {
+    return static_cast<uint16_t>(data[0] | (data[1] << 8));
+}
+
+/**
+ * @brief Uncompressed 24/32-bit BMP: each source row is read with one seek
+ */
+class BmpRegionReader : public RegionImageReader {
+public:
+    static std::unique_ptr<RegionImageReader> open(const QString& imagePath) {
+        QFile file(imagePath);
+        if (!file.open(QIODevice::ReadOnly)) {
+            return nullptr;
+        }
+
+        QByteArray header = file.read(54);
+        if (header.size() < 54 || !header.startsWith("BM")) {
+            return nullptr;
+        }
+
+        const auto* data = reinterpret_cast<const uchar*>(header.constData());
+        uint32_t pixelOffset = readLe32(data + 10);
+        uint32_t headerSize = readLe32(data + 14);
+        auto width = static_cast<int32_t>(readLe32(data + 18));
+        auto height = static_cast<int32_t>(readLe32(data + 22));
+        uint16_t bitsPerPixel = readLe16(data + 28);
+        uint32_t compression = readLe32(data + 30);
+
+        // OS/2 headers, RLE, bit fields and palettes are left to Qt
+        if (headerSize < 40 || compression != 0 || (bitsPerPixel != 24 && bitsPerPixel != 32) ||
+            width <= 0 || height == 0 || height == INT32_MIN) {
+            return nullptr;
+        }
+
+        std::unique_ptr<BmpRegionReader> reader(new BmpRegionReader(imagePath));
+        reader->size_ = QSize(width, std::abs(height));
+        reader->topDown_ = height < 0;
+        reader->bytesPerPixel_ = bitsPerPixel / 8;
+        reader->pixelOffset_ = pixelOffset;
+        reader->stride_ = (static_cast<qint64>(width) * bitsPerPixel + 31) / 32 * 4;
+        if (file.size() < pixelOffset + reader->stride_ * reader->size_.height()) {
+            return nullptr;   // Truncated
+        }
+        return reader;
+    }
+
+protected:
+    bool readRegion(const QRect& sourceRect, Accumulator& accumulator) override {
+        QFile file(imagePath_);
+        if (!file.open(QIODevice::ReadOnly)) {
+            return false;
+        }
+
+        const int width = sourceRect.width();
+        std::vector<uchar> raw(static_cast<size_t>(width) * bytesPerPixel_);
+        std::vector<uchar> rgb(static_cast<size_t>(width) * 3);
+        for (int y = sourceRect.top(); y <= sourceRect.bottom(); ++y) {
+            qint64 fileRow = topDown_ ? y : size_.height() - 1 - y;
+            qint64 offset = pixelOffset_ + fileRow * stride_ + static_cast<qint64>(sourceRect.left()) * bytesPerPixel_;
+            if (!file.seek(offset) ||
+                file.read(reinterpret_cast<char*>(raw.data()), static_cast<qint64>(raw.size())) !=
+                    static_cast<qint64>(raw.size())) {
+                return false;
+            }
+
+            // BGR(X) to RGB
+            for (int x = 0; x < width; ++x) {
+                const uchar* pixel = raw.data() + static_cast<size_t>(x) * bytesPerPixel_;
+                uchar* out = rgb.data() + static_cast<size_t>(x) * 3;
+                out[0] = pixel[2];
+                out[1] = pixel[1];
+                out[2] = pixel[0];
+            }
+            accumulator.addRow(y, sourceRect.left(), rgb.data(), width);
+        }
+        return true;
+    }
+
+private:
+    explicit BmpRegionReader(const QString& imagePath)
+        : RegionImageReader(imagePath) {
+    }
+
+    bool topDown_ = false;
+    int bytesPerPixel_ = 3;
+    qint64 pixelOffset_ = 0;
+    qint64 stride_ = 0;
+};
+
+#ifdef YOLO_HAVE_PNG
+/**
+ * @brief Non-interlaced PNG, decoded one row at a time from the top
+ *
+ * PNG rows can only be decoded in file order, so rows above the region are
+ * decoded and dropped; memory stays at one row of the frame.
+ */
+class PngRegionReader : public RegionImageReader {
+public:
+    static std::unique_ptr<RegionImageReader> open(const QString& imagePath) {
+        std::unique_ptr<PngRegionReader> reader(new PngRegionReader(imagePath));
+        if (!reader->readHeader()) {
+            return nullptr;
+        }
+        return reader;
+    }
+
+protected:
+    bool readRegion(const QRect& sourceRect, Accumulator& accumulator) override {
+        Decoder decoder;
+        std::vector<uchar> row(static_cast<size_t>(size_.width()) * 3);
+        if (!start(decoder)) {
+            return false;
+        }
+
+        // libpng reports errors by jumping back here; nothing below owns resources
+        if (setjmp(png_jmpbuf(decoder.png))) {
+            return false;
+        }
+
+        png_read_info(decoder.png, decoder.info);
+        png_set_expand(decoder.png);
+        png_set_strip_16(decoder.png);
+        png_set_strip_alpha(decoder.png);
+        png_set_gray_to_rgb(decoder.png);
+        png_read_update_info(decoder.png, decoder.info);
+        if (png_get_rowbytes(decoder.png, decoder.info) != row.size()) {
+            return false;
+        }
+
+        for (int y = 0; y <= sourceRect.bottom(); ++y) {
+            png_read_row(decoder.png, row.data(), nullptr);
+            if (y >= sourceRect.top()) {
+                accumulator.addRow(y, sourceRect.left(), row.data() + static_cast<size_t>(sourceRect.left()) * 3,
+                                   sourceRect.width());
+            }
+        }
+        return true;
+    }
+
+private:
+    explicit PngRegionReader(const QString& imagePath)
+        : RegionImageReader(imagePath) {
+    }
+
+    // libpng state for one pass over the file
+    struct Decoder {
+        QFile file;
+        png_structp png = nullptr;
+        png_infop info = nullptr;
+
+        ~Decoder() {
+            if (png) {
+                png_destroy_read_struct(&png, info ? &info : nullptr, nullptr);
+            }
+        }
+    };
+
+    static void readData(png_structp png, png_bytep data, png_size_t length) {
+        auto* file = static_cast<QFile*>(png_get_io_ptr(png));
+        if (file->read(reinterpret_cast<char*>(data), static_cast<qint64>(length)) != static_cast<qint64>(length)) {
+            png_error(png, "Unexpected end of file");
+        }
+    }
+
+    static void ignoreWarning(png_structp, png_const_charp) {
+    }
+
+    bool start(Decoder& decoder) const {
+        decoder.file.setFileName(imagePath_);
+        if (!decoder.file.open(QIODevice::ReadOnly)) {
+            return false;
+        }
+
+        png_byte signature[8];
+        if (decoder.file.read(reinterpret_cast<char*>(signature), 8) != 8 || png_sig_cmp(signature, 0, 8) != 0) {
+            return false;
+        }
+
+        decoder.png = png_create_read_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, &ignoreWarning);
+        if (!decoder.png) {
+            return false;
+        }
+        decoder.info = png_create_info_struct(decoder.png);
+        if (!decoder.info) {
+            return false;
+        }
+        png_set_read_fn(decoder.png, &decoder.file, &readData);
+        png_set_sig_bytes(decoder.png, 8);
+        return true;
+    }
+
+    bool readHeader() {
+        Decoder decoder;
+        if (!start(decoder)) {
+            return false;
+        }
+        if (setjmp(png_jmpbuf(decoder.png))) {
+            return false;
+        }
+
+        png_read_info(decoder.png, decoder.info);
+
+        // Adam7 passes cover the whole frame; those are left to Qt
+        if (png_get_interlace_type(decoder.png, decoder.info) != PNG_INTERLACE_NONE) {
+            return false;
+        }
+
+        png_uint_32 width = png_get_image_width(decoder.png, decoder.info);
+        png_uint_32 height = png_get_image_height(decoder.png, decoder.info);
+        if (width == 0 || height == 0 || width > INT_MAX / 3 || height > INT_MAX) {
+            return false;
+        }
+        size_ = QSize(static_cast<int>(width), static_cast<int>(height));
+        return true;
+    }
+};
+#endif
+
+#ifdef YOLO_HAVE_TIFF
+struct TiffCloser {
+    void operator()(TIFF* tiff) const { TIFFClose(tiff); }
+};
+using TiffHandle = std::unique_ptr<TIFF, TiffCloser>;
+
+TiffHandle openTiff(const QString& imagePath) {
+#ifdef _WIN32
+    return TiffHandle(TIFFOpenW(reinterpret_cast<const wchar_t*>(imagePath.utf16()), "r"));
+#else
+    return TiffHandle(TIFFOpen(QFile::encodeName(imagePath).constData(), "r"));
+#endif
+}
+
+/**
+ * @brief Stripped or tiled TIFF, read one strip or tile at a time
+ *
+ * libtiff's RGBA interface converts any photometric, bit depth and
+ * compression it supports, so only the block size is checked.
+ */
+class TiffRegionReader : public RegionImageReader {
+public:
+    static std::unique_ptr<RegionImageReader> open(const QString& imagePath) {
+        TiffHandle tiff = openTiff(imagePath);
+        if (!tiff) {
+            return nullptr;
+        }
+
+        uint32_t width = 0;
+        uint32_t height = 0;
+        if (!TIFFGetField(tiff.get(), TIFFTAG_IMAGEWIDTH, &width) ||
+            !TIFFGetField(tiff.get(), TIFFTAG_IMAGELENGTH, &height) ||
+            width == 0 || height == 0 || width > INT_MAX || height > INT_MAX) {
+            return nullptr;
+        }
+
+        char message[1024];
+        if (!TIFFRGBAImageOK(tiff.get(), message)) {
+            return nullptr;
+        }
+
+        std::unique_ptr<TiffRegionReader> reader(new TiffRegionReader(imagePath));
+        reader->size_ = QSize(static_cast<int>(width), static_cast<int>(height));
+        reader->tiled_ = TIFFIsTiled(tiff.get()) != 0;
+        uint32_t blockWidth = width;
+        uint32_t blockHeight = 0;
+        if (reader->tiled_) {
+            TIFFGetField(tiff.get(), TIFFTAG_TILEWIDTH, &blockWidth);
+            TIFFGetField(tiff.get(), TIFFTAG_TILELENGTH, &blockHeight);
+        } else {
+            TIFFGetFieldDefaulted(tiff.get(), TIFFTAG_ROWSPERSTRIP, &blockHeight);
+            blockHeight = std::min(blockHeight, height);
+        }
+
+        // One strip for the whole frame would bring back the full-frame decode
+        const uint64_t maxBlockBytes = static_cast<uint64_t>(Config::TILE_DECODE_BLOCK_MAX_MB) * 1024 * 1024;
+        if (blockWidth == 0 || blockHeight == 0 || blockWidth > INT_MAX || blockHeight > INT_MAX ||
+            static_cast<uint64_t>(blockWidth) * blockHeight * 4 > maxBlockBytes) {
+            return nullptr;
+        }
+        reader->blockWidth_ = static_cast<int>(blockWidth);
+        reader->blockHeight_ = static_cast<int>(blockHeight);
+        return reader;
+    }
+
+protected:
+    bool readRegion(const QRect& sourceRect, Accumulator& accumulator) override {
+        TiffHandle tiff = openTiff(imagePath_);
+        if (!tiff) {
+            return false;
+        }
+
+        std::vector<uint32_t> raster(static_cast<size_t>(blockWidth_) * blockHeight_);
+        std::vector<uchar> rgb(static_cast<size_t>(blockWidth_) * 3);
+        int firstRow = sourceRect.top() / blockHeight_ * blockHeight_;
+        int firstCol = tiled_ ? sourceRect.left() / blockWidth_ * blockWidth_ : 0;
+        int lastCol = tiled_ ? sourceRect.right() : 0;
+
+        for (int row = firstRow; row <= sourceRect.bottom(); row += blockHeight_) {
+            int rows = std::min(blockHeight_, size_.height() - row);
+            for (int col = firstCol; col <= lastCol; col += blockWidth_) {
+                int ok = tiled_ ? TIFFReadRGBATile(tiff.get(), static_cast<uint32_t>(col),
+                                                   static_cast<uint32_t>(row), raster.data())
+                                : TIFFReadRGBAStrip(tiff.get(), static_cast<uint32_t>(row), raster.data());
+                if (!ok) {
+                    return false;
+                }
+
+                // Rasters are bottom-up; an edge tile keeps the full tile height, a last strip does not
+                int rasterRows = tiled_ ? blockHeight_ : rows;
+                int x0 = std::max(col, sourceRect.left());
+                int x1 = std::min({col + blockWidth_, size_.width(), sourceRect.right() + 1});
+                for (int i = std::max(0, sourceRect.top() - row); i < rows && row + i <= sourceRect.bottom(); ++i) {
+                    const uint32_t* pixels = raster.data() + static_cast<size_t>(rasterRows - 1 - i) * blockWidth_;
+                    for (int x = x0; x < x1; ++x) {
+                        uint32_t pixel = pixels[x - col];
+                        uchar* out = rgb.data() + static_cast<size_t>(x - x0) * 3;
+                        out[0] = static_cast<uchar>(TIFFGetR(pixel));
+                        out[1] = static_cast<uchar>(TIFFGetG(pixel));
+                        out[2] = static_cast<uchar>(TIFFGetB(pixel));
+                    }
+                    accumulator.addRow(row + i, x0, rgb.data(), x1 - x0);
+                }
+            }
+        }
+        return true;
+    }
+
+private:
+    explicit TiffRegionReader(const QString& imagePath)
+        : RegionImageReader(imagePath) {
+    }
+
+    bool tiled_ = false;
+    int blockWidth_ = 0;
+    int blockHeight_ = 0;
+};
+#endif
+
+} // namespace
+
+std::unique_ptr<RegionImageReader> RegionImageReader::open(const QString& imagePath) {
+    QFile file(imagePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return nullptr;
+    }
+    QByteArray magic = file.read(4);
+    file.close();
+
+    if (magic.startsWith("BM")) {
+        return BmpRegionReader::open(imagePath);
+    }
+#ifdef YOLO_HAVE_PNG
+    if (magic.startsWith("\x89PNG")) {
+        return PngRegionReader::open(imagePath);
+    }
+#endif
+#ifdef YOLO_HAVE_TIFF
+    if (magic.startsWith("II") || magic.startsWith("MM")) {
+        return TiffRegionReader::open(imagePath);
+    }
+#endif
+    return nullptr;
+}
+
+QImage RegionImageReader::read(int factor, const QRect& clipRect) {
+    if (factor < 1 || clipRect.isEmpty() || clipRect.left() < 0 || clipRect.top() < 0) {
+        return QImage();
+    }
+
+    // The last level pixel of a row or column may cover less than factor source pixels
+    qint64 left = static_cast<qint64>(clipRect.left()) * factor;
+    qint64 top = static_cast<qint64>(clipRect.top()) * factor;
+    qint64 right = std::min<qint64>(static_cast<qint64>(clipRect.right() + 1) * factor, size_.width());
+    qint64 bottom = std::min<qint64>(static_cast<qint64>(clipRect.bottom() + 1) * factor, size_.height());
+    if (left >= right || top >= bottom) {
+        return QImage();
+    }
+
+    QRect sourceRect(static_cast<int>(left), static_cast<int>(top),
+                     static_cast<int>(right - left), static_cast<int>(bottom - top));
+    Accumulator accumulator(sourceRect, factor, clipRect.size());
+    if (!readRegion(sourceRect, accumulator)) {
+        return QImage();
+    }
+    return accumulator.toImage();
+}
+
+RegionImageReader::Accumulator::Accumulator(const QRect& sourceRect, int factor, const QSize& outputSize)
+    : sourceRect_(sourceRect)
+    , factor_(factor)
+    , outputSize_(outputSize)
+    , sums_(static_cast<size_t>(outputSize.width()) * outputSize.height() * 3, 0) {
+}
+
+void RegionImageReader::Accumulator::addRow(int sourceY, int sourceX, const uchar* rgb, int width) {
+    if (sourceY < sourceRect_.top() || sourceY > sourceRect_.bottom()) {
+        return;
+    }
+
+    int first = std::max(sourceX, sourceRect_.left());
+    int last = std::min(sourceX + width, sourceRect_.right() + 1);
+    uint64_t* row = sums_.data() +
+                    static_cast<size_t>((sourceY - sourceRect_.top()) / factor_) * outputSize_.width() * 3;
+    for (int x = first; x < last; ++x) {
+        uint64_t* sum = row + static_cast<size_t>((x - sourceRect_.left()) / factor_) * 3;
+        const uchar* pixel = rgb + static_cast<size_t>(x - sourceX) * 3;
+        sum[0] += pixel[0];
+        sum[1] += pixel[1];
+        sum[2] += pixel[2];
+    }
+}
+
+QImage RegionImageReader::Accumulator::toImage() const {
+    QImage image(outputSize_, QImage::Format_RGB32);
+    if (image.isNull()) {
+        return image;
+    }
+
+    for (int y = 0; y < outputSize_.height(); ++y) {
+        auto* line = reinterpret_cast<QRgb*>(image.scanLine(y));
+        int rows = std::clamp(sourceRect_.height() - y * factor_, 0, factor_);
+        for (int x = 0; x < outputSize_.width(); ++x) {
+            int cols = std::clamp(sourceRect_.width() - x * factor_, 0, factor_);
+            uint64_t count = static_cast<uint64_t>(rows) * cols;
+            if (count == 0) {
+                line[x] = qRgb(0, 0, 0);
+                continue;
+            }
+            const uint64_t* sum = sums_.data() + (static_cast<size_t>(y) * outputSize_.width() + x) * 3;
+            line[x] = qRgb(static_cast<int>((sum[0] + count / 2) / count),
+                           static_cast<int>((sum[1] + count / 2) / count),
+                           static_cast<int>((sum[2] + count / 2) / count));
+        }
+    }
+    return image;
+}
+
+} // namespace UI
+} // namespace YoloApp
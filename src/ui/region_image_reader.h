@@ -0,0 +1,82 @@
+// src/ui/region_image_reader.h
+#pragma once
+
+#include <QImage>
+#include <QRect>
+#include <QSize>
+#include <QString>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace YoloApp {
+namespace UI {
+
+/**
+ * @brief Decodes a reduced region of an image a few rows or tiles at a time
+ *
+ * Qt can only clip while decoding JPEG; for other formats it decodes the
+ * whole frame before scaling and clipping. This reader walks only the source
+ * rows (or TIFF tiles) under a region and averages them straight into the
+ * output, so a decode holds the output tile plus one strip or tile of the
+ * source, whatever the frame size. Supported are stripped and tiled TIFF
+ * (built with libtiff), non-interlaced PNG (built with libpng) and
+ * uncompressed 24/32-bit BMP.
+ */
+class RegionImageReader {
+public:
+    /**
+     * @brief Reader for the file, or nullptr if its format or layout is not supported
+     */
+    static std::unique_ptr<RegionImageReader> open(const QString& imagePath);
+
+    virtual ~RegionImageReader() = default;
+
+    QSize size() const { return size_; }
+
+    /**
+     * @brief Decode a region of the image reduced by a power of two
+     * @param factor Source pixels per output pixel along each axis
+     * @param clipRect Region in reduced coordinates (those of a pyramid level)
+     * @return Format_RGB32 image of clipRect's size, or a null image on a read error
+     */
+    QImage read(int factor, const QRect& clipRect);
+
+protected:
+    /**
+     * @brief Box-filters source rows into the output region
+     */
+    class Accumulator {
+    public:
+        Accumulator(const QRect& sourceRect, int factor, const QSize& outputSize);
+
+        /**
+         * @brief Add RGB888 pixels of one source row; those outside the region are skipped
+         */
+        void addRow(int sourceY, int sourceX, const uchar* rgb, int width);
+
+        QImage toImage() const;
+
+    private:
+        QRect sourceRect_;
+        int factor_;
+        QSize outputSize_;
+        std::vector<uint64_t> sums_;    // Per output pixel and channel
+    };
+
+    explicit RegionImageReader(const QString& imagePath)
+        : imagePath_(imagePath) {
+    }
+
+    /**
+     * @brief Feed every source row of sourceRect (within the image) to the accumulator
+     * @return false on a read or decode error
+     */
+    virtual bool readRegion(const QRect& sourceRect, Accumulator& accumulator) = 0;
+
+    QString imagePath_;
+    QSize size_;
+};
+
+} // namespace UI
+} // namespace YoloApp
@@ -0,0 +1,140 @@
+// src/ui/results_model.cpp
+#include "results_model.h"
+
+namespace YoloApp {
+namespace UI {
+
+ResultsModel::ResultsModel(QObject* parent)
+    : QAbstractTableModel(parent) {
+}
+
+int ResultsModel::rowCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : static_cast<int>(rows_.size());
+}
+
+int ResultsModel::columnCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+QVariant ResultsModel::data(const QModelIndex& index, int role) const {
+    if (!index.isValid() || index.row() >= static_cast<int>(rows_.size())) {
+        return QVariant();
+    }
+
+    const Row& row = rows_[index.row()];
+
+    if (role == FolderIndexRole) {
+        return index.row();
+    }
+
+    if (role != Qt::DisplayRole) {
+        return QVariant();
+    }
+
+    // Numeric columns return ints so the sort proxy compares them numerically
+    switch (index.column()) {
+        case FolderColumn:     return row.folderName;
+        case ImagesColumn:     return row.imageCount;
+        case DetectionsColumn: return row.totalDetections;
+        case StatusColumn:     return row.processed ? QStringLiteral("Completed")
+                                                    : QStringLiteral("Processing...");
+        default:               return QVariant();
+    }
+}
+
+QVariant ResultsModel::headerData(int section, Qt::Orientation orientation, int role) const {
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) {
+        return QAbstractTableModel::headerData(section, orientation, role);
+    }
+
+    switch (section) {
+        case FolderColumn:     return QStringLiteral("Folder");
+        case ImagesColumn:     return QStringLiteral("Images");
+        case DetectionsColumn: return QStringLiteral("Detections");
+        case StatusColumn:     return QStringLiteral("Status");
+        default:               return QVariant();
+    }
+}
+
+void ResultsModel::setFolders(const std::vector<Core::FolderResult>& folders) {
+    beginResetModel();
+    rows_.clear();
+    totals_ = Totals();
+    rows_.reserve(folders.size());
+    for (const auto& folder : folders) {
+        rows_.push_back(makeRow(folder));
+        addToTotals(rows_.back(), 1);
+    }
+    endResetModel();
+
+    emit totalsChanged();
+}
+
+void ResultsModel::appendFolders(const std::vector<Core::FolderResult>& folders) {
+    if (folders.empty()) {
+        return;
+    }
+
+    int first = static_cast<int>(rows_.size());
+    int last = first + static_cast<int>(folders.size()) - 1;
+
+    beginInsertRows(QModelIndex(), first, last);
+    rows_.reserve(rows_.size() + folders.size());
+    for (const auto& folder : folders) {
+        rows_.push_back(makeRow(folder));
+        addToTotals(rows_.back(), 1);
+    }
+    endInsertRows();
+
+    emit totalsChanged();
+}
+
+void ResultsModel::updateFolder(int folderIndex, int imageCount, int totalDetections, bool processed) {
+    if (folderIndex < 0 || folderIndex >= static_cast<int>(rows_.size())) {
+        return;
+    }
+
+    Row& row = rows_[folderIndex];
+    addToTotals(row, -1);
+    row.imageCount = imageCount;
+    row.totalDetections = totalDetections;
+    row.processed = processed;
+    addToTotals(row, 1);
+
+    emit dataChanged(index(folderIndex, ImagesColumn), index(folderIndex, StatusColumn));
+    emit totalsChanged();
+}
+
+void ResultsModel::clear() {
+    if (rows_.empty()) {
+        return;
+    }
+
+    beginResetModel();
+    rows_.clear();
+    totals_ = Totals();
+    endResetModel();
+
+    emit totalsChanged();
+}
+
+ResultsModel::Row ResultsModel::makeRow(const Core::FolderResult& folder) {
+    Row row;
+    row.folderName = QString::fromStdString(folder.folderName);
+    row.imageCount = folder.imageCount;
+    row.totalDetections = folder.totalDetections;
+    row.processed = folder.processed;
+    return row;
+}
+
+void ResultsModel::addToTotals(const Row& row, int sign) {
+    totals_.folders += sign;
+    totals_.images += sign * row.imageCount;
+    totals_.detections += sign * row.totalDetections;
+    if (row.processed) {
+        totals_.completedFolders += sign;
+    }
+}
+
+} // namespace UI
+} // namespace YoloApp
@@ -0,0 +1,93 @@
+// src/ui/results_model.h
+#pragma once
+
+#include "../core/types.h"
+#include <QAbstractTableModel>
+#include <QString>
+#include <vector>
+
+namespace YoloApp {
+namespace UI {
+
+/**
+ * @brief Table model holding one lightweight row per scanned folder
+ *
+ * Rows are appended once after scanning and then patched in place as the
+ * worker reports folder completions, so views only repaint what changed.
+ * Summary totals are maintained incrementally alongside the rows.
+ */
+class ResultsModel : public QAbstractTableModel {
+    Q_OBJECT
+
+public:
+    enum Column {
+        FolderColumn = 0,
+        ImagesColumn,
+        DetectionsColumn,
+        StatusColumn,
+        ColumnCount
+    };
+
+    /**
+     * @brief Role returning the folder index of a row (stable under sorting)
+     */
+    static constexpr int FolderIndexRole = Qt::UserRole;
+
+    struct Totals {
+        int folders = 0;
+        int completedFolders = 0;
+        long long images = 0;
+        long long detections = 0;
+    };
+
+    explicit ResultsModel(QObject* parent = nullptr);
+    ~ResultsModel() override = default;
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation,
+                        int role = Qt::DisplayRole) const override;
+
+    /**
+     * @brief Replace all rows (full resync, e.g. on explicit refresh)
+     */
+    void setFolders(const std::vector<Core::FolderResult>& folders);
+
+    /**
+     * @brief Append rows for newly scanned folders
+     */
+    void appendFolders(const std::vector<Core::FolderResult>& folders);
+
+    /**
+     * @brief Patch a single row and emit dataChanged for it only
+     */
+    void updateFolder(int folderIndex, int imageCount, int totalDetections, bool processed);
+
+    /**
+     * @brief Remove all rows
+     */
+    void clear();
+
+    const Totals& totals() const { return totals_; }
+
+signals:
+    void totalsChanged();
+
+private:
+    struct Row {
+        QString folderName;
+        int imageCount = 0;
+        int totalDetections = 0;
+        bool processed = false;
+    };
+
+    static Row makeRow(const Core::FolderResult& folder);
+    void addToTotals(const Row& row, int sign);
+
+    std::vector<Row> rows_;
+    Totals totals_;
+};
+
+} // namespace UI
+} // namespace YoloApp
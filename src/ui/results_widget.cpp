@@ -3,6 +3,7 @@
 #include "../core/config.h"
 #include <QHeaderView>
 #include <QAbstractItemView>
+#include <QItemSelectionModel>
 
 namespace YoloApp {
 namespace UI {
@@ -21,8 +22,15 @@ void ResultsWidget::setupUI() {
     summaryLabel_ = new QLabel("No results");
     summaryLabel_->setStyleSheet("font-weight: bold;");
     
+    // Class query over all results, e.g. "person>=3, truck@0.7"
+    queryEdit_ = new QLineEdit();
+    queryEdit_->setPlaceholderText("Find images, e.g. person>=3, truck@0.7, !dog");
+    queryEdit_->setClearButtonEnabled(true);
+    queryEdit_->setMinimumWidth(260);
+    
     topLayout_->addWidget(summaryLabel_);
     topLayout_->addStretch();
+    topLayout_->addWidget(queryEdit_);
     
     // Bottom controls
     bottomLayout_ = new QHBoxLayout();
@@ -45,54 +53,54 @@ void ResultsWidget::setupUI() {
     
     connect(exportButton_, &QPushButton::clicked, this, &ResultsWidget::onExportClicked);
     connect(refreshButton_, &QPushButton::clicked, this, &ResultsWidget::onRefreshClicked);
+    connect(queryEdit_, &QLineEdit::returnPressed, this, &ResultsWidget::onQuerySubmitted);
 }
 
 void ResultsWidget::setupTable() {
-    resultsTable_ = new QTableWidget();
-    resultsTable_->setColumnCount(4);
+    resultsModel_ = new ResultsModel(this);
+    
+    // Sorting goes through a proxy so row updates only re-position the changed row
+    sortModel_ = new QSortFilterProxyModel(this);
+    sortModel_->setSourceModel(resultsModel_);
+    sortModel_->setDynamicSortFilter(true);
     
-    QStringList headers = {"Folder", "Images", "Detections", "Status"};
-    resultsTable_->setHorizontalHeaderLabels(headers);
+    resultsTable_ = new QTableView();
+    resultsTable_->setModel(sortModel_);
     
     // Configure table
     resultsTable_->setSelectionBehavior(QAbstractItemView::SelectRows);
+    resultsTable_->setSelectionMode(QAbstractItemView::SingleSelection);
     resultsTable_->setAlternatingRowColors(true);
     resultsTable_->setSortingEnabled(true);
+    resultsTable_->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    resultsTable_->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
     
     // Set column widths
     QHeaderView* header = resultsTable_->horizontalHeader();
     header->setStretchLastSection(true);
-    header->resizeSection(0, 200);  // Folder name
-    header->resizeSection(1, 80);   // Image count
-    header->resizeSection(2, 100);  // Detection count
+    header->resizeSection(ResultsModel::FolderColumn, 200);
+    header->resizeSection(ResultsModel::ImagesColumn, 80);
+    header->resizeSection(ResultsModel::DetectionsColumn, 100);
     
-    connect(resultsTable_, &QTableWidget::itemSelectionChanged, 
+    connect(resultsTable_->selectionModel(), &QItemSelectionModel::selectionChanged,
             this, &ResultsWidget::onTableSelectionChanged);
+    connect(resultsModel_, &ResultsModel::totalsChanged, this, &ResultsWidget::updateSummary);
 }
 
 void ResultsWidget::updateResults(const std::vector<Core::FolderResult>& results) {
-    results_ = results;
-    
-    resultsTable_->setRowCount(static_cast<int>(results.size()));
-    
-    for (int i = 0; i < static_cast<int>(results.size()); ++i) {
-        const auto& folder = results[i];
-        
-        resultsTable_->setItem(i, 0, new QTableWidgetItem(QString::fromStdString(folder.folderName)));
-        resultsTable_->setItem(i, 1, new QTableWidgetItem(QString::number(folder.imageCount)));
-        resultsTable_->setItem(i, 2, new QTableWidgetItem(QString::number(folder.totalDetections)));
-        resultsTable_->setItem(i, 3, new QTableWidgetItem(folder.processed ? "Completed" : "Processing..."));
-        
-        // Set row data for easy access
-        resultsTable_->item(i, 0)->setData(Qt::UserRole, i);
-    }
-    
-    updateSummary();
+    resultsModel_->setFolders(results);
+}
+
+void ResultsWidget::appendFolders(const std::vector<Core::FolderResult>& folders) {
+    resultsModel_->appendFolders(folders);
+}
+
+void ResultsWidget::updateFolder(int folderIndex, int imageCount, int totalDetections, bool processed) {
+    resultsModel_->updateFolder(folderIndex, imageCount, totalDetections, processed);
 }
 
 void ResultsWidget::clearResults() {
-    results_.clear();
-    resultsTable_->setRowCount(0);
+    resultsModel_->clear();
     selectedFolderIndex_ = -1;
     updateSummary();
 }
@@ -112,10 +120,9 @@ int ResultsWidget::getSelectedFolderIndex() const {
 }
 
 void ResultsWidget::onTableSelectionChanged() {
-    QList<QTableWidgetItem*> selected = resultsTable_->selectedItems();
+    QModelIndexList selected = resultsTable_->selectionModel()->selectedRows();
     if (!selected.isEmpty()) {
-        int row = selected.first()->row();
-        selectedFolderIndex_ = resultsTable_->item(row, 0)->data(Qt::UserRole).toInt();
+        selectedFolderIndex_ = selected.first().data(ResultsModel::FolderIndexRole).toInt();
         emit folderSelected(selectedFolderIndex_);
     }
 }
@@ -128,29 +135,25 @@ void ResultsWidget::onRefreshClicked() {
     emit refreshRequested();
 }
 
+void ResultsWidget::onQuerySubmitted() {
+    QString query = queryEdit_->text().trimmed();
+    if (!query.isEmpty()) {
+        emit queryRequested(query);
+    }
+}
+
 void ResultsWidget::updateSummary() {
-    if (results_.empty()) {
+    const ResultsModel::Totals& totals = resultsModel_->totals();
+    if (totals.folders == 0) {
         summaryLabel_->setText("No results");
         return;
     }
     
-    int totalImages = 0;
-    int totalDetections = 0;
-    int completedFolders = 0;
-    
-    for (const auto& folder : results_) {
-        totalImages += folder.imageCount;
-        totalDetections += folder.totalDetections;
-        if (folder.processed) {
-            completedFolders++;
-        }
-    }
-    
     QString summary = QString("Folders: %1/%2 | Images: %3 | Detections: %4")
-                     .arg(completedFolders)
-                     .arg(results_.size())
-                     .arg(totalImages)
-                     .arg(totalDetections);
+                     .arg(totals.completedFolders)
+                     .arg(totals.folders)
+                     .arg(totals.images)
+                     .arg(totals.detections);
     
     summaryLabel_->setText(summary);
 }
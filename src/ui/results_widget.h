@@ -2,12 +2,15 @@
 #pragma once
 
 #include "../core/types.h"
+#include "results_model.h"
 #include <QWidget>
-#include <QTableWidget>
+#include <QTableView>
+#include <QSortFilterProxyModel>
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QLabel>
 #include <QPushButton>
+#include <QLineEdit>
 #include <QProgressBar>
 #include <QHeaderView>
 #include <memory>
@@ -26,10 +29,20 @@ public:
     ~ResultsWidget() override = default;
     
     /**
-     * @brief Update results display
+     * @brief Replace the results display (full resync)
      */
     void updateResults(const std::vector<Core::FolderResult>& results);
     
+    /**
+     * @brief Append rows for folders found by the scanner
+     */
+    void appendFolders(const std::vector<Core::FolderResult>& folders);
+    
+    /**
+     * @brief Apply a single folder update reported by the worker
+     */
+    void updateFolder(int folderIndex, int imageCount, int totalDetections, bool processed);
+    
     /**
      * @brief Clear all results
      */
@@ -49,11 +62,13 @@ signals:
     void folderSelected(int folderIndex);
     void exportRequested();
     void refreshRequested();
+    void queryRequested(QString query);
 
 private slots:
     void onTableSelectionChanged();
     void onExportClicked();
     void onRefreshClicked();
+    void onQuerySubmitted();
 
 private:
     void setupUI();
@@ -67,10 +82,12 @@ private:
     QLabel* summaryLabel_;
     QPushButton* exportButton_;
     QPushButton* refreshButton_;
+    QLineEdit* queryEdit_;
     QProgressBar* progressBar_;
-    QTableWidget* resultsTable_;
+    QTableView* resultsTable_;
+    ResultsModel* resultsModel_;
+    QSortFilterProxyModel* sortModel_;
     
-    std::vector<Core::FolderResult> results_;
     int selectedFolderIndex_;
 };
 
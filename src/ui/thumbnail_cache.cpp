@@ -0,0 +1,101 @@
+// src/ui/thumbnail_cache.cpp
+#include "thumbnail_cache.h"
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QImageReader>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+namespace YoloApp {
+namespace UI {
+
+QImage ThumbnailCache::load(const QString& imagePath, int edge) {
+    QString cachePath = cacheFilePath(imagePath, edge);
+    if (cachePath.isEmpty() || !QFileInfo::exists(cachePath)) {
+        return QImage();
+    }
+
+    QImageReader reader(cachePath);
+    return reader.read();
+}
+
+void ThumbnailCache::store(const QString& imagePath, int edge, const QImage& thumbnail) {
+    QString cachePath = cacheFilePath(imagePath, edge);
+    if (cachePath.isEmpty() || thumbnail.isNull()) {
+        return;
+    }
+
+    QDir().mkpath(QFileInfo(cachePath).path());
+
+    // Write atomically so concurrent readers never see a partial file
+    QSaveFile file(cachePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return;
+    }
+    if (thumbnail.save(&file, "JPG", 85)) {
+        file.commit();
+    } else {
+        file.cancelWriting();
+    }
+}
+
+QImage ThumbnailCache::generate(const QString& imagePath, int edge) {
+    QImageReader reader(imagePath);
+    reader.setAutoTransform(true);
+
+    QSize fullSize = reader.size();
+    if (fullSize.isValid()) {
+        // Let the codec decode at reduced resolution where it supports it
+        reader.setScaledSize(fullSize.scaled(edge, edge, Qt::KeepAspectRatio));
+    }
+
+    QImage image = reader.read();
+    if (image.isNull()) {
+        return image;
+    }
+
+    if (image.width() > edge || image.height() > edge) {
+        image = image.scaled(edge, edge, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    }
+    return image;
+}
+
+QImage ThumbnailCache::loadOrGenerate(const QString& imagePath, int edge) {
+    QImage thumbnail = load(imagePath, edge);
+    if (!thumbnail.isNull()) {
+        return thumbnail;
+    }
+
+    thumbnail = generate(imagePath, edge);
+    store(imagePath, edge, thumbnail);
+    return thumbnail;
+}
+
+QString ThumbnailCache::cacheDirectory() {
+    static const QString directory =
+        QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/thumbnails";
+    return directory;
+}
+
+QString ThumbnailCache::cacheFilePath(const QString& imagePath, int edge) {
+    QFileInfo info(imagePath);
+    if (!info.exists()) {
+        return QString();
+    }
+
+    QByteArray key = info.absoluteFilePath().toUtf8();
+    key += '|' + QByteArray::number(info.size());
+    key += '|' + QByteArray::number(info.lastModified().toMSecsSinceEpoch());
+    key += '|' + QByteArray::number(edge);
+
+    QString hash = QString::fromLatin1(
+        QCryptographicHash::hash(key, QCryptographicHash::Sha1).toHex());
+
+    // Two-level layout keeps directory sizes manageable for large libraries
+    return cacheDirectory() + "/" + hash.left(2) + "/" + hash + ".jpg";
+}
+
+} // namespace UI
+} // namespace YoloApp
@@ -0,0 +1,52 @@
+// src/ui/thumbnail_cache.h
+#pragma once
+
+#include <QImage>
+#include <QString>
+
+namespace YoloApp {
+namespace UI {
+
+/**
+ * @brief Persistent on-disk thumbnail cache
+ *
+ * Thumbnails are keyed by source path, file size, modification time and
+ * thumbnail edge length, so edited files are regenerated automatically.
+ * All functions are thread-safe and may be called from pool threads.
+ */
+class ThumbnailCache {
+public:
+    /**
+     * @brief Load a cached thumbnail, or a null image on a miss
+     */
+    static QImage load(const QString& imagePath, int edge);
+
+    /**
+     * @brief Store a thumbnail for later sessions
+     */
+    static void store(const QString& imagePath, int edge, const QImage& thumbnail);
+
+    /**
+     * @brief Decode a reduced-resolution thumbnail directly from the file
+     *
+     * Uses the reader's scaled decode so JPEGs are downsampled during DCT
+     * decoding instead of materializing the full-resolution frame.
+     */
+    static QImage generate(const QString& imagePath, int edge);
+
+    /**
+     * @brief Cached thumbnail if present, otherwise generate and store it
+     */
+    static QImage loadOrGenerate(const QString& imagePath, int edge);
+
+    /**
+     * @brief Directory holding the cached thumbnails
+     */
+    static QString cacheDirectory();
+
+private:
+    static QString cacheFilePath(const QString& imagePath, int edge);
+};
+
+} // namespace UI
+} // namespace YoloApp
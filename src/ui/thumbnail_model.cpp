@@ -0,0 +1,234 @@
+// src/ui/thumbnail_model.cpp
+#include "thumbnail_model.h"
+#include "thumbnail_cache.h"
+#include "../core/config.h"
+#include <QPainter>
+#include <QRunnable>
+#include <QThread>
+#include <algorithm>
+
+namespace YoloApp {
+namespace UI {
+
+/**
+ * @brief Pool task producing one thumbnail
+ */
+class ThumbnailLoadTask : public QRunnable {
+public:
+    ThumbnailLoadTask(ThumbnailModel* model, std::shared_ptr<ThumbnailModel::RequestState> state,
+                      quint64 generation, int row, QString imagePath)
+        : model_(model)
+        , state_(std::move(state))
+        , generation_(generation)
+        , row_(row)
+        , imagePath_(std::move(imagePath)) {
+    }
+
+    void run() override {
+        // The model waits for the pool before it is destroyed, so model_ stays valid here
+        if (state_->generation.load() != generation_) {
+            return;
+        }
+
+        int margin = Config::THUMBNAIL_PREFETCH_MARGIN;
+        if (row_ < state_->firstVisible.load() - margin || row_ > state_->lastVisible.load() + margin) {
+            QMetaObject::invokeMethod(model_, [model = model_, generation = generation_, row = row_]() {
+                model->onThumbnailSkipped(generation, row);
+            }, Qt::QueuedConnection);
+            return;
+        }
+
+        QImage thumbnail = ThumbnailCache::loadOrGenerate(imagePath_, model_->thumbnailEdge());
+        QMetaObject::invokeMethod(model_, [model = model_, generation = generation_, row = row_, thumbnail]() {
+            model->onThumbnailReady(generation, row, thumbnail);
+        }, Qt::QueuedConnection);
+    }
+
+private:
+    ThumbnailModel* model_;
+    std::shared_ptr<ThumbnailModel::RequestState> state_;
+    quint64 generation_;
+    int row_;
+    QString imagePath_;
+};
+
+ThumbnailModel::ThumbnailModel(int thumbnailEdge, QObject* parent)
+    : QAbstractListModel(parent)
+    , thumbnailEdge_(thumbnailEdge)
+    , state_(std::make_shared<RequestState>())
+    , pixmapCache_(Config::THUMBNAIL_MEMORY_CACHE_SIZE)
+    , requestSerial_(0) {
+    pool_.setMaxThreadCount(std::max(1, QThread::idealThreadCount() / 2));
+
+    placeholder_ = QPixmap(thumbnailEdge_, thumbnailEdge_);
+    placeholder_.fill(QColor(60, 60, 60));
+}
+
+ThumbnailModel::~ThumbnailModel() {
+    cancelPending();
+    pool_.waitForDone();
+}
+
+int ThumbnailModel::rowCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : static_cast<int>(images_.size());
+}
+
+QVariant ThumbnailModel::data(const QModelIndex& index, int role) const {
+    if (!index.isValid() || index.row() >= static_cast<int>(images_.size())) {
+        return QVariant();
+    }
+
+    int row = index.row();
+    const auto& image = images_[row];
+    int detectionCount = detectionCounts_[row];
+
+    switch (role) {
+        case Qt::DisplayRole: {
+            QString label = QString::number(row + 1);
+            if (detectionCount >= 0) {
+                label += QString(" (%1)").arg(detectionCount);
+            }
+            return label;
+        }
+        case Qt::ToolTipRole: {
+            if (!image) {
+                return QVariant();
+            }
+            QString tip = QString::fromStdString(image->imagePath);
+            if (detectionCount >= 0) {
+                tip += QString("\n%1 detections").arg(detectionCount);
+            }
+            return tip;
+        }
+        case Qt::DecorationRole: {
+            if (QPixmap* cached = pixmapCache_.object(row)) {
+                return *cached;
+            }
+            requestThumbnail(row);
+            return placeholder_;
+        }
+        case Qt::SizeHintRole:
+            return QSize(thumbnailEdge_ + 8, thumbnailEdge_ + 24);
+        default:
+            return QVariant();
+    }
+}
+
+void ThumbnailModel::setImages(const std::vector<std::shared_ptr<Core::ImageResult>>& images) {
+    beginResetModel();
+    cancelPending();
+    images_ = images;
+    resetLabels();
+    endResetModel();
+}
+
+void ThumbnailModel::updateImages(const std::vector<std::shared_ptr<Core::ImageResult>>& images) {
+    if (images.size() != images_.size() || images_.empty()) {
+        return;
+    }
+
+    images_ = images;
+    resetLabels();
+    emit dataChanged(index(0), index(static_cast<int>(images_.size()) - 1),
+                     {Qt::DisplayRole, Qt::ToolTipRole});
+}
+
+void ThumbnailModel::setImageProcessed(const QString& imagePath, int detectionCount) {
+    auto it = rowsByPath_.constFind(imagePath);
+    if (it == rowsByPath_.constEnd()) {
+        return;
+    }
+
+    detectionCounts_[it.value()] = detectionCount;
+    QModelIndex changed = index(it.value());
+    emit dataChanged(changed, changed, {Qt::DisplayRole, Qt::ToolTipRole});
+}
+
+void ThumbnailModel::clear() {
+    beginResetModel();
+    cancelPending();
+    images_.clear();
+    resetLabels();
+    endResetModel();
+}
+
+void ThumbnailModel::setVisibleRange(int first, int last) {
+    state_->firstVisible.store(first);
+    state_->lastVisible.store(last);
+}
+
+void ThumbnailModel::requestThumbnail(int row) const {
+    if (pending_.contains(row)) {
+        return;
+    }
+
+    const auto& image = images_[row];
+    if (!image) {
+        return;
+    }
+
+    pending_.insert(row);
+
+    // Newest requests run first so the cells the user is looking at fill in first
+    auto* task = new ThumbnailLoadTask(const_cast<ThumbnailModel*>(this), state_,
+                                       state_->generation.load(), row,
+                                       QString::fromStdString(image->imagePath));
+    pool_.start(task, ++requestSerial_);
+}
+
+void ThumbnailModel::onThumbnailReady(quint64 generation, int row, const QImage& thumbnail) {
+    if (generation != state_->generation.load()) {
+        return;
+    }
+
+    pending_.remove(row);
+
+    QPixmap pixmap(thumbnailEdge_, thumbnailEdge_);
+    pixmap.fill(Qt::transparent);
+    if (!thumbnail.isNull()) {
+        // Center the thumbnail in a fixed-size cell so the grid stays uniform
+        QPainter painter(&pixmap);
+        QPoint offset((thumbnailEdge_ - thumbnail.width()) / 2,
+                      (thumbnailEdge_ - thumbnail.height()) / 2);
+        painter.drawImage(offset, thumbnail);
+    } else {
+        pixmap = placeholder_;
+    }
+
+    pixmapCache_.insert(row, new QPixmap(pixmap));
+
+    QModelIndex changed = index(row);
+    emit dataChanged(changed, changed, {Qt::DecorationRole});
+}
+
+void ThumbnailModel::onThumbnailSkipped(quint64 generation, int row) {
+    if (generation == state_->generation.load()) {
+        pending_.remove(row);
+    }
+}
+
+void ThumbnailModel::resetLabels() {
+    detectionCounts_.assign(images_.size(), -1);
+    rowsByPath_.clear();
+    for (size_t row = 0; row < images_.size(); ++row) {
+        const auto& image = images_[row];
+        if (!image) {
+            continue;
+        }
+        rowsByPath_.insert(QString::fromStdString(image->imagePath), static_cast<int>(row));
+        if (image->processed) {
+            detectionCounts_[row] = image->getDetectionCount();
+        }
+    }
+}
+
+void ThumbnailModel::cancelPending() {
+    state_->generation.fetch_add(1);
+    pool_.clear();
+    pending_.clear();
+    pixmapCache_.clear();
+    requestSerial_ = 0;
+}
+
+} // namespace UI
+} // namespace YoloApp
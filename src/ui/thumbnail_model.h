@@ -0,0 +1,104 @@
+// src/ui/thumbnail_model.h
+#pragma once
+
+#include "../core/types.h"
+#include <QAbstractListModel>
+#include <QCache>
+#include <QHash>
+#include <QPixmap>
+#include <QSet>
+#include <QThreadPool>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace YoloApp {
+namespace UI {
+
+/**
+ * @brief List model serving folder images as lazily loaded thumbnails
+ *
+ * Views only query data() for visible cells, so thumbnails are requested
+ * on demand and decoded on a private thread pool. Requests that scroll out
+ * of view before they start are dropped, and finished thumbnails are kept
+ * in a bounded in-memory cache backed by the persistent ThumbnailCache.
+ *
+ * Labels show the detection counts known when the images were set, patched
+ * by setImageProcessed; the image results are not read again, since the
+ * worker may still be writing them.
+ */
+class ThumbnailModel : public QAbstractListModel {
+    Q_OBJECT
+
+public:
+    explicit ThumbnailModel(int thumbnailEdge, QObject* parent = nullptr);
+    ~ThumbnailModel() override;
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+
+    /**
+     * @brief Show the images of a folder, cancelling pending thumbnail work
+     */
+    void setImages(const std::vector<std::shared_ptr<Core::ImageResult>>& images);
+
+    /**
+     * @brief Replace the images of the same folder, keeping thumbnails and views
+     *
+     * Only the labels are refreshed. Ignored if the image count differs.
+     */
+    void updateImages(const std::vector<std::shared_ptr<Core::ImageResult>>& images);
+
+    /**
+     * @brief Label an image as processed (from the worker's imageProcessed signal)
+     */
+    void setImageProcessed(const QString& imagePath, int detectionCount);
+
+    /**
+     * @brief Remove all images
+     */
+    void clear();
+
+    /**
+     * @brief Tell the loader which rows are on screen
+     *
+     * Queued requests outside this range (plus a small margin) are skipped.
+     */
+    void setVisibleRange(int first, int last);
+
+    int thumbnailEdge() const { return thumbnailEdge_; }
+
+    /**
+     * @brief Shared state between the model and its loader tasks
+     */
+    struct RequestState {
+        std::atomic<quint64> generation{0};
+        std::atomic<int> firstVisible{0};
+        std::atomic<int> lastVisible{-1};
+    };
+
+private:
+    friend class ThumbnailLoadTask;
+
+    void requestThumbnail(int row) const;
+    void onThumbnailReady(quint64 generation, int row, const QImage& thumbnail);
+    void onThumbnailSkipped(quint64 generation, int row);
+    void cancelPending();
+    void resetLabels();
+
+    int thumbnailEdge_;
+    std::vector<std::shared_ptr<Core::ImageResult>> images_;
+    std::vector<int> detectionCounts_;  // Per row, -1 until processed
+    QHash<QString, int> rowsByPath_;
+    std::shared_ptr<RequestState> state_;
+    QPixmap placeholder_;
+
+    // Mutable because thumbnails are requested lazily from data()
+    mutable QThreadPool pool_;
+    mutable QSet<int> pending_;
+    mutable QCache<int, QPixmap> pixmapCache_;
+    mutable int requestSerial_;
+};
+
+} // namespace UI
+} // namespace YoloApp
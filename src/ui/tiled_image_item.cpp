@@ -0,0 +1,341 @@
+// src/ui/tiled_image_item.cpp
+#include "tiled_image_item.h"
+#include "region_image_reader.h"
+#include "../core/config.h"
+#include <QImageIOHandler>
+#include <QImageReader>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QPainter>
+#include <QRunnable>
+#include <QStyleOptionGraphicsItem>
+#include <QThread>
+#include <algorithm>
+#include <cmath>
+
+namespace YoloApp {
+namespace UI {
+
+namespace {
+
+QImage toDisplayFormat(QImage image) {
+    if (!image.isNull() && image.format() != QImage::Format_RGB32 &&
+        image.format() != QImage::Format_ARGB32_Premultiplied) {
+        image = image.convertToFormat(QImage::Format_RGB32);
+    }
+    return image;
+}
+
+} // namespace
+
+/**
+ * @brief One pyramid level decoded whole, for files no reader can clip
+ *
+ * The first tile task of the level decodes it; the others wait for that
+ * decode and cut their tile from the shared image. A failed decode is not
+ * kept, so the next tile of the level tries again.
+ */
+class DecodedLevel {
+public:
+    QImage image(const QString& imagePath, const QSize& levelSize) {
+        QMutexLocker lock(&mutex_);
+        if (image_.isNull()) {
+            QImageReader reader(imagePath);
+            reader.setScaledSize(levelSize);
+            image_ = toDisplayFormat(reader.read());
+        }
+        return image_;
+    }
+
+private:
+    QMutex mutex_;
+    QImage image_;
+};
+
+/**
+ * @brief Pool task decoding one tile at one pyramid level
+ */
+class TileLoadTask : public QRunnable {
+public:
+    TileLoadTask(TiledImageItem* item, std::shared_ptr<std::atomic<quint64>> generation,
+                 quint64 expectedGeneration, quint64 key, QString imagePath,
+                 TiledImageItem::DecodeMode mode, int level, QSize levelSize, QRect clipRect,
+                 std::shared_ptr<DecodedLevel> decodedLevel)
+        : item_(item)
+        , generation_(std::move(generation))
+        , expectedGeneration_(expectedGeneration)
+        , key_(key)
+        , imagePath_(std::move(imagePath))
+        , mode_(mode)
+        , level_(level)
+        , levelSize_(levelSize)
+        , clipRect_(clipRect)
+        , decodedLevel_(std::move(decodedLevel)) {
+    }
+
+    void run() override {
+        // The item waits for its pool on destruction, so item_ stays valid here
+        if (generation_->load() != expectedGeneration_) {
+            return;
+        }
+
+        QImage tile;
+        switch (mode_) {
+            case TiledImageItem::DecodeMode::ClipRect: {
+                // Scaled decode + clip keeps memory proportional to the tile, not the frame
+                QImageReader reader(imagePath_);
+                reader.setScaledSize(levelSize_);
+                reader.setScaledClipRect(clipRect_);
+                tile = toDisplayFormat(reader.read());
+                break;
+            }
+            case TiledImageItem::DecodeMode::Region: {
+                // Only the source strips under the tile are decoded, averaged down to the level
+                std::unique_ptr<RegionImageReader> reader = RegionImageReader::open(imagePath_);
+                if (reader) {
+                    tile = reader->read(1 << level_, clipRect_);
+                }
+                break;
+            }
+            case TiledImageItem::DecodeMode::WholeLevel: {
+                QImage levelImage = decodedLevel_->image(imagePath_, levelSize_);
+                if (!levelImage.isNull()) {
+                    tile = levelImage.copy(clipRect_);
+                }
+                break;
+            }
+        }
+
+        QMetaObject::invokeMethod(item_, [item = item_, generation = expectedGeneration_,
+                                          key = key_, tile]() {
+            item->onTileLoaded(generation, key, tile);
+        }, Qt::QueuedConnection);
+    }
+
+private:
+    TiledImageItem* item_;
+    std::shared_ptr<std::atomic<quint64>> generation_;
+    quint64 expectedGeneration_;
+    quint64 key_;
+    QString imagePath_;
+    TiledImageItem::DecodeMode mode_;
+    int level_;
+    QSize levelSize_;
+    QRect clipRect_;
+    std::shared_ptr<DecodedLevel> decodedLevel_;    // WholeLevel mode only
+};
+
+TiledImageItem::TiledImageItem(QGraphicsItem* parent)
+    : QGraphicsObject(parent)
+    , levelCount_(0)
+    , lastPaintLevel_(-1)
+    , decodeMode_(DecodeMode::ClipRect)
+    , generation_(std::make_shared<std::atomic<quint64>>(0))
+    , tiles_(Config::TILE_CACHE_MB * 1024) {
+    setFlag(QGraphicsItem::ItemUsesExtendedStyleOption);
+    pool_.setMaxThreadCount(std::max(2, QThread::idealThreadCount() / 2));
+}
+
+TiledImageItem::~TiledImageItem() {
+    cancelPending();
+    pool_.waitForDone();
+}
+
+void TiledImageItem::setSource(const QString& imagePath, const QSize& imageSize) {
+    prepareGeometryChange();
+    cancelPending();
+    tiles_.clear();
+    decodedLevels_.clear();
+
+    imagePath_ = imagePath;
+    imageSize_ = imageSize;
+    lastPaintLevel_ = -1;
+    decodeMode_ = DecodeMode::ClipRect;
+    if (!imagePath_.isEmpty()) {
+        QImageReader reader(imagePath_);
+        if (!reader.supportsOption(QImageIOHandler::ScaledClipRect)) {
+            decodeMode_ = RegionImageReader::open(imagePath_) ? DecodeMode::Region : DecodeMode::WholeLevel;
+        }
+    }
+
+    // Levels halve until the whole image fits in one tile
+    levelCount_ = 1;
+    int edge = std::max(imageSize_.width(), imageSize_.height());
+    while (edge > Config::TILE_SIZE) {
+        edge = (edge + 1) / 2;
+        ++levelCount_;
+    }
+
+    // The coarsest tile doubles as the placeholder for everything else
+    if (!imagePath_.isEmpty() && imageSize_.isValid()) {
+        requestTile(levelCount_ - 1, 0, 0);
+    }
+    update();
+}
+
+void TiledImageItem::clear() {
+    setSource(QString(), QSize());
+}
+
+QSize TiledImageItem::probeImageSize(const QString& imagePath) {
+    QImageReader reader(imagePath);
+    return reader.size();
+}
+
+QRectF TiledImageItem::boundingRect() const {
+    if (!imageSize_.isValid()) {
+        return QRectF();
+    }
+    return QRectF(QPointF(0, 0), imageSize_);
+}
+
+void TiledImageItem::paint(QPainter* painter, const QStyleOptionGraphicsItem* option,
+                           QWidget* widget) {
+    Q_UNUSED(widget)
+    if (imagePath_.isEmpty() || !imageSize_.isValid()) {
+        return;
+    }
+
+    qreal scale = QStyleOptionGraphicsItem::levelOfDetailFromTransform(painter->worldTransform());
+    int level = levelForScale(scale);
+
+    // Queued work for a level we zoomed away from is no longer useful
+    if (level != lastPaintLevel_) {
+        if (lastPaintLevel_ >= 0) {
+            pool_.clear();
+            pending_.clear();
+            releaseDecodedLevels(level);
+            requestTile(levelCount_ - 1, 0, 0);
+        }
+        lastPaintLevel_ = level;
+    }
+
+    const qreal factor = static_cast<qreal>(1 << level);
+    const int tileSize = Config::TILE_SIZE;
+    QSize size = levelSize(level);
+
+    QRectF exposed = option->exposedRect.intersected(boundingRect());
+    int firstX = std::max(0, static_cast<int>(std::floor(exposed.left() / factor / tileSize)));
+    int firstY = std::max(0, static_cast<int>(std::floor(exposed.top() / factor / tileSize)));
+    int lastX = std::min((size.width() - 1) / tileSize,
+                         static_cast<int>(std::floor(exposed.right() / factor / tileSize)));
+    int lastY = std::min((size.height() - 1) / tileSize,
+                         static_cast<int>(std::floor(exposed.bottom() / factor / tileSize)));
+
+    painter->setRenderHint(QPainter::SmoothPixmapTransform, true);
+
+    for (int tileY = firstY; tileY <= lastY; ++tileY) {
+        for (int tileX = firstX; tileX <= lastX; ++tileX) {
+            QRect rect = tileRect(level, tileX, tileY);
+            QRectF target(rect.x() * factor, rect.y() * factor,
+                          rect.width() * factor, rect.height() * factor);
+            target = target.intersected(boundingRect());
+
+            if (const QPixmap* tile = tiles_.object(tileKey(level, tileX, tileY))) {
+                painter->drawPixmap(target, *tile, QRectF(tile->rect()));
+            } else {
+                requestTile(level, tileX, tileY);
+                drawFallback(painter, target);
+            }
+        }
+    }
+}
+
+quint64 TiledImageItem::tileKey(int level, int tileX, int tileY) {
+    return (static_cast<quint64>(level) << 56) |
+           (static_cast<quint64>(tileX & 0xFFFFFFF) << 28) |
+           static_cast<quint64>(tileY & 0xFFFFFFF);
+}
+
+QSize TiledImageItem::levelSize(int level) const {
+    int factor = 1 << level;
+    return QSize((imageSize_.width() + factor - 1) / factor,
+                 (imageSize_.height() + factor - 1) / factor);
+}
+
+QRect TiledImageItem::tileRect(int level, int tileX, int tileY) const {
+    const int tileSize = Config::TILE_SIZE;
+    QSize size = levelSize(level);
+    QRect rect(tileX * tileSize, tileY * tileSize, tileSize, tileSize);
+    return rect.intersected(QRect(QPoint(0, 0), size));
+}
+
+int TiledImageItem::levelForScale(qreal scale) const {
+    if (scale >= 1.0 || levelCount_ <= 1) {
+        return 0;
+    }
+    int level = static_cast<int>(std::floor(std::log2(1.0 / scale)));
+    return std::clamp(level, 0, levelCount_ - 1);
+}
+
+void TiledImageItem::requestTile(int level, int tileX, int tileY) {
+    quint64 key = tileKey(level, tileX, tileY);
+    if (pending_.contains(key) || tiles_.contains(key)) {
+        return;
+    }
+    pending_.insert(key);
+
+    std::shared_ptr<DecodedLevel> decodedLevel;
+    if (decodeMode_ == DecodeMode::WholeLevel) {
+        std::shared_ptr<DecodedLevel>& entry = decodedLevels_[level];
+        if (!entry) {
+            entry = std::make_shared<DecodedLevel>();
+        }
+        decodedLevel = entry;
+    }
+
+    auto* task = new TileLoadTask(this, generation_, generation_->load(), key, imagePath_, decodeMode_,
+                                  level, levelSize(level), tileRect(level, tileX, tileY), decodedLevel);
+    // Coarse tiles are cheap and unblock the fallback, so they go first
+    pool_.start(task, level);
+}
+
+void TiledImageItem::drawFallback(QPainter* painter, const QRectF& target) {
+    int coarsest = levelCount_ - 1;
+    const QPixmap* overview = tiles_.object(tileKey(coarsest, 0, 0));
+    if (!overview) {
+        painter->fillRect(target, QColor(80, 80, 80));
+        return;
+    }
+
+    qreal scaleX = static_cast<qreal>(overview->width()) / imageSize_.width();
+    qreal scaleY = static_cast<qreal>(overview->height()) / imageSize_.height();
+    QRectF source(target.x() * scaleX, target.y() * scaleY,
+                  target.width() * scaleX, target.height() * scaleY);
+    painter->drawPixmap(target, *overview, source);
+}
+
+void TiledImageItem::onTileLoaded(quint64 generation, quint64 key, const QImage& tile) {
+    if (generation != generation_->load()) {
+        return;
+    }
+
+    pending_.remove(key);
+    if (tile.isNull()) {
+        return;
+    }
+
+    int costKb = std::max(1, static_cast<int>(tile.sizeInBytes() / 1024));
+    tiles_.insert(key, new QPixmap(QPixmap::fromImage(tile)), costKb);
+    update();
+}
+
+void TiledImageItem::releaseDecodedLevels(int keepLevel) {
+    // Running tasks hold their own reference, so a level in use is freed when they finish
+    for (auto it = decodedLevels_.begin(); it != decodedLevels_.end(); ) {
+        if (it.key() == keepLevel || it.key() == levelCount_ - 1) {
+            ++it;
+        } else {
+            it = decodedLevels_.erase(it);
+        }
+    }
+}
+
+void TiledImageItem::cancelPending() {
+    generation_->fetch_add(1);
+    pool_.clear();
+    pending_.clear();
+}
+
+} // namespace UI
+} // namespace YoloApp
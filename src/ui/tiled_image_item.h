@@ -0,0 +1,93 @@
+// src/ui/tiled_image_item.h
+#pragma once
+
+#include <QCache>
+#include <QGraphicsObject>
+#include <QHash>
+#include <QImage>
+#include <QPixmap>
+#include <QSet>
+#include <QThreadPool>
+#include <atomic>
+#include <memory>
+
+namespace YoloApp {
+namespace UI {
+
+class DecodedLevel;
+
+/**
+ * @brief Graphics item rendering a very large image from a tile pyramid
+ *
+ * Nothing is decoded up front. On paint the item picks the pyramid level
+ * matching the view scale, draws the cached tiles that intersect the
+ * exposed area and queues the missing ones on a private pool. Missing
+ * tiles are drawn from the coarsest level until they arrive.
+ *
+ * Each tile is decoded on its own: JPEG through Qt's scaled clip rect,
+ * TIFF, PNG and BMP through RegionImageReader, which reads only the strips
+ * under the tile. Either way a decode holds about a tile's worth of pixels.
+ * Files neither can clip (e.g. WebP, interlaced PNG) fall back to decoding
+ * a whole pyramid level once, shared by its tiles, keeping only the level
+ * in view and the coarsest.
+ */
+class TiledImageItem : public QGraphicsObject {
+    Q_OBJECT
+
+public:
+    explicit TiledImageItem(QGraphicsItem* parent = nullptr);
+    ~TiledImageItem() override;
+
+    /**
+     * @brief Show an image file of the given full-resolution size
+     */
+    void setSource(const QString& imagePath, const QSize& imageSize);
+
+    /**
+     * @brief Drop the source, cached tiles and pending loads
+     */
+    void clear();
+
+    /**
+     * @brief Read the image dimensions from the file header only
+     */
+    static QSize probeImageSize(const QString& imagePath);
+
+    QRectF boundingRect() const override;
+    void paint(QPainter* painter, const QStyleOptionGraphicsItem* option,
+               QWidget* widget = nullptr) override;
+
+private:
+    friend class TileLoadTask;
+
+    enum class DecodeMode {
+        ClipRect,       // Qt's reader decodes a scaled clip rect
+        Region,         // RegionImageReader streams the strips under the tile
+        WholeLevel      // Neither can clip; tiles are cut from a shared level
+    };
+
+    static quint64 tileKey(int level, int tileX, int tileY);
+    QSize levelSize(int level) const;
+    QRect tileRect(int level, int tileX, int tileY) const;
+    int levelForScale(qreal scale) const;
+    void requestTile(int level, int tileX, int tileY);
+    void drawFallback(QPainter* painter, const QRectF& target);
+    void onTileLoaded(quint64 generation, quint64 key, const QImage& tile);
+    void cancelPending();
+    void releaseDecodedLevels(int keepLevel);
+
+    QString imagePath_;
+    QSize imageSize_;
+    int levelCount_;
+    int lastPaintLevel_;
+    DecodeMode decodeMode_;
+    QHash<int, std::shared_ptr<DecodedLevel>> decodedLevels_;  // Only in WholeLevel mode
+
+    std::shared_ptr<std::atomic<quint64>> generation_;
+    QThreadPool pool_;
+    QCache<quint64, QPixmap> tiles_;
+    QSet<quint64> pending_;
+};
+
+} // namespace UI
+} // namespace YoloApp
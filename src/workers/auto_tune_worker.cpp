@@ -0,0 +1,76 @@
+// src/workers/auto_tune_worker.cpp
+#include "auto_tune_worker.h"
+#include "../processing/folder_scanner.h"
+#include "../core/trace.h"
+#include <QMutexLocker>
+
+namespace YoloApp {
+namespace Workers {
+
+AutoTuneWorker::AutoTuneWorker(QObject* parent)
+    : QThread(parent)
+    , cancellationRequested_(false) {
+}
+
+AutoTuneWorker::~AutoTuneWorker() {
+    requestCancellation();
+    if (isRunning()) {
+        wait();
+    }
+}
+
+void AutoTuneWorker::startTuning(const QString& folderPath,
+                                 std::shared_ptr<Core::IDetector> detector,
+                                 const Processing::AutoTuner::Options& options) {
+    if (isRunning()) {
+        return;
+    }
+
+    {
+        QMutexLocker locker(&mutex_);
+        folderPath_ = folderPath;
+        detector_ = std::move(detector);
+        options_ = options;
+        result_ = Processing::AutoTuner::Result();
+    }
+    cancellationRequested_ = false;
+
+    start();
+}
+
+void AutoTuneWorker::requestCancellation() {
+    cancellationRequested_ = true;
+}
+
+Processing::AutoTuner::Result AutoTuneWorker::result() const {
+    QMutexLocker locker(&mutex_);
+    return result_;
+}
+
+void AutoTuneWorker::run() {
+    Core::Trace::setThreadName("auto tune");
+    try {
+        emit tuneProgress(0, "Scanning folder");
+        Processing::FolderScanner scanner;
+        std::vector<Core::FolderResult> folders = scanner.scanForImages(folderPath_.toStdString(), true);
+
+        Processing::AutoTuner tuner(detector_, options_);
+        tuner.setCancellationFlag(&cancellationRequested_);
+        tuner.setProgressCallback([this](int percent, const std::string& step) {
+            emit tuneProgress(percent, QString::fromStdString(step));
+        });
+        Processing::AutoTuner::Result result = tuner.run(Processing::AutoTuner::sampleImages(folders));
+
+        {
+            QMutexLocker locker(&mutex_);
+            result_ = result;
+        }
+        emit tuneCompleted(!result.cancelled && result.recommended >= 0,
+                           result.cancelled ? QString("Cancelled") : QString());
+    } catch (const std::exception& e) {
+        emit tuneCompleted(false, QString::fromStdString(e.what()));
+    }
+}
+
+} // namespace Workers
+} // namespace YoloApp
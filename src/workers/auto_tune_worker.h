@@ -0,0 +1,57 @@
+// src/workers/auto_tune_worker.h
+#pragma once
+
+#include "../core/types.h"
+#include "../core/detector.h"
+#include "../processing/auto_tuner.h"
+#include <QThread>
+#include <QString>
+#include <QMutex>
+#include <atomic>
+#include <memory>
+
+namespace YoloApp {
+namespace Workers {
+
+/**
+ * @brief Background worker that scans a folder and runs the AutoTuner on a sample of it
+ */
+class AutoTuneWorker : public QThread {
+    Q_OBJECT
+
+public:
+    explicit AutoTuneWorker(QObject* parent = nullptr);
+    ~AutoTuneWorker() override;
+
+    /**
+     * @brief Start tuning; ignored while a run is going
+     */
+    void startTuning(const QString& folderPath,
+                     std::shared_ptr<Core::IDetector> detector,
+                     const Processing::AutoTuner::Options& options);
+
+    void requestCancellation();
+
+    /**
+     * @brief Trials and recommendation of the last run
+     */
+    Processing::AutoTuner::Result result() const;
+
+signals:
+    void tuneProgress(int percent, QString step);
+    void tuneCompleted(bool success, QString error);
+
+protected:
+    void run() override;
+
+private:
+    QString folderPath_;
+    std::shared_ptr<Core::IDetector> detector_;
+    Processing::AutoTuner::Options options_;
+    Processing::AutoTuner::Result result_;
+    std::atomic<bool> cancellationRequested_;
+    mutable QMutex mutex_;
+};
+
+} // namespace Workers
+} // namespace YoloApp
@@ -1,6 +1,7 @@
 
 // src/workers/detection_worker.cpp
 #include "detection_worker.h"
+#include "../core/trace.h"
 #include <QMutexLocker>
 #include <chrono>
 
@@ -27,15 +28,17 @@ DetectionWorker::~DetectionWorker() {
 }
 
 void DetectionWorker::startProcessing(const std::string& rootPath, 
-                                     std::shared_ptr<Core::IDetector> detector,
-                                     bool recursive) {
+                                     std::shared_ptr<Core::EngineHandle> engine,
+                                     bool recursive,
+                                     const std::string& sessionDirectory) {
     if (isRunning()) {
         return; // Already processing
     }
     
     rootPath_ = rootPath;
-    detector_ = detector;
+    engine_ = std::move(engine);
     recursive_ = recursive;
+    sessionDirectory_ = sessionDirectory;
     cancellationRequested_ = false;
     processing_ = true;
     
@@ -62,17 +65,81 @@ Core::ProcessingStats DetectionWorker::getStats() const {
 }
 
 std::vector<Core::FolderResult> DetectionWorker::getResults() const {
-    QMutexLocker locker(&resultsMutex_);
-    return results_;
+    std::vector<std::shared_ptr<const Core::FolderResult>> published;
+    {
+        QMutexLocker locker(&resultsMutex_);
+        published = results_;
+    }
+    
+    std::vector<Core::FolderResult> results;
+    results.reserve(published.size());
+    for (const auto& folder : published) {
+        results.push_back(*folder);
+    }
+    return results;
+}
+
+std::vector<std::shared_ptr<Core::ImageResult>> DetectionWorker::getImageResults(
+    const std::vector<Core::ClassIndex::ImageLocation>& locations) const {
+    std::vector<std::shared_ptr<const Core::FolderResult>> published;
+    {
+        QMutexLocker locker(&resultsMutex_);
+        published = results_;
+    }
+    
+    std::vector<std::shared_ptr<Core::ImageResult>> images;
+    images.reserve(locations.size());
+    for (const auto& location : locations) {
+        if (location.folderIndex < published.size() &&
+            location.imageIndex < published[location.folderIndex]->images.size()) {
+            images.push_back(published[location.folderIndex]->images[location.imageIndex]);
+        }
+    }
+    return images;
+}
+
+void DetectionWorker::setClassIndex(std::shared_ptr<Core::ClassIndex> classIndex) {
+    classIndex_ = std::move(classIndex);
+}
+
+void DetectionWorker::setMetrics(std::shared_ptr<Core::PipelineMetrics> metrics) {
+    metrics_ = std::move(metrics);
+}
+
+void DetectionWorker::setScheduler(std::shared_ptr<Core::ThreadScheduler> scheduler) {
+    scheduler_ = std::move(scheduler);
+}
+
+Core::FolderResult DetectionWorker::getFolderResult(int folderIndex) const {
+    std::shared_ptr<const Core::FolderResult> folder;
+    {
+        QMutexLocker locker(&resultsMutex_);
+        if (folderIndex < 0 || folderIndex >= static_cast<int>(results_.size())) {
+            return Core::FolderResult();
+        }
+        folder = results_[folderIndex];
+    }
+    return *folder;
 }
 
 void DetectionWorker::run() {
+    Core::Trace::setThreadName("detection");
     try {
+        Processing::DetectionPipeline::Options options;
+        options.recursive = recursive_;
+        
+        Processing::DetectionPipeline pipeline(engine_, options);
+        pipeline.setCancellationFlag(&cancellationRequested_);
+        pipeline.setClassIndex(classIndex_);
+        pipeline.setMetrics(metrics_);
+        pipeline.setScheduler(scheduler_);
+        pipeline.setCallbacks(pipelineCallbacks());
+        
         stats_.start();
-        performScanning();
+        performScanning(pipeline);
         
         if (!cancellationRequested_) {
-            performProcessing();
+            performProcessing(pipeline);
         }
         
         stats_.finish();
@@ -85,90 +152,129 @@ void DetectionWorker::run() {
     processing_ = false;
 }
 
-void DetectionWorker::performScanning() {
-    if (!detector_ || !detector_->isLoaded()) {
-        throw std::runtime_error("Detector not loaded");
-    }
-    
-    Processing::FolderScanner scanner;
-    
-    // Set up progress callback
-    scanner.setProgressCallback([this](int current, int total, const std::string& currentPath) {
-        if (cancellationRequested_) return;
-        
-        if (current == 0 && total > 0) {
-            emit scanningStarted(total);
-        }
-        
-        if (!currentPath.empty()) {
-            emit folderScanned(QString::fromStdString(currentPath), 0);
-        }
-    });
-    
+void DetectionWorker::performScanning(Processing::DetectionPipeline& pipeline) {
     // Scan for folders containing images
-    std::vector<Core::FolderResult> scannedResults = scanner.scanForImages(rootPath_, recursive_);
+    folders_ = pipeline.scan(rootPath_);
     
     if (cancellationRequested_) {
         return;
     }
     
+    // The GUI reads the published folders while the pipeline writes its own
+    // image results, so those are not shared until their folder completes
+    std::vector<std::shared_ptr<const Core::FolderResult>> published;
+    published.reserve(folders_.size());
+    int totalImages = 0;
+    for (const auto& folder : folders_) {
+        totalImages += folder.imageCount;
+        Core::FolderResult placeholder(folder.folderPath);
+        placeholder.folderName = folder.folderName;
+        placeholder.imageCount = folder.imageCount;
+        placeholder.images.reserve(folder.images.size());
+        for (const auto& image : folder.images) {
+            placeholder.images.push_back(std::make_shared<Core::ImageResult>(image->imagePath));
+        }
+        published.push_back(std::make_shared<const Core::FolderResult>(std::move(placeholder)));
+    }
+    
     // Update results and stats
     {
         QMutexLocker locker(&resultsMutex_);
-        results_ = std::move(scannedResults);
+        results_ = std::move(published);
         stats_.totalFolders = static_cast<int>(results_.size());
-        
-        // Count total images
-        for (const auto& folder : results_) {
-            stats_.totalImages += folder.imageCount;
-        }
+        stats_.totalImages += totalImages;
     }
     
     emit processingStarted(stats_.totalImages);
 }
 
-void DetectionWorker::performProcessing() {
-    QMutexLocker locker(&resultsMutex_);
+void DetectionWorker::performProcessing(Processing::DetectionPipeline& pipeline) {
+    if (!sessionDirectory_.empty()) {
+        try {
+            storeWriter_ = std::make_unique<Core::ResultsStoreWriter>(sessionDirectory_);
+        } catch (const std::exception& e) {
+            emit errorOccurred(QString("Results will not be saved: %1").arg(e.what()));
+        }
+    }
+    
+    // Each folder is published with its image results once it completes
+    pipeline.calibrate(folders_);
     
-    for (auto& folderResult : results_) {
+    for (size_t folderIndex = 0; folderIndex < folders_.size(); ++folderIndex) {
         if (cancellationRequested_) {
             break;
         }
+        pipeline.processFolder(folderIndex, folders_[folderIndex]);
+    }
+    
+    folders_.clear();
+    storeWriter_.reset();
+}
+
+Processing::DetectionPipeline::Callbacks DetectionWorker::pipelineCallbacks() {
+    Processing::DetectionPipeline::Callbacks callbacks;
+    
+    callbacks.scanProgress = [this](int current, int total, const std::string& currentPath) {
+        if (current == 0 && total > 0) {
+            emit scanningStarted(total);
+        }
         
-        // Process each image in the folder
-        for (auto& imageResult : folderResult.images) {
-            if (cancellationRequested_) {
-                break;
-            }
-            
-            // Unlock mutex during processing to allow UI updates
-            locker.unlock();
-            
-            try {
-                Processing::ImageProcessor::processImageResult(imageResult, *detector_);
-                emit imageProcessed(QString::fromStdString(imageResult->imagePath), 
-                                  imageResult->getDetectionCount());
-                
-            } catch (const std::exception& e) {
-                // Log error but continue processing
-                emit errorOccurred(QString("Error processing %1: %2")
-                                  .arg(QString::fromStdString(imageResult->imagePath))
-                                  .arg(QString::fromStdString(e.what())));
-            }
-            
-            // Relock and update stats
-            locker.relock();
-            stats_.processedImages++;
-            stats_.totalDetections += imageResult->getDetectionCount();
+        if (!currentPath.empty()) {
+            emit folderScanned(QString::fromStdString(currentPath), 0);
+        }
+    };
+    
+    callbacks.imageFailed = [this](const std::string& imagePath, const std::string& error) {
+        // Log error but continue processing
+        emit errorOccurred(QString("Error processing %1: %2")
+                          .arg(QString::fromStdString(imagePath))
+                          .arg(QString::fromStdString(error)));
+    };
+    
+    callbacks.imageProcessed = [this](size_t, size_t, const Core::ImageResult& imageResult) {
+        if (metrics_) {
+            metrics_->addQueueDepth(Core::PipelineMetrics::Queue::UiBacklog, 1);
+        }
+        emit imageProcessed(QString::fromStdString(imageResult.imagePath), 
+                          imageResult.getDetectionCount());
+        
+        QMutexLocker locker(&resultsMutex_);
+        stats_.processedImages++;
+        stats_.totalDetections += imageResult.getDetectionCount();
+    };
+    
+    callbacks.folderCompleted = [this](size_t folderIndex, const Core::FolderResult& folderResult) {
+        // The snapshot is built outside the lock and swapped in
+        auto published = std::make_shared<const Core::FolderResult>(folderResult);
+        {
+            QMutexLocker locker(&resultsMutex_);
+            results_[folderIndex] = std::move(published);
+            stats_.processedFolders++;
         }
         
-        // Update folder statistics
-        folderResult.updateCounts();
-        folderResult.processed = true;
-        stats_.processedFolders++;
+        // Persist outside the lock; the folder shares the image results
+        saveFolder(folderResult);
         
-        emit folderCompleted(QString::fromStdString(folderResult.folderName), 
+        emit folderCompleted(static_cast<int>(folderIndex),
+                           QString::fromStdString(folderResult.folderName),
+                           folderResult.imageCount,
                            folderResult.totalDetections);
+    };
+    
+    return callbacks;
+}
+
+void DetectionWorker::saveFolder(const Core::FolderResult& folderResult) {
+    if (!storeWriter_) {
+        return;
+    }
+    
+    try {
+        storeWriter_->appendFolder(folderResult);
+    } catch (const std::exception& e) {
+        // Stop saving; what was committed so far stays readable
+        storeWriter_.reset();
+        emit errorOccurred(QString("Failed to save results: %1").arg(e.what()));
     }
 }
 
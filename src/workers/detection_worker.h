@@ -3,8 +3,12 @@
 
 #include "../core/types.h"
 #include "../core/detector.h"
-#include "../processing/folder_scanner.h"
-#include "../processing/image_processor.h"
+#include "../core/engine_handle.h"
+#include "../core/results_store.h"
+#include "../core/class_index.h"
+#include "../core/pipeline_metrics.h"
+#include "../core/thread_scheduler.h"
+#include "../processing/detection_pipeline.h"
 #include <QThread>
 #include <QMutex>
 #include <memory>
@@ -15,6 +19,9 @@ namespace Workers {
 
 /**
  * @brief Background worker for processing image detection
+ *
+ * Runs a Processing::DetectionPipeline on its own thread and turns the
+ * pipeline callbacks into Qt signals and thread-safe result snapshots.
  */
 class DetectionWorker : public QThread {
     Q_OBJECT
@@ -25,10 +32,13 @@ public:
     
     /**
      * @brief Start processing images in the specified folder
+     * @param engine Detector handle; swapping it mid-run applies from the next image
+     * @param sessionDirectory If not empty, completed folders are also saved there
      */
     void startProcessing(const std::string& rootPath, 
-                        std::shared_ptr<Core::IDetector> detector,
-                        bool recursive = true);
+                        std::shared_ptr<Core::EngineHandle> engine,
+                        bool recursive = true,
+                        const std::string& sessionDirectory = "");
     
     /**
      * @brief Request cancellation of current processing
@@ -47,15 +57,51 @@ public:
     
     /**
      * @brief Get results (thread-safe)
+     *
+     * Only the published folder pointers are copied under the lock; the
+     * folders themselves are copied afterwards.
      */
     std::vector<Core::FolderResult> getResults() const;
+    
+    /**
+     * @brief Get a single folder result (thread-safe)
+     */
+    Core::FolderResult getFolderResult(int folderIndex) const;
+    
+    /**
+     * @brief Get the image results at the given locations (thread-safe)
+     */
+    std::vector<std::shared_ptr<Core::ImageResult>> getImageResults(
+        const std::vector<Core::ClassIndex::ImageLocation>& locations) const;
+    
+    /**
+     * @brief Index each image's detections as it completes (call before starting)
+     */
+    void setClassIndex(std::shared_ptr<Core::ClassIndex> classIndex);
+    
+    /**
+     * @brief Record live pipeline metrics into this object (call before starting)
+     *
+     * The UiBacklog queue counts imageProcessed signals not yet handled; the
+     * receiver decrements it.
+     */
+    void setMetrics(std::shared_ptr<Core::PipelineMetrics> metrics);
+    
+    /**
+     * @brief Run images on the engines this scheduler asks for (call before starting)
+     *
+     * An undecided scheduler is calibrated on the scanned images first.
+     */
+    void setScheduler(std::shared_ptr<Core::ThreadScheduler> scheduler);
 
 signals:
     void scanningStarted(int totalFolders);
     void folderScanned(QString folderName, int imageCount);
     void processingStarted(int totalImages);
+    
+    // Until its folder completes, a processed image is published only through this signal
     void imageProcessed(QString imagePath, int detectionCount);
-    void folderCompleted(QString folderName, int totalDetections);
+    void folderCompleted(int folderIndex, QString folderName, int imageCount, int totalDetections);
     void processingCompleted(Core::ProcessingStats stats);
     void errorOccurred(QString error);
 
@@ -64,17 +110,29 @@ protected:
 
 private:
     std::string rootPath_;
-    std::shared_ptr<Core::IDetector> detector_;
+    std::shared_ptr<Core::EngineHandle> engine_;
     bool recursive_;
+    std::string sessionDirectory_;
+    std::unique_ptr<Core::ResultsStoreWriter> storeWriter_;
+    std::shared_ptr<Core::ClassIndex> classIndex_;
+    std::shared_ptr<Core::PipelineMetrics> metrics_;
+    std::shared_ptr<Core::ThreadScheduler> scheduler_;
     std::atomic<bool> cancellationRequested_;
     std::atomic<bool> processing_;
     
+    // Published folders are never modified; a completed folder replaces its entry.
+    // Until then its images are placeholders, not the pipeline's image results.
     mutable QMutex resultsMutex_;
-    std::vector<Core::FolderResult> results_;
+    std::vector<std::shared_ptr<const Core::FolderResult>> results_;
     Core::ProcessingStats stats_;
     
-    void performScanning();
-    void performProcessing();
+    // The pipeline's folders, only touched by the worker thread
+    std::vector<Core::FolderResult> folders_;
+    
+    void performScanning(Processing::DetectionPipeline& pipeline);
+    void performProcessing(Processing::DetectionPipeline& pipeline);
+    Processing::DetectionPipeline::Callbacks pipelineCallbacks();
+    void saveFolder(const Core::FolderResult& folderResult);
     void updateStats();
 };
 
@@ -0,0 +1,160 @@
+// src/workers/export_worker.cpp
+#include "export_worker.h"
+#include "../core/trace.h"
+#include <chrono>
+
+namespace YoloApp {
+namespace Workers {
+
+ExportWorker::ExportWorker(QObject* parent)
+    : QThread(parent)
+    , task_(Task::Results)
+    , format_(Processing::ResultExporter::Format::Csv)
+    , cancellationRequested_(false) {
+}
+
+ExportWorker::~ExportWorker() {
+    requestCancellation();
+    if (isRunning()) {
+        wait();
+    }
+}
+
+void ExportWorker::startExport(std::vector<Core::FolderResult> folders,
+                               Processing::ResultExporter::Format format,
+                               const QString& outputPath) {
+    if (isRunning()) {
+        return;
+    }
+    format_ = format;
+    begin(Task::Results, std::move(folders), nullptr, outputPath);
+}
+
+void ExportWorker::startExport(std::shared_ptr<const Core::ResultsStore> store,
+                               Processing::ResultExporter::Format format,
+                               const QString& outputPath) {
+    if (isRunning()) {
+        return;
+    }
+    format_ = format;
+    begin(Task::Results, {}, std::move(store), outputPath);
+}
+
+void ExportWorker::startImageExport(std::vector<Core::FolderResult> folders,
+                                    const Processing::ImageExporter::Options& options,
+                                    const QString& outputDirectory) {
+    if (isRunning()) {
+        return;
+    }
+    imageOptions_ = options;
+    begin(Task::Images, std::move(folders), nullptr, outputDirectory);
+}
+
+void ExportWorker::startImageExport(std::shared_ptr<const Core::ResultsStore> store,
+                                    const Processing::ImageExporter::Options& options,
+                                    const QString& outputDirectory) {
+    if (isRunning()) {
+        return;
+    }
+    imageOptions_ = options;
+    begin(Task::Images, {}, std::move(store), outputDirectory);
+}
+
+void ExportWorker::requestCancellation() {
+    cancellationRequested_ = true;
+}
+
+void ExportWorker::begin(Task task, std::vector<Core::FolderResult> folders,
+                         std::shared_ptr<const Core::ResultsStore> store, const QString& outputPath) {
+    task_ = task;
+    folders_ = std::move(folders);
+    store_ = std::move(store);
+    outputPath_ = outputPath;
+    cancellationRequested_ = false;
+
+    start();
+}
+
+void ExportWorker::run() {
+    Core::Trace::setThreadName("export");
+    try {
+        if (task_ == Task::Results) {
+            runResultExport();
+        } else {
+            runImageExport();
+        }
+    } catch (const std::exception& e) {
+        emit errorOccurred(QString("Export failed: %1").arg(e.what()));
+    }
+
+    // Drop the references to the image results as soon as the export is done
+    folders_.clear();
+    store_.reset();
+}
+
+void ExportWorker::runResultExport() {
+    auto start = std::chrono::steady_clock::now();
+
+    Processing::ResultExporter exporter(format_);
+    exporter.setCancellationFlag(&cancellationRequested_);
+    exporter.setProgressCallback([this](size_t done, size_t total) {
+        emit exportProgress(static_cast<int>(done), static_cast<int>(total));
+    });
+
+    Processing::ResultExporter::Summary summary =
+        exporter.exportResults(folderCount(), imageCount(), folderLoader(), outputPath_.toStdString());
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    emit exportCompleted(outputPath_,
+                         static_cast<qint64>(summary.images),
+                         static_cast<qint64>(summary.detections),
+                         static_cast<qint64>(summary.bytesWritten),
+                         seconds, summary.cancelled);
+}
+
+void ExportWorker::runImageExport() {
+    auto start = std::chrono::steady_clock::now();
+
+    Processing::ImageExporter exporter(imageOptions_);
+    exporter.setCancellationFlag(&cancellationRequested_);
+    exporter.setProgressCallback([this](size_t done, size_t total) {
+        emit exportProgress(static_cast<int>(done), static_cast<int>(total));
+    });
+
+    Processing::ImageExporter::Summary summary =
+        exporter.exportImages(folderCount(), imageCount(), folderLoader(), outputPath_.toStdString());
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    emit imageExportCompleted(outputPath_,
+                              static_cast<qint64>(summary.images),
+                              static_cast<qint64>(summary.crops),
+                              static_cast<qint64>(summary.failedImages),
+                              static_cast<qint64>(summary.bytesWritten),
+                              seconds, summary.cancelled);
+}
+
+size_t ExportWorker::folderCount() const {
+    return store_ ? store_->folderCount() : folders_.size();
+}
+
+size_t ExportWorker::imageCount() const {
+    if (store_) {
+        return store_->imageCount();
+    }
+    size_t count = 0;
+    for (const auto& folder : folders_) {
+        count += folder.images.size();
+    }
+    return count;
+}
+
+std::function<Core::FolderResult(size_t)> ExportWorker::folderLoader() const {
+    if (store_) {
+        std::shared_ptr<const Core::ResultsStore> store = store_;
+        return [store](size_t folderIndex) { return store->loadFolder(folderIndex); };
+    }
+    return [this](size_t folderIndex) { return folders_[folderIndex]; };
+}
+
+} // namespace Workers
+} // namespace YoloApp
@@ -0,0 +1,101 @@
+// src/workers/export_worker.h
+#pragma once
+
+#include "../core/types.h"
+#include "../core/results_store.h"
+#include "../processing/result_exporter.h"
+#include "../processing/image_exporter.h"
+#include <QThread>
+#include <QString>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace YoloApp {
+namespace Workers {
+
+/**
+ * @brief Background worker that writes results to disk
+ *
+ * Runs either a ResultExporter (detection data) or an ImageExporter
+ * (annotated images and crops) over a snapshot of the live results or
+ * over a saved session.
+ */
+class ExportWorker : public QThread {
+    Q_OBJECT
+
+public:
+    explicit ExportWorker(QObject* parent = nullptr);
+    ~ExportWorker() override;
+
+    /**
+     * @brief Start exporting a snapshot of the results
+     */
+    void startExport(std::vector<Core::FolderResult> folders,
+                     Processing::ResultExporter::Format format,
+                     const QString& outputPath);
+
+    /**
+     * @brief Start exporting a saved session, reading one folder at a time
+     */
+    void startExport(std::shared_ptr<const Core::ResultsStore> store,
+                     Processing::ResultExporter::Format format,
+                     const QString& outputPath);
+
+    /**
+     * @brief Start writing annotated images and/or crops for a snapshot of the results
+     */
+    void startImageExport(std::vector<Core::FolderResult> folders,
+                          const Processing::ImageExporter::Options& options,
+                          const QString& outputDirectory);
+
+    /**
+     * @brief Start writing annotated images and/or crops for a saved session
+     */
+    void startImageExport(std::shared_ptr<const Core::ResultsStore> store,
+                          const Processing::ImageExporter::Options& options,
+                          const QString& outputDirectory);
+
+    /**
+     * @brief Request cancellation of the running export
+     */
+    void requestCancellation();
+
+signals:
+    void exportProgress(int doneImages, int totalImages);
+    void exportCompleted(QString outputPath, qint64 images, qint64 detections,
+                         qint64 bytesWritten, double seconds, bool cancelled);
+    void imageExportCompleted(QString outputDirectory, qint64 images, qint64 crops, qint64 failedImages,
+                              qint64 bytesWritten, double seconds, bool cancelled);
+    void errorOccurred(QString error);
+
+protected:
+    void run() override;
+
+private:
+    enum class Task {
+        Results,
+        Images
+    };
+
+    void begin(Task task, std::vector<Core::FolderResult> folders,
+               std::shared_ptr<const Core::ResultsStore> store, const QString& outputPath);
+    void runResultExport();
+    void runImageExport();
+
+    size_t folderCount() const;
+    size_t imageCount() const;
+    std::function<Core::FolderResult(size_t)> folderLoader() const;
+
+    Task task_;
+    std::vector<Core::FolderResult> folders_;
+    std::shared_ptr<const Core::ResultsStore> store_;
+    Processing::ResultExporter::Format format_;
+    Processing::ImageExporter::Options imageOptions_;
+    QString outputPath_;
+    std::atomic<bool> cancellationRequested_;
+};
+
+} // namespace Workers
+} // namespace YoloApp
@@ -0,0 +1,89 @@
+// src/workers/model_load_worker.cpp
+#include "model_load_worker.h"
+#include "../core/trace.h"
+#include <QMutexLocker>
+#include <chrono>
+
+namespace YoloApp {
+namespace Workers {
+
+namespace {
+
+// Share of the progress bar for parsing; the warm-up forward takes the rest
+constexpr int LOAD_PROGRESS_PERCENT = 80;
+
+} // namespace
+
+ModelLoadWorker::ModelLoadWorker(std::shared_ptr<Core::ModelCache> modelCache, QObject* parent)
+    : QThread(parent)
+    , modelCache_(std::move(modelCache)) {
+}
+
+ModelLoadWorker::~ModelLoadWorker() {
+    // Parsing cannot be interrupted; wait for it rather than leave it running
+    if (isRunning()) {
+        wait();
+    }
+}
+
+void ModelLoadWorker::startLoading(const Request& request) {
+    if (isRunning()) {
+        return;
+    }
+
+    {
+        QMutexLocker locker(&mutex_);
+        request_ = request;
+        detector_.reset();
+    }
+
+    start();
+}
+
+ModelLoadWorker::Request ModelLoadWorker::request() const {
+    QMutexLocker locker(&mutex_);
+    return request_;
+}
+
+std::shared_ptr<Core::YoloDetector> ModelLoadWorker::takeDetector() {
+    QMutexLocker locker(&mutex_);
+    return std::move(detector_);
+}
+
+void ModelLoadWorker::run() {
+    Core::Trace::setThreadName("model load");
+    Request request = this->request();
+
+    auto detector = std::make_shared<Core::YoloDetector>();
+    detector->setConfig(request.config);
+    detector->setModelCache(modelCache_);
+    detector->setProgressCallback([this](int percent, const std::string& step) {
+        emit loadProgress(percent * LOAD_PROGRESS_PERCENT / 100, QString::fromStdString(step));
+    });
+
+    auto start = std::chrono::steady_clock::now();
+    bool loaded = detector->loadModel(request.modelPath.toStdString(),
+                                      request.configPath.toStdString(),
+                                      request.classesPath.toStdString());
+    double loadSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    detector->setProgressCallback(nullptr);
+
+    if (!loaded) {
+        emit loadCompleted(false, QString::fromStdString(detector->getLastError()), loadSeconds, 0.0, false);
+        return;
+    }
+
+    emit loadProgress(LOAD_PROGRESS_PERCENT, "Warming up");
+    double warmUpSeconds = detector->warmUp();
+    emit loadProgress(100, "Ready");
+
+    bool fromCache = detector->wasLoadedFromCache();
+    {
+        QMutexLocker locker(&mutex_);
+        detector_ = std::move(detector);
+    }
+    emit loadCompleted(true, QString(), loadSeconds, warmUpSeconds, fromCache);
+}
+
+} // namespace Workers
+} // namespace YoloApp
@@ -0,0 +1,67 @@
+// src/workers/model_load_worker.h
+#pragma once
+
+#include "../core/types.h"
+#include "../core/detector.h"
+#include "../core/model_cache.h"
+#include <QThread>
+#include <QString>
+#include <QMutex>
+#include <memory>
+
+namespace YoloApp {
+namespace Workers {
+
+/**
+ * @brief Background worker that loads and warms up a model
+ *
+ * Builds a fresh YoloDetector on its own thread, so parsing large weight
+ * files and the one-time initialization of the first forward never block
+ * the window. The caller takes the ready detector after loadCompleted and
+ * swaps it in; the previous detector stays usable until then.
+ */
+class ModelLoadWorker : public QThread {
+    Q_OBJECT
+
+public:
+    struct Request {
+        QString modelPath;
+        QString configPath;     ///< Darknet .cfg for .weights models
+        QString classesPath;    ///< Optional class names, one per line
+        Core::DetectionConfig config;
+    };
+
+    explicit ModelLoadWorker(std::shared_ptr<Core::ModelCache> modelCache, QObject* parent = nullptr);
+    ~ModelLoadWorker() override;
+
+    /**
+     * @brief Start loading; ignored while a load is running
+     */
+    void startLoading(const Request& request);
+
+    /**
+     * @brief The request of the current or last load
+     */
+    Request request() const;
+
+    /**
+     * @brief Hand over the detector of a successful load (null otherwise or if already taken)
+     */
+    std::shared_ptr<Core::YoloDetector> takeDetector();
+
+signals:
+    void loadProgress(int percent, QString step);
+    void loadCompleted(bool success, QString error, double loadSeconds, double warmUpSeconds, bool fromCache);
+
+protected:
+    void run() override;
+
+private:
+    std::shared_ptr<Core::ModelCache> modelCache_;
+    Request request_;
+    std::shared_ptr<Core::YoloDetector> detector_;
+    mutable QMutex mutex_;
+};
+
+} // namespace Workers
+} // namespace YoloApp
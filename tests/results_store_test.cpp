@@ -0,0 +1,127 @@
+// tests/results_store_test.cpp
+#include "core/results_store.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+namespace fs = std::filesystem;
+using namespace YoloApp;
+using namespace YoloApp::Core;
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& message) {
+    if (!condition) {
+        std::fprintf(stderr, "FAILED: %s\n", message.c_str());
+        ++failures;
+    }
+}
+
+// Two folders of two images with one detection each
+void writeSession(const fs::path& directory) {
+    fs::remove_all(directory);
+    ResultsStoreWriter writer(directory.string());
+    for (int f = 0; f < 2; ++f) {
+        FolderResult folder("/data/folder" + std::to_string(f));
+        folder.folderName = "folder" + std::to_string(f);
+        for (int i = 0; i < 2; ++i) {
+            auto image = std::make_shared<ImageResult>(folder.folderPath + "/image" + std::to_string(i) + ".jpg");
+            image->imageSize = cv::Size(640, 480);
+            image->processed = true;
+            image->detections.emplace_back(cv::Rect(10, 20, 30, 40), 0.9f, f, f == 0 ? "person" : "car");
+            folder.images.push_back(image);
+        }
+        writer.appendFolder(folder);
+    }
+}
+
+// Overwrite a field of one record in a column file
+template <typename Record, typename Field>
+void patchRecord(const fs::path& directory, const char* file, size_t index, Field Record::*field, Field value) {
+    Record record{};
+    std::fstream stream(directory / file, std::ios::binary | std::ios::in | std::ios::out);
+    stream.seekg(static_cast<std::streamoff>(index * sizeof(Record)));
+    stream.read(reinterpret_cast<char*>(&record), sizeof(record));
+    record.*field = value;
+    stream.seekp(static_cast<std::streamoff>(index * sizeof(Record)));
+    stream.write(reinterpret_cast<const char*>(&record), sizeof(record));
+    check(static_cast<bool>(stream), std::string("patching ") + file);
+}
+
+void expectCorrupt(const fs::path& directory, const std::string& name,
+                   const std::function<void()>& corrupt) {
+    writeSession(directory);
+    corrupt();
+
+    ResultsStore store;
+    try {
+        store.open(directory.string());
+        check(false, name + ": open accepted a corrupt session");
+    } catch (const std::runtime_error& error) {
+        check(std::string(error.what()).find("Session file is corrupt") != std::string::npos,
+              name + ": unexpected error: " + error.what());
+    }
+    check(!store.isOpen(), name + ": store left open after a failed open");
+}
+
+} // namespace
+
+int main() {
+    const fs::path directory = fs::temp_directory_path() / "yolo_results_store_test";
+
+    // An intact session opens and reads back
+    writeSession(directory);
+    {
+        ResultsStore store;
+        store.open(directory.string());
+        check(store.folderCount() == 2 && store.imageCount() == 4 && store.detectionCount() == 4,
+              "intact session counts");
+        FolderResult folder = store.loadFolder(1);
+        check(folder.images.size() == 2 && folder.images[1]->detections.size() == 1 &&
+              folder.images[1]->detections[0].className == "car",
+              "intact session contents");
+    }
+
+    using StoreFormat::FolderRecord;
+    using StoreFormat::ImageRecord;
+    using StoreFormat::ClassRecord;
+
+    expectCorrupt(directory, "folder range past the images", [&] {
+        patchRecord(directory, StoreFormat::FOLDERS_FILE, 1, &FolderRecord::firstImage, uint64_t{3});
+    });
+    expectCorrupt(directory, "folder range overflowing", [&] {
+        patchRecord(directory, StoreFormat::FOLDERS_FILE, 0, &FolderRecord::imageCount, UINT64_MAX);
+    });
+    expectCorrupt(directory, "image range past the detections", [&] {
+        patchRecord(directory, StoreFormat::IMAGES_FILE, 2, &ImageRecord::firstDetection, uint64_t{4});
+    });
+    expectCorrupt(directory, "image range overflowing", [&] {
+        patchRecord(directory, StoreFormat::IMAGES_FILE, 0, &ImageRecord::firstDetection, UINT64_MAX);
+    });
+    expectCorrupt(directory, "negative class id", [&] {
+        patchRecord(directory, StoreFormat::CLASSES_FILE, 0, &ClassRecord::classId, int32_t{-5});
+    });
+    expectCorrupt(directory, "duplicate class id", [&] {
+        patchRecord(directory, StoreFormat::CLASSES_FILE, 1, &ClassRecord::classId, int32_t{0});
+    });
+    expectCorrupt(directory, "class name past the strings", [&] {
+        patchRecord(directory, StoreFormat::CLASSES_FILE, 0, &ClassRecord::nameOffset, UINT64_MAX);
+    });
+
+    fs::remove_all(directory);
+
+    if (failures > 0) {
+        std::fprintf(stderr, "%d check(s) failed\n", failures);
+        return 1;
+    }
+    std::printf("results_store_test passed\n");
+    return 0;
+}